@@ -0,0 +1,1209 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * Benchmark of the message path, producing machine-readable JSON so that two runs (before and after
+ * a change to zajel_send for instance) can be compared. Every scenario builds its own topology on
+ * the ring transport, runs its threads on pthreads and reports the messages per second along with
+ * the 50th, 99th and 99.9th percentiles of its latency, in nanoseconds:
+ *
+ * o async:       A component sends asynchronous messages to another one, for each dynamic relation
+ *                (latency from zajel_send to the handler).
+ * o sync:        A component sends synchronous messages to another one, for each dynamic relation
+ *                and synchronization mode: the built-in slots or semaphore based thread callbacks
+ *                (latency of the whole round trip).
+ * o fan_in:      1 to 64 producer threads send to a single component (latency from zajel_send to the
+ *                handler).
+ * o fan_out:     A single producer sends to 1 to 64 components, each on its own thread.
+ * o acknowledge: A synchronous message is acknowledged from another thread of the same core or
+ *                from another core (latency from zajel_acknowledge to the sender resuming).
+ * o reference:   The same exchanges over a plain mutex and condition variable queue, as a baseline.
+ *
+ * The cores are simulated within the process: the core callbacks push the messages to the
+ * reference queue of the destination core, drained by a gateway thread running on that core.
+ *
+ * Build: make, into build/ (or make run to write build/results.json)
+ * Usage: zajel_bench [-n messages] [-t max threads] [-o json file]
+ */
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include "zajel.h"
+
+/***************************************************************************************************
+ *
+ *  D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+#define ZAJEL_BENCH_DEFAULT_MESSAGE_COUNT   (100000)
+#define ZAJEL_BENCH_MAX_THREAD_COUNT        (64)
+/*Producer or consumer threads, plus the thread on the other side and the gateway of each core*/
+#define ZAJEL_BENCH_MAX_TOPOLOGY_THREADS    (ZAJEL_BENCH_MAX_THREAD_COUNT + 3)
+#define ZAJEL_BENCH_CORE_COUNT              (2)
+#define ZAJEL_BENCH_RING_CAPACITY           (1024)
+#define ZAJEL_BENCH_QUEUE_CAPACITY          (1024)
+#define ZAJEL_BENCH_DISPATCH_BUDGET         (64)
+#define ZAJEL_BENCH_MESSAGE_ID              (1)
+
+#define L COMMA() FILE_AND_LINE_FOR_REF()
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/*Role of a thread of the benchmark topology*/
+typedef enum zajel_bench_role
+{
+    /*Run by the main thread, or idle*/
+    ZAJEL_BENCH_ROLE_NONE       = 0,
+    /*Runs zajel_dispatch until the scenario ends*/
+    ZAJEL_BENCH_ROLE_WORKER     = 1,
+    /*Drains the reference queue of its core through zajel_deliver*/
+    ZAJEL_BENCH_ROLE_GATEWAY    = 2,
+    /*Sends its share of the asynchronous messages (fan-in)*/
+    ZAJEL_BENCH_ROLE_PRODUCER   = 3
+} zajel_bench_role_e;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_bench_message_s
+ *
+ * Structure Description:
+ * The message exchanged by every scenario.
+ **************************************************************************************************/
+typedef struct zajel_bench_message
+{
+    zajel_message_descriptor_s  descriptor;
+    /*Time of the send, or of the request for the reference queue*/
+    uint64_t                    sendTime;
+    /*Time the handler acknowledged the message*/
+    uint64_t                    acknowledgeTime;
+    /*Entry of the latency samples*/
+    uint32_t                    index;
+} zajel_bench_message_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_bench_entry_s
+ *
+ * Structure Description:
+ * An entry of the reference queue. The acknowledgments are built on the stack of zajel_acknowledge,
+ * so they are carried by value, the other messages by address. A NULL message which is not an
+ * acknowledgment stops the consumer.
+ **************************************************************************************************/
+typedef struct zajel_bench_entry
+{
+    void*                       message_ptr;
+    zajel_message_descriptor_s  acknowledge;
+    int                         isAcknowledge;
+} zajel_bench_entry_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_bench_queue_s
+ *
+ * Structure Description:
+ * The reference queue: a bounded circular buffer guarded by a mutex, the producers waiting for room
+ * and the consumers for entries on condition variables.
+ **************************************************************************************************/
+typedef struct zajel_bench_queue
+{
+    pthread_mutex_t     mutex;
+    pthread_cond_t      notEmpty;
+    pthread_cond_t      notFull;
+    uint32_t            head;
+    uint32_t            tail;
+    zajel_bench_entry_s entryArray[ZAJEL_BENCH_QUEUE_CAPACITY];
+} zajel_bench_queue_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_bench_s
+ *
+ * Structure Description:
+ * The state of the benchmark, shared by the threads of the running scenario (the handlers and the
+ * callbacks of the framework take no context).
+ **************************************************************************************************/
+typedef struct zajel_bench
+{
+    zajel_s*                zajel_ptr;
+    /*Results file*/
+    FILE*                   output_ptr;
+    /*Messages sent by each scenario*/
+    uint32_t                messageCount;
+    uint32_t                maxThreadCount;
+    int                     isFirstResult;
+    /*Topology of the running scenario*/
+    uint32_t                threadCount;
+    uint32_t                coreArray[ZAJEL_BENCH_MAX_TOPOLOGY_THREADS];
+    zajel_bench_role_e      roleArray[ZAJEL_BENCH_MAX_TOPOLOGY_THREADS];
+    pthread_t               pthreadArray[ZAJEL_BENCH_MAX_TOPOLOGY_THREADS];
+    sem_t                   semaphoreArray[ZAJEL_BENCH_MAX_TOPOLOGY_THREADS];
+    zajel_bench_queue_s     queueArray[ZAJEL_BENCH_CORE_COUNT];
+    /*First message sent by each producer, the last one being the first of the next producer*/
+    uint32_t                firstMessageArray[ZAJEL_BENCH_MAX_TOPOLOGY_THREADS + 1];
+    /*Progress of the running scenario*/
+    volatile int            isGoing;
+    volatile int            isStopping;
+    /*Whether the handler shall acknowledge the synchronous messages*/
+    int                     isAcknowledging;
+    uint64_t                handledCount;
+    uint64_t                endTime;
+    zajel_bench_message_s*  messageArray;
+    uint64_t*               sampleArray;
+} zajel_bench_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_now
+ *
+ *  Arguments   : None.
+ *
+ *  Description : Reads the monotonic clock.
+ *
+ *  Returns     : uint64_t, the time in nanoseconds.
+ **************************************************************************************************/
+static uint64_t zajel_bench_now(void);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_queue_init
+ *
+ *  Arguments   : zajel_bench_queue_s* queue_ptr
+ *
+ *  Description : Initializes an empty reference queue.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_queue_init(zajel_bench_queue_s* queue_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_queue_destroy
+ *
+ *  Arguments   : zajel_bench_queue_s* queue_ptr
+ *
+ *  Description : Releases the synchronization primitives of a reference queue.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_queue_destroy(zajel_bench_queue_s* queue_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_queue_push
+ *
+ *  Arguments   : zajel_bench_queue_s*          queue_ptr,
+ *                const zajel_bench_entry_s*    entry_ptr
+ *
+ *  Description : Appends a copy of the entry, waiting for room if the queue is full.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_queue_push(zajel_bench_queue_s*         queue_ptr,
+                                   const zajel_bench_entry_s*   entry_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_queue_pop
+ *
+ *  Arguments   : zajel_bench_queue_s*  queue_ptr,
+ *                zajel_bench_entry_s*  entry_ptr
+ *
+ *  Description : Removes the oldest entry, waiting for one if the queue is empty.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_queue_pop(zajel_bench_queue_s*  queue_ptr,
+                                  zajel_bench_entry_s*  entry_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_handle
+ *
+ *  Arguments   : zajel_message_descriptor_s* descriptor_ptr
+ *
+ *  Description : Handler of the benchmark message: records the latency of the asynchronous
+ *                  messages and acknowledges the synchronous ones.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_handle(zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_core_0, zajel_bench_core_1
+ *
+ *  Arguments   : zajel_message_descriptor_s* descriptor_ptr
+ *
+ *  Description : Core callbacks, passing the message to the reference queue of the core.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_core_0(zajel_message_descriptor_s* descriptor_ptr);
+static void zajel_bench_core_1(zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_thread_unused, zajel_bench_block, zajel_bench_unblock
+ *
+ *  Arguments   : zajel_message_descriptor_s* descriptor_ptr / void* semaphore_ptr
+ *
+ *  Description : Thread callbacks. The messages of the threads go through the ring transport, and
+ *                  the blocking uses the semaphore of the thread when the slots are not enabled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_thread_unused(zajel_message_descriptor_s* descriptor_ptr);
+static void zajel_bench_block(void* semaphore_ptr);
+static void zajel_bench_unblock(void* semaphore_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_thread
+ *
+ *  Arguments   : void* argument_ptr, the thread ID
+ *
+ *  Description : Runs a thread of the topology according to its role.
+ *
+ *  Returns     : void*, NULL.
+ **************************************************************************************************/
+static void* zajel_bench_thread(void* argument_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_setup
+ *
+ *  Arguments   : zajel_bench_s*    bench_ptr,
+ *                uint32_t          componentCount,
+ *                const uint32_t*   componentThreadArray,
+ *                int               isUsingSlots
+ *
+ *  Description : Builds and seals the topology described by threadCount, coreArray and the given
+ *                  thread of each component, then starts the threads having a role. The main thread
+ *                  runs thread 0.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_setup(zajel_bench_s*    bench_ptr,
+                              uint32_t          componentCount,
+                              const uint32_t*   componentThreadArray,
+                              int               isUsingSlots);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_teardown
+ *
+ *  Arguments   : zajel_bench_s* bench_ptr
+ *
+ *  Description : Stops the threads of the scenario and destroys its topology.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_teardown(zajel_bench_s* bench_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_prepare
+ *
+ *  Arguments   : zajel_bench_s*    bench_ptr,
+ *                uint32_t          count
+ *
+ *  Description : Resets the progress of the scenario, expecting count messages to be handled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_prepare(zajel_bench_s*  bench_ptr,
+                                uint32_t        count);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_send
+ *
+ *  Arguments   : zajel_bench_s*    bench_ptr,
+ *                uint32_t          index,
+ *                uint32_t          sourceComponentID,
+ *                uint32_t          destinationComponentID,
+ *                int               isSynchronous
+ *
+ *  Description : Stamps and sends the given message of the scenario.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_send(zajel_bench_s* bench_ptr,
+                             uint32_t       index,
+                             uint32_t       sourceComponentID,
+                             uint32_t       destinationComponentID,
+                             int            isSynchronous);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_wait
+ *
+ *  Arguments   : zajel_bench_s* bench_ptr
+ *
+ *  Description : Waits (from thread 0) until the asynchronous messages of the scenario were handled,
+ *                  dispatching the messages of thread 0 meanwhile.
+ *
+ *  Returns     : uint64_t, the time the last message was handled.
+ **************************************************************************************************/
+static uint64_t zajel_bench_wait(zajel_bench_s* bench_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_report
+ *
+ *  Arguments   : zajel_bench_s*    bench_ptr,
+ *                const char*       scenario_ptr,
+ *                const char*       relation_ptr,
+ *                const char*       mode_ptr,
+ *                uint32_t          threadCount,
+ *                uint64_t          elapsedTime
+ *
+ *  Description : Writes the result of a scenario, computed from the messageCount latency samples and
+ *                  the time it took to exchange the messages.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_report(zajel_bench_s*   bench_ptr,
+                               const char*      scenario_ptr,
+                               const char*      relation_ptr,
+                               const char*      mode_ptr,
+                               uint32_t         threadCount,
+                               uint64_t         elapsedTime);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_relation
+ *
+ *  Arguments   : zajel_bench_s*                        bench_ptr,
+ *                zajel_component_dynamic_relation_e    relation
+ *
+ *  Description : Builds the topology of the given relation between component 0 (thread 0, core 0)
+ *                  and component 1: on thread 0, on thread 1 of core 0 (a worker), or on thread 1 of
+ *                  core 1 (its gateway, thread 2 being the gateway of core 0).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_relation(zajel_bench_s*                        bench_ptr,
+                                 zajel_component_dynamic_relation_e    relation,
+                                 int                                   isUsingSlots);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_async, zajel_bench_sync, zajel_bench_acknowledge, zajel_bench_fan_in,
+ *                zajel_bench_fan_out, zajel_bench_reference
+ *
+ *  Arguments   : zajel_bench_s* bench_ptr, and the parameters of the scenario
+ *
+ *  Description : Run a scenario and report its result.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_bench_async(zajel_bench_s*                        bench_ptr,
+                              zajel_component_dynamic_relation_e    relation);
+static void zajel_bench_sync(zajel_bench_s*                         bench_ptr,
+                             zajel_component_dynamic_relation_e     relation,
+                             int                                    isUsingSlots,
+                             int                                    isMeasuringAcknowledge);
+static void zajel_bench_fan_in(zajel_bench_s*  bench_ptr,
+                               uint32_t        producerCount);
+static void zajel_bench_fan_out(zajel_bench_s* bench_ptr,
+                                uint32_t       consumerCount);
+static void zajel_bench_reference(zajel_bench_s*   bench_ptr,
+                                  int              isSynchronous);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_reference_consumer
+ *
+ *  Arguments   : void* argument_ptr, unused
+ *
+ *  Description : Consumer of the reference scenario: records the latency of the requests of queue 0,
+ *                  answering the synchronous ones on queue 1.
+ *
+ *  Returns     : void*, NULL.
+ **************************************************************************************************/
+static void* zajel_bench_reference_consumer(void* argument_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_bench_compare
+ *
+ *  Arguments   : const void* first_ptr,
+ *                const void* second_ptr
+ *
+ *  Description : Orders two latency samples, for qsort.
+ *
+ *  Returns     : int.
+ **************************************************************************************************/
+static int zajel_bench_compare(const void*  first_ptr,
+                               const void*  second_ptr);
+
+/***************************************************************************************************
+ *
+ *  G L O B A L S
+ *
+ **************************************************************************************************/
+static zajel_bench_s zajelBench;
+
+static const char* const zajelBenchRelationNameArray[ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT] =
+{
+    "same_thread",
+    "same_core",
+    "different_cores"
+};
+
+/***************************************************************************************************
+ *
+ *  F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+int main(int    argumentCount,
+         char** argument_ptr_array)
+{
+    zajel_bench_s*  bench_ptr;
+    const char*     path_ptr;
+    uint32_t        relation;
+    uint32_t        threadCount;
+    int             i;
+
+    bench_ptr                   = &zajelBench;
+    bench_ptr->messageCount     = ZAJEL_BENCH_DEFAULT_MESSAGE_COUNT;
+    bench_ptr->maxThreadCount   = ZAJEL_BENCH_MAX_THREAD_COUNT;
+    bench_ptr->isFirstResult    = 1;
+    path_ptr                    = NULL;
+
+    for(i = 1; i < argumentCount; i += 2)
+    {
+        if((i + 1) >= argumentCount)
+        {
+            i = 0;
+            break;
+        } /*if: <Option without value>*/
+        else if(0 == strcmp(argument_ptr_array[i], "-n"))
+        {
+            bench_ptr->messageCount = (uint32_t) strtoul(argument_ptr_array[i + 1], NULL, 0);
+        } /*if: <Messages per scenario>*/
+        else if(0 == strcmp(argument_ptr_array[i], "-t"))
+        {
+            bench_ptr->maxThreadCount = (uint32_t) strtoul(argument_ptr_array[i + 1], NULL, 0);
+        } /*if: <Most producers or consumers>*/
+        else if(0 == strcmp(argument_ptr_array[i], "-o"))
+        {
+            path_ptr = argument_ptr_array[i + 1];
+        } /*if: <Results file>*/
+        else
+        {
+            i = 0;
+            break;
+        } /*else: <Unknown option>*/
+    } /*for: <Parse the options>*/
+
+    if((0 == i) ||
+       (0 == bench_ptr->messageCount) ||
+       (0 == bench_ptr->maxThreadCount) ||
+       (ZAJEL_BENCH_MAX_THREAD_COUNT < bench_ptr->maxThreadCount))
+    {
+        fprintf(stderr, "Usage: %s [-n messages] [-t max threads (1 to %u)] [-o json file]\n",
+                argument_ptr_array[0], ZAJEL_BENCH_MAX_THREAD_COUNT);
+        return 1;
+    } /*if: <Wrong arguments>*/
+
+    bench_ptr->output_ptr   = (NULL != path_ptr) ? (fopen(path_ptr, "w")) : (stdout);
+    bench_ptr->messageArray = (zajel_bench_message_s*) calloc(bench_ptr->messageCount, sizeof(zajel_bench_message_s));
+    bench_ptr->sampleArray  = (uint64_t*) calloc(bench_ptr->messageCount, sizeof(uint64_t));
+
+    if((NULL == bench_ptr->output_ptr) ||
+       (NULL == bench_ptr->messageArray) ||
+       (NULL == bench_ptr->sampleArray))
+    {
+        fprintf(stderr, "%s: cannot start\n", argument_ptr_array[0]);
+        return 1;
+    } /*if: <Cannot start>*/
+
+    for(i = 0; i < ZAJEL_BENCH_CORE_COUNT; ++i)
+    {
+        zajel_bench_queue_init(&bench_ptr->queueArray[i]);
+    } /*for: <Initialize the queue of each core>*/
+
+    for(i = 0; i < ZAJEL_BENCH_MAX_TOPOLOGY_THREADS; ++i)
+    {
+        sem_init(&bench_ptr->semaphoreArray[i], 0, 0);
+    } /*for: <Initialize the semaphore of each thread>*/
+
+    fprintf(bench_ptr->output_ptr,
+            "{\"benchmark\":\"zajel\",\"messages\":%u,\"max_threads\":%u,\"results\":[\n",
+            bench_ptr->messageCount, bench_ptr->maxThreadCount);
+
+    for(relation = 0; relation < ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT; ++relation)
+    {
+        zajel_bench_async(bench_ptr, (zajel_component_dynamic_relation_e) relation);
+        zajel_bench_sync(bench_ptr, (zajel_component_dynamic_relation_e) relation, 1, 0);
+        zajel_bench_sync(bench_ptr, (zajel_component_dynamic_relation_e) relation, 0, 0);
+    } /*for: <Each dynamic relation>*/
+
+    for(threadCount = 1; threadCount <= bench_ptr->maxThreadCount; threadCount *= 2)
+    {
+        zajel_bench_fan_in(bench_ptr, threadCount);
+        zajel_bench_fan_out(bench_ptr, threadCount);
+    } /*for: <Each number of producers or consumers>*/
+
+    for(relation = ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE; relation < ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT; ++relation)
+    {
+        zajel_bench_sync(bench_ptr, (zajel_component_dynamic_relation_e) relation, 1, 1);
+        zajel_bench_sync(bench_ptr, (zajel_component_dynamic_relation_e) relation, 0, 1);
+    } /*for: <Each relation crossing threads>*/
+
+    zajel_bench_reference(bench_ptr, 0);
+    zajel_bench_reference(bench_ptr, 1);
+
+    fprintf(bench_ptr->output_ptr, "\n]}\n");
+
+    for(i = 0; i < ZAJEL_BENCH_CORE_COUNT; ++i)
+    {
+        zajel_bench_queue_destroy(&bench_ptr->queueArray[i]);
+    } /*for: <Destroy the queue of each core>*/
+
+    for(i = 0; i < ZAJEL_BENCH_MAX_TOPOLOGY_THREADS; ++i)
+    {
+        sem_destroy(&bench_ptr->semaphoreArray[i]);
+    } /*for: <Destroy the semaphore of each thread>*/
+
+    free(bench_ptr->messageArray);
+    free(bench_ptr->sampleArray);
+
+    if((stdout != bench_ptr->output_ptr) &&
+       (0 != fclose(bench_ptr->output_ptr)))
+    {
+        fprintf(stderr, "%s: cannot be written\n", path_ptr);
+        return 1;
+    } /*if: <Results cannot be written>*/
+
+    return 0;
+} /*function: main*/
+
+static uint64_t zajel_bench_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+} /*function: zajel_bench_now*/
+
+static void zajel_bench_queue_init(zajel_bench_queue_s* queue_ptr)
+{
+    pthread_mutex_init(&queue_ptr->mutex, NULL);
+    pthread_cond_init(&queue_ptr->notEmpty, NULL);
+    pthread_cond_init(&queue_ptr->notFull, NULL);
+    queue_ptr->head = 0;
+    queue_ptr->tail = 0;
+} /*function: zajel_bench_queue_init*/
+
+static void zajel_bench_queue_destroy(zajel_bench_queue_s* queue_ptr)
+{
+    pthread_mutex_destroy(&queue_ptr->mutex);
+    pthread_cond_destroy(&queue_ptr->notEmpty);
+    pthread_cond_destroy(&queue_ptr->notFull);
+} /*function: zajel_bench_queue_destroy*/
+
+static void zajel_bench_queue_push(zajel_bench_queue_s*         queue_ptr,
+                                   const zajel_bench_entry_s*   entry_ptr)
+{
+    pthread_mutex_lock(&queue_ptr->mutex);
+
+    while(ZAJEL_BENCH_QUEUE_CAPACITY == (queue_ptr->tail - queue_ptr->head))
+    {
+        pthread_cond_wait(&queue_ptr->notFull, &queue_ptr->mutex);
+    } /*while: <Queue is full>*/
+
+    queue_ptr->entryArray[queue_ptr->tail % ZAJEL_BENCH_QUEUE_CAPACITY] = *entry_ptr;
+    ++queue_ptr->tail;
+
+    pthread_cond_signal(&queue_ptr->notEmpty);
+    pthread_mutex_unlock(&queue_ptr->mutex);
+} /*function: zajel_bench_queue_push*/
+
+static void zajel_bench_queue_pop(zajel_bench_queue_s*  queue_ptr,
+                                  zajel_bench_entry_s*  entry_ptr)
+{
+    pthread_mutex_lock(&queue_ptr->mutex);
+
+    while(queue_ptr->tail == queue_ptr->head)
+    {
+        pthread_cond_wait(&queue_ptr->notEmpty, &queue_ptr->mutex);
+    } /*while: <Queue is empty>*/
+
+    *entry_ptr = queue_ptr->entryArray[queue_ptr->head % ZAJEL_BENCH_QUEUE_CAPACITY];
+    ++queue_ptr->head;
+
+    pthread_cond_signal(&queue_ptr->notFull);
+    pthread_mutex_unlock(&queue_ptr->mutex);
+} /*function: zajel_bench_queue_pop*/
+
+static void zajel_bench_handle(zajel_message_descriptor_s* descriptor_ptr)
+{
+    zajel_bench_message_s*  message_ptr;
+    uint64_t                now;
+
+    message_ptr = (zajel_bench_message_s*) descriptor_ptr;
+    now         = zajel_bench_now();
+
+    if(FALSE == descriptor_ptr->isSynchronous)
+    {
+        zajelBench.sampleArray[message_ptr->index] = now - message_ptr->sendTime;
+
+        if(0 == __atomic_sub_fetch(&zajelBench.handledCount, 1, __ATOMIC_ACQ_REL))
+        {
+            __atomic_store_n(&zajelBench.endTime, now, __ATOMIC_RELEASE);
+        } /*if: <Last message of the scenario>*/
+    } /*if: <Asynchronous message>*/
+    else if(zajelBench.isAcknowledging)
+    {
+        message_ptr->acknowledgeTime = zajel_bench_now();
+
+        zajel_acknowledge(zajelBench.zajel_ptr, descriptor_ptr L);
+    } /*if: <Synchronous message sent from another thread>*/
+} /*function: zajel_bench_handle*/
+
+static void zajel_bench_core_0(zajel_message_descriptor_s* descriptor_ptr)
+{
+    zajel_bench_entry_s entry;
+
+    entry.isAcknowledge = (ZAJEL_ACK_MESSAGE_ID == descriptor_ptr->messageID);
+    entry.message_ptr   = (entry.isAcknowledge) ? (NULL) : (descriptor_ptr);
+    entry.acknowledge   = *descriptor_ptr;
+
+    zajel_bench_queue_push(&zajelBench.queueArray[0], &entry);
+} /*function: zajel_bench_core_0*/
+
+static void zajel_bench_core_1(zajel_message_descriptor_s* descriptor_ptr)
+{
+    zajel_bench_entry_s entry;
+
+    entry.isAcknowledge = (ZAJEL_ACK_MESSAGE_ID == descriptor_ptr->messageID);
+    entry.message_ptr   = (entry.isAcknowledge) ? (NULL) : (descriptor_ptr);
+    entry.acknowledge   = *descriptor_ptr;
+
+    zajel_bench_queue_push(&zajelBench.queueArray[1], &entry);
+} /*function: zajel_bench_core_1*/
+
+static void zajel_bench_thread_unused(zajel_message_descriptor_s* descriptor_ptr)
+{
+    (void) descriptor_ptr;
+
+    fprintf(stderr, "zajel_bench: message bypassed the ring transport\n");
+    abort();
+} /*function: zajel_bench_thread_unused*/
+
+static void zajel_bench_block(void* semaphore_ptr)
+{
+    while(0 != sem_wait((sem_t*) semaphore_ptr));
+} /*function: zajel_bench_block*/
+
+static void zajel_bench_unblock(void* semaphore_ptr)
+{
+    sem_post((sem_t*) semaphore_ptr);
+} /*function: zajel_bench_unblock*/
+
+static void* zajel_bench_thread(void* argument_ptr)
+{
+    zajel_bench_s*      bench_ptr;
+    zajel_bench_entry_s entry;
+    uint32_t            threadID;
+    uint32_t            index;
+
+    bench_ptr   = &zajelBench;
+    threadID    = (uint32_t)(uintptr_t) argument_ptr;
+
+    switch(bench_ptr->roleArray[threadID])
+    {
+        case ZAJEL_BENCH_ROLE_WORKER:
+            while(!bench_ptr->isStopping)
+            {
+                if(0 == zajel_dispatch(bench_ptr->zajel_ptr, threadID, ZAJEL_BENCH_DISPATCH_BUDGET L))
+                {
+                    sched_yield();
+                } /*if: <Nothing to do>*/
+            } /*while: <Scenario is running>*/
+            break;
+        case ZAJEL_BENCH_ROLE_GATEWAY:
+            for(;;)
+            {
+                zajel_bench_queue_pop(&bench_ptr->queueArray[bench_ptr->coreArray[threadID]], &entry);
+
+                if(entry.isAcknowledge)
+                {
+                    zajel_deliver(bench_ptr->zajel_ptr, &entry.acknowledge, threadID L);
+                } /*if: <Acknowledgment>*/
+                else if(NULL != entry.message_ptr)
+                {
+                    zajel_deliver(bench_ptr->zajel_ptr, entry.message_ptr, threadID L);
+                } /*if: <Message>*/
+                else
+                {
+                    break;
+                } /*else: <Scenario is over>*/
+            } /*for: <Drain the queue of the core>*/
+            break;
+        case ZAJEL_BENCH_ROLE_PRODUCER:
+            while(!bench_ptr->isGoing)
+            {
+                sched_yield();
+            } /*while: <Wait for the other producers>*/
+
+            for(index = bench_ptr->firstMessageArray[threadID];
+                index < bench_ptr->firstMessageArray[threadID + 1];
+                ++index)
+            {
+                /*The producer runs the component of the same ID, sending to component 0*/
+                zajel_bench_send(bench_ptr, index, threadID, 0, FALSE);
+            } /*for: <Send the share of the producer>*/
+            break;
+        default:
+            break;
+    } /*switch: <Run the role of the thread>*/
+
+    return NULL;
+} /*function: zajel_bench_thread*/
+
+static void zajel_bench_setup(zajel_bench_s*    bench_ptr,
+                              uint32_t          componentCount,
+                              const uint32_t*   componentThreadArray,
+                              int               isUsingSlots)
+{
+    zajel_config_s  config;
+    char            name[] = "bench";
+    uint32_t        i;
+
+    config.messageCount     = ZAJEL_BENCH_MESSAGE_ID + 1;
+    config.componentCount   = componentCount;
+    config.threadCount      = bench_ptr->threadCount;
+    config.coreCount        = ZAJEL_BENCH_CORE_COUNT;
+
+    zajel_init(&bench_ptr->zajel_ptr, &config, malloc, free L);
+    zajel_regsiter_core(bench_ptr->zajel_ptr, 0, zajel_bench_core_0, name L);
+    zajel_regsiter_core(bench_ptr->zajel_ptr, 1, zajel_bench_core_1, name L);
+
+    for(i = 0; i < bench_ptr->threadCount; ++i)
+    {
+        zajel_regsiter_thread(bench_ptr->zajel_ptr,
+                              i,
+                              bench_ptr->coreArray[i],
+                              zajel_bench_thread_unused,
+                              zajel_bench_block,
+                              zajel_bench_unblock,
+                              &bench_ptr->semaphoreArray[i],
+                              name L);
+    } /*for: <Register each thread>*/
+
+    zajel_enable_ring_transport(bench_ptr->zajel_ptr, ZAJEL_BENCH_RING_CAPACITY L);
+
+    if(isUsingSlots)
+    {
+        zajel_enable_sync_slots(bench_ptr->zajel_ptr L);
+    } /*if: <Built-in synchronization>*/
+
+    for(i = 0; i < componentCount; ++i)
+    {
+        zajel_regsiter_component(bench_ptr->zajel_ptr, i, componentThreadArray[i], name L);
+    } /*for: <Register each component>*/
+
+    zajel_regsiter_message(bench_ptr->zajel_ptr, ZAJEL_BENCH_MESSAGE_ID, zajel_bench_handle, name L);
+
+    if(ZAJEL_STATUS_SUCCESS != zajel_seal(bench_ptr->zajel_ptr L))
+    {
+        fprintf(stderr, "zajel_bench: the topology cannot be sealed\n");
+        exit(1);
+    } /*if: <Topology cannot be sealed>*/
+
+    bench_ptr->isGoing      = 0;
+    bench_ptr->isStopping   = 0;
+
+    for(i = 1; i < bench_ptr->threadCount; ++i)
+    {
+        if(ZAJEL_BENCH_ROLE_NONE != bench_ptr->roleArray[i])
+        {
+            pthread_create(&bench_ptr->pthreadArray[i], NULL, zajel_bench_thread, (void*)(uintptr_t) i);
+        } /*if: <Thread has a role>*/
+    } /*for: <Start each thread>*/
+} /*function: zajel_bench_setup*/
+
+static void zajel_bench_teardown(zajel_bench_s* bench_ptr)
+{
+    zajel_bench_entry_s entry;
+    uint32_t            i;
+
+    bench_ptr->isStopping   = 1;
+    entry.message_ptr       = NULL;
+    entry.isAcknowledge     = 0;
+
+    for(i = 1; i < bench_ptr->threadCount; ++i)
+    {
+        if(ZAJEL_BENCH_ROLE_GATEWAY == bench_ptr->roleArray[i])
+        {
+            zajel_bench_queue_push(&bench_ptr->queueArray[bench_ptr->coreArray[i]], &entry);
+        } /*if: <Gateway waiting on its queue>*/
+    } /*for: <Stop each gateway>*/
+
+    for(i = 1; i < bench_ptr->threadCount; ++i)
+    {
+        if(ZAJEL_BENCH_ROLE_NONE != bench_ptr->roleArray[i])
+        {
+            pthread_join(bench_ptr->pthreadArray[i], NULL);
+        } /*if: <Thread has a role>*/
+
+        bench_ptr->roleArray[i] = ZAJEL_BENCH_ROLE_NONE;
+        bench_ptr->coreArray[i] = 0;
+    } /*for: <Join each thread>*/
+
+    zajel_destroy(&bench_ptr->zajel_ptr L);
+} /*function: zajel_bench_teardown*/
+
+static void zajel_bench_prepare(zajel_bench_s*  bench_ptr,
+                                uint32_t        count)
+{
+    __atomic_store_n(&bench_ptr->endTime, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&bench_ptr->handledCount, count, __ATOMIC_RELEASE);
+} /*function: zajel_bench_prepare*/
+
+static void zajel_bench_send(zajel_bench_s* bench_ptr,
+                             uint32_t       index,
+                             uint32_t       sourceComponentID,
+                             uint32_t       destinationComponentID,
+                             int            isSynchronous)
+{
+    zajel_bench_message_s* message_ptr;
+
+    message_ptr                                     = &bench_ptr->messageArray[index];
+    message_ptr->descriptor.messageID               = ZAJEL_BENCH_MESSAGE_ID;
+    message_ptr->descriptor.sourceComponentID       = sourceComponentID;
+    message_ptr->descriptor.destinationComponentID  = destinationComponentID;
+    message_ptr->descriptor.isSynchronous           = isSynchronous ? (TRUE) : (FALSE);
+    message_ptr->descriptor.flags                   = ZAJEL_MESSAGE_FLAG_NONE;
+    message_ptr->index                              = index;
+    message_ptr->sendTime                           = zajel_bench_now();
+
+    zajel_send(bench_ptr->zajel_ptr, message_ptr L);
+} /*function: zajel_bench_send*/
+
+static uint64_t zajel_bench_wait(zajel_bench_s* bench_ptr)
+{
+    while(0 != __atomic_load_n(&bench_ptr->handledCount, __ATOMIC_ACQUIRE))
+    {
+        if(0 == zajel_dispatch(bench_ptr->zajel_ptr, 0, ZAJEL_BENCH_DISPATCH_BUDGET L))
+        {
+            sched_yield();
+        } /*if: <Nothing to do>*/
+    } /*while: <Messages left>*/
+
+    return __atomic_load_n(&bench_ptr->endTime, __ATOMIC_ACQUIRE);
+} /*function: zajel_bench_wait*/
+
+static void zajel_bench_report(zajel_bench_s*   bench_ptr,
+                               const char*      scenario_ptr,
+                               const char*      relation_ptr,
+                               const char*      mode_ptr,
+                               uint32_t         threadCount,
+                               uint64_t         elapsedTime)
+{
+    uint64_t*   sample_ptr;
+    uint32_t    count;
+
+    sample_ptr  = bench_ptr->sampleArray;
+    count       = bench_ptr->messageCount;
+
+    qsort(sample_ptr, count, sizeof(uint64_t), zajel_bench_compare);
+
+    fprintf(bench_ptr->output_ptr,
+            "%s{\"scenario\":\"%s\",\"relation\":\"%s\",\"mode\":\"%s\",\"threads\":%u,"
+            "\"messages\":%u,\"seconds\":%.6f,\"msgs_per_sec\":%.0f,"
+            "\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu}",
+            (bench_ptr->isFirstResult) ? ("") : (",\n"),
+            scenario_ptr, relation_ptr, mode_ptr, threadCount,
+            count, (double) elapsedTime / 1e9,
+            (0 != elapsedTime) ? ((double) count * 1e9 / (double) elapsedTime) : (0.0),
+            (unsigned long long) sample_ptr[(uint64_t) count * 50 / 100],
+            (unsigned long long) sample_ptr[(uint64_t) count * 99 / 100],
+            (unsigned long long) sample_ptr[(uint64_t) count * 999 / 1000]);
+    fflush(bench_ptr->output_ptr);
+
+    bench_ptr->isFirstResult = 0;
+} /*function: zajel_bench_report*/
+
+static void zajel_bench_relation(zajel_bench_s*                        bench_ptr,
+                                 zajel_component_dynamic_relation_e    relation,
+                                 int                                   isUsingSlots)
+{
+    uint32_t componentThreadArray[2];
+
+    componentThreadArray[0] = 0;
+
+    switch(relation)
+    {
+        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD:
+            bench_ptr->threadCount  = 1;
+            componentThreadArray[1] = 0;
+            break;
+        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE:
+            bench_ptr->threadCount  = 2;
+            bench_ptr->roleArray[1] = ZAJEL_BENCH_ROLE_WORKER;
+            componentThreadArray[1] = 1;
+            break;
+        default:
+            bench_ptr->threadCount  = 3;
+            bench_ptr->coreArray[1] = 1;
+            bench_ptr->roleArray[1] = ZAJEL_BENCH_ROLE_GATEWAY;
+            bench_ptr->roleArray[2] = ZAJEL_BENCH_ROLE_GATEWAY;
+            componentThreadArray[1] = 1;
+            break;
+    } /*switch: <Place component 1 according to the relation>*/
+
+    zajel_bench_setup(bench_ptr, 2, componentThreadArray, isUsingSlots);
+} /*function: zajel_bench_relation*/
+
+static void zajel_bench_async(zajel_bench_s*                        bench_ptr,
+                              zajel_component_dynamic_relation_e    relation)
+{
+    uint64_t startTime;
+    uint64_t endTime;
+    uint32_t index;
+
+    zajel_bench_relation(bench_ptr, relation, 1);
+    zajel_bench_prepare(bench_ptr, bench_ptr->messageCount);
+
+    startTime = zajel_bench_now();
+
+    for(index = 0; index < bench_ptr->messageCount; ++index)
+    {
+        zajel_bench_send(bench_ptr, index, 0, 1, FALSE);
+
+        if(0 == ((index + 1) % ZAJEL_BENCH_DISPATCH_BUDGET))
+        {
+            /*A component sending to its own thread only gets its messages when the thread dispatches*/
+            zajel_dispatch(bench_ptr->zajel_ptr, 0, ZAJEL_BENCH_DISPATCH_BUDGET L);
+        } /*if: <End of a burst>*/
+    } /*for: <Send each message>*/
+
+    endTime = zajel_bench_wait(bench_ptr);
+
+    zajel_bench_report(bench_ptr, "async", zajelBenchRelationNameArray[relation], "ring", 1, endTime - startTime);
+    zajel_bench_teardown(bench_ptr);
+} /*function: zajel_bench_async*/
+
+static void zajel_bench_sync(zajel_bench_s*                         bench_ptr,
+                             zajel_component_dynamic_relation_e     relation,
+                             int                                    isUsingSlots,
+                             int                                    isMeasuringAcknowledge)
+{
+    uint64_t startTime;
+    uint64_t endTime;
+    uint32_t index;
+
+    zajel_bench_relation(bench_ptr, relation, isUsingSlots);
+
+    /*The handler of a message sent from its own thread runs in the sender context, nothing to acknowledge*/
+    bench_ptr->isAcknowledging = (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD != relation);
+    startTime = zajel_bench_now();
+
+    for(index = 0; index < bench_ptr->messageCount; ++index)
+    {
+        zajel_bench_send(bench_ptr, index, 0, 1, TRUE);
+
+        endTime = zajel_bench_now();
+        bench_ptr->sampleArray[index] = endTime - ((isMeasuringAcknowledge) ?
+                                                   (bench_ptr->messageArray[index].acknowledgeTime) :
+                                                   (bench_ptr->messageArray[index].sendTime));
+    } /*for: <Send each message>*/
+
+    endTime = zajel_bench_now();
+
+    zajel_bench_report(bench_ptr,
+                       (isMeasuringAcknowledge) ? ("acknowledge") : ("sync"),
+                       zajelBenchRelationNameArray[relation],
+                       (isUsingSlots) ? ("slots") : ("callbacks"),
+                       1,
+                       endTime - startTime);
+    zajel_bench_teardown(bench_ptr);
+} /*function: zajel_bench_sync*/
+
+static void zajel_bench_fan_in(zajel_bench_s*  bench_ptr,
+                               uint32_t        producerCount)
+{
+    uint32_t componentThreadArray[ZAJEL_BENCH_MAX_THREAD_COUNT + 1];
+    uint64_t startTime;
+    uint64_t endTime;
+    uint32_t i;
+
+    /*Thread 0 runs the consumer (component 0), thread i the producer i*/
+    bench_ptr->threadCount = producerCount + 1;
+
+    for(i = 0; i <= producerCount; ++i)
+    {
+        componentThreadArray[i]             = i;
+        bench_ptr->roleArray[i]             = (0 == i) ? (ZAJEL_BENCH_ROLE_NONE) : (ZAJEL_BENCH_ROLE_PRODUCER);
+        bench_ptr->firstMessageArray[i + 1] = (uint32_t)(((uint64_t) bench_ptr->messageCount * i) / producerCount);
+    } /*for: <Place each component and share the messages>*/
+
+    zajel_bench_prepare(bench_ptr, bench_ptr->messageCount);
+    zajel_bench_setup(bench_ptr, producerCount + 1, componentThreadArray, 1);
+
+    startTime           = zajel_bench_now();
+    bench_ptr->isGoing  = 1;
+    endTime             = zajel_bench_wait(bench_ptr);
+
+    zajel_bench_report(bench_ptr, "fan_in", "same_core", "ring", producerCount, endTime - startTime);
+    zajel_bench_teardown(bench_ptr);
+} /*function: zajel_bench_fan_in*/
+
+static void zajel_bench_fan_out(zajel_bench_s* bench_ptr,
+                                uint32_t       consumerCount)
+{
+    uint32_t componentThreadArray[ZAJEL_BENCH_MAX_THREAD_COUNT + 1];
+    uint64_t startTime;
+    uint64_t endTime;
+    uint32_t index;
+    uint32_t i;
+
+    /*Thread 0 runs the producer (component 0), thread i the consumer i*/
+    bench_ptr->threadCount = consumerCount + 1;
+
+    for(i = 0; i <= consumerCount; ++i)
+    {
+        componentThreadArray[i] = i;
+        bench_ptr->roleArray[i] = (0 == i) ? (ZAJEL_BENCH_ROLE_NONE) : (ZAJEL_BENCH_ROLE_WORKER);
+    } /*for: <Place each component>*/
+
+    zajel_bench_setup(bench_ptr, consumerCount + 1, componentThreadArray, 1);
+    zajel_bench_prepare(bench_ptr, bench_ptr->messageCount);
+
+    startTime = zajel_bench_now();
+
+    for(index = 0; index < bench_ptr->messageCount; ++index)
+    {
+        zajel_bench_send(bench_ptr, index, 0, 1 + (index % consumerCount), FALSE);
+    } /*for: <Send each message, in turn to each consumer>*/
+
+    endTime = zajel_bench_wait(bench_ptr);
+
+    zajel_bench_report(bench_ptr, "fan_out", "same_core", "ring", consumerCount, endTime - startTime);
+    zajel_bench_teardown(bench_ptr);
+} /*function: zajel_bench_fan_out*/
+
+static void zajel_bench_reference(zajel_bench_s*   bench_ptr,
+                                  int              isSynchronous)
+{
+    zajel_bench_entry_s     entry;
+    zajel_bench_message_s*  message_ptr;
+    pthread_t               consumer;
+    uint64_t                startTime;
+    uint64_t                endTime;
+    uint32_t                index;
+
+    zajel_bench_prepare(bench_ptr, bench_ptr->messageCount);
+    pthread_create(&consumer, NULL, zajel_bench_reference_consumer, NULL);
+
+    entry.isAcknowledge = 0;
+    startTime           = zajel_bench_now();
+
+    for(index = 0; index < bench_ptr->messageCount; ++index)
+    {
+        message_ptr                             = &bench_ptr->messageArray[index];
+        message_ptr->descriptor.isSynchronous   = isSynchronous ? (TRUE) : (FALSE);
+        message_ptr->index                      = index;
+        message_ptr->sendTime                   = zajel_bench_now();
+        entry.message_ptr                       = message_ptr;
+
+        zajel_bench_queue_push(&bench_ptr->queueArray[0], &entry);
+
+        if(isSynchronous)
+        {
+            zajel_bench_queue_pop(&bench_ptr->queueArray[1], &entry);
+            bench_ptr->sampleArray[index] = zajel_bench_now() - message_ptr->sendTime;
+        } /*if: <Wait for the answer>*/
+    } /*for: <Send each message>*/
+
+    entry.message_ptr = NULL;
+    zajel_bench_queue_push(&bench_ptr->queueArray[0], &entry);
+    pthread_join(consumer, NULL);
+
+    endTime = (isSynchronous) ? (zajel_bench_now()) : (bench_ptr->endTime);
+
+    zajel_bench_report(bench_ptr,
+                       (isSynchronous) ? ("sync") : ("async"),
+                       "same_core",
+                       "reference",
+                       1,
+                       endTime - startTime);
+} /*function: zajel_bench_reference*/
+
+static void* zajel_bench_reference_consumer(void* argument_ptr)
+{
+    zajel_bench_entry_s     entry;
+    zajel_bench_message_s*  message_ptr;
+
+    (void) argument_ptr;
+
+    for(;;)
+    {
+        zajel_bench_queue_pop(&zajelBench.queueArray[0], &entry);
+        message_ptr = (zajel_bench_message_s*) entry.message_ptr;
+
+        if(NULL == message_ptr)
+        {
+            break;
+        } /*if: <Scenario is over>*/
+
+        if(message_ptr->descriptor.isSynchronous)
+        {
+            zajel_bench_queue_push(&zajelBench.queueArray[1], &entry);
+        } /*if: <Answer the request>*/
+        else
+        {
+            zajel_bench_handle(&message_ptr->descriptor);
+        } /*else: <Record the latency>*/
+    } /*for: <Drain the requests>*/
+
+    return argument_ptr;
+} /*function: zajel_bench_reference_consumer*/
+
+static int zajel_bench_compare(const void*  first_ptr,
+                               const void*  second_ptr)
+{
+    uint64_t first;
+    uint64_t second;
+
+    first   = *(const uint64_t*) first_ptr;
+    second  = *(const uint64_t*) second_ptr;
+
+    return (first < second) ? (-1) : ((first > second) ? (1) : (0));
+} /*function: zajel_bench_compare*/
@@ -29,13 +29,6 @@
  **************************************************************************************************/
 
 
-/*
- * TODO: mgalal on Mar 9, 2010
- *
- * It might be required to add another field to the message descriptor to hold user-status for
- * synchronous messages.
- */
-
 /***************************************************************************************************
  *
  *  I N C L U D E S
@@ -43,7 +36,20 @@
  **************************************************************************************************/
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include "zajel.h"
+#include "zajel_platform.h"
+#include "zajel_ring.h"
+#include "zajel_mailbox.h"
+#include "zajel_pool.h"
+#include "zajel_sync.h"
+#include "zajel_shm.h"
+#include "zajel_balance.h"
+#include "zajel_actor.h"
+#include "zajel_timer.h"
+#include "zajel_stats.h"
+#include "zajel_trace.h"
+#include "zajel_numa.h"
 
 /***************************************************************************************************
  *
@@ -52,14 +58,54 @@
  **************************************************************************************************/
 
 
-/*Total number of messages*/
-#define ZAJEL_MESSAGE_COUNT     (100)
-/*Total number of components*/
-#define ZAJEL_COMPONENT_COUNT   (10)
-/*Total number of threads*/
-#define ZAJEL_THREAD_COUNT      (4)
-/*Total number of cores*/
-#define ZAJEL_CORE_COUNT        (2)
+/*Number of messages zajel_send_batch classifies at once*/
+#define ZAJEL_BATCH_CHUNK_SIZE  (64)
+
+/*Marks a message of a batch chunk which was already handed to its destination*/
+#define ZAJEL_BATCH_KEY_DONE    (0xFFFFFFFF)
+
+/*Number of messages zajel_dispatch collects from the inbound queues at once*/
+#define ZAJEL_DISPATCH_BATCH_SIZE (32)
+
+/*Number of messages an actor handles before it is queued again, so the actors take turns*/
+#define ZAJEL_ACTOR_BATCH_SIZE      (16)
+
+/*Marks a payload handle holding an offset within the shared region, instead of an address*/
+#define ZAJEL_PAYLOAD_HANDLE_SHARED (1)
+
+/*Values of the published messages scope, a message covers the subscribers of a thread or of a whole core*/
+#define ZAJEL_TOPIC_SCOPE_THREAD    (0)
+#define ZAJEL_TOPIC_SCOPE_CORE      (1)
+
+/*Where a published message was allocated from*/
+#define ZAJEL_TOPIC_FROM_HEAP       (0)
+#define ZAJEL_TOPIC_FROM_POOL       (1)
+#define ZAJEL_TOPIC_FROM_SHM        (2)
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_SUBSCRIPTION_KEY
+ *
+ *  Arguments   : subscription
+ *
+ *  Description : This macro gets the sorting key of the given subscription (zajel_subscription_s),
+ *                  ordering by topic, core, thread then component.
+ *
+ *  Returns     : uint64_t.
+ **************************************************************************************************/
+#define ZAJEL_SUBSCRIPTION_KEY(subscription)                                                       \
+    (((uint64_t)(subscription).topicID << 32) | ((uint64_t)(subscription).coreID << 24) |           \
+     ((uint64_t)(subscription).threadID << 16) | (subscription).componentID)
+
+/*Values of the routes state, the routes are only used while valid*/
+#define ZAJEL_ROUTES_STATE_INVALID  (0)
+#define ZAJEL_ROUTES_STATE_BUILDING (1)
+#define ZAJEL_ROUTES_STATE_VALID    (2)
+
+/*Number of component migrations which can be in progress at the same time*/
+#define ZAJEL_MIGRATION_SLOT_COUNT  (8)
+
+/*Initial number of messages a migration can hold before growing*/
+#define ZAJEL_MIGRATION_PENDING_CAPACITY (16)
 
 /***************************************************************************************************
  *  Macro Name  : ZAJEL_IS_ITEM_REGISTERED
@@ -77,7 +123,9 @@
  *
  *  Arguments   : cfw_ptr, desc_ptr, action
  *
- *  Description : This macro locks the calling thread.
+ *  Description : This macro locks the calling thread. When the built-in synchronization slots are
+ *                  enabled, the thread slot is used (block spins then parks, unblock completes the
+ *                  slot directly), otherwise the thread callbacks are used.
  *
  *  Returns     : None.
  **************************************************************************************************/
@@ -87,50 +135,123 @@
     zajel_thread_information_s*     thread_ptr;                                                    \
                                                                                                    \
     component_ptr =  &(cfw_ptr)->componentInformationArray[(id)];                                  \
-    thread_ptr    =  &(cfw_ptr)->threadInformationArray[component_ptr->parameters.threadID];       \
                                                                                                    \
-    thread_ptr->action##Callback(thread_ptr->synchronizationPrimitive_ptr);                        \
+    if(NULL != (cfw_ptr)->syncSlotArray_ptr)                                                       \
+    {                                                                                              \
+        zajel_sync_slot_##action(&(cfw_ptr)->syncSlotArray_ptr[component_ptr->parameters.threadID]);\
+    }                                                                                              \
+    else                                                                                           \
+    {                                                                                              \
+        thread_ptr = &(cfw_ptr)->threadInformationArray[component_ptr->parameters.threadID];       \
+                                                                                                   \
+        thread_ptr->action##Callback(thread_ptr->synchronizationPrimitive_ptr);                    \
+    }                                                                                              \
 }
 
 /***************************************************************************************************
- *  Macro Name  : ZAJEL_THREAD_HANDLE_MESSAGE
+ *  Macro Name  : ZAJEL_THREAD_RING
  *
- *  Arguments   : cfw_ptr, desc_ptr
+ *  Arguments   : cfw_ptr, producerThreadID, consumerThreadID
  *
- *  Description : This macro deliver the given message (descriptor) to the given thread.
+ *  Description : This macro gets the ring carrying the messages from the producer thread to the
+ *                  consumer thread.
  *
- *  Returns     : None.
+ *  Returns     : zajel_ring_s*.
  **************************************************************************************************/
-#define ZAJEL_THREAD_HANDLE_MESSAGE(cfw_ptr, desc_ptr)                                             \
-{                                                                                                  \
-    zajel_component_information_u*  component_ptr;                                                 \
-    zajel_thread_information_s*     thread_ptr;                                                    \
-                                                                                                   \
-    component_ptr =  &(cfw_ptr)->componentInformationArray[(desc_ptr)->destinationComponentID];    \
-    thread_ptr    =  &(cfw_ptr)->threadInformationArray[component_ptr->parameters.threadID];       \
-                                                                                                   \
-    thread_ptr->handleMessageCallback((desc_ptr));                                                 \
-}
+#define ZAJEL_THREAD_RING(cfw_ptr, producerThreadID, consumerThreadID)                             \
+    (&(cfw_ptr)->ringArray_ptr[((producerThreadID) * (cfw_ptr)->threadCount) + (consumerThreadID)])
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_THREAD_LANES
+ *
+ *  Arguments   : cfw_ptr, threadID
+ *
+ *  Description : This macro gets the priority lanes of the given thread, NULL when they are not
+ *                  enabled.
+ *
+ *  Returns     : zajel_lanes_s*.
+ **************************************************************************************************/
+#define ZAJEL_THREAD_LANES(cfw_ptr, threadID)                                                      \
+    ((NULL != (cfw_ptr)->laneArray_ptr) ? (&(cfw_ptr)->laneArray_ptr[(threadID)]) : (NULL))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_THREAD_STATS
+ *
+ *  Arguments   : cfw_ptr, threadID
+ *
+ *  Description : This macro gets the statistics of the given thread, they shall be enabled.
+ *
+ *  Returns     : zajel_stats_thread_s*.
+ **************************************************************************************************/
+#define ZAJEL_THREAD_STATS(cfw_ptr, threadID)                                                      \
+    ((zajel_stats_thread_s*) ((cfw_ptr)->statsBase_ptr + ((threadID) * (cfw_ptr)->statsStride)))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_THREAD_TRACE
+ *
+ *  Arguments   : cfw_ptr, threadID
+ *
+ *  Description : This macro gets the trace ring of the given thread, the trace shall be enabled.
+ *
+ *  Returns     : zajel_trace_ring_s*.
+ **************************************************************************************************/
+#define ZAJEL_THREAD_TRACE(cfw_ptr, threadID)                                                      \
+    (&(cfw_ptr)->traceRingArray_ptr[(threadID)])
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_THREAD_POOL
+ *
+ *  Arguments   : cfw_ptr, threadID
+ *
+ *  Description : This macro gets the message pool of the given thread, the pools shall be enabled.
+ *
+ *  Returns     : zajel_pool_s*.
+ **************************************************************************************************/
+#define ZAJEL_THREAD_POOL(cfw_ptr, threadID)                                                       \
+    ((zajel_pool_s*) ((uintptr_t)(cfw_ptr)->poolArray_ptr + ((threadID) * (cfw_ptr)->poolStride)))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_ROUTE
+ *
+ *  Arguments   : table_ptr, sourceThreadID, destinationComponentID
+ *
+ *  Description : This macro gets the route of the given table taken by the messages sent from the
+ *                  given thread to the given component.
+ *
+ *  Returns     : zajel_route_s*.
+ **************************************************************************************************/
+#define ZAJEL_ROUTE(table_ptr, sourceThreadID, destinationComponentID)                             \
+    ((zajel_route_s*) ((uintptr_t)(table_ptr)->routeArray_ptr + ((sourceThreadID) * (table_ptr)->rowStride)) + \
+     (destinationComponentID))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_MESSAGE_HANDLER_CALL
+ *
+ *  Arguments   : information_ptr, descriptor_ptr
+ *
+ *  Description : This macro calls the handler of the given entry (see zajel_handler_get) on the
+ *                  given message, with its context if it was registered for a component.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+#define ZAJEL_MESSAGE_HANDLER_CALL(information_ptr, descriptor_ptr)                                \
+    ((NULL != (information_ptr)->componentHandlerFunction) ?                                       \
+     ((information_ptr)->componentHandlerFunction((information_ptr)->context_ptr, (descriptor_ptr))) : \
+     ((information_ptr)->messageHandlerFunction((descriptor_ptr))))
 
 /***************************************************************************************************
- *  Macro Name  : ZAJEL_CORE_HANDLE_MESSAGE
+ *  Macro Name  : ZAJEL_ROUTES_INVALIDATE
  *
- *  Arguments   : controlBlock_ptr, desc_ptr
+ *  Arguments   : cfw_ptr
  *
- *  Description : This macro deliver the given message (descriptor) to the given core.
+ *  Description : This macro marks the routes as outdated, they are rebuilt by the next message sent.
+ *                  It shall be used by every function changing the component/thread/core mapping
+ *                  or the thread transports.
  *
  *  Returns     : None.
  **************************************************************************************************/
-#define ZAJEL_CORE_HANDLE_MESSAGE(controlBlock_ptr, desc_ptr)                                      \
-{                                                                                                  \
-    zajel_component_information_u*  destinationComponent_ptr;                                      \
-    zajel_core_information_s*       destinationCore_ptr;                                           \
-                                                                                                   \
-    destinationComponent_ptr =  &(controlBlock_ptr)->componentInformationArray[(desc_ptr)->destinationComponentID];\
-    destinationCore_ptr      =  &(controlBlock_ptr)->coreInformationArray[destinationComponent_ptr->parameters.coreID];\
-                                                                                                   \
-    destinationCore_ptr->handleMessageCallback((desc_ptr));                                        \
-}
+#define ZAJEL_ROUTES_INVALIDATE(cfw_ptr)                                                           \
+    ZAJEL_ATOMIC_STORE(&(cfw_ptr)->routesState, ZAJEL_ROUTES_STATE_INVALID)
 
 /***************************************************************************************************
  *  Macro Name  : ZAJEL_THREAD_GET_CORE_ID
@@ -168,6 +289,24 @@
 #define ZAJEL_COMPONENT_GET_THREAD_ID(cfw, componentID)\
     ((cfw)->componentInformationArray[componentID].parameters.threadID)
 
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_TIMER_ID
+ *
+ *  Arguments   : threadID, index, generation
+ *
+ *  Description : This macro builds the identifier of a timer: its generation in the upper 32 bits,
+ *                  then the thread whose wheel holds it, then its index in that wheel (24 bits).
+ *
+ *  Returns     : timer_id.
+ **************************************************************************************************/
+#define ZAJEL_TIMER_ID(threadID, index, generation)                                                \
+    ((((timer_id)(generation)) << 32) | (((timer_id)(threadID)) << 24) | ((timer_id)(index)))
+
+/*Parts of a timer identifier (see ZAJEL_TIMER_ID)*/
+#define ZAJEL_TIMER_ID_GET_THREAD_ID(timerID)   ((uint32_t)(((timerID) >> 24) & 0xFF))
+#define ZAJEL_TIMER_ID_GET_INDEX(timerID)       ((uint32_t)((timerID) & 0xFFFFFF))
+#define ZAJEL_TIMER_ID_GET_GENERATION(timerID)  ((uint32_t)((timerID) >> 32))
+
 
 /***************************************************************************************************
  *
@@ -178,42 +317,57 @@
 
 /***************************************************************************************************
  * Enumeration Name:
- * zajel_component_dynamic_relation_e
+ * zajel_thread_transport_e
  *
  * Enumeration Description:
- * Lists the different relation that can exist between any two components.
+ * Lists the different ways a message can be handed over to its destination thread.
  **************************************************************************************************/
-typedef enum zajel_component_dynamic_relation
+typedef enum zajel_thread_transport
 {
-    /*Both components are running on the same thread, on the same core*/
-    ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD        = 0,
-    /*Both components are running on different threads, on the same core*/
-    ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE          = 1,
-    /*Both components are running on different threads, on different cores*/
-    ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES    = 2
-} zajel_component_dynamic_relation_e;
+    /*Messages are handed to the user supplied handleMessageCallback*/
+    ZAJEL_THREAD_TRANSPORT_CALLBACK     = 0,
+    /*Messages are pushed into the built-in SPSC ring of the (producer, consumer) threads pair*/
+    ZAJEL_THREAD_TRANSPORT_RING         = 1,
+    /*Messages are pushed into the MPSC mailbox of the destination thread*/
+    ZAJEL_THREAD_TRANSPORT_MAILBOX      = 2
+} zajel_thread_transport_e;
 
 /***************************************************************************************************
  * Structure Name:
  * zajel_message_information_s
  *
  * Structure Description:
- * structure_description.
+ * Holds the message routing information, the message table is indexed by the message identifier,
+ * the handler tables of the components by the message identifier less their first one.
  **************************************************************************************************/
 typedef struct zajel_message_information
 {
-    /*Message Handler*/
-    zajel_message_handler_function  messageHandlerFunction;
-#ifdef DEBUG
-    /*TRUE if the message is registered*/
-    bool_t                          isRegistered;
-    /*Message identifier*/
-    message_id                      messageID;
-    /*Textual representation of the message, for debugging purposes*/
-    char*                           messageName_ptr;
-#endif /*DEBUG*/
+    /*Message Handler, set in the message table*/
+    zajel_message_handler_function      messageHandlerFunction;
+    /*Message Handler of a component, set in its handler table (NULL if not registered)*/
+    zajel_component_handler_function    componentHandlerFunction;
+    /*The context passed to the handler of the component*/
+    void*                               context_ptr;
 } zajel_message_information_s;
 
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_handler_table_s
+ *
+ * Structure Description:
+ * Holds the message handlers registered for a component, densely spanning its smallest to its
+ * biggest registered message identifier, so that the handlers of a component share a few cache lines.
+ **************************************************************************************************/
+typedef struct zajel_handler_table
+{
+    /*The handlers, count entries, entry i handling the message identifier firstMessageID + i*/
+    zajel_message_information_s*    entryArray;
+    /*The smallest registered message identifier*/
+    uint32_t                        firstMessageID;
+    /*The number of entries, 0 if the component has no handler of its own*/
+    uint32_t                        count;
+} zajel_handler_table_s;
+
 /***************************************************************************************************
  * Structure Name:
  * zajel_component_information_parameters_s
@@ -227,18 +381,10 @@ typedef struct zajel_component_information_parameters
     uint8_t threadID;
     /*Core identifier on which the component runs, support up to 256 different core*/
     uint8_t coreID;
-    /*for padding*/
-    uint8_t reserved1;
-    /*for padding*/
-    uint8_t reserved2;
-#ifdef DEBUG
-    /*TRUE if the component is registered*/
-    bool_t  isRegistered;
-    /*Component identifier, supports up to 256 different component*/
-    uint8_t componentID;
-    /*Component Name*/
-    char*   componentName_ptr;
-#endif /*DEBUG*/
+    /*TRUE once the component is registered, kept in the handle so that it is known in all builds*/
+    uint8_t isMapped;
+    /*Index + 1 of the migration moving the component (see zajel_migrate_component), 0 if none*/
+    uint8_t migrationSlot;
 } zajel_component_information_parameters_s;
 
 /***************************************************************************************************
@@ -265,14 +411,19 @@ typedef union zajel_component_information
  * zajel_thread_information_s
  *
  * Structure Description:
- * This structure holds the thread related information.
+ * This structure holds the thread related information, each entry fills its own cache line so that
+ * the pollCursor updates of a thread do not disturb the senders reading the entry of another thread.
  **************************************************************************************************/
 typedef struct zajel_thread_information
 {
     /*Core identifier on which this thread runs*/
-    uint32_t                        coreID;
+    uint32_t                        coreID                      ZAJEL_CACHE_ALIGNED;
+    /*How the messages are handed over to this thread, holds one of zajel_thread_transport_e*/
+    uint32_t                        transport;
     /*This callback function is used to deliver the messages to the thread*/
     zajel_handle_message_callback   handleMessageCallback;
+    /*The inbound mailbox of the thread, only used by the mailbox transport*/
+    zajel_mailbox_s*                mailbox_ptr;
     /*
      * This can be any synchronization primitive passed by the framework to the blockFunction in order
      * to support synchronous messages
@@ -292,15 +443,18 @@ typedef struct zajel_thread_information
      * It is not applicable for "same thread" synchronous message.
      */
     zajel_unblock_callback          unblockCallback;
-
-#ifdef DEBUG
-    /*TRUE if the thread is registered*/
-    bool_t                          isRegistered;
-    /*Thread identifier, this is meant to be user-assigned rather than the OS-assigned*/
-    uint32_t                        threadID;
-    /*Thread textual name, to be used for debugging*/
-    char*                           threadName_ptr;
-#endif /*DEBUG*/
+    /*Optional batch variant of handleMessageCallback, used by zajel_send_batch when not NULL*/
+    zajel_handle_message_batch_callback handleMessageBatchCallback;
+    /*The producer thread whose ring is polled first, used to keep the polling fair*/
+    uint32_t                        pollCursor;
+    /*Epoch of the last routes table used by this thread, the older tables are no longer used by it*/
+    uint32_t                        routeEpoch;
+    /*Increased when this thread starts then ends handing messages over, odd in between*/
+    uint32_t                        sendCount;
+    /*Bound of the messages queued to this thread, 0 when unbounded (see zajel_set_inbound_capacity)*/
+    uint32_t                        inboundCapacity;
+    /*Messages queued to this thread and not collected yet, only counted when the capacity is bounded*/
+    uint32_t                        inboundCount                ZAJEL_CACHE_ALIGNED;
 } zajel_thread_information_s;
 
 /***************************************************************************************************
@@ -314,689 +468,7375 @@ typedef struct zajel_core_information
 {
     /*This call back function is used to deliver messages to the destination core*/
     zajel_core_handle_message_callback  handleMessageCallback;
-#ifdef DEBUG
-    /*core identifier, this is meant to be user-assigned rather than the OS-assigned*/
-    uint32_t                            coreID;
-    /*TRUE if the core is registered*/
-    bool_t                              isRegistered;
-    /*core textual name, to be used for debugging*/
-    char*                               coreName_ptr;
-#endif /*DEBUG*/
+    /*Optional batch variant of handleMessageCallback, used by zajel_send_batch when not NULL*/
+    zajel_core_handle_message_batch_callback handleMessageBatchCallback;
+    /*The NUMA node the threads of the core run on, ZAJEL_NUMA_NODE_ANY if unknown*/
+    uint32_t                            nodeID;
 } zajel_core_information_s;
 
 /***************************************************************************************************
  * Structure Name:
- * zajel_s
+ * zajel_lanes_s
  *
  * Structure Description:
- * Holds the control block for the communication framework..
+ * The priority lanes of a thread (see zajel_enable_priority_lanes), the normal priority lane being
+ * the thread transport itself.
  **************************************************************************************************/
-struct zajel
+typedef struct zajel_lanes
 {
-    /*An array that holds the registered message handlers*/
-    zajel_message_information_s     messageInformationArray[ZAJEL_MESSAGE_COUNT];
-    /*An array that holds the component related information like the component ID, thread/core ID*/
-    zajel_component_information_u   componentInformationArray[ZAJEL_COMPONENT_COUNT];
-    /*An array that holds the thread related information*/
-    zajel_thread_information_s      threadInformationArray[ZAJEL_THREAD_COUNT];
-    /*An array that holds the core related information*/
-    zajel_core_information_s        coreInformationArray[ZAJEL_CORE_COUNT];
-    /*The deallocation function pointer to be used when destroying the control block*/
-    zajel_deallocation_function     deallocationFunction_ptr;
-};
+    /*Indexed by the priority, the ZAJEL_PRIORITY_NORMAL entry is not used*/
+    zajel_mailbox_s                 laneArray[ZAJEL_PRIORITY_COUNT];
+    /*The thread owning the lanes, woken up when it is parked on its own mailbox*/
+    zajel_thread_information_s*     thread_ptr;
+} zajel_lanes_s;
+
+/*Hands the given message over to the destination of a route, the context is route specific*/
+typedef void (*zajel_route_function) (void*, zajel_message_descriptor_s*);
 
 /***************************************************************************************************
+ * Structure Name:
+ * zajel_route_s
  *
- *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
- *
+ * Structure Description:
+ * This structure holds the precomputed route from a thread to a component, everything needed to
+ * hand a message over is resolved when the routes are built, so sending only costs a single indexed
+ * load and an indirect call.
  **************************************************************************************************/
-
-
+typedef struct zajel_route
+{
+    /*Hands the message over to the destination thread transport or core*/
+    zajel_route_function            deliverFunction;
+    /*The ring, mailbox, thread or core information passed to deliverFunction*/
+    void*                           context_ptr;
+    /*Relation between the source thread and the destination component, one of zajel_component_dynamic_relation_e*/
+    uint32_t                        relation;
+    /*The priority lanes of the destination thread, NULL when the priority of the messages is ignored*/
+    zajel_lanes_s*                  lanes_ptr;
+    /*The destination thread when its inbound capacity is bounded, NULL otherwise*/
+    zajel_thread_information_s*     boundedThread_ptr;
+} zajel_route_s;
 
 /***************************************************************************************************
- *  Name        : zajel_component_get_dynamic_relation
- *
- *  Arguments   : zajel_s*    zajel_ptr
- *                uint32_t    sourceComponentID,
- *                uint32_t    destinationComponentID
- *
- *  Description : Determines the dynamic relation between the two given component.
+ * Structure Name:
+ * zajel_route_table_s
  *
- *  Returns     : zajel_component_dynamic_relation_e.
+ * Structure Description:
+ * A set of routes from every thread to every component. Before sealing the routes are rebuilt in
+ * place, afterwards every migration publishes a new table, the replaced ones being retired until no
+ * thread uses them anymore.
  **************************************************************************************************/
-zajel_component_dynamic_relation_e zajel_component_get_dynamic_relation(zajel_s*    zajel_ptr,
-                                                                        uint32_t    sourceComponentID,
-                                                                        uint32_t    destinationComponentID);
+typedef struct zajel_route_table
+{
+    /*The routes, a row per source thread indexed by the destination component (see ZAJEL_ROUTE)*/
+    zajel_route_s*                  routeArray_ptr;
+    /*Distance between the rows of two threads, each row is page aligned once NUMA placement is enabled*/
+    uintptr_t                       rowStride;
+    /*Increased by every published table, compared to the routeEpoch of the threads*/
+    uint32_t                        epoch;
+    /*Next retired table*/
+    struct zajel_route_table*       next_ptr;
+    /*The memory block holding the table, as returned by the allocation function*/
+    void*                           memory_ptr;
+} zajel_route_table_s;
 
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_mapping_s
+ *
+ * Structure Description:
+ * A memory block mapped from the system once NUMA placement is enabled (see zajel_placement_alloc).
+ **************************************************************************************************/
+typedef struct zajel_mapping
+{
+    void*                           address_ptr;
+    uintptr_t                       size;
+    /*Bytes bound to the node of their thread*/
+    uintptr_t                       boundBytes;
+    /*TRUE if the block is made of huge pages*/
+    bool_t                          isHuge;
+    struct zajel_mapping*           next_ptr;
+} zajel_mapping_s;
 
 /***************************************************************************************************
+ * Structure Name:
+ * zajel_migration_s
  *
- *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ * Structure Description:
+ * Tracks a component moving to another thread, from zajel_migrate_component until the marker reaches
+ * the new thread. The pending messages are only used by the new thread.
+ **************************************************************************************************/
+typedef struct zajel_migration
+{
+    /*TRUE while the slot tracks a migration*/
+    uint32_t                        isUsed;
+    /*The threads the component moves from and to*/
+    uint32_t                        fromThreadID;
+    uint32_t                        toThreadID;
+    /*
+     * Ring transport only: the head of every ring of the former thread when the marker was sent,
+     * and the marker, held by the former thread until it consumed its rings up to these heads
+     */
+    uint32_t*                       drainHeadArray;
+    zajel_message_descriptor_s*     heldMarker_ptr;
+    /*
+     * The sendCount of the threads which were handing messages over when the mapping changed, and
+     * may still deliver them along the old route, 0 for the other threads. NULL if there were none.
+     */
+    uint32_t*                       sendCountArray;
+    /*Bit per priority, set once the marker of the lane was queued again behind the late senders*/
+    uint32_t                        requeuedMask;
+    /*Number of markers (one per lane of the former thread) the new thread still waits for*/
+    uint32_t                        markerCount;
+    /*The messages sent after the migration, held (in order) until the marker is received*/
+    zajel_message_descriptor_s**    pending_ptr_array;
+    uint32_t                        pendingCount;
+    uint32_t                        pendingCapacity;
+} zajel_migration_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_subscription_s
  *
+ * Structure Description:
+ * A subscription of a component to a topic. Once the routes are built the subscriptions are sorted by
+ * topic, core, thread then component, so the subscribers sharing a destination are contiguous.
  **************************************************************************************************/
+typedef struct zajel_subscription
+{
+    uint32_t                        topicID;
+    component_id                    componentID;
+    /*Copies of the component mapping, refreshed when the routes are built*/
+    uint8_t                         threadID;
+    uint8_t                         coreID;
+} zajel_subscription_s;
 
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_topic_envelope_s
+ *
+ * Structure Description:
+ * A message sent by zajel_publish to a destination thread or core, it covers a contiguous range of
+ * the sorted subscriptions. Its descriptor is what the handlers see, the destination being set to
+ * each subscriber in turn.
+ **************************************************************************************************/
+typedef struct zajel_topic_envelope
+{
+    /*The message descriptor (with its mailbox link) and the payload handle, kept first*/
+    zajel_payload_descriptor_s      payloadDescriptor;
+    /*First subscription covered by this message, and number of subscriptions covered*/
+    uint32_t                        subscriptionIndex;
+    uint32_t                        subscriptionCount;
+    /*ZAJEL_TOPIC_SCOPE_xxx*/
+    uint8_t                         scope;
+    /*ZAJEL_TOPIC_FROM_xxx*/
+    uint8_t                         allocator;
+} zajel_topic_envelope_s;
 
-void zajel_init(zajel_s**                     zajelPointer_ptr,
-                allocation_function           allocationFunction_ptr,
-                zajel_deallocation_function   deallocationFunction_ptr COMMA()
-                FILE_AND_LINE_FOR_TYPE())
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_debug_information_s
+ *
+ * Structure Description:
+ * This structure holds the registration information of a message, component, thread or core, which
+ * is only needed by the debug checks, and is kept away from the routing information.
+ **************************************************************************************************/
+typedef struct zajel_debug_information
 {
-    /*Temporarily holds the allocated structure, just to avoid using the multiple indirection frequently*/
-    zajel_s* zajel_ptr;
-    /*Status of the initialization*/
-    /*Temporary counter*/
-    uint32_t i;
+    /*TRUE if the item is registered*/
+    bool_t      isRegistered;
+    /*Item textual name, to be used for debugging*/
+    char*       name_ptr;
+} zajel_debug_information_s;
 
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_s
+ *
+ * Structure Description:
+ * Holds the control block for the communication framework. The control block, then the routing
+ * tables (each starting on its own cache line) are allocated as a single block, and the debug only
+ * registration information is allocated as a separate block, so that the send path only touches
+ * densely packed routing data.
+ **************************************************************************************************/
+struct zajel
+{
     /*
-     * This function is responsible for:
-     ***********************************************************************************************
-     *
-     * o Validating inputs.
-     * o Saving the necessary information from the input.
-     * o Allocating the required resources.
-     * o Initializing the control block variables.
+     * Routing tables, read on every message
      */
-
-    ASSERT((NULL != zajelPointer_ptr),
-           "zajel: Invalid address to pointer passed (zajel_ptr)!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL == *zajelPointer_ptr),
-           "zajel: Address passed of a non-null pointer, expecting an address of a null-initialized "
-           "pointer (zajel_ptr), this might be a sign of double initialization using the same pointer!",
-           fileName,
-           lineNumber);
-    ASSERT((ZAJEL_MESSAGE_COUNT > 0),
-           "zajel: Message count must be greater than zero!",
-           fileName,
-           lineNumber);
-    ASSERT((ZAJEL_COMPONENT_COUNT > 0),
-           "zajel: Component count must be greater than zero!",
-           fileName,
-           lineNumber);
-    ASSERT((ZAJEL_THREAD_COUNT > 0),
-           "zajel: Thread count must be greater than zero!",
-           fileName,
-           lineNumber);
-    ASSERT((ZAJEL_CORE_COUNT > 0),
-           "zajel: Core count must be greater than zero!",
-           fileName,
-           lineNumber);
+    /*An array that holds the component related information like the thread/core ID, componentCount entries*/
+    zajel_component_information_u*  componentInformationArray;
+    /*An array that holds the thread related information, threadCount entries*/
+    zajel_thread_information_s*     threadInformationArray;
+    /*An array that holds the registered message handlers, messageCount entries*/
+    zajel_message_information_s*    messageInformationArray;
+    /*The handler tables of the components, componentCount entries, NULL unless a component has its own handlers*/
+    zajel_handler_table_s*          handlerTableArray_ptr;
+    /*An array that holds the core related information, coreCount entries*/
+    zajel_core_information_s*       coreInformationArray;
+    /*The routes from every thread to every component, allocated by the first build of the routes*/
+    zajel_route_table_s*            routeTable_ptr;
+    /*One of ZAJEL_ROUTES_STATE_xxx*/
+    uint32_t                        routesState;
+    /*TRUE once zajel_seal validated the topology, it cannot be changed afterwards*/
+    bool_t                          isSealed;
+    /*TRUE while the events are recorded (see zajel_trace_start), tested on every message*/
+    bool_t                          isTracing;
+    /*The number of entries of each of the above tables*/
+    uint32_t                        messageCount;
+    uint32_t                        componentCount;
+    uint32_t                        threadCount;
+    uint32_t                        coreCount;
+#ifdef DEBUG
     /*
-     * TODO: mgalal on Feb 27, 2010
-     *
-     * Add proper exception handling in this function, allocation failure, invalid parameters, etc...
+     * Registration information, only used by the debug checks
      */
-
-    /* HINT: [PROGRAMMING]
-     **********************************************************************************************
-     * It is safer to use the sizeof(*pointer) instead of sizeof(type), simply because if the type
-     * was later changed, the latter method will "logically" fail unless the type passed to sizeof()
-     * was changed too. Unlike the former method, which relies on the variable name, and leave the
-     * the size evaluation of the associated type to be performed by the compiler.
+    zajel_debug_information_s*      messageDebugArray;
+    zajel_debug_information_s*      componentDebugArray;
+    zajel_debug_information_s*      threadDebugArray;
+    zajel_debug_information_s*      coreDebugArray;
+    /*The memory block holding the registration information, as returned by the allocation function*/
+    void*                           debugMemory_ptr;
+#endif /*DEBUG*/
+    /*The memory block holding the control block and the routing tables, as returned by the allocation function*/
+    void*                           memory_ptr;
+    /*The routes tables replaced by a migration, and possibly still used by some thread*/
+    zajel_route_table_s*            retiredRouteTable_ptr;
+    /*The allocation function pointer to be used when allocating the optional transports*/
+    allocation_function             allocationFunction_ptr;
+    /*The deallocation function pointer to be used when destroying the control block*/
+    zajel_deallocation_function     deallocationFunction_ptr;
+    /*
+     * The SPSC rings connecting every ordered pair of threads, indexed by
+     * (producerThreadID * threadCount + consumerThreadID), NULL unless the ring transport is
+     * enabled
      */
-    zajel_ptr = (zajel_s*) allocationFunction_ptr(sizeof(*zajel_ptr));
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Failed to allocate a memory for the control block!",
-           fileName,
-           lineNumber);
+    zajel_ring_s*                   ringArray_ptr;
+    /*The memory block holding the rings and their slots, as returned by the allocation function*/
+    void*                           ringMemory_ptr;
+    /*The message pools, one per thread, NULL unless the message pools are enabled*/
+    zajel_pool_s*                   poolArray_ptr;
+    /*Distance between the pools of two threads (see ZAJEL_THREAD_POOL)*/
+    uintptr_t                       poolStride;
+    /*The memory block holding the pools, as returned by the allocation function*/
+    void*                           poolMemory_ptr;
+    /*The synchronization slots, one per thread, NULL unless the synchronization slots are enabled*/
+    zajel_sync_slot_s*              syncSlotArray_ptr;
+    /*The memory block holding the synchronization slots, as returned by the allocation function*/
+    void*                           syncSlotMemory_ptr;
+    /*The shared region carrying the messages to the other cores, NULL unless the shm transport is enabled*/
+    zajel_shm_s*                    shm_ptr;
+    /*The subscriptions, subscriptionCapacity entries, NULL unless the topics are enabled*/
+    zajel_subscription_s*           subscriptionArray_ptr;
+    /*Index of the first subscription of each topic, topicCount + 1 entries (valid with the routes)*/
+    uint32_t*                       topicStartArray_ptr;
+    uint32_t                        topicCount;
+    uint32_t                        subscriptionCount;
+    uint32_t                        subscriptionCapacity;
+    /*The memory block holding the subscriptions, as returned by the allocation function*/
+    void*                           topicMemory_ptr;
+    /*The migrations in progress, indexed by the migrationSlot of the component handle - 1*/
+    zajel_migration_s               migrationArray[ZAJEL_MIGRATION_SLOT_COUNT];
+    /*Serializes the migrations (and the retirement of the routes tables)*/
+    uint32_t                        migrationLock;
+    /*Number of markers held by the former threads of the migrating components*/
+    uint32_t                        heldMarkerCount;
+    /*The counters of each component, componentCount entries, NULL unless the load balancer is enabled*/
+    zajel_balance_counters_s*       balanceCounterArray_ptr;
+    /*The loads handed to the balancing policy, componentCount, threadCount and threadCount entries*/
+    zajel_component_load_s*         componentLoadArray_ptr;
+    uint64_t*                       threadLoadArray_ptr;
+    uint32_t*                       threadCoreArray_ptr;
+    /*The balancing policy, and the context passed to it*/
+    zajel_balance_policy            balancePolicy;
+    void*                           balanceContext_ptr;
+    /*The memory block holding the above arrays, as returned by the allocation function*/
+    void*                           balanceMemory_ptr;
+    /*The actor of each component (NULL if it is not one), NULL unless work stealing is enabled*/
+    zajel_actor_s**                 actorArray_ptr;
+    /*The run queues, one per thread*/
+    zajel_actor_queue_s*            actorQueueArray_ptr;
+    /*The memory block holding the above arrays, as returned by the allocation function*/
+    void*                           actorMemory_ptr;
+    /*The priority lanes of every thread, NULL unless enabled (see zajel_enable_priority_lanes)*/
+    zajel_lanes_s*                  laneArray_ptr;
+    /*The zajel_priority_e of every message ID*/
+    uint8_t*                        messagePriorityArray;
+    /*Share of every collected batch given to each lane, only used when isLaneWeighted*/
+    uint32_t                        laneWeightArray[ZAJEL_PRIORITY_COUNT];
+    bool_t                          isLaneWeighted;
+    /*The memory block holding the lanes, as returned by the allocation function*/
+    void*                           laneMemory_ptr;
+    /*The timing wheels, one per thread, NULL unless the timers are enabled*/
+    zajel_timer_wheel_s*            timerWheelArray_ptr;
+    /*Resolution of the wheels, and the time of their tick 0*/
+    uint64_t                        timerTickNanoseconds;
+    uint64_t                        timerStartTime;
+    /*The memory block holding the wheels and their timers, as returned by the allocation function*/
+    void*                           timerMemory_ptr;
+    /*The statistics of every thread, NULL unless enabled (see zajel_enable_stats)*/
+    uint8_t*                        statsBase_ptr;
+    /*Distance between the statistics of two threads, their counters of each message ID included*/
+    uintptr_t                       statsStride;
+    /*The memory block holding the statistics, as returned by the allocation function*/
+    void*                           statsMemory_ptr;
+    /*The trace rings, one per thread, NULL unless the trace is enabled*/
+    zajel_trace_ring_s*             traceRingArray_ptr;
+    /*The timestamp counter and the monotonic clock, read together when the trace was enabled*/
+    uint64_t                        traceStartTimestamp;
+    uint64_t                        traceStartTime;
+    /*The memory block holding the rings and their records, as returned by the allocation function*/
+    void*                           traceMemory_ptr;
+    /*TRUE once the memory of each thread is placed on its node (see zajel_enable_numa)*/
+    bool_t                          isNumaEnabled;
+    /*ZAJEL_NUMA_FLAG_xxx*/
+    uint32_t                        numaFlags;
+    /*The memory blocks mapped by the placement, guarded by mappingLock as the routes tables come and go*/
+    zajel_mapping_s*                mapping_ptr;
+    uint32_t                        mappingLock;
+};
 
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
 
-#ifdef DEBUG
-    for(i = 0; i < ZAJEL_MESSAGE_COUNT; ++i)
-    {
-        /*<Reset all message handlers>*/
 
-        ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->messageInformationArray[i]) = FALSE;
-    } /*for: <Reset all message handlers>*/
 
-    for(i = 0; i < ZAJEL_COMPONENT_COUNT; ++i)
-    {
-        /*<Reset all component information>*/
+/***************************************************************************************************
+ *  Name        : zajel_route_get
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  sourceThreadID,
+ *                uint32_t  destinationComponentID
+ *
+ *  Description : Gets the route from the given thread to the given component, (re)building the
+ *                  routes first if the mapping changed since they were last built.
+ *
+ *  Returns     : zajel_route_s*.
+ **************************************************************************************************/
+STATIC INLINE zajel_route_s* zajel_route_get(zajel_s*   zajel_ptr,
+                                             uint32_t   sourceThreadID,
+                                             uint32_t   destinationComponentID);
 
-        ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->componentInformationArray[i].parameters) = FALSE;
-    } /*for: <Reset all component information>*/
+/***************************************************************************************************
+ *  Name        : zajel_route_lookup
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  sourceThreadID,
+ *                uint32_t  destinationComponentID
+ *
+ *  Description : Gets the route from the given thread (which shall be the calling thread) to the
+ *                  given component out of the current routes table, the routes shall be valid. The
+ *                  first use of a newly published table is recorded in the thread information.
+ *
+ *  Returns     : zajel_route_s*.
+ **************************************************************************************************/
+STATIC INLINE zajel_route_s* zajel_route_lookup(zajel_s*    zajel_ptr,
+                                                uint32_t    sourceThreadID,
+                                                uint32_t    destinationComponentID);
 
-    for(i = 0; i < ZAJEL_THREAD_COUNT; ++i)
-    {
-        /*<Reset all thread information>*/
-        ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadInformationArray[i]) = FALSE;
-    } /*for: <Reset all thread information>*/
+/***************************************************************************************************
+ *  Name        : zajel_send_message
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr,
+ *                uint8_t   flags COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : Validates then sends the given message like zajel_send, once its flags are reset to
+ *                  the ones set by the sender, and the given framework flags.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_send_message(zajel_s* zajel_ptr,
+                               void*    message_ptr,
+                               uint8_t  flags COMMA()
+                               FILE_AND_LINE_FOR_TYPE());
 
-    for(i = 0; i < ZAJEL_CORE_COUNT; ++i)
-    {
-        /*<Reset all core information>*/
+/***************************************************************************************************
+ *  Name        : zajel_send_begin
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID
+ *
+ *  Description : Marks the given (calling) thread as handing messages over, it shall be called before
+ *                  reading the mapping or the routes. A migration changing the mapping meanwhile
+ *                  knows that the thread may still use the old route (see zajel_migrate_component).
+ *
+ *  Returns     : bool_t, FALSE if the thread was already handing messages over, from a handler
+ *                  called along the way.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_send_begin(zajel_s*  zajel_ptr,
+                                      uint32_t  threadID);
 
-        ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreInformationArray[i]) = FALSE;
-    } /*for: <Reset all core information>*/
-#endif /*DEBUG*/
+/***************************************************************************************************
+ *  Name        : zajel_send_end
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                bool_t    isOutermost
+ *
+ *  Description : Marks the given (calling) thread as done handing messages over, isOutermost is the
+ *                  value returned by the matching zajel_send_begin.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_send_end(zajel_s*  zajel_ptr,
+                                  uint32_t  threadID,
+                                  bool_t    isOutermost);
 
-    zajel_ptr->deallocationFunction_ptr = deallocationFunction_ptr;
+/***************************************************************************************************
+ *  Name        : zajel_send_route
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr,
+ *                zajel_route_s*                route_ptr,
+ *                uint32_t                      sourceThreadID,
+ *                bool_t                        isOutermost
+ *
+ *  Description : Sends the given (already validated) message along the given route, blocking the
+ *                  calling thread until the acknowledgment for a synchronous message. The send
+ *                  started by the caller with zajel_send_begin is ended once the message is handed
+ *                  over, before blocking or calling the handler.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_send_route(zajel_s*                     zajel_ptr,
+                                    zajel_message_descriptor_s*  descriptor_ptr,
+                                    zajel_route_s*               route_ptr,
+                                    uint32_t                     sourceThreadID,
+                                    bool_t                       isOutermost);
 
-    /*Copy the initialized pointer to the one pointed to the passed double pointer*/
-    *zajelPointer_ptr = zajel_ptr;
-} /*function: zajel_init*/
+/***************************************************************************************************
+ *  Name        : zajel_message_priority
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Gets the priority of the given message, the one chosen by its sender, otherwise the
+ *                  one of its message ID. The priority lanes shall be enabled.
+ *
+ *  Returns     : uint32_t, one of zajel_priority_e.
+ **************************************************************************************************/
+STATIC INLINE uint32_t zajel_message_priority(zajel_s*                      zajel_ptr,
+                                              zajel_message_descriptor_s*   descriptor_ptr);
 
-void zajel_destroy(zajel_s** zajelPointer_ptr COMMA()
-                   FILE_AND_LINE_FOR_TYPE())
-{
-    zajel_s* zajel_ptr;
-    /*
-     * This function is responsible for:
-     ***********************************************************************************************
-     *
+/***************************************************************************************************
+ *  Name        : zajel_route_deliver
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                zajel_route_s*                route_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Hands the given message over along the given route, through the lane of its
+ *                  priority when the destination thread has priority lanes.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_route_deliver(zajel_s*                     zajel_ptr,
+                                       zajel_route_s*               route_ptr,
+                                       zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_lane_push
+ *
+ *  Arguments   : zajel_lanes_s*                lanes_ptr,
+ *                uint32_t                      priority,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Pushes the given message into the lane of the given (not normal) priority, then
+ *                  wakes the owner thread up if it is parked on its mailbox.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_lane_push(zajel_lanes_s*               lanes_ptr,
+                                   uint32_t                     priority,
+                                   zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_is_full
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                zajel_route_s*                route_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Checks whether the given route can take the given asynchronous message right now,
+ *                  that is the inbound capacity of the destination thread is not reached, and the
+ *                  ring the message would go through (if any) is not full. The shm routes are not
+ *                  checked here, their credits are taken when pushing.
+ *
+ *  Returns     : bool_t, TRUE if sending the message would have to wait.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_route_is_full(zajel_s*                     zajel_ptr,
+                                         zajel_route_s*               route_ptr,
+                                         zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_inbound_count
+ *
+ *  Arguments   : zajel_thread_information_s*   thread_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Counts the given message against the inbound capacity of the given thread, before
+ *                  it is queued to the thread. The message is flagged so that it is uncounted when
+ *                  collected, whichever way it got queued.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_inbound_count(zajel_thread_information_s*  thread_ptr,
+                                       zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_inbound_release
+ *
+ *  Arguments   : zajel_thread_information_s*   thread_ptr,
+ *                void**                        message_ptr_array,
+ *                uint32_t                      count
+ *
+ *  Description : Uncounts the given messages, just collected by the given thread, from its inbound
+ *                  capacity, with a single atomic update.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_inbound_release(zajel_thread_information_s*    thread_ptr,
+                                         void**                         message_ptr_array,
+                                         uint32_t                       count);
+
+/***************************************************************************************************
+ *  Name        : zajel_routes_build
+ *
+ *  Arguments   : zajel_s*  zajel_ptr
+ *
+ *  Description : Resolves the route from every thread to every component. When several threads find
+ *                  the routes outdated at the same time, one of them builds them while the others
+ *                  wait for it.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_routes_build(zajel_s* zajel_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_table_alloc
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  epoch
+ *
+ *  Description : Allocates an (unfilled) routes table of the given epoch.
+ *
+ *  Returns     : zajel_route_table_s*.
+ **************************************************************************************************/
+STATIC zajel_route_table_s* zajel_route_table_alloc(zajel_s*    zajel_ptr,
+                                                    uint32_t    epoch);
+
+/***************************************************************************************************
+ *  Name        : zajel_routes_fill
+ *
+ *  Arguments   : zajel_s*              zajel_ptr,
+ *                zajel_route_table_s*  table_ptr
+ *
+ *  Description : Resolves the route from every thread to every component into the given table,
+ *                  according to the current mapping.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_routes_fill(zajel_s*              zajel_ptr,
+                              zajel_route_table_s*  table_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_routes_publish
+ *
+ *  Arguments   : zajel_s*  zajel_ptr
+ *
+ *  Description : Resolves the routes of a sealed topology into a new table, publishes it, and
+ *                  retires the replaced one. The caller shall hold the migration lock.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_routes_publish(zajel_s* zajel_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_routes_reclaim
+ *
+ *  Arguments   : zajel_s*  zajel_ptr
+ *
+ *  Description : Frees the retired routes tables which every thread moved past. The caller shall
+ *                  hold the migration lock.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_routes_reclaim(zajel_s* zajel_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_to_ring
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Pushes the given message into the ring given as context, spinning while the ring is
+ *                  full (i.e. until the consumer catches up).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_route_to_ring(void*                       context_ptr,
+                                zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_to_own_ring
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Pushes the given message into the ring of a thread to itself, given as context.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_route_to_own_ring(void*                       context_ptr,
+                                    zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_to_mailbox
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Pushes the given message into the mailbox given as context.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_route_to_mailbox(void*                        context_ptr,
+                                   zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_to_actor
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Posts the given message to the actor given as context, and queues the actor on its
+ *                  home thread if it just became runnable.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_route_to_actor(void*                          context_ptr,
+                                 zajel_message_descriptor_s*    descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_to_thread_callback
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Hands the given message to the handleMessageCallback of the thread given as context.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_route_to_thread_callback(void*                        context_ptr,
+                                           zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_route_to_core_callback
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Hands the given message to the handleMessageCallback of the core given as context.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_route_to_core_callback(void*                          context_ptr,
+                                         zajel_message_descriptor_s*    descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_thread_collect
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                void**    message_ptr_array,
+ *                uint32_t  maxCount
+ *
+ *  Description : Collects up to maxCount messages from the inbound queues of the given thread,
+ *                  without blocking. With priority lanes, the lanes are collected from the most
+ *                  urgent one, as set by zajel_enable_priority_lanes.
+ *
+ *  Returns     : uint32_t, number of messages collected.
+ **************************************************************************************************/
+STATIC uint32_t zajel_thread_collect(zajel_s*   zajel_ptr,
+                                     uint32_t   threadID,
+                                     void**     message_ptr_array,
+                                     uint32_t   maxCount);
+
+/***************************************************************************************************
+ *  Name        : zajel_thread_collect_transport
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                void**    message_ptr_array,
+ *                uint32_t  maxCount
+ *
+ *  Description : Collects up to maxCount messages from the inbound rings or mailbox of the given
+ *                  thread (its normal priority lane), without blocking.
+ *
+ *  Returns     : uint32_t, number of messages collected.
+ **************************************************************************************************/
+STATIC uint32_t zajel_thread_collect_transport(zajel_s*     zajel_ptr,
+                                               uint32_t     threadID,
+                                               void**       message_ptr_array,
+                                               uint32_t     maxCount);
+
+/***************************************************************************************************
+ *  Name        : zajel_thread_handle_message_batch
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      producerThreadID,
+ *                uint32_t                      consumerThreadID,
+ *                zajel_message_descriptor_s**  descriptor_ptr_array,
+ *                uint32_t                      count
+ *
+ *  Description : Hands the given messages to the consumer thread at once, using the cheapest way its
+ *                  transport offers.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_thread_handle_message_batch(zajel_s*                      zajel_ptr,
+                                              uint32_t                      producerThreadID,
+                                              uint32_t                      consumerThreadID,
+                                              zajel_message_descriptor_s**  descriptor_ptr_array,
+                                              uint32_t                      count);
+
+/***************************************************************************************************
+ *  Name        : zajel_core_handle_message_batch
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      coreID,
+ *                zajel_message_descriptor_s**  descriptor_ptr_array,
+ *                uint32_t                      count
+ *
+ *  Description : Hands the given messages to the given core, at once when it has a batch callback.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_core_handle_message_batch(zajel_s*                      zajel_ptr,
+                                            uint32_t                      coreID,
+                                            zajel_message_descriptor_s**  descriptor_ptr_array,
+                                            uint32_t                      count);
+
+/***************************************************************************************************
+ *  Name        : zajel_message_handle
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      callerThreadID,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Handles the given message received by the calling thread, unless its destination
+ *                  is being migrated, in which case the migration decides what to do with it.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_message_handle(zajel_s*                    zajel_ptr,
+                                        uint32_t                    callerThreadID,
+                                        zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_message_run
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      callerThreadID,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Runs the handler of the given message, then releases the payload it carries (the
+ *                  handle is read beforehand, as the handler may free the message).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_message_run(zajel_s*                      zajel_ptr,
+                              uint32_t                      callerThreadID,
+                              zajel_message_descriptor_s*   descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_message_unused
+ *
+ *  Arguments   : zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : The handler of the message IDs declared by zajel_regsiter_unused_messages, reaching
+ *                  it is a bug: the debug builds stop there, the release ones drop the message.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_message_unused(zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_handler_get
+ *
+ *  Arguments   : zajel_s*                          zajel_ptr,
+ *                const zajel_message_descriptor_s* descriptor_ptr
+ *
+ *  Description : Gets the handler of the given message, the one registered for its destination
+ *                  component if any, otherwise the one registered for its message ID.
+ *
+ *  Returns     : const zajel_message_information_s*.
+ **************************************************************************************************/
+STATIC INLINE const zajel_message_information_s* zajel_handler_get(zajel_s*                            zajel_ptr,
+                                                                   const zajel_message_descriptor_s*   descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_handler_run
+ *
+ *  Arguments   : zajel_s*                          zajel_ptr,
+ *                uint32_t                          callerThreadID,
+ *                const zajel_message_information_s* information_ptr,
+ *                zajel_message_descriptor_s*       descriptor_ptr
+ *
+ *  Description : Runs the given handler on the given message, counting the message (and timing the
+ *                  sampled ones) for its destination when the load balancer is enabled, and tracing
+ *                  the handler entry and exit while the events are recorded.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_handler_run(zajel_s*                           zajel_ptr,
+                                     uint32_t                           callerThreadID,
+                                     const zajel_message_information_s* information_ptr,
+                                     zajel_message_descriptor_s*        descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_handler_run_counted
+ *
+ *  Arguments   : zajel_s*                          zajel_ptr,
+ *                const zajel_message_information_s* information_ptr,
+ *                zajel_message_descriptor_s*       descriptor_ptr
+ *
+ *  Description : Runs the given handler on the given message, counting the message (and timing the
+ *                  sampled ones) for its destination, the load balancer shall be enabled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_handler_run_counted(zajel_s*                           zajel_ptr,
+                                             const zajel_message_information_s* information_ptr,
+                                             zajel_message_descriptor_s*        descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_get
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Gets the actor the given message shall be posted to, which is the case when its
+ *                  destination is an actor, except for the published messages covering several
+ *                  subscribers (checked one by one).
+ *
+ *  Returns     : zajel_actor_s*, NULL if the message is handled right away.
+ **************************************************************************************************/
+STATIC INLINE zajel_actor_s* zajel_actor_get(zajel_s*                       zajel_ptr,
+                                             zajel_message_descriptor_s*    descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_actors_run
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                uint32_t  budget
+ *
+ *  Description : Runs the runnable actors of the given (calling) thread, then the ones stolen from
+ *                  the other threads of its core, until none is left or budget messages were handled.
+ *                  Each actor handles a batch of messages before it is queued again.
+ *
+ *  Returns     : uint32_t, number of messages handled.
+ **************************************************************************************************/
+STATIC uint32_t zajel_actors_run(zajel_s*   zajel_ptr,
+                                 uint32_t   threadID,
+                                 uint32_t   budget);
+
+/***************************************************************************************************
+ *  Name        : zajel_migration_applies
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Tells whether the given message shall go through zajel_migration_handle, which is
+ *                  the case when its destination is being migrated, except for the acknowledgments
+ *                  and the published messages covering several subscribers (checked one by one).
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_migration_applies(zajel_s*                       zajel_ptr,
+                                             zajel_message_descriptor_s*    descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_migration_handle
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      callerThreadID,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Handles a message received for a migrating component. Any thread other than the
+ *                  new one passes it on to the new thread, which runs the forwarded messages right
+ *                  away, holds the other ones, and runs the held messages once the marker arrives.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_migration_handle(zajel_s*                     zajel_ptr,
+                                   uint32_t                     callerThreadID,
+                                   zajel_message_descriptor_s*  descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_migration_release_markers
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID
+ *
+ *  Description : Passes on the markers held by the given (calling) thread whose rings were consumed
+ *                  past the heads recorded by the migration. It is called before collecting new
+ *                  messages, so the messages collected before are all handled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_migration_release_markers(zajel_s*    zajel_ptr,
+                                            uint32_t    threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_migration_senders_done
+ *
+ *  Arguments   : zajel_s*              zajel_ptr,
+ *                zajel_migration_s*    migration_ptr
+ *
+ *  Description : Checks whether the threads which were handing messages over when the migration
+ *                  changed the mapping are all done, so that whatever they sent along the old route
+ *                  already reached the former thread.
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+STATIC bool_t zajel_migration_senders_done(zajel_s*             zajel_ptr,
+                                           zajel_migration_s*   migration_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_migration_requeue
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      threadID,
+ *                zajel_message_descriptor_s*   marker_ptr,
+ *                uint32_t                      priority
+ *
+ *  Description : Queues the given marker again at the end of the given lane of the given (calling)
+ *                  thread, which shall not be the normal lane of a thread using the rings.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_migration_requeue(zajel_s*                    zajel_ptr,
+                                    uint32_t                    threadID,
+                                    zajel_message_descriptor_s* marker_ptr,
+                                    uint32_t                    priority);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_start
+ *
+ *  Arguments   : zajel_s*      zajel_ptr,
+ *                uint32_t      callerThreadID,
+ *                void*         message_ptr,
+ *                uint32_t      size,
+ *                uint64_t      delayNanoseconds,
+ *                uint64_t      periodNanoseconds
+ *
+ *  Description : Arms a timer on the wheel of the calling thread, sending the given message once
+ *                  the delay is over, then a copy of it (of size bytes) every period unless the
+ *                  period is 0. The message shall be validated by the caller.
+ *
+ *  Returns     : timer_id, ZAJEL_TIMER_ID_INVALID if the thread has no timer left.
+ **************************************************************************************************/
+STATIC timer_id zajel_timer_start(zajel_s*  zajel_ptr,
+                                  uint32_t  callerThreadID,
+                                  void*     message_ptr,
+                                  uint32_t  size,
+                                  uint64_t  delayNanoseconds,
+                                  uint64_t  periodNanoseconds);
+
+/***************************************************************************************************
+ *  Name        : zajel_timers_expire
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID
+ *
+ *  Description : Moves the wheel of the given (calling) thread up to the current tick, and sends the
+ *                  messages of the expired timers, from this thread.
+ *
+ *  Returns     : uint32_t, number of messages sent.
+ **************************************************************************************************/
+STATIC uint32_t zajel_timers_expire(zajel_s*    zajel_ptr,
+                                    uint32_t    threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_tick
+ *
+ *  Arguments   : zajel_s*  zajel_ptr
+ *
+ *  Description : Gets the current time, in ticks of the timing wheels.
+ *
+ *  Returns     : uint64_t.
+ **************************************************************************************************/
+STATIC INLINE uint64_t zajel_timer_tick(zajel_s* zajel_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_payload_resolve
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint64_t  payloadHandle
+ *
+ *  Description : Gets the local address of the payload referred to by the given handle.
+ *
+ *  Returns     : zajel_payload_s*.
+ **************************************************************************************************/
+STATIC INLINE zajel_payload_s* zajel_payload_resolve(zajel_s*   zajel_ptr,
+                                                     uint64_t   payloadHandle);
+
+/***************************************************************************************************
+ *  Name        : zajel_topics_build
+ *
+ *  Arguments   : zajel_s*  zajel_ptr
+ *
+ *  Description : Refreshes the mapping of the subscribers, sorts the subscriptions by topic, core,
+ *                  thread then component, and indexes the first subscription of each topic. Called
+ *                  while building the routes.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_topics_build(zajel_s* zajel_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_topic_send
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                uint32_t          producerThreadID,
+ *                message_id        messageID,
+ *                component_id      sourceComponentID,
+ *                zajel_payload_s*  payload_ptr,
+ *                uint32_t          subscriptionIndex,
+ *                uint32_t          subscriptionCount,
+ *                uint8_t           scope,
+ *                uint8_t           flags
+ *
+ *  Description : Allocates a published message covering the given subscriptions, and hands it over
+ *                  to the destination of the first one (a thread or a core, depending on the scope).
+ *                  The flags are added to ZAJEL_MESSAGE_FLAG_TOPIC.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_topic_send(zajel_s*           zajel_ptr,
+                             uint32_t           producerThreadID,
+                             message_id         messageID,
+                             component_id       sourceComponentID,
+                             zajel_payload_s*   payload_ptr,
+                             uint32_t           subscriptionIndex,
+                             uint32_t           subscriptionCount,
+                             uint8_t            scope,
+                             uint8_t            flags);
+
+/***************************************************************************************************
+ *  Name        : zajel_topic_forward
+ *
+ *  Arguments   : zajel_s*                  zajel_ptr,
+ *                uint32_t                  callerThreadID,
+ *                zajel_topic_envelope_s*   envelope_ptr
+ *
+ *  Description : Splits a published message received for the whole core into a message per
+ *                  subscribing thread, then releases it.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_topic_forward(zajel_s*                zajel_ptr,
+                                uint32_t                callerThreadID,
+                                zajel_topic_envelope_s* envelope_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_topic_handle
+ *
+ *  Arguments   : zajel_s*                  zajel_ptr,
+ *                uint32_t                  callerThreadID,
+ *                zajel_topic_envelope_s*   envelope_ptr
+ *
+ *  Description : Runs the handler of a published message once per covered subscriber, then releases
+ *                  the message. The subscribers migrated away from the calling thread (or being
+ *                  migrated to it) and the actors get a message of their own instead.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_topic_handle(zajel_s*                 zajel_ptr,
+                               uint32_t                 callerThreadID,
+                               zajel_topic_envelope_s*  envelope_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_topic_release
+ *
+ *  Arguments   : zajel_s*                  zajel_ptr,
+ *                uint32_t                  callerThreadID,
+ *                zajel_topic_envelope_s*   envelope_ptr
+ *
+ *  Description : Releases the payload of a published message, then frees the message where it was
+ *                  allocated.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_topic_release(zajel_s*                zajel_ptr,
+                                uint32_t                callerThreadID,
+                                zajel_topic_envelope_s* envelope_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_send
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      sourceThreadID,
+ *                zajel_message_descriptor_s*   descriptor_ptr,
+ *                uint32_t                      relation
+ *
+ *  Description : Counts a message about to be sent from the given thread, and probes its residency
+ *                  when it is sampled and queued to a thread of this process.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_stats_send(zajel_s*                       zajel_ptr,
+                             uint32_t                       sourceThreadID,
+                             zajel_message_descriptor_s*    descriptor_ptr,
+                             uint32_t                       relation);
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_deliver
+ *
+ *  Arguments   : zajel_s*                      zajel_ptr,
+ *                uint32_t                      callerThreadID,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Counts a message about to be handled by the calling thread, and records its
+ *                  residency when it is the one probed.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_stats_deliver(zajel_s*                    zajel_ptr,
+                                uint32_t                    callerThreadID,
+                                zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_placement_granule
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uintptr_t blockSize
+ *
+ *  Description : Gets the alignment of the per-thread blocks of the given size, so each of them can
+ *                  be placed on its own node: a huge page for the big blocks when huge pages are
+ *                  wanted, a page otherwise, and 1 (no padding) unless NUMA placement is enabled.
+ *
+ *  Returns     : uintptr_t.
+ **************************************************************************************************/
+STATIC uintptr_t zajel_placement_granule(zajel_s*   zajel_ptr,
+                                         uintptr_t  blockSize);
+
+/***************************************************************************************************
+ *  Name        : zajel_placement_alloc
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uintptr_t size,
+ *                uintptr_t granule
+ *
+ *  Description : Allocates a memory block whose per-thread blocks are aligned to the given granule
+ *                  (see zajel_placement_granule). Once NUMA placement is enabled the block is mapped
+ *                  from the system (made of huge pages if the granule is a huge page and some are
+ *                  left), otherwise (or if mapping fails) it comes from the allocation function.
+ *
+ *  Returns     : void*, NULL if the memory cannot be allocated.
+ **************************************************************************************************/
+STATIC void* zajel_placement_alloc(zajel_s*     zajel_ptr,
+                                   uintptr_t    size,
+                                   uintptr_t    granule);
+
+/***************************************************************************************************
+ *  Name        : zajel_placement_bind
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     memory_ptr,
+ *                void*     block_ptr,
+ *                uintptr_t size,
+ *                uint32_t  threadID
+ *
+ *  Description : Places the given block (granule aligned, inside memory_ptr returned by
+ *                  zajel_placement_alloc) on the node of the core of the given thread. It shall be
+ *                  called before the block is touched, and does nothing unless memory_ptr was mapped
+ *                  and the node of the core is known.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_placement_bind(zajel_s*   zajel_ptr,
+                                 void*      memory_ptr,
+                                 void*      block_ptr,
+                                 uintptr_t  size,
+                                 uint32_t   threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_placement_free
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     memory_ptr
+ *
+ *  Description : Releases a memory block returned by zajel_placement_alloc.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_placement_free(zajel_s*   zajel_ptr,
+                                 void*      memory_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_placement_find
+ *
+ *  Arguments   : zajel_s*      zajel_ptr,
+ *                const void*   memory_ptr,
+ *                bool_t        isRemoved
+ *
+ *  Description : Finds the mapping of the given memory block, and unlinks it when isRemoved.
+ *
+ *  Returns     : zajel_mapping_s*, NULL if the block was not mapped by the placement.
+ **************************************************************************************************/
+STATIC zajel_mapping_s* zajel_placement_find(zajel_s*       zajel_ptr,
+                                             const void*    memory_ptr,
+                                             bool_t         isRemoved);
+
+/***************************************************************************************************
+ *  Name        : zajel_placement_lock / zajel_placement_unlock
+ *
+ *  Arguments   : zajel_s*  zajel_ptr
+ *
+ *  Description : Acquires/releases the lock guarding the list of the mapped blocks.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_placement_lock(zajel_s* zajel_ptr);
+STATIC void zajel_placement_unlock(zajel_s* zajel_ptr);
+
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+
+void zajel_init(zajel_s**                     zajelPointer_ptr,
+                const zajel_config_s*         config_ptr,
+                allocation_function           allocationFunction_ptr,
+                zajel_deallocation_function   deallocationFunction_ptr COMMA()
+                FILE_AND_LINE_FOR_TYPE())
+{
+    /*Temporarily holds the allocated structure, just to avoid using the multiple indirection frequently*/
+    zajel_s*        zajel_ptr;
+    /*The configuration in use, either the given one or the default one*/
+    zajel_config_s  config;
+    /*Offsets of the routing tables inside the allocated block*/
+    uintptr_t       componentsOffset;
+    uintptr_t       threadsOffset;
+    uintptr_t       messagesOffset;
+    uintptr_t       coresOffset;
+    uintptr_t       totalSize;
+    /*The memory block holding the control block and the routing tables*/
+    void*           memory_ptr;
+    /*Start of the cache aligned area inside the allocated block*/
+    uintptr_t       alignedBase;
+    /*Temporary counter*/
+    uint32_t        i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Saving the necessary information from the input.
+     * o Allocating the required resources.
+     * o Initializing the control block variables.
+     */
+
+    ASSERT((NULL != zajelPointer_ptr),
+           "zajel: Invalid address to pointer passed (zajel_ptr)!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == *zajelPointer_ptr),
+           "zajel: Address passed of a non-null pointer, expecting an address of a null-initialized "
+           "pointer (zajel_ptr), this might be a sign of double initialization using the same pointer!",
+           fileName,
+           lineNumber);
+
+    if(NULL != config_ptr)
+    {
+        config = *config_ptr;
+    } /*if: <User configuration>*/
+    else
+    {
+        config.messageCount     = ZAJEL_DEFAULT_MESSAGE_COUNT;
+        config.componentCount   = ZAJEL_DEFAULT_COMPONENT_COUNT;
+        config.threadCount      = ZAJEL_DEFAULT_THREAD_COUNT;
+        config.coreCount        = ZAJEL_DEFAULT_CORE_COUNT;
+    } /*else: <Default configuration>*/
+
+    ASSERT(((config.messageCount > 0) && (config.messageCount <= ZAJEL_MAX_MESSAGE_COUNT)),
+           "zajel: Message count must be greater than zero, and at most ZAJEL_MAX_MESSAGE_COUNT!",
+           fileName,
+           lineNumber);
+    ASSERT(((config.componentCount > 0) && (config.componentCount <= ZAJEL_MAX_COMPONENT_COUNT)),
+           "zajel: Component count must be greater than zero, and at most ZAJEL_MAX_COMPONENT_COUNT!",
+           fileName,
+           lineNumber);
+    ASSERT(((config.threadCount > 0) && (config.threadCount <= ZAJEL_MAX_THREAD_COUNT)),
+           "zajel: Thread count must be greater than zero, and at most ZAJEL_MAX_THREAD_COUNT!",
+           fileName,
+           lineNumber);
+    ASSERT(((config.coreCount > 0) && (config.coreCount <= ZAJEL_MAX_CORE_COUNT)),
+           "zajel: Core count must be greater than zero, and at most ZAJEL_MAX_CORE_COUNT!",
+           fileName,
+           lineNumber);
+    /*
+     * TODO: mgalal on Feb 27, 2010
+     *
+     * Add proper exception handling in this function, allocation failure, invalid parameters, etc...
+     */
+
+    /* HINT: [PROGRAMMING]
+     **********************************************************************************************
+     * It is safer to use the sizeof(*pointer) instead of sizeof(type), simply because if the type
+     * was later changed, the latter method will "logically" fail unless the type passed to sizeof()
+     * was changed too. Unlike the former method, which relies on the variable name, and leave the
+     * the size evaluation of the associated type to be performed by the compiler.
+     */
+
+    /*
+     * The tables are laid out in the order they are used by zajel_send: the component handles of
+     * both ends, the thread entry of the destination, then the message handler.
+     */
+    componentsOffset    = ZAJEL_CACHE_ALIGN_UP(sizeof(*zajel_ptr));
+    threadsOffset       = componentsOffset + ZAJEL_CACHE_ALIGN_UP(sizeof(*zajel_ptr->componentInformationArray) * config.componentCount);
+    messagesOffset      = threadsOffset    + ZAJEL_CACHE_ALIGN_UP(sizeof(*zajel_ptr->threadInformationArray) * config.threadCount);
+    coresOffset         = messagesOffset   + ZAJEL_CACHE_ALIGN_UP(sizeof(*zajel_ptr->messageInformationArray) * config.messageCount);
+    totalSize           = coresOffset      + ZAJEL_CACHE_ALIGN_UP(sizeof(*zajel_ptr->coreInformationArray) * config.coreCount);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    memory_ptr = allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE + totalSize);
+    ASSERT((NULL != memory_ptr),
+           "zajel: Failed to allocate a memory for the control block!",
+           fileName,
+           lineNumber);
+
+    alignedBase = ZAJEL_CACHE_ALIGN_UP((uintptr_t)memory_ptr);
+    memset((void*)alignedBase, 0, totalSize);
+
+    zajel_ptr                               = (zajel_s*) alignedBase;
+    zajel_ptr->memory_ptr                   = memory_ptr;
+    zajel_ptr->componentInformationArray    = (zajel_component_information_u*) (alignedBase + componentsOffset);
+    zajel_ptr->threadInformationArray       = (zajel_thread_information_s*) (alignedBase + threadsOffset);
+    zajel_ptr->messageInformationArray      = (zajel_message_information_s*) (alignedBase + messagesOffset);
+    zajel_ptr->coreInformationArray         = (zajel_core_information_s*) (alignedBase + coresOffset);
+    zajel_ptr->messageCount                 = config.messageCount;
+    zajel_ptr->componentCount               = config.componentCount;
+    zajel_ptr->threadCount                  = config.threadCount;
+    zajel_ptr->coreCount                    = config.coreCount;
+    zajel_ptr->routeTable_ptr               = NULL;
+    zajel_ptr->retiredRouteTable_ptr        = NULL;
+    zajel_ptr->routesState                  = ZAJEL_ROUTES_STATE_INVALID;
+    zajel_ptr->isSealed                     = FALSE;
+    zajel_ptr->isTracing                    = FALSE;
+
+#ifdef DEBUG
+    zajel_ptr->debugMemory_ptr = allocationFunction_ptr(sizeof(zajel_debug_information_s) *
+                                                        (config.messageCount +
+                                                         config.componentCount +
+                                                         config.threadCount +
+                                                         config.coreCount));
+    ASSERT((NULL != zajel_ptr->debugMemory_ptr),
+           "zajel: Failed to allocate a memory for the registration information!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->messageDebugArray    = (zajel_debug_information_s*) zajel_ptr->debugMemory_ptr;
+    zajel_ptr->componentDebugArray  = zajel_ptr->messageDebugArray + config.messageCount;
+    zajel_ptr->threadDebugArray     = zajel_ptr->componentDebugArray + config.componentCount;
+    zajel_ptr->coreDebugArray       = zajel_ptr->threadDebugArray + config.threadCount;
+
+    for(i = 0; i < (config.messageCount + config.componentCount + config.threadCount + config.coreCount); ++i)
+    {
+        /*<Reset all the registration information>*/
+        ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->messageDebugArray[i])  = FALSE;
+        zajel_ptr->messageDebugArray[i].name_ptr                    = NULL;
+    } /*for: <Reset all the registration information>*/
+#endif /*DEBUG*/
+
+    zajel_ptr->allocationFunction_ptr   = allocationFunction_ptr;
+    zajel_ptr->deallocationFunction_ptr = deallocationFunction_ptr;
+    zajel_ptr->handlerTableArray_ptr    = NULL;
+    zajel_ptr->ringArray_ptr            = NULL;
+    zajel_ptr->ringMemory_ptr           = NULL;
+    zajel_ptr->poolArray_ptr            = NULL;
+    zajel_ptr->poolMemory_ptr           = NULL;
+    zajel_ptr->syncSlotArray_ptr        = NULL;
+    zajel_ptr->syncSlotMemory_ptr       = NULL;
+    zajel_ptr->shm_ptr                  = NULL;
+    zajel_ptr->subscriptionArray_ptr    = NULL;
+    zajel_ptr->topicStartArray_ptr      = NULL;
+    zajel_ptr->topicCount               = 0;
+    zajel_ptr->subscriptionCount        = 0;
+    zajel_ptr->subscriptionCapacity     = 0;
+    zajel_ptr->topicMemory_ptr          = NULL;
+    zajel_ptr->balanceCounterArray_ptr  = NULL;
+    zajel_ptr->balanceMemory_ptr        = NULL;
+    zajel_ptr->actorArray_ptr           = NULL;
+    zajel_ptr->actorQueueArray_ptr      = NULL;
+    zajel_ptr->actorMemory_ptr          = NULL;
+    zajel_ptr->laneArray_ptr            = NULL;
+    zajel_ptr->messagePriorityArray     = NULL;
+    zajel_ptr->isLaneWeighted           = FALSE;
+    zajel_ptr->laneMemory_ptr           = NULL;
+    zajel_ptr->timerWheelArray_ptr      = NULL;
+    zajel_ptr->timerMemory_ptr          = NULL;
+    zajel_ptr->statsBase_ptr            = NULL;
+    zajel_ptr->statsMemory_ptr          = NULL;
+    zajel_ptr->traceRingArray_ptr       = NULL;
+    zajel_ptr->traceMemory_ptr          = NULL;
+    zajel_ptr->isNumaEnabled            = FALSE;
+    zajel_ptr->numaFlags                = ZAJEL_NUMA_FLAG_NONE;
+    zajel_ptr->mapping_ptr              = NULL;
+    zajel_ptr->mappingLock              = FALSE;
+
+    for(i = 0; i < config.coreCount; ++i)
+    {
+        /*<The nodes of the cores are unknown until set>*/
+        zajel_ptr->coreInformationArray[i].nodeID = ZAJEL_NUMA_NODE_ANY;
+    } /*for: <The nodes of the cores are unknown until set>*/
+
+    /*Copy the initialized pointer to the one pointed to the passed double pointer*/
+    *zajelPointer_ptr = zajel_ptr;
+} /*function: zajel_init*/
+
+void zajel_destroy(zajel_s** zajelPointer_ptr COMMA()
+                   FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_s*                zajel_ptr;
+    zajel_route_table_s*    table_ptr;
+    zajel_timer_wheel_s*    wheel_ptr;
+    /*Temporary counters*/
+    uint32_t                i;
+    uint32_t                j;
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Releasing the allocated resources.
+     * o Resetting the control block pointer.
+     */
+
+    ASSERT((NULL != zajelPointer_ptr),
+           "zajel: Invalid address to pointer passed (zajel_ptr)!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != *zajelPointer_ptr),
+           "zajel: Address passed of a null pointer, expecting an address of a not-null pointer (zajel_ptr)"
+           "This might be a sign of double destroy using the same pointer!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr = *zajelPointer_ptr;
+
+    if(NULL != zajel_ptr->timerMemory_ptr)
+    {
+        /*<Release the timers, and the messages still held by them (unless the pools release them)>*/
+        for(i = 0; (i < zajel_ptr->threadCount) && (NULL == zajel_ptr->poolArray_ptr); ++i)
+        {
+            wheel_ptr = &zajel_ptr->timerWheelArray_ptr[i];
+
+            for(j = 0; j < wheel_ptr->capacity; ++j)
+            {
+                if(NULL != wheel_ptr->timerArray[j].message_ptr)
+                {
+                    zajel_ptr->deallocationFunction_ptr(wheel_ptr->timerArray[j].message_ptr);
+                } /*if: <Timer is armed>*/
+            } /*for: <Check each timer of the thread>*/
+        } /*for: <Check the wheel of each thread>*/
+
+        zajel_placement_free(zajel_ptr,
+                             zajel_ptr->timerMemory_ptr);
+    } /*if: <Release the timers, and the messages still held by them (unless the pools release them)>*/
+
+    if(NULL != zajel_ptr->ringMemory_ptr)
+    {
+        /*<Release the built-in rings>*/
+        zajel_placement_free(zajel_ptr,
+                             zajel_ptr->ringMemory_ptr);
+    } /*if: <Release the built-in rings>*/
+
+    if(NULL != zajel_ptr->poolMemory_ptr)
+    {
+        /*<Release the message pools>*/
+        for(i = 0; i < zajel_ptr->threadCount; ++i)
+        {
+            zajel_pool_destroy(ZAJEL_THREAD_POOL(zajel_ptr,
+                                                 i),
+                               zajel_ptr->deallocationFunction_ptr);
+        } /*for: <Release the slabs of each thread>*/
+
+        zajel_placement_free(zajel_ptr,
+                             zajel_ptr->poolMemory_ptr);
+    } /*if: <Release the message pools>*/
+
+    if(NULL != zajel_ptr->syncSlotMemory_ptr)
+    {
+        /*<Release the synchronization slots>*/
+        zajel_ptr->deallocationFunction_ptr(zajel_ptr->syncSlotMemory_ptr);
+    } /*if: <Release the synchronization slots>*/
+
+    if(NULL != zajel_ptr->topicMemory_ptr)
+    {
+        /*<Release the subscriptions>*/
+        zajel_ptr->deallocationFunction_ptr(zajel_ptr->topicMemory_ptr);
+    } /*if: <Release the subscriptions>*/
+
+    if(NULL != zajel_ptr->actorMemory_ptr)
+    {
+        /*<Release the actors>*/
+        for(i = 0; i < zajel_ptr->componentCount; ++i)
+        {
+            if(NULL != zajel_ptr->actorArray_ptr[i])
+            {
+                zajel_ptr->deallocationFunction_ptr(zajel_ptr->actorArray_ptr[i]->memory_ptr);
+            } /*if: <Component is an actor>*/
+        } /*for: <Release each actor>*/
+
+        zajel_ptr->deallocationFunction_ptr(zajel_ptr->actorMemory_ptr);
+    } /*if: <Release the actors>*/
+
+    if(NULL != zajel_ptr->laneMemory_ptr)
+    {
+        /*<Release the priority lanes>*/
+        zajel_ptr->deallocationFunction_ptr(zajel_ptr->laneMemory_ptr);
+    } /*if: <Release the priority lanes>*/
+
+    if(NULL != zajel_ptr->balanceMemory_ptr)
+    {
+        /*<Release the load balancer counters>*/
+        zajel_ptr->deallocationFunction_ptr(zajel_ptr->balanceMemory_ptr);
+    } /*if: <Release the load balancer counters>*/
+
+    if(NULL != zajel_ptr->statsMemory_ptr)
+    {
+        /*<Release the statistics>*/
+        zajel_placement_free(zajel_ptr,
+                             zajel_ptr->statsMemory_ptr);
+    } /*if: <Release the statistics>*/
+
+    if(NULL != zajel_ptr->traceMemory_ptr)
+    {
+        /*<Release the trace rings>*/
+        zajel_placement_free(zajel_ptr,
+                             zajel_ptr->traceMemory_ptr);
+    } /*if: <Release the trace rings>*/
+
+    if(NULL != zajel_ptr->routeTable_ptr)
+    {
+        /*<Release the routes, the retired tables being chained after the current one>*/
+        zajel_ptr->routeTable_ptr->next_ptr = zajel_ptr->retiredRouteTable_ptr;
+
+        while(NULL != zajel_ptr->routeTable_ptr)
+        {
+            table_ptr                   = zajel_ptr->routeTable_ptr;
+            zajel_ptr->routeTable_ptr   = table_ptr->next_ptr;
+            zajel_placement_free(zajel_ptr,
+                                 table_ptr->memory_ptr);
+        } /*while: <There are tables left>*/
+    } /*if: <Release the routes, the retired tables being chained after the current one>*/
+
+    if(NULL != zajel_ptr->handlerTableArray_ptr)
+    {
+        /*<Release the handler tables of the components>*/
+        for(i = 0; i < zajel_ptr->componentCount; ++i)
+        {
+            if(NULL != zajel_ptr->handlerTableArray_ptr[i].entryArray)
+            {
+                zajel_ptr->deallocationFunction_ptr(zajel_ptr->handlerTableArray_ptr[i].entryArray);
+            } /*if: <Component has its own handlers>*/
+        } /*for: <Release each table>*/
+
+        zajel_ptr->deallocationFunction_ptr(zajel_ptr->handlerTableArray_ptr);
+    } /*if: <Release the handler tables of the components>*/
+
+    for(i = 0; i < ZAJEL_MIGRATION_SLOT_COUNT; ++i)
+    {
+        /*<Release the memory of the unfinished migrations>*/
+        if(NULL != zajel_ptr->migrationArray[i].pending_ptr_array)
+        {
+            zajel_ptr->deallocationFunction_ptr(zajel_ptr->migrationArray[i].pending_ptr_array);
+        } /*if: <Migration holds messages>*/
+
+        if(NULL != zajel_ptr->migrationArray[i].drainHeadArray)
+        {
+            zajel_ptr->deallocationFunction_ptr(zajel_ptr->migrationArray[i].drainHeadArray);
+        } /*if: <Migration recorded the rings heads>*/
+
+        if(NULL != zajel_ptr->migrationArray[i].sendCountArray)
+        {
+            zajel_ptr->deallocationFunction_ptr(zajel_ptr->migrationArray[i].sendCountArray);
+        } /*if: <Migration recorded the threads sending along the old route>*/
+
+        if(NULL != zajel_ptr->migrationArray[i].heldMarker_ptr)
+        {
+            zajel_ptr->deallocationFunction_ptr(zajel_ptr->migrationArray[i].heldMarker_ptr);
+        } /*if: <Marker is held by the former thread>*/
+    } /*for: <Release the memory of the unfinished migrations>*/
+
+#ifdef DEBUG
+    zajel_ptr->deallocationFunction_ptr(zajel_ptr->debugMemory_ptr);
+#endif /*DEBUG*/
+
+    /*The control block lives inside the released block, so it is the last thing to go*/
+    zajel_ptr->deallocationFunction_ptr(zajel_ptr->memory_ptr);
+
+    /*
+     * Here the original pointer to pointer must be used, to make sure that the passed pointer is
+     * reset, this is done to protect against the accidental use of the pointer after destroying it.
+     */
+    *zajelPointer_ptr = NULL;
+} /*function: zajel_destory*/
+
+void zajel_regsiter_message(zajel_s*                        zajel_ptr,
+                            uint32_t                        messageID,
+                            zajel_message_handler_function  messageHandler_ptr,
+                            char*                           messageName_Ptr COMMA()
+                            FILE_AND_LINE_FOR_TYPE())
+{
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Registering the given message handler for the given message ID.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((messageID < zajel_ptr->messageCount),
+           "zajel: MessageID passed must be less than the total message count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((messageID),
+           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != messageHandler_ptr),
+           "zajel: Message handler cannot be null!",
+           fileName,
+           lineNumber);
+    ASSERT(('\0' != messageName_Ptr[0]),
+           "zajel: Message name cannot be an empty string!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->messageDebugArray[messageID])),
+           "zajel: Message is already registerd!",
+           fileName,
+           lineNumber);
+
+
+    zajel_ptr->messageInformationArray[messageID].messageHandlerFunction    = messageHandler_ptr;
+#ifdef DEBUG
+    zajel_ptr->messageDebugArray[messageID].name_ptr                        = messageName_Ptr;
+    zajel_ptr->messageDebugArray[messageID].isRegistered                    = TRUE;
+#else
+    (void) messageName_Ptr;
+#endif /*DEBUG*/
+} /*function: zajel_register_message*/
+
+void zajel_regsiter_component_handler(zajel_s*                          zajel_ptr,
+                                      uint32_t                          componentID,
+                                      uint32_t                          messageID,
+                                      zajel_component_handler_function  handler_ptr,
+                                      void*                             context_ptr COMMA()
+                                      FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_handler_table_s*          table_ptr;
+    zajel_message_information_s*    entryArray;
+    /*The range of message IDs the table spans once the handler is added*/
+    uint32_t                        firstMessageID;
+    uint32_t                        endMessageID;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating the handler tables of the components, at the first registration.
+     * o Widening the table of the given component to cover the given message ID.
+     * o Registering the given handler and context in the table.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((componentID < zajel_ptr->componentCount),
+           "zajel: ComponentID passed must be less than the total component count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((messageID < zajel_ptr->messageCount),
+           "zajel: MessageID passed must be less than the total message count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((messageID),
+           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != handler_ptr),
+           "zajel: Message handler cannot be null!",
+           fileName,
+           lineNumber);
+
+    if(NULL == zajel_ptr->handlerTableArray_ptr)
+    {
+        /*<First component handler, allocate the (empty) tables of all the components>*/
+        zajel_ptr->handlerTableArray_ptr = (zajel_handler_table_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_handler_table_s) *
+                                                                                                      zajel_ptr->componentCount);
+        ASSERT((NULL != zajel_ptr->handlerTableArray_ptr),
+               "zajel: Failed to allocate a memory for the handler tables!",
+               fileName,
+               lineNumber);
+
+        memset(zajel_ptr->handlerTableArray_ptr,
+               0,
+               sizeof(zajel_handler_table_s) * zajel_ptr->componentCount);
+    } /*if: <First component handler, allocate the (empty) tables of all the components>*/
+
+    table_ptr       = &zajel_ptr->handlerTableArray_ptr[componentID];
+    firstMessageID  = messageID;
+    endMessageID    = messageID + 1;
+
+    if(0 != table_ptr->count)
+    {
+        /*<Table already spans some message IDs, keep them>*/
+        if(table_ptr->firstMessageID < firstMessageID)
+        {
+            firstMessageID = table_ptr->firstMessageID;
+        } /*if: <Table starts before the message ID>*/
+
+        if((table_ptr->firstMessageID + table_ptr->count) > endMessageID)
+        {
+            endMessageID = table_ptr->firstMessageID + table_ptr->count;
+        } /*if: <Table ends after the message ID>*/
+    } /*if: <Table already spans some message IDs, keep them>*/
+
+    if((endMessageID - firstMessageID) != table_ptr->count)
+    {
+        /*<Message ID is out of the table, move it into a wider one>*/
+        entryArray = (zajel_message_information_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_message_information_s) *
+                                                                                      (endMessageID - firstMessageID));
+        ASSERT((NULL != entryArray),
+               "zajel: Failed to allocate a memory for the handler table!",
+               fileName,
+               lineNumber);
+
+        memset(entryArray,
+               0,
+               sizeof(zajel_message_information_s) * (endMessageID - firstMessageID));
+
+        if(NULL != table_ptr->entryArray)
+        {
+            memcpy(&entryArray[table_ptr->firstMessageID - firstMessageID],
+                   table_ptr->entryArray,
+                   sizeof(zajel_message_information_s) * table_ptr->count);
+
+            zajel_ptr->deallocationFunction_ptr(table_ptr->entryArray);
+        } /*if: <Table had some handlers>*/
+
+        table_ptr->entryArray       = entryArray;
+        table_ptr->firstMessageID   = firstMessageID;
+        table_ptr->count            = endMessageID - firstMessageID;
+    } /*if: <Message ID is out of the table, move it into a wider one>*/
+
+    ASSERT((NULL == table_ptr->entryArray[messageID - table_ptr->firstMessageID].componentHandlerFunction),
+           "zajel: Message is already registerd for this component!",
+           fileName,
+           lineNumber);
+
+    table_ptr->entryArray[messageID - table_ptr->firstMessageID].componentHandlerFunction   = handler_ptr;
+    table_ptr->entryArray[messageID - table_ptr->firstMessageID].context_ptr                = context_ptr;
+} /*function: zajel_regsiter_component_handler*/
+
+void zajel_regsiter_unused_messages(zajel_s*    zajel_ptr,
+                                    uint32_t    firstMessageID,
+                                    uint32_t    messageCount COMMA()
+                                    FILE_AND_LINE_FOR_TYPE())
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((firstMessageID),
+           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
+           fileName,
+           lineNumber);
+    ASSERT(((firstMessageID < zajel_ptr->messageCount) &&
+            (messageCount <= (zajel_ptr->messageCount - firstMessageID))),
+           "zajel: The message IDs passed must be less than the total message count used during initialization!",
+           fileName,
+           lineNumber);
+
+    for(i = firstMessageID; i < (firstMessageID + messageCount); ++i)
+    {
+        /*<Give each message the handler catching the unexpected ones>*/
+        ASSERT((NULL == zajel_ptr->messageInformationArray[i].messageHandlerFunction),
+               "zajel: Message is already registerd!",
+               fileName,
+               lineNumber);
+
+        zajel_ptr->messageInformationArray[i].messageHandlerFunction = zajel_message_unused;
+#ifdef DEBUG
+        zajel_ptr->messageDebugArray[i].name_ptr        = "unused";
+        zajel_ptr->messageDebugArray[i].isRegistered    = TRUE;
+#endif /*DEBUG*/
+    } /*for: <Give each message the handler catching the unexpected ones>*/
+} /*function: zajel_regsiter_unused_messages*/
+
+void zajel_regsiter_component(zajel_s*  zajel_ptr,
+                              uint32_t  componentID,
+                              uint32_t  threadID,
+                              char*     componentName_Ptr COMMA()
+                              FILE_AND_LINE_FOR_TYPE())
+{
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Registering the given component for the given ID.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((componentID < zajel_ptr->componentCount),
+           "zajel: componentID passed must be less than the total component count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT(('\0' != componentName_Ptr[0]),
+           "zajel: Component name cannot be an empty string!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadDebugArray[threadID])),
+           "zajel: Thread is not registered!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->componentDebugArray[componentID])),
+           "zajel: Component is already registered!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->componentInformationArray[componentID].parameters.threadID           = threadID;
+    zajel_ptr->componentInformationArray[componentID].parameters.coreID             = ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                                                                               threadID);
+    zajel_ptr->componentInformationArray[componentID].parameters.isMapped           = TRUE;
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+#ifdef DEBUG
+    zajel_ptr->componentDebugArray[componentID].name_ptr                            = componentName_Ptr;
+    zajel_ptr->componentDebugArray[componentID].isRegistered                        = TRUE;
+#else
+    (void) componentName_Ptr;
+#endif /*DEBUG*/
+} /*function: zajel_register_component*/
+
+void zajel_regsiter_thread(zajel_s*                         zajel_ptr,
+                           uint32_t                         threadID,
+                           uint32_t                         coreID,
+                           zajel_handle_message_callback    handleMessageCallback,
+                           zajel_block_callback             blockCallback,
+                           zajel_unblock_callback           unblockCallback,
+                           void*                            synchronizationPrimitive_ptr,
+                           char*                            threadName_Ptr COMMA()
+                           FILE_AND_LINE_FOR_TYPE())
+{
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Registering the given thread for the given ID.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT(('\0' != threadName_Ptr[0]),
+           "zajel: thread name cannot be an empty string!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreDebugArray[coreID])),
+           "zajel: core is not registered!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadDebugArray[threadID])),
+           "zajel: thread is already registered!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != handleMessageCallback),
+           "zajel: handleMessageCallback cannot be NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != blockCallback),
+           "zajel: blockCallback cannot be NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != unblockCallback),
+           "zajel: unblockCallback cannot be NULL!",
+           fileName,
+           lineNumber);
+
+
+    zajel_ptr->threadInformationArray[threadID].coreID                          = coreID;
+    zajel_ptr->threadInformationArray[threadID].handleMessageCallback           = handleMessageCallback;
+    zajel_ptr->threadInformationArray[threadID].blockCallback                   = blockCallback;
+    zajel_ptr->threadInformationArray[threadID].unblockCallback                 = unblockCallback;
+    zajel_ptr->threadInformationArray[threadID].synchronizationPrimitive_ptr    = synchronizationPrimitive_ptr;
+    zajel_ptr->threadInformationArray[threadID].transport                       = ZAJEL_THREAD_TRANSPORT_CALLBACK;
+    zajel_ptr->threadInformationArray[threadID].pollCursor                      = 0;
+    zajel_ptr->threadInformationArray[threadID].mailbox_ptr                     = NULL;
+    zajel_ptr->threadInformationArray[threadID].handleMessageBatchCallback      = NULL;
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+
+#ifdef DEBUG
+    zajel_ptr->threadDebugArray[threadID].name_ptr      = threadName_Ptr;
+    zajel_ptr->threadDebugArray[threadID].isRegistered  = TRUE;
+#else
+    (void) threadName_Ptr;
+#endif /*DEBUG*/
+} /*function: zajel_register_thread*/
+
+void zajel_regsiter_thread_mailbox(zajel_s*         zajel_ptr,
+                                   uint32_t         threadID,
+                                   uint32_t         coreID,
+                                   zajel_mailbox_s* mailbox_ptr,
+                                   char*            threadName_Ptr COMMA()
+                                   FILE_AND_LINE_FOR_TYPE())
+{
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Registering the given thread for the given ID, with the mailbox as its inbound queue and the
+     *   ready-made mailbox callbacks for the synchronous messages.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT(('\0' != threadName_Ptr[0]),
+           "zajel: thread name cannot be an empty string!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreDebugArray[coreID])),
+           "zajel: core is not registered!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadDebugArray[threadID])),
+           "zajel: thread is already registered!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != mailbox_ptr),
+           "zajel: mailbox_ptr cannot be NULL!",
+           fileName,
+           lineNumber);
+
+    zajel_mailbox_init(mailbox_ptr);
+
+    zajel_ptr->threadInformationArray[threadID].coreID                          = coreID;
+    zajel_ptr->threadInformationArray[threadID].handleMessageCallback           = NULL;
+    zajel_ptr->threadInformationArray[threadID].blockCallback                   = zajel_mailbox_block;
+    zajel_ptr->threadInformationArray[threadID].unblockCallback                 = zajel_mailbox_unblock;
+    zajel_ptr->threadInformationArray[threadID].synchronizationPrimitive_ptr    = mailbox_ptr;
+    zajel_ptr->threadInformationArray[threadID].transport                       = ZAJEL_THREAD_TRANSPORT_MAILBOX;
+    zajel_ptr->threadInformationArray[threadID].pollCursor                      = 0;
+    zajel_ptr->threadInformationArray[threadID].mailbox_ptr                     = mailbox_ptr;
+    zajel_ptr->threadInformationArray[threadID].handleMessageBatchCallback      = NULL;
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+
+#ifdef DEBUG
+    zajel_ptr->threadDebugArray[threadID].name_ptr      = threadName_Ptr;
+    zajel_ptr->threadDebugArray[threadID].isRegistered  = TRUE;
+#else
+    (void) threadName_Ptr;
+#endif /*DEBUG*/
+} /*function: zajel_regsiter_thread_mailbox*/
+
+void zajel_regsiter_core(zajel_s*                           zajel_ptr,
+                         uint32_t                           coreID,
+                         zajel_core_handle_message_callback handleMessageCallback,
+                         char*                              coreName_Ptr COMMA()
+                         FILE_AND_LINE_FOR_TYPE())
+{
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Registering the given core for the given ID.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((coreID < zajel_ptr->coreCount),
+           "zajel: coreID passed must be less than the total core count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT(('\0' != coreName_Ptr[0]),
+           "zajel: Core name cannot be an empty string!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreDebugArray[coreID])),
+           "zajel: Core is already registered!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != handleMessageCallback),
+           "zajel: handleMessageCallback cannot be NULL!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->coreInformationArray[coreID].handleMessageCallback       = handleMessageCallback;
+    zajel_ptr->coreInformationArray[coreID].handleMessageBatchCallback  = NULL;
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+
+
+#ifdef DEBUG
+    zajel_ptr->coreDebugArray[coreID].name_ptr          = coreName_Ptr;
+    zajel_ptr->coreDebugArray[coreID].isRegistered      = TRUE;
+#else
+    (void) coreName_Ptr;
+#endif /*DEBUG*/
+} /*function: zajel_register_core*/
+
+void zajel_set_inbound_capacity(zajel_s*    zajel_ptr,
+                                uint32_t    threadID,
+                                uint32_t    capacity COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadDebugArray[threadID])),
+           "zajel: Thread is not registered!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->threadInformationArray[threadID].inboundCapacity = capacity;
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+} /*function: zajel_set_inbound_capacity*/
+
+void zajel_regsiter_thread_batch_callback(zajel_s*                              zajel_ptr,
+                                          uint32_t                              threadID,
+                                          zajel_handle_message_batch_callback   handleMessageBatchCallback COMMA()
+                                          FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadDebugArray[threadID])),
+           "zajel: Thread is not registered!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != handleMessageBatchCallback),
+           "zajel: handleMessageBatchCallback cannot be NULL!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->threadInformationArray[threadID].handleMessageBatchCallback = handleMessageBatchCallback;
+} /*function: zajel_regsiter_thread_batch_callback*/
+
+void zajel_regsiter_core_batch_callback(zajel_s*                                    zajel_ptr,
+                                        uint32_t                                    coreID,
+                                        zajel_core_handle_message_batch_callback    handleMessageBatchCallback COMMA()
+                                        FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((coreID < zajel_ptr->coreCount),
+           "zajel: coreID passed must be less than the total core count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreDebugArray[coreID])),
+           "zajel: Core is not registered!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != handleMessageBatchCallback),
+           "zajel: handleMessageBatchCallback cannot be NULL!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->coreInformationArray[coreID].handleMessageBatchCallback = handleMessageBatchCallback;
+} /*function: zajel_regsiter_core_batch_callback*/
+
+void zajel_enable_ring_transport(zajel_s*   zajel_ptr,
+                                 uint32_t   ringCapacity COMMA()
+                                 FILE_AND_LINE_FOR_TYPE())
+{
+    /*Size of the rings array, rounded up to keep the slots cache aligned*/
+    uintptr_t   ringsSize;
+    /*Size of the slots of a single ring*/
+    uintptr_t   slotsSize;
+    /*Size of the slots of all the rings leading to a consumer, and their alignment*/
+    uintptr_t   inboundSize;
+    uintptr_t   granule;
+    /*Start of the cache aligned area inside the allocated block*/
+    uintptr_t   alignedBase;
+    /*Points to the slots of the rings leading to the first consumer*/
+    void**      slots_ptr;
+    /*Temporary counter*/
+    uint32_t    i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating a ring for every ordered pair of threads (including a thread and itself, which is
+     *   used for the asynchronous messages between components of the same thread), the slots of the
+     *   rings leading to a consumer being contiguous, and placed on the node of the consumer.
+     * o Switching all the registered threads to the ring transport.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->ringArray_ptr),
+           "zajel: Ring transport is already enabled!",
+           fileName,
+           lineNumber);
+    ASSERT(((ringCapacity > 1) && (0 == (ringCapacity & (ringCapacity - 1)))),
+           "zajel: Ring capacity must be a power of two greater than one!",
+           fileName,
+           lineNumber);
+
+    slotsSize   = ZAJEL_CACHE_ALIGN_UP(sizeof(void*) * ringCapacity);
+    granule     = zajel_placement_granule(zajel_ptr,
+                                          slotsSize * zajel_ptr->threadCount);
+    inboundSize = ZAJEL_NUMA_ALIGN_UP(slotsSize * zajel_ptr->threadCount, granule);
+    ringsSize   = ZAJEL_NUMA_ALIGN_UP(ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_ring_s) * zajel_ptr->threadCount * zajel_ptr->threadCount),
+                                      granule);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->ringMemory_ptr = zajel_placement_alloc(zajel_ptr,
+                                                      ZAJEL_CACHE_LINE_SIZE +
+                                                      ringsSize +
+                                                      (inboundSize * zajel_ptr->threadCount),
+                                                      granule);
+    ASSERT((NULL != zajel_ptr->ringMemory_ptr),
+           "zajel: Failed to allocate a memory for the rings!",
+           fileName,
+           lineNumber);
+
+    alignedBase                 = ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->ringMemory_ptr);
+    zajel_ptr->ringArray_ptr    = (zajel_ring_s*) alignedBase;
+    slots_ptr                   = (void**) (alignedBase + ringsSize);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Place the slots of the rings leading to each consumer, before they are touched>*/
+        zajel_placement_bind(zajel_ptr,
+                             zajel_ptr->ringMemory_ptr,
+                             (void*) ((uintptr_t)slots_ptr + (i * inboundSize)),
+                             inboundSize,
+                             i);
+    } /*for: <Place the slots of the rings leading to each consumer, before they are touched>*/
+
+    for(i = 0; i < (zajel_ptr->threadCount * zajel_ptr->threadCount); ++i)
+    {
+        /*<Initialize all the rings, ring i leads from thread (i / threadCount) to thread (i % threadCount)>*/
+        zajel_ring_init(&zajel_ptr->ringArray_ptr[i],
+                        (void**) ((uintptr_t)slots_ptr +
+                                  ((i % zajel_ptr->threadCount) * inboundSize) +
+                                  ((i / zajel_ptr->threadCount) * slotsSize)),
+                        ringCapacity);
+    } /*for: <Initialize all the rings, ring i leads from thread (i / threadCount) to thread (i % threadCount)>*/
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Switch the threads to the ring transport, threads having a mailbox keep using it>*/
+        if(ZAJEL_THREAD_TRANSPORT_MAILBOX != zajel_ptr->threadInformationArray[i].transport)
+        {
+            zajel_ptr->threadInformationArray[i].transport  = ZAJEL_THREAD_TRANSPORT_RING;
+            zajel_ptr->threadInformationArray[i].pollCursor = 0;
+        } /*if: <Thread is not using a mailbox>*/
+    } /*for: <Switch the threads to the ring transport, threads having a mailbox keep using it>*/
+
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+} /*function: zajel_enable_ring_transport*/
+
+zajel_status_e zajel_migrate_component(zajel_s*   zajel_ptr,
+                                       uint32_t   componentID,
+                                       uint32_t   newThreadID,
+                                       uint32_t   callerThreadID COMMA()
+                                       FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_component_information_u*      component_ptr;
+    zajel_component_information_u       component;
+    zajel_migration_s*                  migration_ptr;
+    zajel_route_table_s*                oldTable_ptr;
+    zajel_route_s*                      route_ptr;
+    zajel_linked_message_descriptor_s*  marker_ptr;
+    /*Expected lock value*/
+    uint32_t                            unlocked;
+    uint32_t                            oldThreadID;
+    uint32_t                            sendCount;
+    uint32_t                            priority;
+    /*Number of markers sent, one per queue of the former thread*/
+    uint32_t                            markerCount;
+    /*Temporary counters*/
+    uint32_t                            i;
+    uint32_t                            producerThreadID;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Publishing the new component handle, then the new routes.
+     * o Recording the threads which may still be sending along the old route.
+     * o Sending the marker along the old route, behind the messages already queued on the former
+     *   thread, and one more behind those queued on each of its priority lanes.
+     * o Freeing the routes tables no longer used.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == zajel_ptr->isSealed),
+           "zajel: Components can only be migrated once the topology is sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((componentID < zajel_ptr->componentCount),
+           "zajel: Component ID is greater than the supported component count!",
+           fileName,
+           lineNumber);
+    ASSERT(((newThreadID < zajel_ptr->threadCount) && (callerThreadID < zajel_ptr->threadCount)),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+
+    component_ptr = &zajel_ptr->componentInformationArray[componentID];
+    oldThreadID   = component_ptr->parameters.threadID;
+
+    ASSERT(((NULL == zajel_ptr->actorArray_ptr) || (NULL == zajel_ptr->actorArray_ptr[componentID])),
+           "zajel: Actors are run by all the threads of their core, they cannot be migrated!",
+           fileName,
+           lineNumber);
+
+    ASSERT(((NULL == zajel_ptr->shm_ptr) ||
+            (component_ptr->parameters.coreID == ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                                          newThreadID))),
+           "zajel: With the shm transport, a component can only be migrated within its core!",
+           fileName,
+           lineNumber);
+
+    if(oldThreadID == newThreadID)
+    {
+        return ZAJEL_STATUS_SUCCESS;
+    } /*if: <Component already runs on the new thread>*/
+
+    unlocked = FALSE;
+
+    while(FALSE == ZAJEL_ATOMIC_CAS(&zajel_ptr->migrationLock,
+                                    &unlocked,
+                                    TRUE))
+    {
+        /*<Another migration is being published>*/
+        unlocked = FALSE;
+        ZAJEL_CPU_RELAX();
+    } /*while: <Another migration is being published>*/
+
+    for(i = 0; (i < ZAJEL_MIGRATION_SLOT_COUNT) && (FALSE != ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->migrationArray[i].isUsed)); ++i)
+    {
+    } /*for: <Find a free migration slot>*/
+
+    if((i == ZAJEL_MIGRATION_SLOT_COUNT) ||
+       (0 != component_ptr->parameters.migrationSlot))
+    {
+        /*<The previous migration of the component (or too many migrations) are still in progress>*/
+        ZAJEL_ATOMIC_STORE_RELEASE(&zajel_ptr->migrationLock, FALSE);
+
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <The previous migration of the component (or too many migrations) are still in progress>*/
+
+    marker_ptr = (zajel_linked_message_descriptor_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_linked_message_descriptor_s));
+    ASSERT((NULL != marker_ptr),
+           "zajel: Failed to allocate a migration marker!",
+           fileName,
+           lineNumber);
+
+    migration_ptr                       = &zajel_ptr->migrationArray[i];
+    migration_ptr->isUsed               = TRUE;
+    migration_ptr->fromThreadID         = oldThreadID;
+    migration_ptr->toThreadID           = newThreadID;
+    migration_ptr->drainHeadArray       = NULL;
+    migration_ptr->heldMarker_ptr       = NULL;
+    migration_ptr->sendCountArray       = NULL;
+    migration_ptr->requeuedMask         = 0;
+    migration_ptr->pending_ptr_array    = NULL;
+    migration_ptr->pendingCount         = 0;
+    migration_ptr->pendingCapacity      = 0;
+    markerCount                         = 1;
+
+    if((NULL != zajel_ptr->laneArray_ptr) &&
+       (ZAJEL_THREAD_TRANSPORT_CALLBACK != zajel_ptr->threadInformationArray[oldThreadID].transport))
+    {
+        markerCount = ZAJEL_PRIORITY_COUNT;
+    } /*if: <The former thread may have messages queued on its priority lanes>*/
+
+    migration_ptr->markerCount          = markerCount;
+
+    if(ZAJEL_THREAD_TRANSPORT_RING == zajel_ptr->threadInformationArray[oldThreadID].transport)
+    {
+        /*<The former thread has a ring per producer, the marker only follows the messages of one of them>*/
+        migration_ptr->drainHeadArray = (uint32_t*) zajel_ptr->allocationFunction_ptr(sizeof(uint32_t) *
+                                                                                      zajel_ptr->threadCount);
+        ASSERT((NULL != migration_ptr->drainHeadArray),
+               "zajel: Failed to allocate a memory for the migration!",
+               fileName,
+               lineNumber);
+    } /*if: <The former thread has a ring per producer, the marker only follows the messages of one of them>*/
+
+    /*The old route to the component, from the calling thread, stays valid until the marker is sent*/
+    oldTable_ptr                        = zajel_ptr->routeTable_ptr;
+    route_ptr                           = ZAJEL_ROUTE(oldTable_ptr,
+                                                      callerThreadID,
+                                                      componentID);
+
+    /*The whole handle is published at once, a reader sees either the old or the new mapping*/
+    component.handle                    = component_ptr->handle;
+    component.parameters.threadID       = (uint8_t) newThreadID;
+    component.parameters.coreID         = (uint8_t) ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                                             newThreadID);
+    component.parameters.migrationSlot  = (uint8_t)(i + 1);
+    ZAJEL_ATOMIC_STORE_RELEASE(&component_ptr->handle, component.handle);
+
+    zajel_routes_publish(zajel_ptr);
+
+    /*
+     * A thread which read the old mapping just before it was replaced may still be handing a message
+     * over to the former thread, behind the marker. Record the threads in the middle of a send, the
+     * former thread holds the marker until they are done (see zajel_migration_handle).
+     */
+    ZAJEL_ATOMIC_FENCE();
+
+    for(producerThreadID = 0; producerThreadID < zajel_ptr->threadCount; ++producerThreadID)
+    {
+        /*<Check each other thread>*/
+        sendCount = ZAJEL_ATOMIC_LOAD_RELAXED(&zajel_ptr->threadInformationArray[producerThreadID].sendCount);
+
+        if((0 == (sendCount & 1)) ||
+           (producerThreadID == callerThreadID))
+        {
+            continue;
+        } /*if: <Thread is not sending, or it is the calling thread (sending from a handler)>*/
+
+        if(NULL == migration_ptr->sendCountArray)
+        {
+            migration_ptr->sendCountArray = (uint32_t*) zajel_ptr->allocationFunction_ptr(sizeof(uint32_t) *
+                                                                                          zajel_ptr->threadCount);
+            ASSERT((NULL != migration_ptr->sendCountArray),
+                   "zajel: Failed to allocate a memory for the migration!",
+                   fileName,
+                   lineNumber);
+            memset(migration_ptr->sendCountArray,
+                   0,
+                   sizeof(uint32_t) * zajel_ptr->threadCount);
+        } /*if: <First thread found sending>*/
+
+        migration_ptr->sendCountArray[producerThreadID] = sendCount;
+    } /*for: <Check each other thread>*/
+
+    if(NULL != migration_ptr->drainHeadArray)
+    {
+        /*<Record how far the rings of the former thread were filled, once the new routes are out>*/
+        for(producerThreadID = 0; producerThreadID < zajel_ptr->threadCount; ++producerThreadID)
+        {
+            migration_ptr->drainHeadArray[producerThreadID] = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ZAJEL_THREAD_RING(zajel_ptr,
+                                                                                                           producerThreadID,
+                                                                                                           oldThreadID)->head);
+        } /*for: <Record the head of each ring>*/
+    } /*if: <Record how far the rings of the former thread were filled, once the new routes are out>*/
+
+    marker_ptr->descriptor.messageID                = ZAJEL_ACK_MESSAGE_ID;
+    marker_ptr->descriptor.sourceComponentID        = componentID;
+    marker_ptr->descriptor.destinationComponentID   = componentID;
+    marker_ptr->descriptor.isSynchronous            = FALSE;
+    marker_ptr->descriptor.flags                    = ZAJEL_MESSAGE_FLAG_MIGRATION |
+                                                      ZAJEL_MESSAGE_FLAG_PRIORITY(ZAJEL_PRIORITY_NORMAL);
+    marker_ptr->next_ptr                            = NULL;
+
+    route_ptr->deliverFunction(route_ptr->context_ptr,
+                               &marker_ptr->descriptor);
+
+    for(priority = 0; (markerCount > 1) && (priority < ZAJEL_PRIORITY_COUNT); ++priority)
+    {
+        /*<Send a marker behind each priority lane of the former thread>*/
+        if(ZAJEL_PRIORITY_NORMAL == priority)
+        {
+            continue;
+        } /*if: <Already sent through the thread transport>*/
+
+        marker_ptr = (zajel_linked_message_descriptor_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_linked_message_descriptor_s));
+        ASSERT((NULL != marker_ptr),
+               "zajel: Failed to allocate a migration marker!",
+               fileName,
+               lineNumber);
+
+        marker_ptr->descriptor.messageID                = ZAJEL_ACK_MESSAGE_ID;
+        marker_ptr->descriptor.sourceComponentID        = componentID;
+        marker_ptr->descriptor.destinationComponentID   = componentID;
+        marker_ptr->descriptor.isSynchronous            = FALSE;
+        marker_ptr->descriptor.flags                    = ZAJEL_MESSAGE_FLAG_MIGRATION |
+                                                          ZAJEL_MESSAGE_FLAG_PRIORITY(priority);
+        marker_ptr->next_ptr                            = NULL;
+
+        zajel_lane_push(&zajel_ptr->laneArray_ptr[oldThreadID],
+                        priority,
+                        &marker_ptr->descriptor);
+    } /*for: <Send a marker behind each priority lane of the former thread>*/
+
+    zajel_routes_reclaim(zajel_ptr);
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&zajel_ptr->migrationLock, FALSE);
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_migrate_component*/
+
+void zajel_enable_load_balancer(zajel_s*                zajel_ptr,
+                                zajel_balance_policy    policy,
+                                void*                   context_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    /*Size of the counters and of the components loads, rounded up to keep the next array aligned*/
+    uintptr_t   countersSize;
+    uintptr_t   loadsSize;
+    /*Start of the cache aligned area inside the allocated block*/
+    uintptr_t   alignedBase;
+    /*Temporary counter*/
+    uint32_t    i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating the counters of every component (each on its own cache line) and the loads handed
+     *   to the policy.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->balanceCounterArray_ptr),
+           "zajel: Load balancer is already enabled!",
+           fileName,
+           lineNumber);
+
+    countersSize    = sizeof(zajel_balance_counters_s) * zajel_ptr->componentCount;
+    loadsSize       = ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_component_load_s) * zajel_ptr->componentCount);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->balanceMemory_ptr = zajel_ptr->allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                                     countersSize +
+                                                                     loadsSize +
+                                                                     ((sizeof(uint64_t) + sizeof(uint32_t)) * zajel_ptr->threadCount));
+    ASSERT((NULL != zajel_ptr->balanceMemory_ptr),
+           "zajel: Failed to allocate a memory for the load balancer!",
+           fileName,
+           lineNumber);
+
+    alignedBase                         = ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->balanceMemory_ptr);
+    zajel_ptr->componentLoadArray_ptr   = (zajel_component_load_s*) (alignedBase + countersSize);
+    zajel_ptr->threadLoadArray_ptr      = (uint64_t*) (alignedBase + countersSize + loadsSize);
+    zajel_ptr->threadCoreArray_ptr      = (uint32_t*) (zajel_ptr->threadLoadArray_ptr + zajel_ptr->threadCount);
+    zajel_ptr->balancePolicy            = (NULL != policy) ? (policy) : (zajel_balance_policy_default);
+    zajel_ptr->balanceContext_ptr       = context_ptr;
+
+    memset((void*)alignedBase,
+           0,
+           countersSize + loadsSize);
+
+    for(i = 0; i < zajel_ptr->componentCount; ++i)
+    {
+        /*<No component was moved yet>*/
+        zajel_ptr->componentLoadArray_ptr[i].idleRounds = UINT32_MAX;
+    } /*for: <No component was moved yet>*/
+
+    /*Published last, the handlers start counting from here*/
+    zajel_ptr->balanceCounterArray_ptr = (zajel_balance_counters_s*) alignedBase;
+} /*function: zajel_enable_load_balancer*/
+
+uint32_t zajel_balance(zajel_s*     zajel_ptr,
+                       uint32_t     callerThreadID COMMA()
+                       FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_balance_counters_s*       counters_ptr;
+    zajel_component_load_s*         load_ptr;
+    zajel_component_information_u   component;
+    zajel_balance_view_s            view;
+    zajel_balance_move_s            moveArray[ZAJEL_BALANCE_MAX_MOVE_COUNT];
+    uint64_t                        messageCount;
+    uint64_t                        handlerTime;
+    uint32_t                        moveCount;
+    uint32_t                        movedCount;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        j;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Turning the counters into the loads since the previous round, per component and per thread.
+     * o Asking the policy for the moves, then migrating the components.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->balanceCounterArray_ptr),
+           "zajel: Load balancer is not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == zajel_ptr->isSealed),
+           "zajel: Components can only be balanced once the topology is sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((callerThreadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        zajel_ptr->threadLoadArray_ptr[i] = 0;
+        zajel_ptr->threadCoreArray_ptr[i] = zajel_ptr->threadInformationArray[i].coreID;
+    } /*for: <Reset the load of every thread>*/
+
+    for(i = 0; i < zajel_ptr->componentCount; ++i)
+    {
+        /*<Gather the load of each registered component since the previous round>*/
+        component.handle = ZAJEL_ATOMIC_LOAD_RELAXED(&zajel_ptr->componentInformationArray[i].handle);
+
+        if((FALSE == component.parameters.isMapped) ||
+           ((NULL != zajel_ptr->actorArray_ptr) && (NULL != zajel_ptr->actorArray_ptr[i])))
+        {
+            continue;
+        } /*if: <Component is not registered, or is an actor (it is not bound to a thread)>*/
+
+        counters_ptr    = &zajel_ptr->balanceCounterArray_ptr[i];
+        load_ptr        = &zajel_ptr->componentLoadArray_ptr[i];
+        messageCount    = ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->messageCount);
+        handlerTime     = ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->handlerTime);
+
+        load_ptr->messageCount              = messageCount - counters_ptr->balancedMessageCount;
+        load_ptr->handlerTime               = handlerTime - counters_ptr->balancedHandlerTime;
+        load_ptr->threadID                  = component.parameters.threadID;
+        counters_ptr->balancedMessageCount  = messageCount;
+        counters_ptr->balancedHandlerTime   = handlerTime;
+
+        for(j = 0; j < ZAJEL_BALANCE_PEER_COUNT; ++j)
+        {
+            load_ptr->peerArray[j].componentID  = ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->peerArray[j].componentID);
+            load_ptr->peerArray[j].messageCount = ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->peerArray[j].messageCount);
+        } /*for: <Copy the sketch of the sources>*/
+
+        if(UINT32_MAX != load_ptr->idleRounds)
+        {
+            ++load_ptr->idleRounds;
+        } /*if: <Component was moved at some point>*/
+
+        zajel_ptr->threadLoadArray_ptr[load_ptr->threadID] += load_ptr->handlerTime;
+    } /*for: <Gather the load of each registered component since the previous round>*/
+
+    view.componentLoadArray = zajel_ptr->componentLoadArray_ptr;
+    view.componentCount     = zajel_ptr->componentCount;
+    view.threadLoadArray    = zajel_ptr->threadLoadArray_ptr;
+    view.threadCoreArray    = zajel_ptr->threadCoreArray_ptr;
+    view.threadCount        = zajel_ptr->threadCount;
+    view.isCoreBound        = (NULL != zajel_ptr->shm_ptr) ? (TRUE) : (FALSE);
+
+    moveCount   = zajel_ptr->balancePolicy(zajel_ptr->balanceContext_ptr,
+                                           &view,
+                                           moveArray,
+                                           ZAJEL_BALANCE_MAX_MOVE_COUNT);
+    movedCount  = 0;
+
+    ASSERT((moveCount <= ZAJEL_BALANCE_MAX_MOVE_COUNT),
+           "zajel: Balancing policy returned too many moves!",
+           fileName,
+           lineNumber);
+
+    for(i = 0; i < moveCount; ++i)
+    {
+        /*<Migrate the components chosen by the policy>*/
+        ASSERT(((moveArray[i].componentID < zajel_ptr->componentCount) &&
+                (moveArray[i].threadID < zajel_ptr->threadCount)),
+               "zajel: Balancing policy returned an invalid move!",
+               fileName,
+               lineNumber);
+
+        load_ptr = &zajel_ptr->componentLoadArray_ptr[moveArray[i].componentID];
+
+        if((load_ptr->threadID != moveArray[i].threadID) &&
+           (ZAJEL_STATUS_SUCCESS == zajel_migrate_component(zajel_ptr,
+                                                            moveArray[i].componentID,
+                                                            moveArray[i].threadID,
+                                                            callerThreadID COMMA()
+                                                            FILE_AND_LINE_FOR_CALL())))
+        {
+            load_ptr->idleRounds = 0;
+            ++movedCount;
+        } /*if: <Component moved>*/
+    } /*for: <Migrate the components chosen by the policy>*/
+
+    return movedCount;
+} /*function: zajel_balance*/
+
+void zajel_enable_work_stealing(zajel_s* zajel_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    /*Size of the run queues, rounded up to keep the actors array aligned*/
+    uintptr_t   queuesSize;
+    /*Start of the cache aligned area inside the allocated block*/
+    uintptr_t   alignedBase;
+    /*Temporary counter*/
+    uint32_t    i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating a run queue per thread (each on its own cache line), and the actors array.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->actorArray_ptr),
+           "zajel: Work stealing is already enabled!",
+           fileName,
+           lineNumber);
+
+    queuesSize = ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_actor_queue_s) * zajel_ptr->threadCount);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->actorMemory_ptr = zajel_ptr->allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                                   queuesSize +
+                                                                   (sizeof(zajel_actor_s*) * zajel_ptr->componentCount));
+    ASSERT((NULL != zajel_ptr->actorMemory_ptr),
+           "zajel: Failed to allocate a memory for the run queues!",
+           fileName,
+           lineNumber);
+
+    alignedBase                     = ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->actorMemory_ptr);
+    zajel_ptr->actorQueueArray_ptr  = (zajel_actor_queue_s*) alignedBase;
+    zajel_ptr->actorArray_ptr       = (zajel_actor_s**) (alignedBase + queuesSize);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        zajel_actor_queue_init(&zajel_ptr->actorQueueArray_ptr[i]);
+    } /*for: <Initialize the run queue of each thread>*/
+
+    for(i = 0; i < zajel_ptr->componentCount; ++i)
+    {
+        zajel_ptr->actorArray_ptr[i] = NULL;
+    } /*for: <No component is an actor yet>*/
+} /*function: zajel_enable_work_stealing*/
+
+void zajel_regsiter_actor(zajel_s*  zajel_ptr,
+                          uint32_t  componentID COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_thread_information_s* thread_ptr;
+    zajel_actor_s*              actor_ptr;
+    void*                       memory_ptr;
+    uint32_t                    threadID;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating the actor, queued on the run queue of the component thread.
+     * o Making the routes to the component lead to the actor mailbox.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->actorArray_ptr),
+           "zajel: Work stealing is not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((componentID < zajel_ptr->componentCount),
+           "zajel: Component ID is greater than the supported component count!",
+           fileName,
+           lineNumber);
+    ASSERT((TRUE == zajel_ptr->componentInformationArray[componentID].parameters.isMapped),
+           "zajel: The component shall be registered before becoming an actor!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->actorArray_ptr[componentID]),
+           "zajel: The component is already an actor!",
+           fileName,
+           lineNumber);
+
+    threadID    = ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                componentID);
+    thread_ptr  = &zajel_ptr->threadInformationArray[threadID];
+
+    ASSERT((ZAJEL_THREAD_TRANSPORT_CALLBACK != thread_ptr->transport),
+           "zajel: Actors shall be hosted by threads using the ring or the mailbox transport!",
+           fileName,
+           lineNumber);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    memory_ptr = zajel_ptr->allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                   sizeof(zajel_actor_s));
+    ASSERT((NULL != memory_ptr),
+           "zajel: Failed to allocate a memory for the actor!",
+           fileName,
+           lineNumber);
+
+    actor_ptr = (zajel_actor_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)memory_ptr);
+
+    zajel_actor_init(actor_ptr,
+                     componentID,
+                     &zajel_ptr->actorQueueArray_ptr[threadID],
+                     (ZAJEL_THREAD_TRANSPORT_MAILBOX == thread_ptr->transport) ?
+                     (thread_ptr->mailbox_ptr) :
+                     (NULL),
+                     memory_ptr);
+
+    zajel_ptr->actorArray_ptr[componentID] = actor_ptr;
+
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+} /*function: zajel_regsiter_actor*/
+
+void zajel_enable_priority_lanes(zajel_s*           zajel_ptr,
+                                 const uint32_t*    weightArray COMMA()
+                                 FILE_AND_LINE_FOR_TYPE())
+{
+    /*Size of the lanes, rounded up to keep the priorities array aligned*/
+    uintptr_t   lanesSize;
+    /*Start of the cache aligned area inside the allocated block*/
+    uintptr_t   alignedBase;
+    /*Temporary counters*/
+    uint32_t    i;
+    uint32_t    priority;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating the lanes of every thread (each lane on its own cache lines), and the priority of
+     *   every message.
+     * o Recording how the lanes share the collected batches.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->laneArray_ptr),
+           "zajel: Priority lanes are already enabled!",
+           fileName,
+           lineNumber);
+
+    lanesSize = ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_lanes_s) * zajel_ptr->threadCount);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->laneMemory_ptr = zajel_ptr->allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                                  lanesSize +
+                                                                  (sizeof(uint8_t) * zajel_ptr->messageCount));
+    ASSERT((NULL != zajel_ptr->laneMemory_ptr),
+           "zajel: Failed to allocate a memory for the priority lanes!",
+           fileName,
+           lineNumber);
+
+    alignedBase                         = ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->laneMemory_ptr);
+    zajel_ptr->laneArray_ptr            = (zajel_lanes_s*) alignedBase;
+    zajel_ptr->messagePriorityArray     = (uint8_t*) (alignedBase + lanesSize);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Initialize the lanes of each thread>*/
+        for(priority = 0; priority < ZAJEL_PRIORITY_COUNT; ++priority)
+        {
+            zajel_mailbox_init(&zajel_ptr->laneArray_ptr[i].laneArray[priority]);
+        } /*for: <Initialize each lane>*/
+
+        zajel_ptr->laneArray_ptr[i].thread_ptr = &zajel_ptr->threadInformationArray[i];
+    } /*for: <Initialize the lanes of each thread>*/
+
+    for(i = 0; i < zajel_ptr->messageCount; ++i)
+    {
+        zajel_ptr->messagePriorityArray[i] = ZAJEL_PRIORITY_NORMAL;
+    } /*for: <Every message is of normal priority until told otherwise>*/
+
+    zajel_ptr->isLaneWeighted = (NULL != weightArray);
+
+    for(priority = 0; priority < ZAJEL_PRIORITY_COUNT; ++priority)
+    {
+        zajel_ptr->laneWeightArray[priority] = (NULL != weightArray) ? (weightArray[priority]) : (0);
+    } /*for: <Record the share of each lane>*/
+
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+} /*function: zajel_enable_priority_lanes*/
+
+void zajel_regsiter_message_priority(zajel_s*   zajel_ptr,
+                                     uint32_t   messageID,
+                                     uint32_t   priority COMMA()
+                                     FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->laneArray_ptr),
+           "zajel: Priority lanes are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((messageID < zajel_ptr->messageCount),
+           "zajel: MessageID passed must be less than the total message count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((priority < ZAJEL_PRIORITY_COUNT),
+           "zajel: Invalid message priority!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->messagePriorityArray[messageID] = (uint8_t) priority;
+} /*function: zajel_regsiter_message_priority*/
+
+void zajel_send(zajel_s*    zajel_ptr,
+                void*       message_ptr COMMA()
+                FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_send_message(zajel_ptr,
+                       message_ptr,
+                       ZAJEL_MESSAGE_FLAG_NONE COMMA()
+                       FILE_AND_LINE_FOR_CALL());
+} /*function: zajel_send*/
+
+void zajel_send_fast(zajel_s*   zajel_ptr,
+                     void*      message_ptr)
+{
+#ifdef DEBUG
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           __FILE__,
+           __LINE__);
+    ASSERT((TRUE == zajel_ptr->isSealed),
+           "zajel: zajel_send_fast can only be used once the topology is sealed!",
+           __FILE__,
+           __LINE__);
+
+    zajel_send(zajel_ptr,
+               message_ptr COMMA()
+               FILE_AND_LINE_FOR_REF());
+#else
+    zajel_message_descriptor_s* descriptor_ptr;
+    uint32_t                    sourceThreadID;
+    bool_t                      isOutermost;
+
+    descriptor_ptr          = (zajel_message_descriptor_s*) message_ptr;
+    descriptor_ptr->flags  &= ZAJEL_MESSAGE_FLAG_SENDER_MASK;
+    sourceThreadID          = ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                            descriptor_ptr->sourceComponentID);
+    isOutermost             = zajel_send_begin(zajel_ptr,
+                                               sourceThreadID);
+
+    /*The topology is sealed, so the routes are known to be valid*/
+    zajel_send_route(zajel_ptr,
+                     descriptor_ptr,
+                     zajel_route_lookup(zajel_ptr,
+                                        sourceThreadID,
+                                        descriptor_ptr->destinationComponentID),
+                     sourceThreadID,
+                     isOutermost);
+#endif /*DEBUG*/
+} /*function: zajel_send_fast*/
+
+zajel_status_e zajel_try_send(zajel_s*  zajel_ptr,
+                              void*     message_ptr COMMA()
+                              FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_message_descriptor_s*         descriptor_ptr;
+    zajel_route_s*                      route_ptr;
+    zajel_status_e                      status;
+    uint32_t                            sourceThreadID;
+    bool_t                              isOutermost;
+
+    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Checking the room left along the route, once the route cannot change anymore.
+     * o Handing the message over like zajel_send, or giving up without side effects.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT(((descriptor_ptr->messageID < zajel_ptr->messageCount) && (descriptor_ptr->messageID)),
+           "zajel: Message ID is either reserved or greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((descriptor_ptr->sourceComponentID < zajel_ptr->componentCount) &&
+            (descriptor_ptr->destinationComponentID < zajel_ptr->componentCount)),
+           "zajel: Component ID is greater than the supported component count!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == descriptor_ptr->isSynchronous),
+           "zajel: Synchronous messages cannot be tried, they are sent using zajel_send!",
+           fileName,
+           lineNumber);
+
+    descriptor_ptr->flags  &= ZAJEL_MESSAGE_FLAG_SENDER_MASK;
+    sourceThreadID          = ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                            descriptor_ptr->sourceComponentID);
+    isOutermost             = zajel_send_begin(zajel_ptr,
+                                               sourceThreadID);
+    route_ptr               = zajel_route_get(zajel_ptr,
+                                              sourceThreadID,
+                                              descriptor_ptr->destinationComponentID);
+
+    if((ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES == route_ptr->relation) &&
+       (NULL != zajel_ptr->shm_ptr))
+    {
+        /*<Shared region carries the message, it goes as long as a credit is left>*/
+        status = (TRUE == zajel_shm_try_push(route_ptr->context_ptr,
+                                             descriptor_ptr)) ?
+                 (ZAJEL_STATUS_SUCCESS) :
+                 (ZAJEL_STATUS_WOULD_BLOCK);
+
+        zajel_send_end(zajel_ptr,
+                       sourceThreadID,
+                       isOutermost);
+
+        return status;
+    } /*if: <Shared region carries the message, it goes as long as a credit is left>*/
+
+    if(TRUE == zajel_route_is_full(zajel_ptr,
+                                   route_ptr,
+                                   descriptor_ptr))
+    {
+        zajel_send_end(zajel_ptr,
+                       sourceThreadID,
+                       isOutermost);
+
+        return ZAJEL_STATUS_WOULD_BLOCK;
+    } /*if: <Destination is full, the caller keeps the message>*/
+
+    zajel_send_route(zajel_ptr,
+                     descriptor_ptr,
+                     route_ptr,
+                     sourceThreadID,
+                     isOutermost);
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_try_send*/
+
+void zajel_send_batch(zajel_s*  zajel_ptr,
+                      void**    message_ptr_array,
+                      uint32_t  messageCount COMMA()
+                      FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_message_descriptor_s*     descriptor_ptr;
+    zajel_component_information_u*  destinationComponent_ptr;
+    /*Messages of the current chunk going to the same destination, in their original order*/
+    zajel_message_descriptor_s*     group_ptr_array[ZAJEL_BATCH_CHUNK_SIZE];
+    /*Destination of each message of the current chunk, a thread ID, or threadCount + core ID*/
+    uint32_t                        keyArray[ZAJEL_BATCH_CHUNK_SIZE];
+    /*The thread and core from which the whole batch is sent*/
+    uint32_t                        sourceThreadID;
+    uint32_t                        sourceCoreID;
+    uint32_t                        chunkStart;
+    uint32_t                        chunkCount;
+    uint32_t                        groupCount;
+    uint32_t                        key;
+    uint32_t                        priority;
+    bool_t                          isOutermost;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        j;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT(((NULL != message_ptr_array) || (0 == messageCount)),
+           "zajel: message_ptr_array cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    if((0 == messageCount) ||
+       (NULL == message_ptr_array))
+    {
+        /*The first message is read below, so the release builds do not rely on the above check*/
+        return;
+    } /*if: <Nothing to send>*/
+
+    descriptor_ptr  = (zajel_message_descriptor_s*) message_ptr_array[0];
+    sourceThreadID  = ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                    descriptor_ptr->sourceComponentID);
+    sourceCoreID    = ZAJEL_COMPONENT_GET_CORE_ID(zajel_ptr,
+                                                  descriptor_ptr->sourceComponentID);
+    isOutermost     = zajel_send_begin(zajel_ptr,
+                                       sourceThreadID);
+
+    for(chunkStart = 0; chunkStart < messageCount; chunkStart += chunkCount)
+    {
+        /*<Classify then hand over the batch, one chunk at a time>*/
+        chunkCount = messageCount - chunkStart;
+
+        if(chunkCount > ZAJEL_BATCH_CHUNK_SIZE)
+        {
+            chunkCount = ZAJEL_BATCH_CHUNK_SIZE;
+        } /*if: <Limit the chunk to the classification buffers>*/
+
+        for(i = 0; i < chunkCount; ++i)
+        {
+            /*<Validate the messages, and find their destinations with a single handle load each>*/
+            descriptor_ptr = (zajel_message_descriptor_s*) message_ptr_array[chunkStart + i];
+
+            ASSERT((NULL != descriptor_ptr),
+                   "zajel: message_cannot equal NULL!",
+                   fileName,
+                   lineNumber);
+            ASSERT(((descriptor_ptr->messageID < zajel_ptr->messageCount) && (descriptor_ptr->messageID)),
+                   "zajel: Message ID is either reserved or greater than the supported message count!",
+                   fileName,
+                   lineNumber);
+            ASSERT(((descriptor_ptr->sourceComponentID < zajel_ptr->componentCount) &&
+                    (descriptor_ptr->destinationComponentID < zajel_ptr->componentCount)),
+                   "zajel: Component ID is greater than the supported component count!",
+                   fileName,
+                   lineNumber);
+            ASSERT((FALSE == descriptor_ptr->isSynchronous),
+                   "zajel: Synchronous messages cannot be sent in a batch!",
+                   fileName,
+                   lineNumber);
+            ASSERT((sourceThreadID == ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                                    descriptor_ptr->sourceComponentID)),
+                   "zajel: All the messages of a batch shall be sent from the same thread!",
+                   fileName,
+                   lineNumber);
+
+            descriptor_ptr->flags &= ZAJEL_MESSAGE_FLAG_SENDER_MASK;
+
+            destinationComponent_ptr = &zajel_ptr->componentInformationArray[descriptor_ptr->destinationComponentID];
+
+            keyArray[i] = (sourceCoreID == destinationComponent_ptr->parameters.coreID) ?
+                          (destinationComponent_ptr->parameters.threadID) :
+                          (zajel_ptr->threadCount + destinationComponent_ptr->parameters.coreID);
+
+            if(ZAJEL_UNLIKELY(NULL != zajel_ptr->statsBase_ptr))
+            {
+                zajel_stats_send(zajel_ptr,
+                                 sourceThreadID,
+                                 descriptor_ptr,
+                                 (keyArray[i] == sourceThreadID) ?
+                                 (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD) :
+                                 ((keyArray[i] < zajel_ptr->threadCount) ?
+                                  (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE) :
+                                  (ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES)));
+            } /*if: <Statistics are enabled>*/
+
+            if(ZAJEL_UNLIKELY(FALSE != zajel_ptr->isTracing))
+            {
+                zajel_trace_message(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                                       sourceThreadID),
+                                    ZAJEL_TRACE_EVENT_SEND,
+                                    descriptor_ptr);
+            } /*if: <Events are recorded>*/
+
+            if((NULL != zajel_ptr->laneArray_ptr) &&
+               (keyArray[i] < zajel_ptr->threadCount) &&
+               (ZAJEL_THREAD_TRANSPORT_CALLBACK != zajel_ptr->threadInformationArray[keyArray[i]].transport))
+            {
+                /*<Destination thread has priority lanes, the urgent and bulk messages skip the batch>*/
+                priority = zajel_message_priority(zajel_ptr,
+                                                  descriptor_ptr);
+
+                if(ZAJEL_PRIORITY_NORMAL != priority)
+                {
+                    if(zajel_ptr->threadInformationArray[keyArray[i]].inboundCapacity)
+                    {
+                        zajel_inbound_count(&zajel_ptr->threadInformationArray[keyArray[i]],
+                                            descriptor_ptr);
+                    } /*if: <Destination thread has a bounded inbound capacity>*/
+
+                    zajel_lane_push(&zajel_ptr->laneArray_ptr[keyArray[i]],
+                                    priority,
+                                    descriptor_ptr);
+                    keyArray[i] = ZAJEL_BATCH_KEY_DONE;
+                } /*if: <Message goes to a priority lane>*/
+            } /*if: <Destination thread has priority lanes, the urgent and bulk messages skip the batch>*/
+        } /*for: <Validate the messages, and find their destinations with a single handle load each>*/
+
+        for(i = 0; i < chunkCount; ++i)
+        {
+            /*<Gather the messages of each destination, the first message of each group drives it>*/
+            key = keyArray[i];
+
+            if(ZAJEL_BATCH_KEY_DONE == key)
+            {
+                continue;
+            } /*if: <Message already handed over with an earlier group>*/
+
+            groupCount = 0;
+
+            for(j = i; j < chunkCount; ++j)
+            {
+                if(key == keyArray[j])
+                {
+                    group_ptr_array[groupCount++]   = (zajel_message_descriptor_s*) message_ptr_array[chunkStart + j];
+                    keyArray[j]                     = ZAJEL_BATCH_KEY_DONE;
+                } /*if: <Same destination>*/
+            } /*for: <Collect the rest of the group>*/
+
+            if(key < zajel_ptr->threadCount)
+            {
+                /*<Destination thread runs on this core>*/
+                zajel_thread_handle_message_batch(zajel_ptr,
+                                                  sourceThreadID,
+                                                  key,
+                                                  group_ptr_array,
+                                                  groupCount);
+            } /*if: <Destination thread runs on this core>*/
+            else
+            {
+                /*<Destination runs on a different core>*/
+                zajel_core_handle_message_batch(zajel_ptr,
+                                                key - zajel_ptr->threadCount,
+                                                group_ptr_array,
+                                                groupCount);
+            } /*else: <Destination runs on a different core>*/
+        } /*for: <Gather the messages of each destination, the first message of each group drives it>*/
+    } /*for: <Classify then hand over the batch, one chunk at a time>*/
+
+    zajel_send_end(zajel_ptr,
+                   sourceThreadID,
+                   isOutermost);
+} /*function: zajel_send_batch*/
+
+void zajel_publish(zajel_s*         zajel_ptr,
+                   uint32_t         topicID,
+                   message_id       messageID,
+                   component_id     sourceComponentID,
+                   zajel_payload_s* payload_ptr COMMA()
+                   FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_subscription_s*   subscriptionArray_ptr;
+    uint32_t                sourceThreadID;
+    uint32_t                sourceCoreID;
+    /*Range of subscriptions sharing a destination*/
+    uint32_t                first;
+    uint32_t                last;
+    uint32_t                end;
+    bool_t                  isOutermost;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Walking the sorted subscriptions of the topic, and sending a single message per destination
+     *   thread of this core, and per other core.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->subscriptionArray_ptr),
+           "zajel: Topics are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((topicID < zajel_ptr->topicCount),
+           "zajel: Topic ID is greater than the supported topic count!",
+           fileName,
+           lineNumber);
+    ASSERT(((messageID < zajel_ptr->messageCount) && (messageID)),
+           "zajel: Message ID is either reserved or greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT((sourceComponentID < zajel_ptr->componentCount),
+           "zajel: Source component ID is greater than the supported component count!",
+           fileName,
+           lineNumber);
+
+    if(ZAJEL_UNLIKELY(ZAJEL_ROUTES_STATE_VALID != ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->routesState)))
+    {
+        /*<The mapping changed since the routes (and the subscriptions order) were built>*/
+        zajel_routes_build(zajel_ptr);
+    } /*if: <The mapping changed since the routes (and the subscriptions order) were built>*/
+
+    subscriptionArray_ptr   = zajel_ptr->subscriptionArray_ptr;
+    sourceThreadID          = ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                            sourceComponentID);
+    sourceCoreID            = ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                       sourceThreadID);
+    end                     = zajel_ptr->topicStartArray_ptr[topicID + 1];
+    isOutermost             = zajel_send_begin(zajel_ptr,
+                                               sourceThreadID);
+
+    for(first = zajel_ptr->topicStartArray_ptr[topicID]; first < end; first = last)
+    {
+        /*<Send a single message per destination thread of this core, and per other core>*/
+        for(last = first + 1;
+            (last < end) &&
+            (subscriptionArray_ptr[last].coreID == subscriptionArray_ptr[first].coreID) &&
+            ((subscriptionArray_ptr[first].coreID != sourceCoreID) ||
+             (subscriptionArray_ptr[last].threadID == subscriptionArray_ptr[first].threadID));
+            ++last)
+        {
+        } /*for: <Find the end of the destination group>*/
+
+        zajel_topic_send(zajel_ptr,
+                         sourceThreadID,
+                         messageID,
+                         sourceComponentID,
+                         payload_ptr,
+                         first,
+                         last - first,
+                         (subscriptionArray_ptr[first].coreID == sourceCoreID) ?
+                         (ZAJEL_TOPIC_SCOPE_THREAD) :
+                         (ZAJEL_TOPIC_SCOPE_CORE),
+                         ZAJEL_MESSAGE_FLAG_NONE);
+    } /*for: <Send a single message per destination thread of this core, and per other core>*/
+
+    zajel_send_end(zajel_ptr,
+                   sourceThreadID,
+                   isOutermost);
+} /*function: zajel_publish*/
+
+timer_id zajel_send_after(zajel_s*  zajel_ptr,
+                          uint32_t  callerThreadID,
+                          void*     message_ptr,
+                          uint64_t  delayNanoseconds COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->timerWheelArray_ptr),
+           "zajel: Timers are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((callerThreadID < zajel_ptr->threadCount),
+           "zajel: callerThreadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT(((((zajel_message_descriptor_s*) message_ptr)->messageID < zajel_ptr->messageCount) &&
+            (((zajel_message_descriptor_s*) message_ptr)->messageID)),
+           "zajel: Message ID is either reserved or greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((((zajel_message_descriptor_s*) message_ptr)->sourceComponentID < zajel_ptr->componentCount) &&
+            (((zajel_message_descriptor_s*) message_ptr)->destinationComponentID < zajel_ptr->componentCount)),
+           "zajel: Component ID is greater than the supported component count!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ((zajel_message_descriptor_s*) message_ptr)->isSynchronous),
+           "zajel: Only asynchronous messages can be sent by a timer!",
+           fileName,
+           lineNumber);
+
+    ((zajel_message_descriptor_s*) message_ptr)->flags &= ZAJEL_MESSAGE_FLAG_SENDER_MASK;
+
+    return zajel_timer_start(zajel_ptr,
+                             callerThreadID,
+                             message_ptr,
+                             0,
+                             delayNanoseconds,
+                             0);
+} /*function: zajel_send_after*/
+
+timer_id zajel_send_every(zajel_s*  zajel_ptr,
+                          uint32_t  callerThreadID,
+                          void*     message_ptr,
+                          uint32_t  size,
+                          uint64_t  periodNanoseconds COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->timerWheelArray_ptr),
+           "zajel: Timers are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((callerThreadID < zajel_ptr->threadCount),
+           "zajel: callerThreadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT(((((zajel_message_descriptor_s*) message_ptr)->messageID < zajel_ptr->messageCount) &&
+            (((zajel_message_descriptor_s*) message_ptr)->messageID)),
+           "zajel: Message ID is either reserved or greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((((zajel_message_descriptor_s*) message_ptr)->sourceComponentID < zajel_ptr->componentCount) &&
+            (((zajel_message_descriptor_s*) message_ptr)->destinationComponentID < zajel_ptr->componentCount)),
+           "zajel: Component ID is greater than the supported component count!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == ((zajel_message_descriptor_s*) message_ptr)->isSynchronous),
+           "zajel: Only asynchronous messages can be sent by a timer!",
+           fileName,
+           lineNumber);
+    ASSERT((size >= sizeof(zajel_message_descriptor_s)),
+           "zajel: A message cannot be smaller than its descriptor!",
+           fileName,
+           lineNumber);
+    ASSERT((periodNanoseconds > 0),
+           "zajel: The period must be greater than zero!",
+           fileName,
+           lineNumber);
+
+    ((zajel_message_descriptor_s*) message_ptr)->flags &= ZAJEL_MESSAGE_FLAG_SENDER_MASK;
+
+    return zajel_timer_start(zajel_ptr,
+                             callerThreadID,
+                             message_ptr,
+                             size,
+                             periodNanoseconds,
+                             periodNanoseconds);
+} /*function: zajel_send_every*/
+
+void* zajel_timer_cancel(zajel_s*   zajel_ptr,
+                         uint32_t   callerThreadID,
+                         timer_id   timerID COMMA()
+                         FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_timer_wheel_s*    wheel_ptr;
+    zajel_timer_s*          timer_ptr;
+    void*                   message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->timerWheelArray_ptr),
+           "zajel: Timers are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((callerThreadID < zajel_ptr->threadCount),
+           "zajel: callerThreadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT(((ZAJEL_TIMER_ID_INVALID == timerID) || (callerThreadID == ZAJEL_TIMER_ID_GET_THREAD_ID(timerID))),
+           "zajel: A timer can only be cancelled by the thread which armed it!",
+           fileName,
+           lineNumber);
+
+    wheel_ptr = &zajel_ptr->timerWheelArray_ptr[callerThreadID];
+
+    if((ZAJEL_TIMER_ID_INVALID == timerID) ||
+       (ZAJEL_TIMER_ID_GET_INDEX(timerID) >= wheel_ptr->capacity))
+    {
+        return NULL;
+    } /*if: <Not a timer of this thread>*/
+
+    timer_ptr = &wheel_ptr->timerArray[ZAJEL_TIMER_ID_GET_INDEX(timerID)];
+
+    if((timer_ptr->generation != ZAJEL_TIMER_ID_GET_GENERATION(timerID)) ||
+       (NULL == timer_ptr->link_ptr_ptr))
+    {
+        return NULL;
+    } /*if: <Timer already expired (or cancelled), and maybe armed again since>*/
+
+    message_ptr = timer_ptr->message_ptr;
+
+    zajel_timer_disarm(wheel_ptr,
+                       timer_ptr);
+    zajel_timer_free(wheel_ptr,
+                     timer_ptr);
+
+    return message_ptr;
+} /*function: zajel_timer_cancel*/
+
+uint32_t zajel_call(zajel_s*    zajel_ptr,
+                    void*       message_ptr,
+                    uint32_t    replyCapacity COMMA()
+                    FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_call_descriptor_s*    call_ptr;
+
+    call_ptr = (zajel_call_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    call_ptr->descriptor.isSynchronous  = TRUE;
+    call_ptr->reply.status              = 0;
+    call_ptr->reply.size                = 0;
+    call_ptr->reply.capacity            = replyCapacity;
+    call_ptr->reply.reserved            = 0;
+    call_ptr->reply.callerAddress       = (uint64_t)(uintptr_t) call_ptr;
+
+    /*The call flag is set once the flags left by a former use of the message are cleared*/
+    zajel_send_message(zajel_ptr,
+                       message_ptr,
+                       ZAJEL_MESSAGE_FLAG_CALL COMMA()
+                       FILE_AND_LINE_FOR_CALL());
+
+    return call_ptr->reply.status;
+} /*function: zajel_call*/
+
+void zajel_reply(zajel_s*       zajel_ptr,
+                 void*          message_ptr,
+                 uint32_t       status,
+                 const void*    result_ptr,
+                 uint32_t       resultSize COMMA()
+                 FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_call_descriptor_s*    call_ptr;
+    void*                       payload_ptr;
+
+    call_ptr = (zajel_call_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((call_ptr->descriptor.flags & ZAJEL_MESSAGE_FLAG_CALL),
+           "zajel: Only messages sent using zajel_call can be replied!",
+           fileName,
+           lineNumber);
+    ASSERT((resultSize <= call_ptr->reply.capacity),
+           "zajel: The result does not fit in the reply area reserved by the caller!",
+           fileName,
+           lineNumber);
+    ASSERT(((NULL != result_ptr) || (0 == resultSize)),
+           "zajel: result_ptr cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    payload_ptr = ZAJEL_CALL_REPLY_PAYLOAD(call_ptr);
+
+    if((0 != resultSize) && (payload_ptr != result_ptr))
+    {
+        memcpy(payload_ptr, result_ptr, resultSize);
+    } /*if: <Result was not written in place>*/
+
+    call_ptr->reply.status  = status;
+    call_ptr->reply.size    = resultSize;
+
+    if(ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD != zajel_route_get(zajel_ptr,
+                                                                      ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                                                                    call_ptr->descriptor.destinationComponentID),
+                                                                      call_ptr->descriptor.sourceComponentID)->relation)
+    {
+        /*<Caller is blocked in another thread, release it (the handler was called directly otherwise)>*/
+        zajel_acknowledge(zajel_ptr,
+                          message_ptr COMMA()
+                          FILE_AND_LINE_FOR_CALL());
+    } /*if: <Caller is blocked in another thread, release it (the handler was called directly otherwise)>*/
+} /*function: zajel_reply*/
+
+void zajel_acknowledge(zajel_s*                zajel_ptr,
+                       void*                   message_ptr COMMA()
+                       FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_message_descriptor_s          ackDescriptor;
+    zajel_message_descriptor_s*         descriptor_ptr;
+    zajel_message_descriptor_s*         ack_ptr;
+    zajel_route_s*                      route_ptr;
+
+    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->messageID < zajel_ptr->messageCount),
+           "zajel: Message ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->messageID),
+           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->sourceComponentID < zajel_ptr->componentCount),
+           "zajel: Source component ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->destinationComponentID < zajel_ptr->componentCount),
+           "zajel: Destination component ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((TRUE == descriptor_ptr->isSynchronous)),
+           "zajel: It is not allowed to acknowledge asynchronous message!",
+           fileName,
+           lineNumber);
+
+
+    if(ZAJEL_UNLIKELY(FALSE != zajel_ptr->isTracing))
+    {
+        zajel_trace_message(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                               ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                                             descriptor_ptr->destinationComponentID)),
+                            ZAJEL_TRACE_EVENT_ACKNOWLEDGE,
+                            descriptor_ptr);
+    } /*if: <Events are recorded>*/
+
+    /*The acknowledgment travels back, from the thread of the destination to the source component*/
+    route_ptr = zajel_route_get(zajel_ptr,
+                                ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                              descriptor_ptr->destinationComponentID),
+                                descriptor_ptr->sourceComponentID);
+
+    switch(route_ptr->relation)
+    {
+        /*<This switch checks the dynamic relation between both components and act accordingly>*/
+
+        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD:
+            /*<Both components are running in the same thread>*/
+
+            ASSERT((FALSE),
+                   "zajel: It is not allowed to ack a message sent from the same thread!",
+                   fileName,
+                   lineNumber);
+
+            break;/*<Both components are running in the same thread>*/
+        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE:
+            /*<Both components are running in different threads, same core>*/
+
+            ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
+                                     descriptor_ptr->sourceComponentID,
+                                     unblock);
+
+            break;/*<Both components are running in different threads, same core>*/
+        case ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES:
+            /*<Both components are running in different threads, different cores>*/
+
+            if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_CALL)
+            {
+                /*<Reply of a call, the reply area itself is sent back as the acknowledgment>*/
+                ack_ptr         = &((zajel_call_descriptor_s*) descriptor_ptr)->reply.descriptor;
+                ack_ptr->flags  = ZAJEL_MESSAGE_FLAG_CALL;
+            } /*if: <Reply of a call, the reply area itself is sent back as the acknowledgment>*/
+            else
+            {
+                ack_ptr         = &ackDescriptor;
+                ack_ptr->flags  = ZAJEL_MESSAGE_FLAG_NONE;
+            } /*else: <Plain synchronous message, an empty acknowledgment is enough>*/
+
+            /*Adjusting the message parameter so that it is delivered to the original source*/
+            ack_ptr->messageID              = ZAJEL_ACK_MESSAGE_ID;
+            ack_ptr->sourceComponentID      = descriptor_ptr->destinationComponentID;
+            ack_ptr->destinationComponentID = descriptor_ptr->sourceComponentID;
+            ack_ptr->isSynchronous          = descriptor_ptr->isSynchronous;
+
+            /*The acknowledgment goes directly to the source core, zajel_send would block this thread*/
+            route_ptr->deliverFunction(route_ptr->context_ptr,
+                                       ack_ptr);
+
+            break;/*<Both components are running in different threads, different cores>*/
+        default:
+            /*<Invalid dynamic relation>*/
+            ASSERT((FALSE),
+                   "zajel: Invalid dynamic relation received!",
+                   fileName,
+                   lineNumber);
+            break;/*<Invalid dynamic relation>*/
+    } /*switch: <This switch checks the dynamic relation between both components and act accordingly>*/
+} /*function: zajel_acknowledge*/
+
+void zajel_deliver(zajel_s* zajel_ptr,
+                   void*    message_ptr,
+                   uint32_t callerThreadID COMMA()
+                   FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_message_descriptor_s*         descriptor_ptr;
+    zajel_call_reply_s*                 reply_ptr;
+    zajel_call_descriptor_s*            call_ptr;
+    zajel_route_s*                      route_ptr;
+    bool_t                              isOutermost;
+
+    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->messageID < zajel_ptr->messageCount),
+           "zajel: Message ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((descriptor_ptr->messageID) ||
+            (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION) ||
+            (callerThreadID != ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                             descriptor_ptr->destinationComponentID))),
+           "zajel: An acknowledge cannot be delivered by the thread waiting for it!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->sourceComponentID < zajel_ptr->componentCount),
+           "zajel: Source component ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->destinationComponentID < zajel_ptr->componentCount),
+           "zajel: Destination component ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((TRUE == descriptor_ptr->isSynchronous) || (FALSE == descriptor_ptr->isSynchronous)),
+           "zajel: isSynchronous is niether true nor false!",
+           fileName,
+           lineNumber);
+    ASSERT(((ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                      callerThreadID) ==
+             ZAJEL_COMPONENT_GET_CORE_ID(zajel_ptr,
+                                         descriptor_ptr->destinationComponentID)) ||
+            (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_FORWARDED) ||
+            (zajel_ptr->componentInformationArray[descriptor_ptr->destinationComponentID].parameters.migrationSlot)),
+           "zajel: The destination core shall be the same as the calling core (unless it was just migrated)!",
+           fileName,
+           lineNumber);
+
+    if(ZAJEL_UNLIKELY(FALSE != zajel_ptr->isTracing))
+    {
+        zajel_trace_message(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                               callerThreadID),
+                            ZAJEL_TRACE_EVENT_DELIVER,
+                            descriptor_ptr);
+    } /*if: <Events are recorded>*/
+
+    if((descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_TOPIC) &&
+       (ZAJEL_TOPIC_SCOPE_CORE == ((zajel_topic_envelope_s*) descriptor_ptr)->scope))
+    {
+        /*<Published message received for the whole core, split it among the subscribing threads>*/
+        zajel_topic_forward(zajel_ptr,
+                            callerThreadID,
+                            (zajel_topic_envelope_s*) descriptor_ptr);
+
+        return;
+    } /*if: <Published message received for the whole core, split it among the subscribing threads>*/
+
+    if(ZAJEL_UNLIKELY(TRUE == zajel_migration_applies(zajel_ptr,
+                                                      descriptor_ptr)))
+    {
+        /*<Destination is being migrated, the migration decides where the message goes>*/
+        zajel_migration_handle(zajel_ptr,
+                               callerThreadID,
+                               descriptor_ptr);
+
+        return;
+    } /*if: <Destination is being migrated, the migration decides where the message goes>*/
+
+    if(callerThreadID == ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                       descriptor_ptr->destinationComponentID))
+    {
+        /*<Caller thread is the same as the destination thread, calling the handler directly in the same context>*/
+        zajel_message_handle(zajel_ptr,
+                             callerThreadID,
+                             descriptor_ptr);
+    } /*if: <Caller thread is the same as the destination thread, calling the handler directly in the same context>*/
+    else
+    {
+        /*<Caller thread is different from the destination thread>*/
+        if(ZAJEL_ACK_MESSAGE_ID != descriptor_ptr->messageID)
+        {
+            /*<Normal message received from a different core>*/
+            isOutermost = zajel_send_begin(zajel_ptr,
+                                           callerThreadID);
+            route_ptr   = zajel_route_get(zajel_ptr,
+                                          callerThreadID,
+                                          descriptor_ptr->destinationComponentID);
+
+            zajel_route_deliver(zajel_ptr,
+                                route_ptr,
+                                descriptor_ptr);
+
+            zajel_send_end(zajel_ptr,
+                           callerThreadID,
+                           isOutermost);
+        } /*if: <Normal message received from a different core>*/
+        else
+        {
+            /*<Acknowledge message received from a different core>*/
+            if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_CALL)
+            {
+                /*<Acknowledge carries the reply of a call>*/
+                reply_ptr   = (zajel_call_reply_s*) descriptor_ptr;
+                call_ptr    = (zajel_call_descriptor_s*)(uintptr_t) reply_ptr->callerAddress;
+
+                if(&call_ptr->reply != reply_ptr)
+                {
+                    /*<Reply was received by value, copy it back to the caller's message>*/
+                    ASSERT((reply_ptr->size <= call_ptr->reply.capacity),
+                           "zajel: The received reply does not fit in the caller reply area!",
+                           fileName,
+                           lineNumber);
+
+                    memcpy(ZAJEL_CALL_REPLY_PAYLOAD(call_ptr),
+                           (void*)(reply_ptr + 1),
+                           reply_ptr->size);
+                    call_ptr->reply.status  = reply_ptr->status;
+                    call_ptr->reply.size    = reply_ptr->size;
+                } /*if: <Reply was received by value, copy it back to the caller's message>*/
+            } /*if: <Acknowledge carries the reply of a call>*/
+
+            ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
+                                     descriptor_ptr->destinationComponentID,
+                                     unblock);
+        } /*else: <Acknowledge message received from a different core>*/
+    } /*else: <Caller thread is different from the destination thread>*/
+} /*function: zajel_deliver*/
+
+uint32_t zajel_poll(zajel_s*    zajel_ptr,
+                    uint32_t    threadID,
+                    void**      message_ptr_array,
+                    uint32_t    maxCount COMMA()
+                    FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr_array),
+           "zajel: message_ptr_array cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((ZAJEL_THREAD_TRANSPORT_CALLBACK != zajel_ptr->threadInformationArray[threadID].transport),
+           "zajel: Polling is only possible for threads using the ring or the mailbox transport!",
+           fileName,
+           lineNumber);
+
+    return zajel_thread_collect(zajel_ptr,
+                                threadID,
+                                message_ptr_array,
+                                maxCount);
+} /*function: zajel_poll*/
+
+uint32_t zajel_dispatch(zajel_s*    zajel_ptr,
+                        uint32_t    threadID,
+                        uint32_t    budget COMMA()
+                        FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_message_descriptor_s*     descriptor_ptr;
+    /*Messages collected from the inbound queues, and not yet handled*/
+    void*                           batch_ptr_array[ZAJEL_DISPATCH_BATCH_SIZE];
+    /*Number of messages handled so far*/
+    uint32_t                        processed;
+    /*Number of messages collected by the last batch*/
+    uint32_t                        count;
+    /*Temporary counter*/
+    uint32_t                        i;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((ZAJEL_THREAD_TRANSPORT_CALLBACK != zajel_ptr->threadInformationArray[threadID].transport),
+           "zajel: Dispatching is only possible for threads using the ring or the mailbox transport!",
+           fileName,
+           lineNumber);
+
+    processed = 0;
+
+    if(NULL != zajel_ptr->timerWheelArray_ptr)
+    {
+        /*<Send the expired timers first, the ones sent to this thread are then dispatched right away>*/
+        (void) zajel_timers_expire(zajel_ptr,
+                                   threadID);
+    } /*if: <Send the expired timers first, the ones sent to this thread are then dispatched right away>*/
+
+    while(processed < budget)
+    {
+        /*<Collect a batch, then run each message handler to completion>*/
+        count = zajel_thread_collect(zajel_ptr,
+                                     threadID,
+                                     batch_ptr_array,
+                                     ((budget - processed) < ZAJEL_DISPATCH_BATCH_SIZE) ?
+                                     (budget - processed) :
+                                     (ZAJEL_DISPATCH_BATCH_SIZE));
+
+        if(0 == count)
+        {
+            break;
+        } /*if: <Nothing left to dispatch>*/
+
+        ZAJEL_PREFETCH(batch_ptr_array[0]);
+
+        if(count > 1)
+        {
+            ZAJEL_PREFETCH(batch_ptr_array[1]);
+        } /*if: <There is a second message>*/
+
+        for(i = 0; i < count; ++i)
+        {
+            /*<Handle the batch, keeping the next descriptors and handler entry on their way to the cache>*/
+            descriptor_ptr = (zajel_message_descriptor_s*) batch_ptr_array[i];
+
+            if((i + 2) < count)
+            {
+                ZAJEL_PREFETCH(batch_ptr_array[i + 2]);
+            } /*if: <Prefetch the descriptor after next>*/
+
+            if((i + 1) < count)
+            {
+                /*The next descriptor was prefetched one iteration ago, its IDs are (most probably) cached*/
+                ZAJEL_PREFETCH(zajel_handler_get(zajel_ptr,
+                                                 (zajel_message_descriptor_s*) batch_ptr_array[i + 1]));
+            } /*if: <Prefetch the next handler entry>*/
+
+            ASSERT(((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->messageDebugArray[descriptor_ptr->messageID])) ||
+                    (NULL != zajel_handler_get(zajel_ptr,
+                                               descriptor_ptr)->componentHandlerFunction) ||
+                    (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION)),
+                   "zajel: Received a message which is not registered!",
+                   fileName,
+                   lineNumber);
+
+            zajel_message_handle(zajel_ptr,
+                                 threadID,
+                                 descriptor_ptr);
+        } /*for: <Handle the batch, keeping the next descriptors and handler entry on their way to the cache>*/
+
+        processed += count;
+    } /*while: <Collect a batch, then run each message handler to completion>*/
+
+    if((NULL != zajel_ptr->actorQueueArray_ptr) &&
+       (processed < budget))
+    {
+        /*<Run the actors with the budget left>*/
+        processed += zajel_actors_run(zajel_ptr,
+                                      threadID,
+                                      budget - processed);
+    } /*if: <Run the actors with the budget left>*/
+
+    return processed;
+} /*function: zajel_dispatch*/
+
+uint32_t zajel_advance_timers(zajel_s*  zajel_ptr,
+                              uint32_t  threadID COMMA()
+                              FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->timerWheelArray_ptr),
+           "zajel: Timers are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+
+    return zajel_timers_expire(zajel_ptr,
+                               threadID);
+} /*function: zajel_advance_timers*/
+
+
+void zajel_enable_message_pools(zajel_s*    zajel_ptr,
+                                uint32_t    blocksPerSlab COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    /*Alignment of the pools, so each of them can be placed on the node of its thread*/
+    uintptr_t   granule;
+    /*Temporary counter*/
+    uint32_t    i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating a cache aligned pool for each thread, placed on the node of the thread, the slabs
+     *   themselves are allocated on demand by the owner thread.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->poolArray_ptr),
+           "zajel: Message pools are already enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((blocksPerSlab > 0),
+           "zajel: Blocks per slab must be greater than zero!",
+           fileName,
+           lineNumber);
+
+    granule                 = zajel_placement_granule(zajel_ptr,
+                                                      sizeof(zajel_pool_s));
+    zajel_ptr->poolStride   = ZAJEL_NUMA_ALIGN_UP(sizeof(zajel_pool_s), granule);
+
+    zajel_ptr->poolMemory_ptr = zajel_placement_alloc(zajel_ptr,
+                                                      ZAJEL_CACHE_LINE_SIZE +
+                                                      (zajel_ptr->poolStride * zajel_ptr->threadCount),
+                                                      granule);
+    ASSERT((NULL != zajel_ptr->poolMemory_ptr),
+           "zajel: Failed to allocate a memory for the message pools!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->poolArray_ptr = (zajel_pool_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->poolMemory_ptr);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Initialize the pool of each thread, once placed>*/
+        zajel_placement_bind(zajel_ptr,
+                             zajel_ptr->poolMemory_ptr,
+                             ZAJEL_THREAD_POOL(zajel_ptr,
+                                               i),
+                             zajel_ptr->poolStride,
+                             i);
+        zajel_pool_init(ZAJEL_THREAD_POOL(zajel_ptr,
+                                          i),
+                        i,
+                        blocksPerSlab);
+    } /*for: <Initialize the pool of each thread, once placed>*/
+} /*function: zajel_enable_message_pools*/
+
+void zajel_enable_sync_slots(zajel_s* zajel_ptr COMMA()
+                             FILE_AND_LINE_FOR_TYPE())
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating a cache aligned synchronization slot for each thread, from then on the threads
+     *   block/unblock callbacks are no longer used.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->syncSlotArray_ptr),
+           "zajel: Synchronization slots are already enabled!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->syncSlotMemory_ptr = zajel_ptr->allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                                      (sizeof(zajel_sync_slot_s) * zajel_ptr->threadCount));
+    ASSERT((NULL != zajel_ptr->syncSlotMemory_ptr),
+           "zajel: Failed to allocate a memory for the synchronization slots!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->syncSlotArray_ptr = (zajel_sync_slot_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->syncSlotMemory_ptr);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Initialize the slot of each thread>*/
+        zajel_sync_slot_init(&zajel_ptr->syncSlotArray_ptr[i]);
+    } /*for: <Initialize the slot of each thread>*/
+} /*function: zajel_enable_sync_slots*/
+
+void zajel_enable_timers(zajel_s*   zajel_ptr,
+                         uint64_t   tickNanoseconds,
+                         uint32_t   timersPerThread COMMA()
+                         FILE_AND_LINE_FOR_TYPE())
+{
+    /*Size of the wheels, rounded up to keep the timers aligned*/
+    uintptr_t       wheelsSize;
+    /*Distance between the timers of two threads, and its alignment*/
+    uintptr_t       timersStride;
+    uintptr_t       granule;
+    zajel_timer_s*  timerArray;
+    /*Temporary counter*/
+    uint32_t        i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating a cache aligned wheel for each thread, followed by all the timers, the timers of
+     *   each thread being placed on its node.
+     * o Starting the clock of the wheels.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->timerWheelArray_ptr),
+           "zajel: Timers are already enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((tickNanoseconds > 0),
+           "zajel: The tick must be greater than zero!",
+           fileName,
+           lineNumber);
+    ASSERT(((timersPerThread > 0) && (timersPerThread <= ZAJEL_MAX_TIMER_COUNT)),
+           "zajel: Timers per thread must be between 1 and ZAJEL_MAX_TIMER_COUNT!",
+           fileName,
+           lineNumber);
+
+    granule         = zajel_placement_granule(zajel_ptr,
+                                              sizeof(zajel_timer_s) * timersPerThread);
+    timersStride    = ZAJEL_NUMA_ALIGN_UP(sizeof(zajel_timer_s) * timersPerThread, granule);
+    wheelsSize      = ZAJEL_NUMA_ALIGN_UP(ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_timer_wheel_s) * zajel_ptr->threadCount),
+                                          granule);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->timerMemory_ptr = zajel_placement_alloc(zajel_ptr,
+                                                       ZAJEL_CACHE_LINE_SIZE +
+                                                       wheelsSize +
+                                                       (timersStride * zajel_ptr->threadCount),
+                                                       granule);
+    ASSERT((NULL != zajel_ptr->timerMemory_ptr),
+           "zajel: Failed to allocate a memory for the timers!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->timerWheelArray_ptr  = (zajel_timer_wheel_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->timerMemory_ptr);
+    timerArray                      = (zajel_timer_s*) ((uintptr_t)zajel_ptr->timerWheelArray_ptr + wheelsSize);
+    zajel_ptr->timerTickNanoseconds = tickNanoseconds;
+    zajel_ptr->timerStartTime       = zajel_time_now();
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Initialize the wheel of each thread, over its share of the timers>*/
+        zajel_placement_bind(zajel_ptr,
+                             zajel_ptr->timerMemory_ptr,
+                             (void*) ((uintptr_t)timerArray + (i * timersStride)),
+                             timersStride,
+                             i);
+        zajel_timer_wheel_init(&zajel_ptr->timerWheelArray_ptr[i],
+                               (zajel_timer_s*) ((uintptr_t)timerArray + (i * timersStride)),
+                               timersPerThread,
+                               0);
+    } /*for: <Initialize the wheel of each thread, over its share of the timers>*/
+} /*function: zajel_enable_timers*/
+
+void zajel_enable_stats(zajel_s* zajel_ptr COMMA()
+                        FILE_AND_LINE_FOR_TYPE())
+{
+    uintptr_t   alignedBase;
+    /*Alignment of the statistics, so each thread can have its own placed on its node*/
+    uintptr_t   granule;
+    /*Temporary counter*/
+    uint32_t    i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating cache aligned statistics for each thread, followed by its counters of each message,
+     *   placed on the node of the thread.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->statsBase_ptr),
+           "zajel: Statistics are already enabled!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->statsStride = ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_stats_thread_s) +
+                                                  (sizeof(zajel_stats_counters_s) * zajel_ptr->messageCount));
+    granule                = zajel_placement_granule(zajel_ptr,
+                                                     zajel_ptr->statsStride);
+    zajel_ptr->statsStride = ZAJEL_NUMA_ALIGN_UP(zajel_ptr->statsStride, granule);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->statsMemory_ptr = zajel_placement_alloc(zajel_ptr,
+                                                       ZAJEL_CACHE_LINE_SIZE +
+                                                       (zajel_ptr->statsStride * zajel_ptr->threadCount),
+                                                       granule);
+    ASSERT((NULL != zajel_ptr->statsMemory_ptr),
+           "zajel: Failed to allocate a memory for the statistics!",
+           fileName,
+           lineNumber);
+
+    alignedBase = ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->statsMemory_ptr);
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Place the statistics of each thread, before they are cleared>*/
+        zajel_placement_bind(zajel_ptr,
+                             zajel_ptr->statsMemory_ptr,
+                             (void*) (alignedBase + (i * zajel_ptr->statsStride)),
+                             zajel_ptr->statsStride,
+                             i);
+    } /*for: <Place the statistics of each thread, before they are cleared>*/
+
+    memset((void*)alignedBase,
+           0,
+           zajel_ptr->statsStride * zajel_ptr->threadCount);
+
+    zajel_ptr->statsBase_ptr = (uint8_t*) alignedBase;
+} /*function: zajel_enable_stats*/
+
+void zajel_enable_trace(zajel_s*    zajel_ptr,
+                        uint32_t    recordsPerThread COMMA()
+                        FILE_AND_LINE_FOR_TYPE())
+{
+    /*Size of the rings, rounded up to keep the records aligned*/
+    uintptr_t               ringsSize;
+    /*Distance between the records of two threads, and its alignment*/
+    uintptr_t               recordsStride;
+    uintptr_t               granule;
+    zajel_trace_record_s*   recordArray;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Allocating a cache aligned ring for each thread, followed by all the records, the records of
+     *   each thread being placed on its node.
+     * o Reading the clocks the trace timestamps are converted with.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->traceRingArray_ptr),
+           "zajel: Trace is already enabled!",
+           fileName,
+           lineNumber);
+    ASSERT(((recordsPerThread > 0) && (0 == (recordsPerThread & (recordsPerThread - 1)))),
+           "zajel: Records per thread must be a power of two!",
+           fileName,
+           lineNumber);
+
+    granule         = zajel_placement_granule(zajel_ptr,
+                                              sizeof(zajel_trace_record_s) * recordsPerThread);
+    recordsStride   = ZAJEL_NUMA_ALIGN_UP(sizeof(zajel_trace_record_s) * recordsPerThread, granule);
+    ringsSize       = ZAJEL_NUMA_ALIGN_UP(ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_trace_ring_s) * zajel_ptr->threadCount),
+                                          granule);
+
+    /*One extra cache line is allocated, as the allocation function does not guarantee the alignment*/
+    zajel_ptr->traceMemory_ptr = zajel_placement_alloc(zajel_ptr,
+                                                       ZAJEL_CACHE_LINE_SIZE +
+                                                       ringsSize +
+                                                       (recordsStride * zajel_ptr->threadCount),
+                                                       granule);
+    ASSERT((NULL != zajel_ptr->traceMemory_ptr),
+           "zajel: Failed to allocate a memory for the trace!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->traceRingArray_ptr   = (zajel_trace_ring_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->traceMemory_ptr);
+    recordArray                     = (zajel_trace_record_s*) ((uintptr_t)zajel_ptr->traceRingArray_ptr + ringsSize);
+    zajel_ptr->traceStartTimestamp  = zajel_timestamp_now();
+    zajel_ptr->traceStartTime       = zajel_time_now();
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Initialize the ring of each thread, over its share of the records>*/
+        zajel_placement_bind(zajel_ptr,
+                             zajel_ptr->traceMemory_ptr,
+                             (void*) ((uintptr_t)recordArray + (i * recordsStride)),
+                             recordsStride,
+                             i);
+        zajel_trace_ring_init(&zajel_ptr->traceRingArray_ptr[i],
+                              (zajel_trace_record_s*) ((uintptr_t)recordArray + (i * recordsStride)),
+                              recordsPerThread);
+    } /*for: <Initialize the ring of each thread, over its share of the records>*/
+} /*function: zajel_enable_trace*/
+
+void zajel_trace_start(zajel_s* zajel_ptr COMMA()
+                       FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->traceRingArray_ptr),
+           "zajel: Trace is not enabled!",
+           fileName,
+           lineNumber);
+
+    ZAJEL_ATOMIC_STORE_RELAXED(&zajel_ptr->isTracing,
+                               TRUE);
+} /*function: zajel_trace_start*/
+
+void zajel_trace_stop(zajel_s* zajel_ptr COMMA()
+                      FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->traceRingArray_ptr),
+           "zajel: Trace is not enabled!",
+           fileName,
+           lineNumber);
+
+    ZAJEL_ATOMIC_STORE_RELAXED(&zajel_ptr->isTracing,
+                               FALSE);
+} /*function: zajel_trace_stop*/
+
+void zajel_enable_numa(zajel_s*     zajel_ptr,
+                       uint32_t     flags COMMA()
+                       FILE_AND_LINE_FOR_TYPE())
+{
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Switching the allocations of the per-thread memory to the placement.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isNumaEnabled),
+           "zajel: NUMA placement is already enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((0 == (flags & ~ZAJEL_NUMA_FLAG_HUGE_PAGES)),
+           "zajel: Invalid NUMA flags!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->numaFlags        = flags;
+    zajel_ptr->isNumaEnabled    = TRUE;
+} /*function: zajel_enable_numa*/
+
+void zajel_set_core_node(zajel_s*   zajel_ptr,
+                         uint32_t   coreID,
+                         uint32_t   nodeID COMMA()
+                         FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((coreID < zajel_ptr->coreCount),
+           "zajel: coreID passed must be less than the total core count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT(((ZAJEL_NUMA_NODE_ANY == nodeID) || (nodeID < ZAJEL_NUMA_MAX_NODE_COUNT)),
+           "zajel: nodeID passed must be less than ZAJEL_NUMA_MAX_NODE_COUNT!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->coreInformationArray[coreID].nodeID = nodeID;
+} /*function: zajel_set_core_node*/
+
+void zajel_enable_shm_transport(zajel_s*        zajel_ptr,
+                                zajel_shm_s*    shm_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != shm_ptr),
+           "zajel: Invalid pointer to the shared region!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((zajel_shm_get_core_count(shm_ptr) == zajel_ptr->coreCount),
+           "zajel: The shared region shall be created for the same core count!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->shm_ptr = shm_ptr;
+
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+} /*function: zajel_enable_shm_transport*/
+
+void zajel_enable_topics(zajel_s*   zajel_ptr,
+                         uint32_t   topicCount,
+                         uint32_t   subscriptionCapacity COMMA()
+                         FILE_AND_LINE_FOR_TYPE())
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL == zajel_ptr->subscriptionArray_ptr),
+           "zajel: Topics are already enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT(((topicCount > 0) && (subscriptionCapacity > 0)),
+           "zajel: Topic count and subscription capacity must be greater than zero!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->topicMemory_ptr = zajel_ptr->allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                                   (sizeof(zajel_subscription_s) * subscriptionCapacity) +
+                                                                   (sizeof(uint32_t) * (topicCount + 1)));
+    ASSERT((NULL != zajel_ptr->topicMemory_ptr),
+           "zajel: Failed to allocate a memory for the subscriptions!",
+           fileName,
+           lineNumber);
+
+    zajel_ptr->subscriptionArray_ptr    = (zajel_subscription_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)zajel_ptr->topicMemory_ptr);
+    zajel_ptr->topicStartArray_ptr      = (uint32_t*)(zajel_ptr->subscriptionArray_ptr + subscriptionCapacity);
+    zajel_ptr->topicCount               = topicCount;
+    zajel_ptr->subscriptionCount        = 0;
+    zajel_ptr->subscriptionCapacity     = subscriptionCapacity;
+
+    for(i = 0; i <= topicCount; ++i)
+    {
+        zajel_ptr->topicStartArray_ptr[i] = 0;
+    } /*for: <No subscriptions yet>*/
+} /*function: zajel_enable_topics*/
+
+void zajel_subscribe(zajel_s*   zajel_ptr,
+                     uint32_t   componentID,
+                     uint32_t   topicID COMMA()
+                     FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_subscription_s*   subscription_ptr;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->subscriptionArray_ptr),
+           "zajel: Topics are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology cannot be changed once sealed!",
+           fileName,
+           lineNumber);
+    ASSERT((topicID < zajel_ptr->topicCount),
+           "zajel: Topic ID is greater than the supported topic count!",
+           fileName,
+           lineNumber);
+    ASSERT((componentID < zajel_ptr->componentCount),
+           "zajel: componentID passed must be less than the total component count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((zajel_ptr->subscriptionCount < zajel_ptr->subscriptionCapacity),
+           "zajel: The subscription capacity is exhausted!",
+           fileName,
+           lineNumber);
+
+    for(i = 0; i < zajel_ptr->subscriptionCount; ++i)
+    {
+        /*<A component subscribes once to a topic>*/
+        ASSERT(((zajel_ptr->subscriptionArray_ptr[i].topicID != topicID) ||
+                (zajel_ptr->subscriptionArray_ptr[i].componentID != componentID)),
+               "zajel: The component is already subscribed to the topic!",
+               fileName,
+               lineNumber);
+    } /*for: <A component subscribes once to a topic>*/
+
+    subscription_ptr                = &zajel_ptr->subscriptionArray_ptr[zajel_ptr->subscriptionCount++];
+    subscription_ptr->topicID       = topicID;
+    subscription_ptr->componentID   = (component_id) componentID;
+    subscription_ptr->threadID      = 0;
+    subscription_ptr->coreID        = 0;
+
+    ZAJEL_ROUTES_INVALIDATE(zajel_ptr);
+} /*function: zajel_subscribe*/
+
+zajel_status_e zajel_seal(zajel_s* zajel_ptr COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_component_information_u*  component_ptr;
+    zajel_thread_information_s*     thread_ptr;
+    zajel_handler_table_s*          table_ptr;
+    /*TRUE for each message ID handled by some component, NULL if no component has its own handlers*/
+    uint8_t*                        isHandledArray;
+    zajel_status_e                  status;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        j;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating the whole topology, using the routing data only so that it works in all builds.
+     * o Resolving the routes.
+     * o Freezing the topology.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((FALSE == zajel_ptr->isSealed),
+           "zajel: The topology is already sealed!",
+           fileName,
+           lineNumber);
+
+    for(i = 0; i < zajel_ptr->coreCount; ++i)
+    {
+        /*<Every core shall be registered>*/
+        if(NULL == zajel_ptr->coreInformationArray[i].handleMessageCallback)
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Core is not registered>*/
+    } /*for: <Every core shall be registered>*/
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Every thread shall be registered, on a registered core>*/
+        thread_ptr = &zajel_ptr->threadInformationArray[i];
+
+        if(((NULL == thread_ptr->handleMessageCallback) && (NULL == thread_ptr->mailbox_ptr)) ||
+           (thread_ptr->coreID >= zajel_ptr->coreCount))
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Thread is not registered>*/
+    } /*for: <Every thread shall be registered, on a registered core>*/
+
+    for(i = 0; i < zajel_ptr->componentCount; ++i)
+    {
+        /*<Every component shall be mapped to a registered thread>*/
+        component_ptr = &zajel_ptr->componentInformationArray[i];
+
+        if((TRUE != component_ptr->parameters.isMapped) ||
+           (component_ptr->parameters.threadID >= zajel_ptr->threadCount))
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Component is not registered>*/
+    } /*for: <Every component shall be mapped to a registered thread>*/
+
+    isHandledArray = NULL;
+
+    if(NULL != zajel_ptr->handlerTableArray_ptr)
+    {
+        /*<Some components have their own handlers, gather the message IDs they handle>*/
+        isHandledArray = (uint8_t*) zajel_ptr->allocationFunction_ptr(zajel_ptr->messageCount);
+
+        if(NULL == isHandledArray)
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Not enough memory to validate the messages>*/
+
+        memset(isHandledArray,
+               FALSE,
+               zajel_ptr->messageCount);
+
+        for(i = 0; i < zajel_ptr->componentCount; ++i)
+        {
+            table_ptr = &zajel_ptr->handlerTableArray_ptr[i];
+
+            for(j = 0; j < table_ptr->count; ++j)
+            {
+                if(NULL != table_ptr->entryArray[j].componentHandlerFunction)
+                {
+                    isHandledArray[table_ptr->firstMessageID + j] = TRUE;
+                } /*if: <Component handles this message>*/
+            } /*for: <Each entry of the table>*/
+        } /*for: <Each component>*/
+    } /*if: <Some components have their own handlers, gather the message IDs they handle>*/
+
+    status = ZAJEL_STATUS_SUCCESS;
+
+    for(i = 1; i < zajel_ptr->messageCount; ++i)
+    {
+        /*<Every message shall have a handler, of its own or of some component, or be declared unused>*/
+        if((NULL == zajel_ptr->messageInformationArray[i].messageHandlerFunction) &&
+           ((NULL == isHandledArray) || (FALSE == isHandledArray[i])))
+        {
+            status = ZAJEL_STATUS_FAILURE;
+            break;
+        } /*if: <Message has no handler>*/
+    } /*for: <Every message shall have a handler, of its own or of some component, or be declared unused>*/
+
+    if(NULL != isHandledArray)
+    {
+        zajel_ptr->deallocationFunction_ptr(isHandledArray);
+    } /*if: <Release the message IDs handled by the components>*/
+
+    if(ZAJEL_STATUS_SUCCESS != status)
+    {
+        return status;
+    } /*if: <Some message has no handler>*/
+
+    /*Resolve the routes now, zajel_send_fast relies on them being valid*/
+    zajel_routes_build(zajel_ptr);
+
+    zajel_ptr->isSealed = TRUE;
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_seal*/
+
+void* zajel_message_alloc(zajel_s*  zajel_ptr,
+                          uint32_t  callerThreadID,
+                          uint32_t  size COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->poolArray_ptr),
+           "zajel: Message pools are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((callerThreadID < zajel_ptr->threadCount),
+           "zajel: callerThreadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((size >= sizeof(zajel_message_descriptor_s)),
+           "zajel: A message cannot be smaller than its descriptor!",
+           fileName,
+           lineNumber);
+
+    return zajel_pool_alloc(ZAJEL_THREAD_POOL(zajel_ptr,
+                                              callerThreadID),
+                            size,
+                            zajel_ptr->allocationFunction_ptr);
+} /*function: zajel_message_alloc*/
+
+void zajel_message_free(zajel_s*    zajel_ptr,
+                        uint32_t    callerThreadID,
+                        void*       message_ptr COMMA()
+                        FILE_AND_LINE_FOR_TYPE())
+{
+    /*Thread whose pool the message came from*/
+    uint32_t ownerThreadID;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->poolArray_ptr),
+           "zajel: Message pools are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    ownerThreadID = zajel_pool_get_owner(message_ptr);
+
+    ASSERT((ownerThreadID < zajel_ptr->threadCount),
+           "zajel: Message was not allocated by zajel_message_alloc (or was corrupted)!",
+           fileName,
+           lineNumber);
+
+    zajel_pool_free(ZAJEL_THREAD_POOL(zajel_ptr,
+                                      ownerThreadID),
+                    message_ptr,
+                    callerThreadID,
+                    zajel_ptr->deallocationFunction_ptr);
+} /*function: zajel_message_free*/
+
+void zajel_get_pool_statistics(zajel_s*                 zajel_ptr,
+                               uint32_t                 threadID,
+                               zajel_pool_statistics_s* statistics_array COMMA()
+                               FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->poolArray_ptr),
+           "zajel: Message pools are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((threadID < zajel_ptr->threadCount),
+           "zajel: threadID passed must be less than the total thread count used during initialization!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != statistics_array),
+           "zajel: statistics_array cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    zajel_pool_get_statistics(ZAJEL_THREAD_POOL(zajel_ptr,
+                                                threadID),
+                              statistics_array);
+} /*function: zajel_get_pool_statistics*/
+
+uint32_t zajel_get_component_core(zajel_s*  zajel_ptr,
+                                  uint32_t  componentID COMMA()
+                                  FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_component_information_u component;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((componentID < zajel_ptr->componentCount),
+           "zajel: componentID passed must be less than the total component count used during initialization!",
+           fileName,
+           lineNumber);
+
+    /*The handle is published atomically by the migrations, read it at once*/
+    component.handle = ZAJEL_ATOMIC_LOAD_RELAXED(&zajel_ptr->componentInformationArray[componentID].handle);
+
+    ASSERT((component.parameters.isMapped),
+           "zajel: component is not registered!",
+           fileName,
+           lineNumber);
+
+    return component.parameters.coreID;
+} /*function: zajel_get_component_core*/
+
+void zajel_get_memory_placement(zajel_s*                    zajel_ptr,
+                                zajel_memory_placement_s*   placement_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_mapping_s* mapping_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != placement_ptr),
+           "zajel: placement_ptr cannot be NULL!",
+           fileName,
+           lineNumber);
+
+    memset(placement_ptr,
+           0,
+           sizeof(zajel_memory_placement_s));
+
+    if(FALSE == zajel_ptr->isNumaEnabled)
+    {
+        return;
+    } /*if: <Nothing is mapped by the placement>*/
+
+    placement_ptr->nodeCount = zajel_numa_node_count();
+
+    /*The lock keeps the routes tables from being released while their pages are queried*/
+    zajel_placement_lock(zajel_ptr);
+
+    for(mapping_ptr = zajel_ptr->mapping_ptr; NULL != mapping_ptr; mapping_ptr = mapping_ptr->next_ptr)
+    {
+        /*<Query the pages of each mapped block>*/
+        zajel_numa_query(mapping_ptr->address_ptr,
+                         mapping_ptr->size,
+                         placement_ptr->nodeBytesArray,
+                         &placement_ptr->unresidentBytes);
+
+        placement_ptr->mappedBytes     += mapping_ptr->size;
+        placement_ptr->boundBytes      += mapping_ptr->boundBytes;
+        placement_ptr->hugePageBytes   += (mapping_ptr->isHuge) ? (mapping_ptr->size) : (0);
+        placement_ptr->mappingCount++;
+    } /*for: <Query the pages of each mapped block>*/
+
+    zajel_placement_unlock(zajel_ptr);
+} /*function: zajel_get_memory_placement*/
+
+void zajel_stats_snapshot(zajel_s*                  zajel_ptr,
+                          zajel_stats_s*            stats_ptr,
+                          zajel_stats_counters_s*   messageCounters_array COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->statsBase_ptr),
+           "zajel: Statistics are not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != stats_ptr),
+           "zajel: stats_ptr cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    memset(stats_ptr,
+           0,
+           sizeof(zajel_stats_s));
+
+    if(NULL != messageCounters_array)
+    {
+        memset(messageCounters_array,
+               0,
+               sizeof(zajel_stats_counters_s) * zajel_ptr->messageCount);
+    } /*if: <Message counters are wanted>*/
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        zajel_stats_merge(ZAJEL_THREAD_STATS(zajel_ptr,
+                                             i),
+                          zajel_ptr->messageCount,
+                          stats_ptr,
+                          messageCounters_array);
+    } /*for: <Merge the statistics of each thread>*/
+} /*function: zajel_stats_snapshot*/
+
+zajel_status_e zajel_trace_dump(zajel_s*    zajel_ptr,
+                                const char* path_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_trace_file_header_s   header;
+    zajel_trace_record_s*       recordArray;
+    FILE*                       file_ptr;
+    bool_t                      isWritten;
+    /*Temporary counter*/
+    uint32_t                    i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
      * o Validating inputs.
-     * o Releasing the allocated resources.
-     * o Resetting the control block pointer.
+     * o Writing the file header, with a second reading of the clocks.
+     * o Copying the ring of each thread out, then writing it.
+     */
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != zajel_ptr->traceRingArray_ptr),
+           "zajel: Trace is not enabled!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != path_ptr),
+           "zajel: path_ptr cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    /*Every ring has the same capacity, one copy buffer does for all of them*/
+    recordArray = (zajel_trace_record_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_trace_record_s) *
+                                                                            (zajel_ptr->traceRingArray_ptr[0].mask + 1));
+
+    if(NULL == recordArray)
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <No memory to copy the rings out>*/
+
+    file_ptr = fopen(path_ptr,
+                     "wb");
+
+    if(NULL == file_ptr)
+    {
+        zajel_ptr->deallocationFunction_ptr(recordArray);
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <File cannot be created>*/
+
+    memset(&header,
+           0,
+           sizeof(header));
+    header.magic            = ZAJEL_TRACE_FILE_MAGIC;
+    header.version          = ZAJEL_TRACE_FILE_VERSION;
+    header.threadCount      = zajel_ptr->threadCount;
+    header.startTimestamp   = zajel_ptr->traceStartTimestamp;
+    header.startNanoseconds = zajel_ptr->traceStartTime;
+    header.endTimestamp     = zajel_timestamp_now();
+    header.endNanoseconds   = zajel_time_now();
+
+    isWritten = (1 == fwrite(&header,
+                             sizeof(header),
+                             1,
+                             file_ptr)) ? (TRUE) : (FALSE);
+
+    for(i = 0; (i < zajel_ptr->threadCount) && (TRUE == isWritten); ++i)
+    {
+        isWritten = zajel_trace_thread_write(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                                                i),
+                                             i,
+                                             ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                                      i),
+                                             recordArray,
+                                             file_ptr);
+    } /*for: <Write the records of each thread>*/
+
+    if(0 != fclose(file_ptr))
+    {
+        isWritten = FALSE;
+    } /*if: <File could not be flushed>*/
+
+    zajel_ptr->deallocationFunction_ptr(recordArray);
+
+    return (TRUE == isWritten) ? (ZAJEL_STATUS_SUCCESS) : (ZAJEL_STATUS_FAILURE);
+} /*function: zajel_trace_dump*/
+
+zajel_payload_s* zajel_payload_alloc(zajel_s*   zajel_ptr,
+                                     uint32_t   size COMMA()
+                                     FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_payload_s* payload_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+
+    if(NULL != zajel_ptr->shm_ptr)
+    {
+        /*<Payload shall be reachable from the other cores>*/
+        payload_ptr = (zajel_payload_s*) zajel_shm_message_alloc(zajel_ptr->shm_ptr,
+                                                                 sizeof(zajel_payload_s) + size);
+    } /*if: <Payload shall be reachable from the other cores>*/
+    else
+    {
+        /*<Payload stays within this process>*/
+        payload_ptr = (zajel_payload_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_payload_s) + size);
+    } /*else: <Payload stays within this process>*/
+
+    if(NULL != payload_ptr)
+    {
+        payload_ptr->referenceCount = 1;
+        payload_ptr->size           = size;
+        payload_ptr->isShared       = (NULL != zajel_ptr->shm_ptr);
+        payload_ptr->reserved       = 0;
+    } /*if: <Allocation succeeded, the caller is the first owner>*/
+
+    return payload_ptr;
+} /*function: zajel_payload_alloc*/
+
+void zajel_payload_retain(zajel_s*          zajel_ptr,
+                          zajel_payload_s*  payload_ptr COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != payload_ptr),
+           "zajel: payload_ptr cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((0 != ZAJEL_ATOMIC_LOAD_RELAXED(&payload_ptr->referenceCount)),
+           "zajel: The payload was already released by all its owners!",
+           fileName,
+           lineNumber);
+
+    /*The reference count lives in the payload, the control block is only checked*/
+    (void) zajel_ptr;
+
+    ZAJEL_ATOMIC_FETCH_ADD(&payload_ptr->referenceCount, 1);
+} /*function: zajel_payload_retain*/
+
+void zajel_payload_release(zajel_s*         zajel_ptr,
+                           zajel_payload_s* payload_ptr COMMA()
+                           FILE_AND_LINE_FOR_TYPE())
+{
+    uint32_t referenceCount;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != payload_ptr),
+           "zajel: payload_ptr cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    referenceCount = ZAJEL_ATOMIC_FETCH_SUB(&payload_ptr->referenceCount, 1);
+
+    ASSERT((0 != referenceCount),
+           "zajel: The payload was already released by all its owners!",
+           fileName,
+           lineNumber);
+
+    if(1 == referenceCount)
+    {
+        /*<Last owner, free the payload where it was allocated>*/
+        if(payload_ptr->isShared)
+        {
+            ASSERT((NULL != zajel_ptr->shm_ptr),
+                   "zajel: A shared payload can only be freed with the shm transport enabled!",
+                   fileName,
+                   lineNumber);
+
+            zajel_shm_message_free(zajel_ptr->shm_ptr,
+                                   payload_ptr);
+        } /*if: <Payload lives in the shared region>*/
+        else
+        {
+            zajel_ptr->deallocationFunction_ptr(payload_ptr);
+        } /*else: <Payload was allocated using the allocation function>*/
+    } /*if: <Last owner, free the payload where it was allocated>*/
+} /*function: zajel_payload_release*/
+
+void zajel_payload_attach(zajel_s*          zajel_ptr,
+                          void*             message_ptr,
+                          zajel_payload_s*  payload_ptr COMMA()
+                          FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_payload_descriptor_s* payloadDescriptor_ptr;
+
+    payloadDescriptor_ptr = (zajel_payload_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((0 == (payloadDescriptor_ptr->linkedDescriptor.descriptor.flags &
+                  (ZAJEL_MESSAGE_FLAG_CALL | ZAJEL_MESSAGE_FLAG_PAYLOAD))),
+           "zajel: The message is a call, or already carries a payload!",
+           fileName,
+           lineNumber);
+
+    zajel_payload_retain(zajel_ptr,
+                         payload_ptr COMMA()
+                         FILE_AND_LINE_FOR_CALL());
+
+    if(payload_ptr->isShared)
+    {
+        payloadDescriptor_ptr->payloadHandle = zajel_shm_get_offset(zajel_ptr->shm_ptr,
+                                                                    payload_ptr) |
+                                               ZAJEL_PAYLOAD_HANDLE_SHARED;
+    } /*if: <Refer to the payload by offset, valid in all the processes>*/
+    else
+    {
+        payloadDescriptor_ptr->payloadHandle = (uint64_t)(uintptr_t) payload_ptr;
+    } /*else: <Refer to the payload by address>*/
+
+    payloadDescriptor_ptr->linkedDescriptor.descriptor.flags |= ZAJEL_MESSAGE_FLAG_PAYLOAD;
+} /*function: zajel_payload_attach*/
+
+zajel_payload_s* zajel_payload_get(zajel_s* zajel_ptr,
+                                   void*    message_ptr COMMA()
+                                   FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_payload_descriptor_s* payloadDescriptor_ptr;
+
+    payloadDescriptor_ptr = (zajel_payload_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+
+    if(0 == (payloadDescriptor_ptr->linkedDescriptor.descriptor.flags & ZAJEL_MESSAGE_FLAG_PAYLOAD))
+    {
+        return NULL;
+    } /*if: <Message carries no payload>*/
+
+    return zajel_payload_resolve(zajel_ptr,
+                                 payloadDescriptor_ptr->payloadHandle);
+} /*function: zajel_payload_get*/
+
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+
+STATIC INLINE zajel_route_s* zajel_route_get(zajel_s*   zajel_ptr,
+                                             uint32_t   sourceThreadID,
+                                             uint32_t   destinationComponentID)
+{
+    if(ZAJEL_UNLIKELY(ZAJEL_ROUTES_STATE_VALID != ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->routesState)))
+    {
+        /*<The mapping changed since the routes were built>*/
+        zajel_routes_build(zajel_ptr);
+    } /*if: <The mapping changed since the routes were built>*/
+
+    return zajel_route_lookup(zajel_ptr,
+                              sourceThreadID,
+                              destinationComponentID);
+} /*function: zajel_route_get*/
+
+STATIC INLINE zajel_route_s* zajel_route_lookup(zajel_s*    zajel_ptr,
+                                                uint32_t    sourceThreadID,
+                                                uint32_t    destinationComponentID)
+{
+    zajel_route_table_s*        table_ptr;
+    zajel_thread_information_s* thread_ptr;
+
+    table_ptr   = ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->routeTable_ptr);
+    thread_ptr  = &zajel_ptr->threadInformationArray[sourceThreadID];
+
+    if(ZAJEL_UNLIKELY(thread_ptr->routeEpoch != table_ptr->epoch))
+    {
+        /*<First use of a newly published table, this thread is done with the older ones>*/
+        ZAJEL_ATOMIC_STORE_RELEASE(&thread_ptr->routeEpoch, table_ptr->epoch);
+    } /*if: <First use of a newly published table, this thread is done with the older ones>*/
+
+    return ZAJEL_ROUTE(table_ptr,
+                       sourceThreadID,
+                       destinationComponentID);
+} /*function: zajel_route_lookup*/
+
+STATIC void zajel_send_message(zajel_s* zajel_ptr,
+                               void*    message_ptr,
+                               uint8_t  flags COMMA()
+                               FILE_AND_LINE_FOR_TYPE())
+{
+    zajel_message_descriptor_s*         descriptor_ptr;
+    uint32_t                            sourceThreadID;
+    bool_t                              isOutermost;
+
+    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid control block pointer!",
+           fileName,
+           lineNumber);
+    ASSERT((NULL != message_ptr),
+           "zajel: message_cannot equal NULL!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->messageID < zajel_ptr->messageCount),
+           "zajel: Message ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->messageID),
+           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->sourceComponentID < zajel_ptr->componentCount),
+           "zajel: Source component ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT((descriptor_ptr->destinationComponentID < zajel_ptr->componentCount),
+           "zajel: Destination component ID is greater than the supported message count!",
+           fileName,
+           lineNumber);
+    ASSERT(((TRUE == descriptor_ptr->isSynchronous) || (FALSE == descriptor_ptr->isSynchronous)),
+           "zajel: isSynchronous is niether true nor false!",
+           fileName,
+           lineNumber);
+    ASSERT(((FALSE == descriptor_ptr->isSynchronous) ||
+            (NULL == zajel_ptr->actorArray_ptr) ||
+            ((NULL == zajel_ptr->actorArray_ptr[descriptor_ptr->sourceComponentID]) &&
+             (NULL == zajel_ptr->actorArray_ptr[descriptor_ptr->destinationComponentID]))),
+           "zajel: Actors can only exchange asynchronous messages!",
+           fileName,
+           lineNumber);
+
+    descriptor_ptr->flags = (uint8_t) ((descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_SENDER_MASK) | flags);
+
+    sourceThreadID  = ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                    descriptor_ptr->sourceComponentID);
+    isOutermost     = zajel_send_begin(zajel_ptr,
+                                       sourceThreadID);
+
+    zajel_send_route(zajel_ptr,
+                     descriptor_ptr,
+                     zajel_route_get(zajel_ptr,
+                                     sourceThreadID,
+                                     descriptor_ptr->destinationComponentID),
+                     sourceThreadID,
+                     isOutermost);
+} /*function: zajel_send_message*/
+
+STATIC INLINE bool_t zajel_send_begin(zajel_s*  zajel_ptr,
+                                      uint32_t  threadID)
+{
+    zajel_thread_information_s* thread_ptr;
+    uint32_t                    sendCount;
+
+    thread_ptr  = &zajel_ptr->threadInformationArray[threadID];
+    sendCount   = ZAJEL_ATOMIC_LOAD_RELAXED(&thread_ptr->sendCount);
+
+    if(sendCount & 1)
+    {
+        return FALSE;
+    } /*if: <Already sending, a handler is sending along the way>*/
+
+    /*The count is made odd before the mapping is read, pairing with the fence of the migration*/
+    ZAJEL_ATOMIC_STORE_RELAXED(&thread_ptr->sendCount, sendCount + 1);
+    ZAJEL_ATOMIC_FENCE();
+
+    return TRUE;
+} /*function: zajel_send_begin*/
+
+STATIC INLINE void zajel_send_end(zajel_s*  zajel_ptr,
+                                  uint32_t  threadID,
+                                  bool_t    isOutermost)
+{
+    zajel_thread_information_s* thread_ptr;
+
+    if(TRUE == isOutermost)
+    {
+        /*<The messages are handed over before the count gets even>*/
+        thread_ptr = &zajel_ptr->threadInformationArray[threadID];
+
+        ZAJEL_ATOMIC_STORE_RELEASE(&thread_ptr->sendCount,
+                                   ZAJEL_ATOMIC_LOAD_RELAXED(&thread_ptr->sendCount) + 1);
+    } /*if: <The messages are handed over before the count gets even>*/
+} /*function: zajel_send_end*/
+
+STATIC INLINE void zajel_send_route(zajel_s*                     zajel_ptr,
+                                    zajel_message_descriptor_s*  descriptor_ptr,
+                                    zajel_route_s*               route_ptr,
+                                    uint32_t                     sourceThreadID,
+                                    bool_t                       isOutermost)
+{
+    /*
+     * Copies of the descriptor fields used after the message is handed over, an asynchronous
+     * message may already be released by its receiver by then
+     */
+    bool_t      isSynchronous;
+    uint32_t    sourceComponentID;
+    uint32_t    messageID;
+    uint32_t    relation;
+    /*Time at which the source thread got blocked, when the statistics are enabled*/
+    uint64_t    blockStart;
+
+    isSynchronous       = descriptor_ptr->isSynchronous;
+    sourceComponentID   = descriptor_ptr->sourceComponentID;
+    messageID           = descriptor_ptr->messageID;
+    relation            = route_ptr->relation;
+
+    if(ZAJEL_UNLIKELY(NULL != zajel_ptr->statsBase_ptr))
+    {
+        zajel_stats_send(zajel_ptr,
+                         sourceThreadID,
+                         descriptor_ptr,
+                         relation);
+    } /*if: <Statistics are enabled>*/
+
+    if(ZAJEL_UNLIKELY(FALSE != zajel_ptr->isTracing))
+    {
+        zajel_trace_message(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                               sourceThreadID),
+                            ZAJEL_TRACE_EVENT_SEND,
+                            descriptor_ptr);
+    } /*if: <Events are recorded>*/
+
+    if(ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD == relation)
+    {
+        /*<Both components are running in the same thread>*/
+        if(TRUE == isSynchronous)
+        {
+            /*<Synchronous message, call the handler directly>*/
+            zajel_send_end(zajel_ptr,
+                           sourceThreadID,
+                           isOutermost);
+
+            zajel_message_handle(zajel_ptr,
+                                 sourceThreadID,
+                                 descriptor_ptr);
+        } /*if: <Synchronous message, call the handler directly>*/
+        else
+        {
+            /*<Asynchronous message, deliver the message to the destination thread>*/
+            zajel_route_deliver(zajel_ptr,
+                                route_ptr,
+                                descriptor_ptr);
+
+            zajel_send_end(zajel_ptr,
+                           sourceThreadID,
+                           isOutermost);
+        } /*else: <Asynchronous message, deliver the message to the destination thread>*/
+    } /*if: <Both components are running in the same thread>*/
+    else
+    {
+        /*<Both components are running in different threads, the route leads to the thread or the core>*/
+        zajel_route_deliver(zajel_ptr,
+                            route_ptr,
+                            descriptor_ptr);
+
+        zajel_send_end(zajel_ptr,
+                       sourceThreadID,
+                       isOutermost);
+
+        if(TRUE == isSynchronous)
+        {
+            /*<Message is synchronous, framework will now block the source (calling) thread>*/
+            if(ZAJEL_UNLIKELY(FALSE != zajel_ptr->isTracing))
+            {
+                zajel_trace_message(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                                       sourceThreadID),
+                                    ZAJEL_TRACE_EVENT_BLOCK,
+                                    descriptor_ptr);
+            } /*if: <Events are recorded>*/
+
+            blockStart = (ZAJEL_UNLIKELY(NULL != zajel_ptr->statsBase_ptr)) ? (zajel_time_now()) : (0);
+
+            ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
+                                     sourceComponentID,
+                                     block);
+
+            if(ZAJEL_UNLIKELY(NULL != zajel_ptr->statsBase_ptr))
+            {
+                zajel_stats_count_block(ZAJEL_THREAD_STATS(zajel_ptr,
+                                                           sourceThreadID),
+                                        messageID,
+                                        relation,
+                                        zajel_time_now() - blockStart);
+            } /*if: <Count the time the source thread stayed blocked>*/
+
+            if(ZAJEL_UNLIKELY(FALSE != zajel_ptr->isTracing))
+            {
+                /*The message is still owned by the source thread until it resumes*/
+                zajel_trace_message(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                                       sourceThreadID),
+                                    ZAJEL_TRACE_EVENT_UNBLOCK,
+                                    descriptor_ptr);
+            } /*if: <Events are recorded>*/
+        } /*if: <Message is synchronous, framework will now block the source (calling) thread>*/
+    } /*else: <Both components are running in different threads, the route leads to the thread or the core>*/
+} /*function: zajel_send_route*/
+
+STATIC INLINE uint32_t zajel_message_priority(zajel_s*                      zajel_ptr,
+                                              zajel_message_descriptor_s*   descriptor_ptr)
+{
+    if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_PRIORITY_MASK)
+    {
+        return ((descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_PRIORITY_MASK) >> ZAJEL_MESSAGE_FLAG_PRIORITY_SHIFT) - 1;
+    } /*if: <Priority chosen by the sender>*/
+
+    return zajel_ptr->messagePriorityArray[descriptor_ptr->messageID];
+} /*function: zajel_message_priority*/
+
+STATIC INLINE void zajel_route_deliver(zajel_s*                     zajel_ptr,
+                                       zajel_route_s*               route_ptr,
+                                       zajel_message_descriptor_s*  descriptor_ptr)
+{
+    uint32_t priority;
+
+    if(NULL != route_ptr->boundedThread_ptr)
+    {
+        zajel_inbound_count(route_ptr->boundedThread_ptr,
+                            descriptor_ptr);
+    } /*if: <Destination thread has a bounded inbound capacity>*/
+
+    if(NULL != route_ptr->lanes_ptr)
+    {
+        /*<Destination thread has priority lanes>*/
+        priority = zajel_message_priority(zajel_ptr,
+                                          descriptor_ptr);
+
+        if(ZAJEL_PRIORITY_NORMAL != priority)
+        {
+            zajel_lane_push(route_ptr->lanes_ptr,
+                            priority,
+                            descriptor_ptr);
+
+            return;
+        } /*if: <Message does not go through the thread transport>*/
+    } /*if: <Destination thread has priority lanes>*/
+
+    route_ptr->deliverFunction(route_ptr->context_ptr,
+                               descriptor_ptr);
+} /*function: zajel_route_deliver*/
+
+STATIC INLINE void zajel_lane_push(zajel_lanes_s*               lanes_ptr,
+                                   uint32_t                     priority,
+                                   zajel_message_descriptor_s*  descriptor_ptr)
+{
+    ASSERT((priority < ZAJEL_PRIORITY_COUNT) && (ZAJEL_PRIORITY_NORMAL != priority),
+           "zajel: Invalid message priority!",
+           __FILE__,
+           __LINE__);
+
+    zajel_mailbox_push(&lanes_ptr->laneArray[priority],
+                       (zajel_linked_message_descriptor_s*) descriptor_ptr);
+
+    if(ZAJEL_THREAD_TRANSPORT_MAILBOX == lanes_ptr->thread_ptr->transport)
+    {
+        /*<The thread only parks on its own mailbox>*/
+        zajel_mailbox_wake(lanes_ptr->thread_ptr->mailbox_ptr);
+    } /*if: <The thread only parks on its own mailbox>*/
+} /*function: zajel_lane_push*/
+
+STATIC INLINE bool_t zajel_route_is_full(zajel_s*                     zajel_ptr,
+                                         zajel_route_s*               route_ptr,
+                                         zajel_message_descriptor_s*  descriptor_ptr)
+{
+    if((NULL != route_ptr->boundedThread_ptr) &&
+       (ZAJEL_ATOMIC_LOAD_RELAXED(&route_ptr->boundedThread_ptr->inboundCount) >= route_ptr->boundedThread_ptr->inboundCapacity))
+    {
+        return TRUE;
+    } /*if: <Destination thread reached its inbound capacity>*/
+
+    if(((zajel_route_to_ring == route_ptr->deliverFunction) ||
+        (zajel_route_to_own_ring == route_ptr->deliverFunction)) &&
+       ((NULL == route_ptr->lanes_ptr) ||
+        (ZAJEL_PRIORITY_NORMAL == zajel_message_priority(zajel_ptr,
+                                                         descriptor_ptr))))
+    {
+        /*<Message would go through the ring of the source thread>*/
+        return zajel_ring_is_full((zajel_ring_s*) route_ptr->context_ptr);
+    } /*if: <Message would go through the ring of the source thread>*/
+
+    return FALSE;
+} /*function: zajel_route_is_full*/
+
+STATIC INLINE void zajel_inbound_count(zajel_thread_information_s*  thread_ptr,
+                                       zajel_message_descriptor_s*  descriptor_ptr)
+{
+    descriptor_ptr->flags |= ZAJEL_MESSAGE_FLAG_COUNTED;
+    ZAJEL_ATOMIC_FETCH_ADD(&thread_ptr->inboundCount, 1);
+} /*function: zajel_inbound_count*/
+
+STATIC INLINE void zajel_inbound_release(zajel_thread_information_s*    thread_ptr,
+                                         void**                         message_ptr_array,
+                                         uint32_t                       count)
+{
+    zajel_message_descriptor_s* descriptor_ptr;
+    /*Number of the collected messages which were counted*/
+    uint32_t                    counted;
+    /*Temporary counter*/
+    uint32_t                    i;
+
+    if(0 == thread_ptr->inboundCapacity)
+    {
+        return;
+    } /*if: <Inbound capacity is not bounded>*/
+
+    counted = 0;
+
+    for(i = 0; i < count; ++i)
+    {
+        /*<Uncount the flagged messages>*/
+        descriptor_ptr = (zajel_message_descriptor_s*) message_ptr_array[i];
+
+        if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_COUNTED)
+        {
+            descriptor_ptr->flags &= (uint8_t) ~ZAJEL_MESSAGE_FLAG_COUNTED;
+            ++counted;
+        } /*if: <Message was counted when queued>*/
+    } /*for: <Uncount the flagged messages>*/
+
+    if(counted)
+    {
+        ZAJEL_ATOMIC_FETCH_SUB(&thread_ptr->inboundCount, counted);
+    } /*if: <Give the room back to the senders>*/
+} /*function: zajel_inbound_release*/
+
+STATIC void zajel_routes_build(zajel_s* zajel_ptr)
+{
+    /*Expected state, used to elect the thread building the routes*/
+    uint32_t state;
+
+    state = ZAJEL_ROUTES_STATE_INVALID;
+
+    if(FALSE == ZAJEL_ATOMIC_CAS(&zajel_ptr->routesState,
+                                 &state,
+                                 ZAJEL_ROUTES_STATE_BUILDING))
+    {
+        /*<Another thread is building the routes (or just did), wait for it>*/
+        while(ZAJEL_ROUTES_STATE_VALID != ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->routesState))
+        {
+            ZAJEL_CPU_RELAX();
+        } /*while: <Routes are being built>*/
+
+        return;
+    } /*if: <Another thread is building the routes (or just did), wait for it>*/
+
+    if(NULL == zajel_ptr->routeTable_ptr)
+    {
+        /*<First build, the table is rebuilt in place until the topology is sealed>*/
+        zajel_ptr->routeTable_ptr = zajel_route_table_alloc(zajel_ptr,
+                                                            1);
+    } /*if: <First build, the table is rebuilt in place until the topology is sealed>*/
+
+    zajel_routes_fill(zajel_ptr,
+                      zajel_ptr->routeTable_ptr);
+
+    if(NULL != zajel_ptr->subscriptionArray_ptr)
+    {
+        zajel_topics_build(zajel_ptr);
+    } /*if: <Order the subscriptions by destination>*/
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&zajel_ptr->routesState, ZAJEL_ROUTES_STATE_VALID);
+} /*function: zajel_routes_build*/
+
+STATIC zajel_route_table_s* zajel_route_table_alloc(zajel_s*    zajel_ptr,
+                                                    uint32_t    epoch)
+{
+    zajel_route_table_s*    table_ptr;
+    void*                   memory_ptr;
+    /*Size of the table, rounded up to keep the routes aligned*/
+    uintptr_t               tableSize;
+    /*Distance between the routes of two threads, and its alignment*/
+    uintptr_t               rowStride;
+    uintptr_t               granule;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    granule     = zajel_placement_granule(zajel_ptr,
+                                          sizeof(zajel_route_s) * zajel_ptr->componentCount);
+    rowStride   = ZAJEL_NUMA_ALIGN_UP(sizeof(zajel_route_s) * zajel_ptr->componentCount, granule);
+    tableSize   = ZAJEL_NUMA_ALIGN_UP(ZAJEL_CACHE_ALIGN_UP(sizeof(zajel_route_table_s)), granule);
+
+    /*The table, then the routes starting on their own cache line (on their own page for each thread once placed)*/
+    memory_ptr = zajel_placement_alloc(zajel_ptr,
+                                       ZAJEL_CACHE_LINE_SIZE +
+                                       tableSize +
+                                       (rowStride * zajel_ptr->threadCount),
+                                       granule);
+    ASSERT((NULL != memory_ptr),
+           "zajel: Failed to allocate a memory for the routes!",
+           __FILE__,
+           __LINE__);
+
+    table_ptr                   = (zajel_route_table_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t)memory_ptr);
+    table_ptr->routeArray_ptr   = (zajel_route_s*) ((uintptr_t)table_ptr + tableSize);
+    table_ptr->rowStride        = rowStride;
+    table_ptr->epoch            = epoch;
+    table_ptr->next_ptr         = NULL;
+    table_ptr->memory_ptr       = memory_ptr;
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Each thread only reads its own routes, they are placed on its node>*/
+        zajel_placement_bind(zajel_ptr,
+                             memory_ptr,
+                             ZAJEL_ROUTE(table_ptr,
+                                         i,
+                                         0),
+                             rowStride,
+                             i);
+    } /*for: <Each thread only reads its own routes, they are placed on its node>*/
+
+    return table_ptr;
+} /*function: zajel_route_table_alloc*/
+
+STATIC void zajel_routes_fill(zajel_s*              zajel_ptr,
+                              zajel_route_table_s*  table_ptr)
+{
+    zajel_component_information_u   source;
+    zajel_component_information_u   decision;
+    zajel_component_information_u*  destination_ptr;
+    zajel_thread_information_s*     destinationThread_ptr;
+    zajel_route_s*                  route_ptr;
+    uint32_t                        threadID;
+    uint32_t                        componentID;
+
+    for(threadID = 0; threadID < zajel_ptr->threadCount; ++threadID)
+    {
+        /*<Resolve the routes of each source thread>*/
+        source.handle               = 0;
+        source.parameters.threadID  = threadID;
+        source.parameters.coreID    = ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                               threadID);
+
+        for(componentID = 0; componentID < zajel_ptr->componentCount; ++componentID)
+        {
+            /*<Resolve the route to each destination component>*/
+            route_ptr               = ZAJEL_ROUTE(table_ptr,
+                                                  threadID,
+                                                  componentID);
+            destination_ptr         = &zajel_ptr->componentInformationArray[componentID];
+            destinationThread_ptr   = &zajel_ptr->threadInformationArray[destination_ptr->parameters.threadID];
+            decision.handle         = source.handle ^ destination_ptr->handle;
+            route_ptr->lanes_ptr    = NULL;
+
+            route_ptr->boundedThread_ptr = NULL;
+
+            if(decision.parameters.coreID)
+            {
+                /*<Destination runs on a different core>*/
+                route_ptr->relation = ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES;
+
+                if(NULL != zajel_ptr->shm_ptr)
+                {
+                    route_ptr->deliverFunction  = zajel_shm_push;
+                    route_ptr->context_ptr      = zajel_shm_get_port(zajel_ptr->shm_ptr,
+                                                                     destination_ptr->parameters.coreID);
+                } /*if: <Shared region carries the messages>*/
+                else
+                {
+                    route_ptr->deliverFunction  = zajel_route_to_core_callback;
+                    route_ptr->context_ptr      = &zajel_ptr->coreInformationArray[destination_ptr->parameters.coreID];
+                } /*else: <Core callback carries the messages>*/
+
+                continue;
+            } /*if: <Destination runs on a different core>*/
+
+            if((NULL != zajel_ptr->actorArray_ptr) &&
+               (NULL != zajel_ptr->actorArray_ptr[componentID]))
+            {
+                /*<Destination is an actor, whichever thread runs it, the route leads to its mailbox>*/
+                route_ptr->relation         = ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE;
+                route_ptr->deliverFunction  = zajel_route_to_actor;
+                route_ptr->context_ptr      = zajel_ptr->actorArray_ptr[componentID];
+
+                continue;
+            } /*if: <Destination is an actor, whichever thread runs it, the route leads to its mailbox>*/
+
+            route_ptr->relation = (decision.parameters.threadID) ?
+                                  (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE) :
+                                  (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD);
+
+            switch(destinationThread_ptr->transport)
+            {
+                /*<Destination runs on this core, the route leads to its thread transport>*/
+                case ZAJEL_THREAD_TRANSPORT_RING:
+                    route_ptr->deliverFunction  = (decision.parameters.threadID) ?
+                                                  (zajel_route_to_ring) :
+                                                  (zajel_route_to_own_ring);
+                    route_ptr->context_ptr      = ZAJEL_THREAD_RING(zajel_ptr,
+                                                                    threadID,
+                                                                    destination_ptr->parameters.threadID);
+                    route_ptr->lanes_ptr        = ZAJEL_THREAD_LANES(zajel_ptr,
+                                                                     destination_ptr->parameters.threadID);
+                    break;
+                case ZAJEL_THREAD_TRANSPORT_MAILBOX:
+                    route_ptr->deliverFunction  = zajel_route_to_mailbox;
+                    route_ptr->context_ptr      = destinationThread_ptr->mailbox_ptr;
+                    route_ptr->lanes_ptr        = ZAJEL_THREAD_LANES(zajel_ptr,
+                                                                     destination_ptr->parameters.threadID);
+                    break;
+                default:
+                    route_ptr->deliverFunction  = zajel_route_to_thread_callback;
+                    route_ptr->context_ptr      = destinationThread_ptr;
+                    break;
+            } /*switch: <Destination runs on this core, the route leads to its thread transport>*/
+
+            if((ZAJEL_THREAD_TRANSPORT_CALLBACK != destinationThread_ptr->transport) &&
+               (destinationThread_ptr->inboundCapacity))
+            {
+                route_ptr->boundedThread_ptr = destinationThread_ptr;
+            } /*if: <The framework owns the queues of the destination thread, and bounds them>*/
+        } /*for: <Resolve the route to each destination component>*/
+    } /*for: <Resolve the routes of each source thread>*/
+} /*function: zajel_routes_fill*/
+
+STATIC void zajel_routes_publish(zajel_s* zajel_ptr)
+{
+    zajel_route_table_s* table_ptr;
+
+    table_ptr = zajel_route_table_alloc(zajel_ptr,
+                                        zajel_ptr->routeTable_ptr->epoch + 1);
+
+    zajel_routes_fill(zajel_ptr,
+                      table_ptr);
+
+    if(NULL != zajel_ptr->subscriptionArray_ptr)
+    {
+        zajel_topics_build(zajel_ptr);
+    } /*if: <Refresh the mapping of the subscribers>*/
+
+    /*The senders switch to the new table, the replaced one is kept until they all did*/
+    zajel_ptr->routeTable_ptr->next_ptr = zajel_ptr->retiredRouteTable_ptr;
+    zajel_ptr->retiredRouteTable_ptr    = zajel_ptr->routeTable_ptr;
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&zajel_ptr->routeTable_ptr, table_ptr);
+} /*function: zajel_routes_publish*/
+
+STATIC void zajel_routes_reclaim(zajel_s* zajel_ptr)
+{
+    zajel_route_table_s*    table_ptr;
+    zajel_route_table_s**   link_ptr;
+    /*Oldest table epoch still used by a thread*/
+    uint32_t                oldestEpoch;
+    uint32_t                epoch;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    oldestEpoch = zajel_ptr->routeTable_ptr->epoch;
+
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        /*<Find the oldest table a thread may still be using>*/
+        epoch = ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->threadInformationArray[i].routeEpoch);
+
+        if(epoch < oldestEpoch)
+        {
+            oldestEpoch = epoch;
+        } /*if: <Thread did not use the newer tables yet>*/
+    } /*for: <Find the oldest table a thread may still be using>*/
+
+    link_ptr = &zajel_ptr->retiredRouteTable_ptr;
+
+    while(NULL != *link_ptr)
+    {
+        /*<Free the tables older than the ones in use>*/
+        table_ptr = *link_ptr;
+
+        if(table_ptr->epoch < oldestEpoch)
+        {
+            *link_ptr = table_ptr->next_ptr;
+            zajel_placement_free(zajel_ptr,
+                                 table_ptr->memory_ptr);
+        } /*if: <No thread uses this table anymore>*/
+        else
+        {
+            link_ptr = &table_ptr->next_ptr;
+        } /*else: <Table may still be in use>*/
+    } /*while: <Free the tables older than the ones in use>*/
+} /*function: zajel_routes_reclaim*/
+
+STATIC void zajel_route_to_ring(void*                       context_ptr,
+                                zajel_message_descriptor_s* descriptor_ptr)
+{
+    while(FALSE == zajel_ring_push((zajel_ring_s*) context_ptr,
+                                   descriptor_ptr))
+    {
+        /*<Ring is full, wait for the consumer to catch up>*/
+        ZAJEL_CPU_RELAX();
+    } /*while: <Ring is full, wait for the consumer to catch up>*/
+} /*function: zajel_route_to_ring*/
+
+STATIC void zajel_route_to_own_ring(void*                       context_ptr,
+                                    zajel_message_descriptor_s* descriptor_ptr)
+{
+    while(FALSE == zajel_ring_push((zajel_ring_s*) context_ptr,
+                                   descriptor_ptr))
+    {
+        /*<Ring is full>*/
+
+        /*
+         * A thread sending to itself can never drain its own ring while waiting, so the ring capacity
+         * must be big enough for the self-addressed messages generated within a single handler.
+         */
+        ASSERT((FALSE),
+               "zajel: Ring of a thread to itself is full, increase the ring capacity!",
+               __FILE__,
+               __LINE__);
+        ZAJEL_CPU_RELAX();
+    } /*while: <Ring is full>*/
+} /*function: zajel_route_to_own_ring*/
+
+STATIC void zajel_route_to_mailbox(void*                        context_ptr,
+                                   zajel_message_descriptor_s*  descriptor_ptr)
+{
+    zajel_mailbox_push((zajel_mailbox_s*) context_ptr,
+                       (zajel_linked_message_descriptor_s*) descriptor_ptr);
+} /*function: zajel_route_to_mailbox*/
+
+STATIC void zajel_route_to_actor(void*                          context_ptr,
+                                 zajel_message_descriptor_s*    descriptor_ptr)
+{
+    if(TRUE == zajel_actor_post((zajel_actor_s*) context_ptr,
+                                (zajel_linked_message_descriptor_s*) descriptor_ptr))
+    {
+        zajel_actor_schedule((zajel_actor_s*) context_ptr);
+    } /*if: <Actor just became runnable>*/
+} /*function: zajel_route_to_actor*/
+
+STATIC void zajel_route_to_thread_callback(void*                        context_ptr,
+                                           zajel_message_descriptor_s*  descriptor_ptr)
+{
+    ((zajel_thread_information_s*) context_ptr)->handleMessageCallback(descriptor_ptr);
+} /*function: zajel_route_to_thread_callback*/
+
+STATIC void zajel_route_to_core_callback(void*                          context_ptr,
+                                         zajel_message_descriptor_s*    descriptor_ptr)
+{
+    ((zajel_core_information_s*) context_ptr)->handleMessageCallback(descriptor_ptr);
+} /*function: zajel_route_to_core_callback*/
+
+STATIC uint32_t zajel_thread_collect(zajel_s*   zajel_ptr,
+                                     uint32_t   threadID,
+                                     void**     message_ptr_array,
+                                     uint32_t   maxCount)
+{
+    zajel_mailbox_s*                    lane_ptr;
+    /*Number of messages collected so far*/
+    uint32_t                            count;
+    /*Number of messages the lane may give in the current pass*/
+    uint32_t                            quota;
+    uint32_t                            pass;
+    uint32_t                            priority;
+
+    if(NULL == zajel_ptr->laneArray_ptr)
+    {
+        /*<No priority lanes>*/
+        count = zajel_thread_collect_transport(zajel_ptr,
+                                               threadID,
+                                               message_ptr_array,
+                                               maxCount);
+
+        zajel_inbound_release(&zajel_ptr->threadInformationArray[threadID],
+                              message_ptr_array,
+                              count);
+
+        return count;
+    } /*if: <No priority lanes>*/
+
+    count = 0;
+
+    /*
+     * The lanes are collected from the most urgent one. Weighted lanes first get up to their share
+     * of the batch, then the room left is filled by priority.
      */
+    for(pass = (TRUE == zajel_ptr->isLaneWeighted) ? 0 : 1; pass < 2; ++pass)
+    {
+        for(priority = 0; (priority < ZAJEL_PRIORITY_COUNT) && (count < maxCount); ++priority)
+        {
+            /*<Collect each lane, up to its quota>*/
+            quota = maxCount - count;
+
+            if((0 == pass) &&
+               (quota > zajel_ptr->laneWeightArray[priority]))
+            {
+                quota = zajel_ptr->laneWeightArray[priority];
+            } /*if: <Limit the lane to its share>*/
+
+            if(ZAJEL_PRIORITY_NORMAL == priority)
+            {
+                count += zajel_thread_collect_transport(zajel_ptr,
+                                                        threadID,
+                                                        &message_ptr_array[count],
+                                                        quota);
+                continue;
+            } /*if: <The normal lane is the thread transport>*/
+
+            lane_ptr = &zajel_ptr->laneArray_ptr[threadID].laneArray[priority];
+
+            while(quota--)
+            {
+                message_ptr_array[count] = zajel_mailbox_pop(lane_ptr);
+
+                if(NULL == message_ptr_array[count])
+                {
+                    break;
+                } /*if: <Lane is empty>*/
+
+                ++count;
+            } /*while: <Lane may give more messages>*/
+        } /*for: <Collect each lane, up to its quota>*/
+    } /*for: <Shares first (weighted lanes only), then by priority>*/
+
+    zajel_inbound_release(&zajel_ptr->threadInformationArray[threadID],
+                          message_ptr_array,
+                          count);
+
+    return count;
+} /*function: zajel_thread_collect*/
+
+STATIC uint32_t zajel_thread_collect_transport(zajel_s*     zajel_ptr,
+                                               uint32_t     threadID,
+                                               void**       message_ptr_array,
+                                               uint32_t     maxCount)
+{
+    zajel_thread_information_s* thread_ptr;
+    /*Number of messages collected so far*/
+    uint32_t                    count;
+    /*The producer thread currently being drained*/
+    uint32_t                    producerThreadID;
+    /*Temporary counter*/
+    uint32_t                    i;
+
+    thread_ptr          = &zajel_ptr->threadInformationArray[threadID];
+    count               = 0;
+
+    if(ZAJEL_THREAD_TRANSPORT_MAILBOX == thread_ptr->transport)
+    {
+        /*<Drain the thread mailbox>*/
+        while(count < maxCount)
+        {
+            message_ptr_array[count] = zajel_mailbox_pop(thread_ptr->mailbox_ptr);
+
+            if(NULL == message_ptr_array[count])
+            {
+                break;
+            } /*if: <Mailbox is empty>*/
+
+            ++count;
+        } /*while: <Caller buffer is not full>*/
+
+        return count;
+    } /*if: <Drain the thread mailbox>*/
+
+    if(ZAJEL_UNLIKELY(ZAJEL_ATOMIC_LOAD_RELAXED(&zajel_ptr->heldMarkerCount)))
+    {
+        zajel_migration_release_markers(zajel_ptr,
+                                        threadID);
+    } /*if: <A migrating component may wait for this thread>*/
+
+    producerThreadID    = thread_ptr->pollCursor;
+
+    for(i = 0; (i < zajel_ptr->threadCount) && (count < maxCount); ++i)
+    {
+        /*<Drain the incoming rings, starting by the one after the last drained ring>*/
+        count += zajel_ring_pop_burst(ZAJEL_THREAD_RING(zajel_ptr,
+                                                        producerThreadID,
+                                                        threadID),
+                                      &message_ptr_array[count],
+                                      maxCount - count);
+
+        producerThreadID = (producerThreadID + 1 < zajel_ptr->threadCount) ? (producerThreadID + 1) : (0);
+    } /*for: <Drain the incoming rings, starting by the one after the last drained ring>*/
+
+    thread_ptr->pollCursor = producerThreadID;
+
+    return count;
+} /*function: zajel_thread_collect_transport*/
+
+STATIC void zajel_thread_handle_message_batch(zajel_s*                      zajel_ptr,
+                                              uint32_t                      producerThreadID,
+                                              uint32_t                      consumerThreadID,
+                                              zajel_message_descriptor_s**  descriptor_ptr_array,
+                                              uint32_t                      count)
+{
+    zajel_thread_information_s*         thread_ptr;
+    zajel_linked_message_descriptor_s*  linked_ptr;
+    /*Number of messages handed over so far*/
+    uint32_t                            done;
+    /*Temporary counter*/
+    uint32_t                            i;
+
+    thread_ptr = &zajel_ptr->threadInformationArray[consumerThreadID];
+
+    if((ZAJEL_THREAD_TRANSPORT_CALLBACK != thread_ptr->transport) &&
+       (thread_ptr->inboundCapacity))
+    {
+        /*<Count the whole group against the inbound capacity, with a single atomic update>*/
+        for(i = 0; i < count; ++i)
+        {
+            descriptor_ptr_array[i]->flags |= ZAJEL_MESSAGE_FLAG_COUNTED;
+        } /*for: <Flag the messages, to be uncounted when collected>*/
+
+        ZAJEL_ATOMIC_FETCH_ADD(&thread_ptr->inboundCount, count);
+    } /*if: <Count the whole group against the inbound capacity, with a single atomic update>*/
+
+    switch(thread_ptr->transport)
+    {
+        /*<Use the cheapest batch hand over of the consumer transport>*/
+
+        case ZAJEL_THREAD_TRANSPORT_RING:
+            /*<Publish the whole group with a single head update (as long as it fits)>*/
+            done = 0;
+
+            while(done < count)
+            {
+                done += zajel_ring_push_burst(ZAJEL_THREAD_RING(zajel_ptr,
+                                                                producerThreadID,
+                                                                consumerThreadID),
+                                              (void**) &descriptor_ptr_array[done],
+                                              count - done);
+
+                if(done < count)
+                {
+                    /*<Ring is full, wait for the consumer to catch up>*/
+                    ASSERT((producerThreadID != consumerThreadID),
+                           "zajel: Ring of a thread to itself is full, increase the ring capacity!",
+                           __FILE__,
+                           __LINE__);
+                    ZAJEL_CPU_RELAX();
+                } /*if: <Ring is full, wait for the consumer to catch up>*/
+            } /*while: <Group is not completely published>*/
+
+            break;/*<Publish the whole group with a single head update (as long as it fits)>*/
+        case ZAJEL_THREAD_TRANSPORT_MAILBOX:
+            /*<Chain the group, then push it with a single exchange>*/
+            for(i = 0; (i + 1) < count; ++i)
+            {
+                linked_ptr              = (zajel_linked_message_descriptor_s*) descriptor_ptr_array[i];
+                linked_ptr->next_ptr    = (zajel_linked_message_descriptor_s*) descriptor_ptr_array[i + 1];
+            } /*for: <Link each message to the next one>*/
+
+            zajel_mailbox_push_chain(thread_ptr->mailbox_ptr,
+                                     (zajel_linked_message_descriptor_s*) descriptor_ptr_array[0],
+                                     (zajel_linked_message_descriptor_s*) descriptor_ptr_array[count - 1]);
+
+            break;/*<Chain the group, then push it with a single exchange>*/
+        default:
+            /*<User callbacks>*/
+            if(NULL != thread_ptr->handleMessageBatchCallback)
+            {
+                thread_ptr->handleMessageBatchCallback(descriptor_ptr_array,
+                                                       count);
+            } /*if: <Thread accepts batches>*/
+            else
+            {
+                for(i = 0; i < count; ++i)
+                {
+                    thread_ptr->handleMessageCallback(descriptor_ptr_array[i]);
+                } /*for: <Hand the messages one by one>*/
+            } /*else: <Thread only accepts single messages>*/
+
+            break;/*<User callbacks>*/
+    } /*switch: <Use the cheapest batch hand over of the consumer transport>*/
+} /*function: zajel_thread_handle_message_batch*/
+
+STATIC void zajel_core_handle_message_batch(zajel_s*                      zajel_ptr,
+                                            uint32_t                      coreID,
+                                            zajel_message_descriptor_s**  descriptor_ptr_array,
+                                            uint32_t                      count)
+{
+    zajel_core_information_s*   core_ptr;
+    /*Temporary counter*/
+    uint32_t                    i;
+
+    core_ptr = &zajel_ptr->coreInformationArray[coreID];
+
+    if(NULL != zajel_ptr->shm_ptr)
+    {
+        /*<Shared region carries the messages>*/
+        for(i = 0; i < count; ++i)
+        {
+            zajel_shm_push(zajel_shm_get_port(zajel_ptr->shm_ptr,
+                                              coreID),
+                           descriptor_ptr_array[i]);
+        } /*for: <Push the messages one by one>*/
+    } /*if: <Shared region carries the messages>*/
+    else if(NULL != core_ptr->handleMessageBatchCallback)
+    {
+        /*<Core accepts batches>*/
+        core_ptr->handleMessageBatchCallback(descriptor_ptr_array,
+                                             count);
+    } /*if: <Core accepts batches>*/
+    else
+    {
+        /*<Core only accepts single messages>*/
+        for(i = 0; i < count; ++i)
+        {
+            core_ptr->handleMessageCallback(descriptor_ptr_array[i]);
+        } /*for: <Hand the messages one by one>*/
+    } /*else: <Core only accepts single messages>*/
+} /*function: zajel_core_handle_message_batch*/
+
+STATIC INLINE void zajel_message_handle(zajel_s*                    zajel_ptr,
+                                        uint32_t                    callerThreadID,
+                                        zajel_message_descriptor_s* descriptor_ptr)
+{
+    zajel_component_information_u       destination;
+    const zajel_message_information_s*  information_ptr;
+    zajel_route_s*                      route_ptr;
+    zajel_actor_s*                      actor_ptr;
+
+    destination.handle = zajel_ptr->componentInformationArray[descriptor_ptr->destinationComponentID].handle;
+
+    if(ZAJEL_LIKELY(0 == (descriptor_ptr->flags & (ZAJEL_MESSAGE_FLAG_PAYLOAD |
+                                                   ZAJEL_MESSAGE_FLAG_TOPIC |
+                                                   ZAJEL_MESSAGE_FLAG_MIGRATION |
+                                                   ZAJEL_MESSAGE_FLAG_FORWARDED))) &&
+       ZAJEL_LIKELY(destination.parameters.threadID == callerThreadID) &&
+       ZAJEL_LIKELY(0 == destination.parameters.migrationSlot) &&
+       ZAJEL_LIKELY(NULL == zajel_ptr->balanceCounterArray_ptr) &&
+       ZAJEL_LIKELY(NULL == zajel_ptr->actorArray_ptr) &&
+       ZAJEL_LIKELY(NULL == zajel_ptr->statsBase_ptr) &&
+       ZAJEL_LIKELY(FALSE == zajel_ptr->isTracing))
+    {
+        information_ptr = zajel_handler_get(zajel_ptr,
+                                            descriptor_ptr);
+
+        ZAJEL_MESSAGE_HANDLER_CALL(information_ptr,
+                                   descriptor_ptr);
+    } /*if: <Plain message>*/
+    else if(NULL != (actor_ptr = zajel_actor_get(zajel_ptr,
+                                                 descriptor_ptr)))
+    {
+        /*<Destination is an actor, it runs the message whenever a thread of the core picks it up>*/
+        zajel_route_to_actor(actor_ptr,
+                             descriptor_ptr);
+    } /*else if: <Destination is an actor, it runs the message whenever a thread of the core picks it up>*/
+    else if(TRUE == zajel_migration_applies(zajel_ptr,
+                                            descriptor_ptr))
+    {
+        zajel_migration_handle(zajel_ptr,
+                               callerThreadID,
+                               descriptor_ptr);
+    } /*else if: <Destination is being migrated>*/
+    else if((destination.parameters.threadID != callerThreadID) &&
+            ((0 == (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_TOPIC)) ||
+             (1 == ((zajel_topic_envelope_s*) descriptor_ptr)->subscriptionCount)))
+    {
+        /*<Sent along the old route while the destination was being migrated away, pass it on>*/
+        descriptor_ptr->flags  |= ZAJEL_MESSAGE_FLAG_FORWARDED;
+        route_ptr               = zajel_route_get(zajel_ptr,
+                                                  callerThreadID,
+                                                  descriptor_ptr->destinationComponentID);
+
+        route_ptr->deliverFunction(route_ptr->context_ptr,
+                                   descriptor_ptr);
+    } /*else if: <Sent along the old route while the destination was being migrated away, pass it on>*/
+    else
+    {
+        /*<A message forwarded during a migration may arrive once it is over>*/
+        descriptor_ptr->flags &= (uint8_t) ~ZAJEL_MESSAGE_FLAG_FORWARDED;
+
+        zajel_message_run(zajel_ptr,
+                          callerThreadID,
+                          descriptor_ptr);
+    } /*else: <A message forwarded during a migration may arrive once it is over>*/
+} /*function: zajel_message_handle*/
+
+STATIC void zajel_message_run(zajel_s*                      zajel_ptr,
+                              uint32_t                      callerThreadID,
+                              zajel_message_descriptor_s*   descriptor_ptr)
+{
+    uint64_t payloadHandle;
+
+    if(ZAJEL_UNLIKELY(NULL != zajel_ptr->statsBase_ptr) &&
+       (0 == (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_TOPIC)))
+    {
+        zajel_stats_deliver(zajel_ptr,
+                            callerThreadID,
+                            descriptor_ptr);
+    } /*if: <Statistics are enabled, the published messages are not counted>*/
+
+    if(0 == (descriptor_ptr->flags & (ZAJEL_MESSAGE_FLAG_PAYLOAD | ZAJEL_MESSAGE_FLAG_TOPIC)))
+    {
+        zajel_handler_run(zajel_ptr,
+                          callerThreadID,
+                          zajel_handler_get(zajel_ptr,
+                                            descriptor_ptr),
+                          descriptor_ptr);
+    } /*if: <Plain message>*/
+    else if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_TOPIC)
+    {
+        zajel_topic_handle(zajel_ptr,
+                           callerThreadID,
+                           (zajel_topic_envelope_s*) descriptor_ptr);
+    } /*else if: <Published message, owned by the framework>*/
+    else
+    {
+        /*<Message carries a payload, drop its reference once handled>*/
+        payloadHandle = ((zajel_payload_descriptor_s*) descriptor_ptr)->payloadHandle;
+
+        zajel_handler_run(zajel_ptr,
+                          callerThreadID,
+                          zajel_handler_get(zajel_ptr,
+                                            descriptor_ptr),
+                          descriptor_ptr);
+
+        zajel_payload_release(zajel_ptr,
+                              zajel_payload_resolve(zajel_ptr,
+                                                    payloadHandle) COMMA()
+                              FILE_AND_LINE_FOR_REF());
+    } /*else: <Message carries a payload, drop its reference once handled>*/
+} /*function: zajel_message_run*/
+
+STATIC void zajel_message_unused(zajel_message_descriptor_s* descriptor_ptr)
+{
+    ASSERT((FALSE),
+           "zajel: Received a message declared as unused!",
+           __FILE__,
+           __LINE__);
+
+    (void) descriptor_ptr;
+} /*function: zajel_message_unused*/
+
+STATIC INLINE const zajel_message_information_s* zajel_handler_get(zajel_s*                            zajel_ptr,
+                                                                   const zajel_message_descriptor_s*   descriptor_ptr)
+{
+    zajel_handler_table_s*  table_ptr;
+    uint32_t                index;
+
+    if(NULL != zajel_ptr->handlerTableArray_ptr)
+    {
+        /*<Some components have their own handlers, look for the one of the destination first>*/
+        table_ptr   = &zajel_ptr->handlerTableArray_ptr[descriptor_ptr->destinationComponentID];
+        /*A message ID below the first one wraps around, and is beyond the count as well*/
+        index       = (uint32_t) descriptor_ptr->messageID - table_ptr->firstMessageID;
+
+        if((index < table_ptr->count) &&
+           (NULL != table_ptr->entryArray[index].componentHandlerFunction))
+        {
+            return &table_ptr->entryArray[index];
+        } /*if: <Destination has its own handler for this message>*/
+    } /*if: <Some components have their own handlers, look for the one of the destination first>*/
+
+    return &zajel_ptr->messageInformationArray[descriptor_ptr->messageID];
+} /*function: zajel_handler_get*/
+
+STATIC INLINE void zajel_handler_run(zajel_s*                           zajel_ptr,
+                                     uint32_t                           callerThreadID,
+                                     const zajel_message_information_s* information_ptr,
+                                     zajel_message_descriptor_s*        descriptor_ptr)
+{
+    uint32_t componentID;
+    uint32_t sourceComponentID;
+    uint32_t messageID;
+
+    if(ZAJEL_LIKELY(NULL == zajel_ptr->balanceCounterArray_ptr) &&
+       ZAJEL_LIKELY(FALSE == zajel_ptr->isTracing))
+    {
+        ZAJEL_MESSAGE_HANDLER_CALL(information_ptr,
+                                   descriptor_ptr);
+        return;
+    } /*if: <Load balancer is disabled, and events are not recorded>*/
+
+    /*The descriptor is read beforehand, as the handler may free the message*/
+    componentID         = descriptor_ptr->destinationComponentID;
+    sourceComponentID   = descriptor_ptr->sourceComponentID;
+    messageID           = descriptor_ptr->messageID;
+
+    if(FALSE != zajel_ptr->isTracing)
+    {
+        zajel_trace_write(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                             callerThreadID),
+                          ZAJEL_TRACE_EVENT_HANDLER_ENTRY,
+                          descriptor_ptr,
+                          messageID,
+                          sourceComponentID,
+                          componentID);
+    } /*if: <Events are recorded>*/
+
+    if(NULL == zajel_ptr->balanceCounterArray_ptr)
+    {
+        ZAJEL_MESSAGE_HANDLER_CALL(information_ptr,
+                                   descriptor_ptr);
+    } /*if: <Load balancer is disabled>*/
+    else
+    {
+        zajel_handler_run_counted(zajel_ptr,
+                                  information_ptr,
+                                  descriptor_ptr);
+    } /*else: <Load balancer is enabled>*/
+
+    if(FALSE != zajel_ptr->isTracing)
+    {
+        zajel_trace_write(ZAJEL_THREAD_TRACE(zajel_ptr,
+                                             callerThreadID),
+                          ZAJEL_TRACE_EVENT_HANDLER_EXIT,
+                          descriptor_ptr,
+                          messageID,
+                          sourceComponentID,
+                          componentID);
+    } /*if: <Events are recorded>*/
+} /*function: zajel_handler_run*/
+
+STATIC INLINE void zajel_handler_run_counted(zajel_s*                           zajel_ptr,
+                                             const zajel_message_information_s* information_ptr,
+                                             zajel_message_descriptor_s*        descriptor_ptr)
+{
+    zajel_balance_counters_s*   counters_ptr;
+    uint32_t                    componentID;
+    uint32_t                    sourceComponentID;
+    uint64_t                    startTime;
+
+    /*The descriptor is read beforehand, as the handler may free the message*/
+    componentID         = descriptor_ptr->destinationComponentID;
+    sourceComponentID   = descriptor_ptr->sourceComponentID;
+    counters_ptr        = &zajel_ptr->balanceCounterArray_ptr[componentID];
+
+    if(TRUE == zajel_balance_is_sampled(counters_ptr))
+    {
+        startTime = zajel_time_now();
+
+        ZAJEL_MESSAGE_HANDLER_CALL(information_ptr,
+                                   descriptor_ptr);
+
+        /*A zero time meaning that the message was not sampled, at least a nanosecond is counted*/
+        zajel_balance_count(counters_ptr,
+                            componentID,
+                            sourceComponentID,
+                            (zajel_time_now() - startTime) | 1);
+    } /*if: <Time this message>*/
+    else
+    {
+        ZAJEL_MESSAGE_HANDLER_CALL(information_ptr,
+                                   descriptor_ptr);
+
+        zajel_balance_count(counters_ptr,
+                            componentID,
+                            sourceComponentID,
+                            0);
+    } /*else: <Only count this message>*/
+} /*function: zajel_handler_run_counted*/
+
+STATIC INLINE zajel_actor_s* zajel_actor_get(zajel_s*                       zajel_ptr,
+                                             zajel_message_descriptor_s*    descriptor_ptr)
+{
+    if((NULL == zajel_ptr->actorArray_ptr) ||
+       ((descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_TOPIC) &&
+        (1 != ((zajel_topic_envelope_s*) descriptor_ptr)->subscriptionCount)))
+    {
+        return NULL;
+    } /*if: <No actors, or message covering several subscribers>*/
+
+    return zajel_ptr->actorArray_ptr[descriptor_ptr->destinationComponentID];
+} /*function: zajel_actor_get*/
+
+STATIC uint32_t zajel_actors_run(zajel_s*   zajel_ptr,
+                                 uint32_t   threadID,
+                                 uint32_t   budget)
+{
+    zajel_actor_s*                      actor_ptr;
+    zajel_linked_message_descriptor_s*  message_ptr;
+    zajel_component_information_u       component;
+    uint32_t                            coreID;
+    uint32_t                            victimThreadID;
+    /*Number of messages handled so far, and by the running actor*/
+    uint32_t                            processed;
+    uint32_t                            count;
+    /*Temporary counter*/
+    uint32_t                            i;
+
+    coreID      = ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                           threadID);
+    processed   = 0;
+
+    while(processed < budget)
+    {
+        /*<Pick a runnable actor, from this thread first, then from the others of the core>*/
+        actor_ptr = zajel_actor_queue_pop(&zajel_ptr->actorQueueArray_ptr[threadID]);
+
+        for(i = 1; (NULL == actor_ptr) && (i < zajel_ptr->threadCount); ++i)
+        {
+            /*<Steal from the next thread of the same core>*/
+            victimThreadID = (threadID + i) % zajel_ptr->threadCount;
+
+            if(coreID == ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                  victimThreadID))
+            {
+                actor_ptr = zajel_actor_queue_pop(&zajel_ptr->actorQueueArray_ptr[victimThreadID]);
+            } /*if: <Thread runs on the same core>*/
+        } /*for: <Steal from the next thread of the same core>*/
+
+        if(NULL == actor_ptr)
+        {
+            break;
+        } /*if: <No runnable actor left>*/
+
+        /*The component runs on this thread for now, its messages are sent from this thread*/
+        component.handle                = zajel_ptr->componentInformationArray[actor_ptr->componentID].handle;
+        component.parameters.threadID   = (uint8_t) threadID;
+        ZAJEL_ATOMIC_STORE_RELAXED(&zajel_ptr->componentInformationArray[actor_ptr->componentID].handle,
+                                   component.handle);
+
+        for(count = 0; (count < ZAJEL_ACTOR_BATCH_SIZE) && (processed < budget); ++count)
+        {
+            /*<Run a batch of messages>*/
+            message_ptr = zajel_mailbox_pop(&actor_ptr->mailbox);
+
+            if(NULL == message_ptr)
+            {
+                break;
+            } /*if: <Mailbox is drained (or a message is being pushed)>*/
+
+            message_ptr->descriptor.flags &= (uint8_t) ~ZAJEL_MESSAGE_FLAG_FORWARDED;
+
+            zajel_message_run(zajel_ptr,
+                              threadID,
+                              &message_ptr->descriptor);
+
+            ++processed;
+        } /*for: <Run a batch of messages>*/
+
+        if(TRUE == zajel_actor_release(actor_ptr))
+        {
+            zajel_actor_schedule(actor_ptr);
+        } /*if: <Messages arrived meanwhile, queue the actor again>*/
+
+        if(0 == count)
+        {
+            break;
+        } /*if: <Message still being pushed, do not spin on it>*/
+    } /*while: <Pick a runnable actor, from this thread first, then from the others of the core>*/
+
+    return processed;
+} /*function: zajel_actors_run*/
+
+STATIC INLINE bool_t zajel_migration_applies(zajel_s*                       zajel_ptr,
+                                             zajel_message_descriptor_s*    descriptor_ptr)
+{
+    if(ZAJEL_LIKELY(0 == zajel_ptr->componentInformationArray[descriptor_ptr->destinationComponentID].parameters.migrationSlot))
+    {
+        return FALSE;
+    } /*if: <Destination is not being migrated>*/
+
+    if((ZAJEL_ACK_MESSAGE_ID == descriptor_ptr->messageID) &&
+       (0 == (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION)))
+    {
+        return FALSE;
+    } /*if: <Acknowledgments go to the waiting thread>*/
+
+    if((descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_TOPIC) &&
+       (1 != ((zajel_topic_envelope_s*) descriptor_ptr)->subscriptionCount))
+    {
+        return FALSE;
+    } /*if: <Subscribers are checked one by one>*/
+
+    return TRUE;
+} /*function: zajel_migration_applies*/
+
+STATIC void zajel_migration_handle(zajel_s*                     zajel_ptr,
+                                   uint32_t                     callerThreadID,
+                                   zajel_message_descriptor_s*  descriptor_ptr)
+{
+    zajel_component_information_u*  component_ptr;
+    zajel_component_information_u   component;
+    zajel_migration_s*              migration_ptr;
+    zajel_route_s*                  route_ptr;
+    zajel_message_descriptor_s**    pending_ptr_array;
+    uint32_t                        pendingCapacity;
+    /*Lane the marker was received on*/
+    uint32_t                        priority;
+    /*Temporary counter*/
+    uint32_t                        i;
+
+    component_ptr   = &zajel_ptr->componentInformationArray[descriptor_ptr->destinationComponentID];
+    migration_ptr   = &zajel_ptr->migrationArray[component_ptr->parameters.migrationSlot - 1];
+    priority        = ZAJEL_PRIORITY_NORMAL;
+
+    if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION)
+    {
+        priority = zajel_message_priority(zajel_ptr,
+                                          descriptor_ptr);
+    } /*if: <Markers carry the lane they were sent on>*/
+
+    if((callerThreadID == migration_ptr->fromThreadID) &&
+       (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION) &&
+       (NULL != migration_ptr->sendCountArray) &&
+       (0 == (migration_ptr->requeuedMask & (1U << priority))) &&
+       ((ZAJEL_PRIORITY_NORMAL != priority) || (NULL == migration_ptr->drainHeadArray)))
+    {
+        /*
+         * Marker received by a former thread on a single queue (a mailbox, the callbacks or a lane),
+         * while some threads were still sending along the old route. Their messages may be queued
+         * behind the marker, so it is queued again behind them once they are done. Until then it
+         * just goes around the queue, a send does not wait for this thread.
+         */
+        if(TRUE == zajel_migration_senders_done(zajel_ptr,
+                                                migration_ptr))
+        {
+            migration_ptr->requeuedMask |= (1U << priority);
+        } /*if: <The late messages are all queued, the next time the marker is passed on>*/
+
+        zajel_migration_requeue(zajel_ptr,
+                                callerThreadID,
+                                descriptor_ptr,
+                                priority);
+    } /*if: <Marker received by a former thread on a single queue, while some threads were still sending>*/
+    else if((callerThreadID == migration_ptr->fromThreadID) &&
+            (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION) &&
+            (ZAJEL_PRIORITY_NORMAL == priority) &&
+            (NULL != migration_ptr->drainHeadArray))
+    {
+        /*
+         * Marker received by a former thread using the rings, the messages sent before it by the
+         * other threads may still be in their rings, or collected along with it
+         */
+        migration_ptr->heldMarker_ptr = descriptor_ptr;
+        ZAJEL_ATOMIC_FETCH_ADD(&zajel_ptr->heldMarkerCount, 1);
+    } /*if: <Marker received by a former thread using the rings>*/
+    else if(callerThreadID != migration_ptr->toThreadID)
+    {
+        /*<Received by the former thread (or on its way), pass it on along the new route>*/
+        if(0 == (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION))
+        {
+            descriptor_ptr->flags |= ZAJEL_MESSAGE_FLAG_FORWARDED;
+        } /*if: <Tell the new thread that it was sent before the migration>*/
+
+        /*Whatever their priority, the messages passed on (and the markers) keep a single lane, in order*/
+        route_ptr = zajel_route_get(zajel_ptr,
+                                    callerThreadID,
+                                    descriptor_ptr->destinationComponentID);
+
+        route_ptr->deliverFunction(route_ptr->context_ptr,
+                                   descriptor_ptr);
+    } /*if: <Received by the former thread (or on its way), pass it on along the new route>*/
+    else if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_FORWARDED)
+    {
+        /*<Sent before the migration, handle it right away>*/
+        descriptor_ptr->flags &= (uint8_t) ~ZAJEL_MESSAGE_FLAG_FORWARDED;
+
+        zajel_message_run(zajel_ptr,
+                          callerThreadID,
+                          descriptor_ptr);
+    } /*else if: <Sent before the migration, handle it right away>*/
+    else if(descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_MIGRATION)
+    {
+        /*<The former thread is drained, end the migration then handle the held messages in order>*/
+        if(0 != --migration_ptr->markerCount)
+        {
+            zajel_ptr->deallocationFunction_ptr(descriptor_ptr);
 
-    ASSERT((NULL != zajelPointer_ptr),
-           "zajel: Invalid address to pointer passed (zajel_ptr)!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != *zajelPointer_ptr),
-           "zajel: Address passed of a null pointer, expecting an address of a not-null pointer (zajel_ptr)"
-           "This might be a sign of double destroy using the same pointer!",
-           fileName,
-           lineNumber);
+            return;
+        } /*if: <Other lanes of the former thread are not drained yet>*/
 
-    zajel_ptr = *zajelPointer_ptr;
+        component.handle                    = component_ptr->handle;
+        component.parameters.migrationSlot  = 0;
+        ZAJEL_ATOMIC_STORE_RELEASE(&component_ptr->handle, component.handle);
 
-    zajel_ptr->deallocationFunction_ptr(zajel_ptr);
+        for(i = 0; i < migration_ptr->pendingCount; ++i)
+        {
+            zajel_message_handle(zajel_ptr,
+                                 callerThreadID,
+                                 migration_ptr->pending_ptr_array[i]);
+        } /*for: <Handle the held messages in order>*/
 
-    /*
-     * Here the original pointer to pointer must be used, to make sure that the passed pointer is
-     * reset, this is done to protect against the accidental use of the pointer after destroying it.
-     */
-    *zajelPointer_ptr = NULL;
-} /*function: zajel_destory*/
+        if(NULL != migration_ptr->pending_ptr_array)
+        {
+            zajel_ptr->deallocationFunction_ptr(migration_ptr->pending_ptr_array);
+        } /*if: <Release the held messages array>*/
 
-void zajel_regsiter_message(zajel_s*                        zajel_ptr,
-                            uint32_t                        messageID,
-                            zajel_message_handler_function  messageHandler_ptr,
-                            char*                           messageName_Ptr COMMA()
-                            FILE_AND_LINE_FOR_TYPE())
+        if(NULL != migration_ptr->drainHeadArray)
+        {
+            zajel_ptr->deallocationFunction_ptr(migration_ptr->drainHeadArray);
+        } /*if: <Release the recorded rings heads>*/
+
+        if(NULL != migration_ptr->sendCountArray)
+        {
+            zajel_ptr->deallocationFunction_ptr(migration_ptr->sendCountArray);
+        } /*if: <Release the recorded send counts>*/
+
+        migration_ptr->sendCountArray       = NULL;
+        migration_ptr->pending_ptr_array    = NULL;
+        migration_ptr->pendingCount         = 0;
+        migration_ptr->pendingCapacity      = 0;
+        migration_ptr->drainHeadArray       = NULL;
+        zajel_ptr->deallocationFunction_ptr(descriptor_ptr);
+
+        ZAJEL_ATOMIC_STORE_RELEASE(&migration_ptr->isUsed, FALSE);
+    } /*else if: <The former thread is drained, end the migration then handle the held messages in order>*/
+    else
+    {
+        /*<Sent after the migration, hold it until the messages sent before are handled>*/
+        if(migration_ptr->pendingCount == migration_ptr->pendingCapacity)
+        {
+            /*<Grow the held messages array>*/
+            pendingCapacity     = (migration_ptr->pendingCapacity) ?
+                                  (migration_ptr->pendingCapacity * 2) :
+                                  (ZAJEL_MIGRATION_PENDING_CAPACITY);
+            pending_ptr_array   = (zajel_message_descriptor_s**) zajel_ptr->allocationFunction_ptr(sizeof(zajel_message_descriptor_s*) *
+                                                                                                    pendingCapacity);
+            ASSERT((NULL != pending_ptr_array),
+                   "zajel: Failed to allocate a memory for the messages held by a migration!",
+                   __FILE__,
+                   __LINE__);
+
+            if(NULL != migration_ptr->pending_ptr_array)
+            {
+                memcpy(pending_ptr_array,
+                       migration_ptr->pending_ptr_array,
+                       sizeof(zajel_message_descriptor_s*) * migration_ptr->pendingCount);
+                zajel_ptr->deallocationFunction_ptr(migration_ptr->pending_ptr_array);
+            } /*if: <Move the held messages>*/
+
+            migration_ptr->pending_ptr_array    = pending_ptr_array;
+            migration_ptr->pendingCapacity      = pendingCapacity;
+        } /*if: <Grow the held messages array>*/
+
+        migration_ptr->pending_ptr_array[migration_ptr->pendingCount++] = descriptor_ptr;
+    } /*else: <Sent after the migration, hold it until the messages sent before are handled>*/
+} /*function: zajel_migration_handle*/
+
+STATIC void zajel_migration_release_markers(zajel_s*    zajel_ptr,
+                                            uint32_t    threadID)
 {
-    /*
-     * This function is responsible for:
-     ***********************************************************************************************
-     *
-     * o Validating inputs.
-     * o Registering the given message handler for the given message ID.
-     */
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid pointer to the control block!",
-           fileName,
-           lineNumber);
-    ASSERT((messageID < ZAJEL_MESSAGE_COUNT),
-           "zajel: MessageID passed must be less than the total message count used during initialization!",
-           fileName,
-           lineNumber);
-    ASSERT((messageID),
-           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != messageHandler_ptr),
-           "zajel: Message handler cannot be null!",
-           fileName,
-           lineNumber);
-    ASSERT(('\0' != messageName_Ptr[0]),
-           "zajel: Message name cannot be an empty string!",
-           fileName,
-           lineNumber);
-    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->messageInformationArray[messageID])),
-           "zajel: Message is already registerd!",
-           fileName,
-           lineNumber);
+    zajel_migration_s*              migration_ptr;
+    zajel_message_descriptor_s*     marker_ptr;
+    zajel_route_s*                  route_ptr;
+    bool_t                          isDrained;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        producerThreadID;
 
+    for(i = 0; i < ZAJEL_MIGRATION_SLOT_COUNT; ++i)
+    {
+        /*<Check each marker held by this thread>*/
+        migration_ptr = &zajel_ptr->migrationArray[i];
 
-    zajel_ptr->messageInformationArray[messageID].messageHandlerFunction    = messageHandler_ptr;
-#ifdef DEBUG
-    zajel_ptr->messageInformationArray[messageID].messageName_ptr           = messageName_Ptr;
-    zajel_ptr->messageInformationArray[messageID].isRegistered              = TRUE;
-    zajel_ptr->messageInformationArray[messageID].messageID                 = messageID;
-#endif /*DEBUG*/
-} /*function: zajel_register_message*/
+        if((FALSE == ZAJEL_ATOMIC_LOAD_ACQUIRE(&migration_ptr->isUsed)) ||
+           (threadID != migration_ptr->fromThreadID) ||
+           (NULL == migration_ptr->heldMarker_ptr))
+        {
+            continue;
+        } /*if: <No marker held by this thread>*/
 
-void zajel_regsiter_component(zajel_s*  zajel_ptr,
-                              uint32_t  componentID,
-                              uint32_t  threadID,
-                              char*     componentName_Ptr COMMA()
-                              FILE_AND_LINE_FOR_TYPE())
+        if((NULL != migration_ptr->sendCountArray) &&
+           (0 == (migration_ptr->requeuedMask & (1U << ZAJEL_PRIORITY_NORMAL))))
+        {
+            /*<Some threads were still sending along the old route when the heads were recorded>*/
+            if(FALSE == zajel_migration_senders_done(zajel_ptr,
+                                                     migration_ptr))
+            {
+                continue;
+            } /*if: <They are not done yet>*/
+
+            for(producerThreadID = 0; producerThreadID < zajel_ptr->threadCount; ++producerThreadID)
+            {
+                migration_ptr->drainHeadArray[producerThreadID] = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ZAJEL_THREAD_RING(zajel_ptr,
+                                                                                                               producerThreadID,
+                                                                                                               threadID)->head);
+            } /*for: <Record again the head of each ring, now past their messages>*/
+
+            migration_ptr->requeuedMask |= (1U << ZAJEL_PRIORITY_NORMAL);
+        } /*if: <Some threads were still sending along the old route when the heads were recorded>*/
+
+        isDrained = TRUE;
+
+        for(producerThreadID = 0; producerThreadID < zajel_ptr->threadCount; ++producerThreadID)
+        {
+            /*<The tails are only moved by this thread>*/
+            if((int32_t)(ZAJEL_THREAD_RING(zajel_ptr,
+                                           producerThreadID,
+                                           threadID)->tail - migration_ptr->drainHeadArray[producerThreadID]) < 0)
+            {
+                isDrained = FALSE;
+                break;
+            } /*if: <Ring still holds messages sent before the marker>*/
+        } /*for: <The tails are only moved by this thread>*/
+
+        if(TRUE == isDrained)
+        {
+            /*<Everything sent before the marker was handled, pass the marker on>*/
+            marker_ptr                      = migration_ptr->heldMarker_ptr;
+            migration_ptr->heldMarker_ptr   = NULL;
+            ZAJEL_ATOMIC_FETCH_SUB(&zajel_ptr->heldMarkerCount, 1);
+
+            route_ptr = zajel_route_get(zajel_ptr,
+                                        threadID,
+                                        marker_ptr->destinationComponentID);
+
+            route_ptr->deliverFunction(route_ptr->context_ptr,
+                                       marker_ptr);
+        } /*if: <Everything sent before the marker was handled, pass the marker on>*/
+    } /*for: <Check each marker held by this thread>*/
+} /*function: zajel_migration_release_markers*/
+
+STATIC bool_t zajel_migration_senders_done(zajel_s*             zajel_ptr,
+                                           zajel_migration_s*   migration_ptr)
 {
-    /*
-     * This function is responsible for:
-     ***********************************************************************************************
-     *
-     * o Validating inputs.
-     * o Registering the given component for the given ID.
-     */
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid pointer to the control block!",
-           fileName,
-           lineNumber);
-    ASSERT((componentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: componentID passed must be less than the total component count used during initialization!",
-           fileName,
-           lineNumber);
-    ASSERT(('\0' != componentName_Ptr[0]),
-           "zajel: Component name cannot be an empty string!",
-           fileName,
-           lineNumber);
-    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadInformationArray[threadID])),
-           "zajel: Thread is not registered!",
-           fileName,
-           lineNumber);
-    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->componentInformationArray[componentID].parameters)),
-           "zajel: Component is already registered!",
-           fileName,
-           lineNumber);
+    /*Temporary counter*/
+    uint32_t i;
 
-    zajel_ptr->componentInformationArray[componentID].parameters.threadID           = threadID;
-    zajel_ptr->componentInformationArray[componentID].parameters.coreID             = ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
-                                                                                                               threadID);
-#ifdef DEBUG
-    zajel_ptr->componentInformationArray[componentID].parameters.componentName_ptr  = componentName_Ptr;
-    zajel_ptr->componentInformationArray[componentID].parameters.isRegistered       = TRUE;
-    zajel_ptr->componentInformationArray[componentID].parameters.componentID        = componentID;
-#endif /*DEBUG*/
-} /*function: zajel_register_component*/
+    for(i = 0; i < zajel_ptr->threadCount; ++i)
+    {
+        if((0 != migration_ptr->sendCountArray[i]) &&
+           (migration_ptr->sendCountArray[i] == ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->threadInformationArray[i].sendCount)))
+        {
+            return FALSE;
+        } /*if: <Thread is still in the send it was in>*/
+    } /*for: <Check each recorded thread>*/
 
-void zajel_regsiter_thread(zajel_s*                         zajel_ptr,
-                           uint32_t                         threadID,
-                           uint32_t                         coreID,
-                           zajel_handle_message_callback    handleMessageCallback,
-                           zajel_block_callback             blockCallback,
-                           zajel_unblock_callback           unblockCallback,
-                           void*                            synchronizationPrimitive_ptr,
-                           char*                            threadName_Ptr COMMA()
-                           FILE_AND_LINE_FOR_TYPE())
+    return TRUE;
+} /*function: zajel_migration_senders_done*/
+
+STATIC void zajel_migration_requeue(zajel_s*                    zajel_ptr,
+                                    uint32_t                    threadID,
+                                    zajel_message_descriptor_s* marker_ptr,
+                                    uint32_t                    priority)
 {
-    /*
-     * This function is responsible for:
-     ***********************************************************************************************
-     *
-     * o Validating inputs.
-     * o Registering the given thread for the given ID.
-     */
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid pointer to the control block!",
-           fileName,
-           lineNumber);
-    ASSERT((threadID < ZAJEL_THREAD_COUNT),
-           "zajel: threadID passed must be less than the total thread count used during initialization!",
-           fileName,
-           lineNumber);
-    ASSERT(('\0' != threadName_Ptr[0]),
-           "zajel: thread name cannot be an empty string!",
-           fileName,
-           lineNumber);
-    ASSERT((TRUE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreInformationArray[coreID])),
-           "zajel: core is not registered!",
-           fileName,
-           lineNumber);
-    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->threadInformationArray[threadID])),
-           "zajel: thread is already registered!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != handleMessageCallback),
-           "zajel: handleMessageCallback cannot be NULL!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != blockCallback),
-           "zajel: blockCallback cannot be NULL!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != unblockCallback),
-           "zajel: unblockCallback cannot be NULL!",
-           fileName,
-           lineNumber);
+    zajel_thread_information_s* thread_ptr;
+
+    thread_ptr = &zajel_ptr->threadInformationArray[threadID];
+
+    if(ZAJEL_PRIORITY_NORMAL != priority)
+    {
+        zajel_lane_push(&zajel_ptr->laneArray_ptr[threadID],
+                        priority,
+                        marker_ptr);
+    } /*if: <Marker was received on a priority lane>*/
+    else if(ZAJEL_THREAD_TRANSPORT_MAILBOX == thread_ptr->transport)
+    {
+        zajel_mailbox_push(thread_ptr->mailbox_ptr,
+                           (zajel_linked_message_descriptor_s*) marker_ptr);
+    } /*else if: <Thread uses a mailbox>*/
+    else
+    {
+        ASSERT((ZAJEL_THREAD_TRANSPORT_CALLBACK == thread_ptr->transport),
+               "zajel: A marker cannot be queued again on the rings!",
+               __FILE__,
+               __LINE__);
+
+        thread_ptr->handleMessageCallback(marker_ptr);
+    } /*else: <Thread uses the callbacks>*/
+} /*function: zajel_migration_requeue*/
+
+STATIC timer_id zajel_timer_start(zajel_s*  zajel_ptr,
+                                  uint32_t  callerThreadID,
+                                  void*     message_ptr,
+                                  uint32_t  size,
+                                  uint64_t  delayNanoseconds,
+                                  uint64_t  periodNanoseconds)
+{
+    zajel_timer_wheel_s*    wheel_ptr;
+    zajel_timer_s*          timer_ptr;
+    /*Time since the tick 0 of the wheels*/
+    uint64_t                elapsed;
+
+    wheel_ptr = &zajel_ptr->timerWheelArray_ptr[callerThreadID];
+    timer_ptr = zajel_timer_alloc(wheel_ptr);
+
+    if(NULL == timer_ptr)
+    {
+        return ZAJEL_TIMER_ID_INVALID;
+    } /*if: <No timer left>*/
+
+    elapsed = zajel_time_now() - zajel_ptr->timerStartTime;
+
+    if(0 == wheel_ptr->armedCount)
+    {
+        /*An empty wheel is not moved while the thread dispatches, catch up before arming*/
+        (void) zajel_timer_wheel_advance(wheel_ptr,
+                                         elapsed / zajel_ptr->timerTickNanoseconds);
+    } /*if: <Wheel may lag behind>*/
+
+    /*Both durations are rounded up, a timer never expires early*/
+    timer_ptr->expiry       = (elapsed + delayNanoseconds + zajel_ptr->timerTickNanoseconds - 1) /
+                              zajel_ptr->timerTickNanoseconds;
+    timer_ptr->period       = (periodNanoseconds + zajel_ptr->timerTickNanoseconds - 1) /
+                              zajel_ptr->timerTickNanoseconds;
+    timer_ptr->message_ptr  = message_ptr;
+    timer_ptr->size         = size;
+
+    zajel_timer_arm(wheel_ptr,
+                    timer_ptr);
+
+    return ZAJEL_TIMER_ID(callerThreadID,
+                          timer_ptr - wheel_ptr->timerArray,
+                          timer_ptr->generation);
+} /*function: zajel_timer_start*/
+
+STATIC uint32_t zajel_timers_expire(zajel_s*    zajel_ptr,
+                                    uint32_t    threadID)
+{
+    zajel_timer_wheel_s*        wheel_ptr;
+    zajel_timer_s*              timer_ptr;
+    zajel_timer_s*              next_ptr;
+    zajel_message_descriptor_s* descriptor_ptr;
+    uint32_t                    count;
+    bool_t                      isOutermost;
+
+    wheel_ptr = &zajel_ptr->timerWheelArray_ptr[threadID];
+
+    if(0 == wheel_ptr->armedCount)
+    {
+        return 0;
+    } /*if: <No timer armed, the clock is not even read>*/
+
+    count = 0;
+
+    for(timer_ptr = zajel_timer_wheel_advance(wheel_ptr,
+                                              zajel_timer_tick(zajel_ptr));
+        NULL != timer_ptr;
+        timer_ptr = next_ptr)
+    {
+        /*<Send the message of each expired timer>*/
+        next_ptr = timer_ptr->next_ptr;
+
+        if(0 == timer_ptr->period)
+        {
+            /*<Expires once, the message goes away with the timer>*/
+            descriptor_ptr = (zajel_message_descriptor_s*) timer_ptr->message_ptr;
+
+            zajel_timer_free(wheel_ptr,
+                             timer_ptr);
+        } /*if: <Expires once, the message goes away with the timer>*/
+        else
+        {
+            /*<Periodic, send a copy and arm the timer for the next period>*/
+            descriptor_ptr = (zajel_message_descriptor_s*) ((NULL != zajel_ptr->poolArray_ptr) ?
+                                                            (zajel_pool_alloc(ZAJEL_THREAD_POOL(zajel_ptr,
+                                                                                                threadID),
+                                                                              timer_ptr->size,
+                                                                              zajel_ptr->allocationFunction_ptr)) :
+                                                            (zajel_ptr->allocationFunction_ptr(timer_ptr->size)));
+            ASSERT((NULL != descriptor_ptr),
+                   "zajel: Failed to allocate a copy of a periodic message!",
+                   __FILE__,
+                   __LINE__);
+
+            memcpy(descriptor_ptr,
+                   timer_ptr->message_ptr,
+                   timer_ptr->size);
+
+            timer_ptr->expiry += timer_ptr->period;
+
+            if(timer_ptr->expiry <= wheel_ptr->currentTick)
+            {
+                /*<The thread was late, skip the missed periods (keeping the phase)>*/
+                timer_ptr->expiry = wheel_ptr->currentTick + timer_ptr->period -
+                                    ((wheel_ptr->currentTick - timer_ptr->expiry) % timer_ptr->period);
+            } /*if: <The thread was late, skip the missed periods (keeping the phase)>*/
+
+            zajel_timer_arm(wheel_ptr,
+                            timer_ptr);
+        } /*else: <Periodic, send a copy and arm the timer for the next period>*/
+
+        /*The message is sent from this thread, wherever its source component runs by now*/
+        isOutermost = zajel_send_begin(zajel_ptr,
+                                       threadID);
+
+        zajel_send_route(zajel_ptr,
+                         descriptor_ptr,
+                         zajel_route_get(zajel_ptr,
+                                         threadID,
+                                         descriptor_ptr->destinationComponentID),
+                         threadID,
+                         isOutermost);
+        ++count;
+    } /*for: <Send the message of each expired timer>*/
+
+    return count;
+} /*function: zajel_timers_expire*/
+
+STATIC INLINE uint64_t zajel_timer_tick(zajel_s* zajel_ptr)
+{
+    return (zajel_time_now() - zajel_ptr->timerStartTime) / zajel_ptr->timerTickNanoseconds;
+} /*function: zajel_timer_tick*/
+
+STATIC INLINE zajel_payload_s* zajel_payload_resolve(zajel_s*   zajel_ptr,
+                                                     uint64_t   payloadHandle)
+{
+    if(payloadHandle & ZAJEL_PAYLOAD_HANDLE_SHARED)
+    {
+        ASSERT((NULL != zajel_ptr->shm_ptr),
+               "zajel: A shared payload can only be reached with the shm transport enabled!",
+               __FILE__,
+               __LINE__);
+
+        return (zajel_payload_s*) zajel_shm_get_pointer(zajel_ptr->shm_ptr,
+                                                        (uint32_t)(payloadHandle & ~(uint64_t)ZAJEL_PAYLOAD_HANDLE_SHARED));
+    } /*if: <Handle holds an offset within the shared region>*/
+
+    return (zajel_payload_s*)(uintptr_t) payloadHandle;
+} /*function: zajel_payload_resolve*/
+
+STATIC void zajel_topics_build(zajel_s* zajel_ptr)
+{
+    zajel_subscription_s*           subscriptionArray_ptr;
+    zajel_component_information_u*  component_ptr;
+    zajel_subscription_s            subscription;
+    uint64_t                        key;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        j;
+
+    subscriptionArray_ptr = zajel_ptr->subscriptionArray_ptr;
+
+    for(i = 0; i < zajel_ptr->subscriptionCount; ++i)
+    {
+        /*<Refresh the mapping of each subscriber>*/
+        component_ptr = &zajel_ptr->componentInformationArray[subscriptionArray_ptr[i].componentID];
+        ZAJEL_ATOMIC_STORE_RELAXED(&subscriptionArray_ptr[i].threadID, component_ptr->parameters.threadID);
+        ZAJEL_ATOMIC_STORE_RELAXED(&subscriptionArray_ptr[i].coreID, component_ptr->parameters.coreID);
+    } /*for: <Refresh the mapping of each subscriber>*/
+
+    if(TRUE == zajel_ptr->isSealed)
+    {
+        /*
+         * Refreshed by a migration, the published messages in flight refer to the subscriptions by
+         * index, so the order is kept (the destination groups only get smaller)
+         */
+        return;
+    } /*if: <Refreshed by a migration>*/
+
+    for(i = 1; i < zajel_ptr->subscriptionCount; ++i)
+    {
+        /*<Sort by topic, core, thread then component (insertion sort, the order changes seldom)>*/
+        subscription    = subscriptionArray_ptr[i];
+        key             = ZAJEL_SUBSCRIPTION_KEY(subscription);
+
+        for(j = i; (j > 0) && (ZAJEL_SUBSCRIPTION_KEY(subscriptionArray_ptr[j - 1]) > key); --j)
+        {
+            subscriptionArray_ptr[j] = subscriptionArray_ptr[j - 1];
+        } /*for: <Shift the bigger subscriptions>*/
+
+        subscriptionArray_ptr[j] = subscription;
+    } /*for: <Sort by topic, core, thread then component (insertion sort, the order changes seldom)>*/
+
+    for(i = 0, j = 0; i <= zajel_ptr->topicCount; ++i)
+    {
+        /*<Index the first subscription of each topic>*/
+        while((j < zajel_ptr->subscriptionCount) && (subscriptionArray_ptr[j].topicID < i))
+        {
+            ++j;
+        } /*while: <Skip the subscriptions of the previous topics>*/
+
+        zajel_ptr->topicStartArray_ptr[i] = j;
+    } /*for: <Index the first subscription of each topic>*/
+} /*function: zajel_topics_build*/
+
+STATIC void zajel_topic_send(zajel_s*           zajel_ptr,
+                             uint32_t           producerThreadID,
+                             message_id         messageID,
+                             component_id       sourceComponentID,
+                             zajel_payload_s*   payload_ptr,
+                             uint32_t           subscriptionIndex,
+                             uint32_t           subscriptionCount,
+                             uint8_t            scope,
+                             uint8_t            flags)
+{
+    zajel_topic_envelope_s*         envelope_ptr;
+    zajel_message_descriptor_s*     descriptor_ptr;
+    zajel_route_s*                  route_ptr;
+    component_id                    destinationComponentID;
+    uint8_t                         allocator;
+
+    destinationComponentID  = zajel_ptr->subscriptionArray_ptr[subscriptionIndex].componentID;
+    route_ptr               = zajel_route_lookup(zajel_ptr,
+                                                 producerThreadID,
+                                                 destinationComponentID);
+
+    if((ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES == route_ptr->relation) &&
+       (NULL != zajel_ptr->shm_ptr))
+    {
+        /*<Message shall be reachable from the other core>*/
+        envelope_ptr    = (zajel_topic_envelope_s*) zajel_shm_message_alloc(zajel_ptr->shm_ptr,
+                                                                            sizeof(zajel_topic_envelope_s));
+        allocator       = ZAJEL_TOPIC_FROM_SHM;
+    } /*if: <Message shall be reachable from the other core>*/
+    else if(NULL != zajel_ptr->poolArray_ptr)
+    {
+        envelope_ptr    = (zajel_topic_envelope_s*) zajel_pool_alloc(ZAJEL_THREAD_POOL(zajel_ptr,
+                                                                                       producerThreadID),
+                                                                     sizeof(zajel_topic_envelope_s),
+                                                                     zajel_ptr->allocationFunction_ptr);
+        allocator       = ZAJEL_TOPIC_FROM_POOL;
+    } /*else if: <Message pools are enabled>*/
+    else
+    {
+        envelope_ptr    = (zajel_topic_envelope_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_topic_envelope_s));
+        allocator       = ZAJEL_TOPIC_FROM_HEAP;
+    } /*else: <Use the allocation function>*/
+
+    ASSERT((NULL != envelope_ptr),
+           "zajel: Failed to allocate a published message!",
+           __FILE__,
+           __LINE__);
+
+    descriptor_ptr                                      = &envelope_ptr->payloadDescriptor.linkedDescriptor.descriptor;
+    descriptor_ptr->messageID                           = messageID;
+    descriptor_ptr->sourceComponentID                   = sourceComponentID;
+    descriptor_ptr->destinationComponentID              = destinationComponentID;
+    descriptor_ptr->isSynchronous                       = FALSE;
+    descriptor_ptr->flags                               = ZAJEL_MESSAGE_FLAG_TOPIC | flags;
+    envelope_ptr->payloadDescriptor.linkedDescriptor.next_ptr = NULL;
+    envelope_ptr->payloadDescriptor.payloadHandle       = 0;
+    envelope_ptr->subscriptionIndex                     = subscriptionIndex;
+    envelope_ptr->subscriptionCount                     = subscriptionCount;
+    envelope_ptr->scope                                 = scope;
+    envelope_ptr->allocator                             = allocator;
+
+    if(NULL != payload_ptr)
+    {
+        zajel_payload_attach(zajel_ptr,
+                             envelope_ptr,
+                             payload_ptr COMMA()
+                             FILE_AND_LINE_FOR_REF());
+    } /*if: <Share the payload with this destination>*/
+
+    zajel_route_deliver(zajel_ptr,
+                        route_ptr,
+                        descriptor_ptr);
+} /*function: zajel_topic_send*/
+
+STATIC void zajel_topic_forward(zajel_s*                zajel_ptr,
+                                uint32_t                callerThreadID,
+                                zajel_topic_envelope_s* envelope_ptr)
+{
+    zajel_subscription_s*   subscriptionArray_ptr;
+    zajel_payload_s*        payload_ptr;
+    /*Range of subscriptions sharing a destination thread*/
+    uint32_t                first;
+    uint32_t                last;
+    uint32_t                end;
+
+    if(ZAJEL_UNLIKELY(ZAJEL_ROUTES_STATE_VALID != ZAJEL_ATOMIC_LOAD_ACQUIRE(&zajel_ptr->routesState)))
+    {
+        /*<The mapping changed since the routes (and the subscriptions order) were built>*/
+        zajel_routes_build(zajel_ptr);
+    } /*if: <The mapping changed since the routes (and the subscriptions order) were built>*/
+
+    subscriptionArray_ptr   = zajel_ptr->subscriptionArray_ptr;
+    payload_ptr             = zajel_payload_get(zajel_ptr,
+                                                envelope_ptr COMMA()
+                                                FILE_AND_LINE_FOR_REF());
+    end                     = envelope_ptr->subscriptionIndex + envelope_ptr->subscriptionCount;
+
+    for(first = envelope_ptr->subscriptionIndex; first < end; first = last)
+    {
+        /*<Send a single message per subscribing thread>*/
+        for(last = first + 1;
+            (last < end) && (subscriptionArray_ptr[last].threadID == subscriptionArray_ptr[first].threadID);
+            ++last)
+        {
+        } /*for: <Find the end of the thread group>*/
+
+        zajel_topic_send(zajel_ptr,
+                         callerThreadID,
+                         envelope_ptr->payloadDescriptor.linkedDescriptor.descriptor.messageID,
+                         envelope_ptr->payloadDescriptor.linkedDescriptor.descriptor.sourceComponentID,
+                         payload_ptr,
+                         first,
+                         last - first,
+                         ZAJEL_TOPIC_SCOPE_THREAD,
+                         ZAJEL_MESSAGE_FLAG_NONE);
+    } /*for: <Send a single message per subscribing thread>*/
 
+    zajel_topic_release(zajel_ptr,
+                        callerThreadID,
+                        envelope_ptr);
+} /*function: zajel_topic_forward*/
 
-    zajel_ptr->threadInformationArray[threadID].coreID                          = coreID;
-    zajel_ptr->threadInformationArray[threadID].handleMessageCallback           = handleMessageCallback;
-    zajel_ptr->threadInformationArray[threadID].blockCallback                   = blockCallback;
-    zajel_ptr->threadInformationArray[threadID].unblockCallback                 = unblockCallback;
-    zajel_ptr->threadInformationArray[threadID].synchronizationPrimitive_ptr    = synchronizationPrimitive_ptr;
+STATIC void zajel_topic_handle(zajel_s*                 zajel_ptr,
+                               uint32_t                 callerThreadID,
+                               zajel_topic_envelope_s*  envelope_ptr)
+{
+    zajel_message_descriptor_s*     descriptor_ptr;
+    zajel_component_information_u*  component_ptr;
+    uint32_t                        end;
+    /*Temporary counter*/
+    uint32_t                        i;
 
-#ifdef DEBUG
-    zajel_ptr->threadInformationArray[threadID].threadName_ptr      = threadName_Ptr;
-    zajel_ptr->threadInformationArray[threadID].isRegistered        = TRUE;
-    zajel_ptr->threadInformationArray[threadID].threadID            = threadID;
-#endif /*DEBUG*/
-} /*function: zajel_register_thread*/
+    descriptor_ptr  = &envelope_ptr->payloadDescriptor.linkedDescriptor.descriptor;
+    end             = envelope_ptr->subscriptionIndex + envelope_ptr->subscriptionCount;
 
-void zajel_regsiter_core(zajel_s*                           zajel_ptr,
-                         uint32_t                           coreID,
-                         zajel_core_handle_message_callback handleMessageCallback,
-                         char*                              coreName_Ptr COMMA()
-                         FILE_AND_LINE_FOR_TYPE())
+    for(i = envelope_ptr->subscriptionIndex; i < end; ++i)
+    {
+        /*<Run the handler for each subscriber hosted by this thread>*/
+        descriptor_ptr->destinationComponentID  = zajel_ptr->subscriptionArray_ptr[i].componentID;
+        component_ptr                           = &zajel_ptr->componentInformationArray[descriptor_ptr->destinationComponentID];
+
+        if(ZAJEL_LIKELY(component_ptr->parameters.threadID == callerThreadID) &&
+           ((1 == envelope_ptr->subscriptionCount) ||
+            ((0 == component_ptr->parameters.migrationSlot) &&
+             ((NULL == zajel_ptr->actorArray_ptr) ||
+              (NULL == zajel_ptr->actorArray_ptr[descriptor_ptr->destinationComponentID])))))
+        {
+            /*Each subscriber may have its own handler for the message*/
+            zajel_handler_run(zajel_ptr,
+                              callerThreadID,
+                              zajel_handler_get(zajel_ptr,
+                                                descriptor_ptr),
+                              descriptor_ptr);
+        } /*if: <Subscriber is hosted by this thread>*/
+        else
+        {
+            /*<Subscriber was migrated or is an actor (a single message was already checked)>*/
+            zajel_topic_send(zajel_ptr,
+                             callerThreadID,
+                             descriptor_ptr->messageID,
+                             descriptor_ptr->sourceComponentID,
+                             zajel_payload_get(zajel_ptr,
+                                               envelope_ptr COMMA()
+                                               FILE_AND_LINE_FOR_REF()),
+                             i,
+                             1,
+                             ZAJEL_TOPIC_SCOPE_THREAD,
+                             (component_ptr->parameters.threadID == callerThreadID) ?
+                             (ZAJEL_MESSAGE_FLAG_NONE) :
+                             (ZAJEL_MESSAGE_FLAG_FORWARDED));
+        } /*else: <Subscriber was migrated or is an actor (a single message was already checked)>*/
+    } /*for: <Run the handler for each subscriber hosted by this thread>*/
+
+    zajel_topic_release(zajel_ptr,
+                        callerThreadID,
+                        envelope_ptr);
+} /*function: zajel_topic_handle*/
+
+STATIC void zajel_topic_release(zajel_s*                zajel_ptr,
+                                uint32_t                callerThreadID,
+                                zajel_topic_envelope_s* envelope_ptr)
 {
-    /*
-     * This function is responsible for:
-     ***********************************************************************************************
-     *
-     * o Validating inputs.
-     * o Registering the given core for the given ID.
-     */
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid pointer to the control block!",
-           fileName,
-           lineNumber);
-    ASSERT((coreID < ZAJEL_CORE_COUNT),
-           "zajel: coreID passed must be less than the total core count used during initialization!",
-           fileName,
-           lineNumber);
-    ASSERT(('\0' != coreName_Ptr[0]),
-           "zajel: Core name cannot be an empty string!",
-           fileName,
-           lineNumber);
-    ASSERT((FALSE == ZAJEL_IS_ITEM_REGISTERED(zajel_ptr->coreInformationArray[coreID])),
-           "zajel: Core is already registered!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != handleMessageCallback),
-           "zajel: handleMessageCallback cannot be NULL!",
-           fileName,
-           lineNumber);
+    if(envelope_ptr->payloadDescriptor.linkedDescriptor.descriptor.flags & ZAJEL_MESSAGE_FLAG_PAYLOAD)
+    {
+        zajel_payload_release(zajel_ptr,
+                              zajel_payload_resolve(zajel_ptr,
+                                                    envelope_ptr->payloadDescriptor.payloadHandle) COMMA()
+                              FILE_AND_LINE_FOR_REF());
+    } /*if: <Drop the reference of this message on the payload>*/
 
-    zajel_ptr->coreInformationArray[coreID].handleMessageCallback   = handleMessageCallback;
+    switch(envelope_ptr->allocator)
+    {
+        /*<Free the message where it was allocated>*/
+        case ZAJEL_TOPIC_FROM_SHM:
+            zajel_shm_message_free(zajel_ptr->shm_ptr,
+                                   envelope_ptr);
+            break;
+        case ZAJEL_TOPIC_FROM_POOL:
+            zajel_pool_free(ZAJEL_THREAD_POOL(zajel_ptr,
+                                              zajel_pool_get_owner(envelope_ptr)),
+                            envelope_ptr,
+                            callerThreadID,
+                            zajel_ptr->deallocationFunction_ptr);
+            break;
+        default:
+            zajel_ptr->deallocationFunction_ptr(envelope_ptr);
+            break;
+    } /*switch: <Free the message where it was allocated>*/
+} /*function: zajel_topic_release*/
+/*function: */
 
+STATIC void zajel_stats_send(zajel_s*                       zajel_ptr,
+                             uint32_t                       sourceThreadID,
+                             zajel_message_descriptor_s*    descriptor_ptr,
+                             uint32_t                       relation)
+{
+    if(FALSE == zajel_stats_count_send(ZAJEL_THREAD_STATS(zajel_ptr,
+                                                          sourceThreadID),
+                                       descriptor_ptr->messageID,
+                                       relation))
+    {
+        return;
+    } /*if: <Message is not sampled>*/
 
-#ifdef DEBUG
-    zajel_ptr->coreInformationArray[coreID].coreName_ptr            = coreName_Ptr;
-    zajel_ptr->coreInformationArray[coreID].isRegistered            = TRUE;
-    zajel_ptr->coreInformationArray[coreID].coreID                  = coreID;
-#endif /*DEBUG*/
-} /*function: zajel_register_core*/
+    if(((ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD == relation) && (TRUE == descriptor_ptr->isSynchronous)) ||
+       ((ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES == relation) && (NULL != zajel_ptr->shm_ptr)) ||
+       ((NULL != zajel_ptr->actorArray_ptr) && (NULL != zajel_ptr->actorArray_ptr[descriptor_ptr->destinationComponentID])))
+    {
+        return;
+    } /*if: <Message is not queued, leaves the process, or may run on any thread of the core>*/
 
-void zajel_send(zajel_s*    zajel_ptr,
-                void*       message_ptr COMMA()
-                FILE_AND_LINE_FOR_TYPE())
+    zajel_stats_probe_set(ZAJEL_THREAD_STATS(zajel_ptr,
+                                             ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
+                                                                           descriptor_ptr->destinationComponentID)),
+                          descriptor_ptr);
+} /*function: zajel_stats_send*/
+
+STATIC void zajel_stats_deliver(zajel_s*                    zajel_ptr,
+                                uint32_t                    callerThreadID,
+                                zajel_message_descriptor_s* descriptor_ptr)
 {
-    zajel_message_descriptor_s*         descriptor_ptr;
-    zajel_component_dynamic_relation_e  dynamicRelation;
+    zajel_component_information_u   source;
+    zajel_stats_thread_s*           thread_ptr;
+    uint32_t                        relation;
 
-    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+    source.handle   = zajel_ptr->componentInformationArray[descriptor_ptr->sourceComponentID].handle;
+    thread_ptr      = ZAJEL_THREAD_STATS(zajel_ptr,
+                                         callerThreadID);
 
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid control block pointer!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != message_ptr),
-           "zajel: message_cannot equal NULL!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->messageID < ZAJEL_MESSAGE_COUNT),
-           "zajel: Message ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->messageID),
-           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->sourceComponentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: Source component ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->destinationComponentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: Destination component ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT(((TRUE == descriptor_ptr->isSynchronous) || (FALSE == descriptor_ptr->isSynchronous)),
-           "zajel: isSynchronous is niether true nor false!",
-           fileName,
-           lineNumber);
+    if(source.parameters.coreID != ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                            callerThreadID))
+    {
+        relation = ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES;
+    } /*if: <Source runs on another core>*/
+    else if(source.parameters.threadID != callerThreadID)
+    {
+        relation = ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE;
+    } /*else if: <Source runs on another thread of this core>*/
+    else
+    {
+        relation = ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD;
+    } /*else: <Source runs on this thread>*/
 
+    zajel_stats_count_deliver(thread_ptr,
+                              descriptor_ptr->messageID,
+                              relation);
+    zajel_stats_probe_check(thread_ptr,
+                            descriptor_ptr,
+                            relation);
+} /*function: zajel_stats_deliver*/
 
-    dynamicRelation = zajel_component_get_dynamic_relation(zajel_ptr,
-                                                           descriptor_ptr->sourceComponentID,
-                                                           descriptor_ptr->destinationComponentID);
+STATIC uintptr_t zajel_placement_granule(zajel_s*   zajel_ptr,
+                                         uintptr_t  blockSize)
+{
+    if(FALSE == zajel_ptr->isNumaEnabled)
+    {
+        return 1;
+    } /*if: <Blocks are not placed, they are not padded either>*/
 
-    switch(dynamicRelation)
+    if((zajel_ptr->numaFlags & ZAJEL_NUMA_FLAG_HUGE_PAGES) &&
+       (blockSize >= ZAJEL_NUMA_HUGE_PAGE_SIZE))
     {
-        /*<This switch checks the dynamic relation between both components and act accordingly>*/
+        return ZAJEL_NUMA_HUGE_PAGE_SIZE;
+    } /*if: <Blocks are big enough to be made of huge pages>*/
 
-        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD:
-            /*<Both components are running in the same thread>*/
+    return ZAJEL_NUMA_PAGE_SIZE;
+} /*function: zajel_placement_granule*/
 
-            if(TRUE == descriptor_ptr->isSynchronous)
-            {
-                /*<Synchronous message, call the handler directly>*/
-                zajel_ptr->messageInformationArray[descriptor_ptr->messageID].messageHandlerFunction(descriptor_ptr);
-            } /*if: <Synchronous message, call the handler directly>*/
-            else
-            {
-                /*<Asynchronous message, deliver the message to the destination thread>*/
-                ZAJEL_THREAD_HANDLE_MESSAGE(zajel_ptr,
-                                            descriptor_ptr);
-            } /*else: <Asynchronous message, deliver the message to the destination thread>*/
+STATIC void* zajel_placement_alloc(zajel_s*     zajel_ptr,
+                                   uintptr_t    size,
+                                   uintptr_t    granule)
+{
+    zajel_mapping_s*    mapping_ptr;
+    void*               address_ptr;
+    bool_t              isHuge;
 
-            break;/*<Both components are running in the same thread>*/
-        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE:
-            /*<Both components are running in different threads, same core>*/
+    if(FALSE == zajel_ptr->isNumaEnabled)
+    {
+        return zajel_ptr->allocationFunction_ptr(size);
+    } /*if: <Memory is not placed>*/
 
-            ZAJEL_THREAD_HANDLE_MESSAGE(zajel_ptr,
-                                        descriptor_ptr);
+    size        = ZAJEL_NUMA_ALIGN_UP(size, granule);
+    isHuge      = (ZAJEL_NUMA_HUGE_PAGE_SIZE == granule) ? (TRUE) : (FALSE);
+    address_ptr = zajel_numa_map(size,
+                                 isHuge,
+                                 FALSE);
 
-            if(TRUE == descriptor_ptr->isSynchronous)
-            {
-                /*<Message is synchronous, framework will now block the source (calling) thread>*/
-                ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
-                                         descriptor_ptr->sourceComponentID,
-                                         block);
-            } /*if: <Message is synchronous, framework will now block the source (calling) thread>*/
+    if((NULL == address_ptr) && (isHuge))
+    {
+        /*<No huge page left, use regular pages and let the system merge them if it can>*/
+        isHuge      = FALSE;
+        address_ptr = zajel_numa_map(size,
+                                     FALSE,
+                                     TRUE);
+    } /*if: <No huge page left, use regular pages and let the system merge them if it can>*/
 
-            break;/*<Both components are running in different threads, same core>*/
-        case ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES:
-            /*<Both components are running in different threads, different cores>*/
+    if(NULL == address_ptr)
+    {
+        return zajel_ptr->allocationFunction_ptr(size);
+    } /*if: <Memory cannot be mapped on this platform>*/
 
-            ZAJEL_CORE_HANDLE_MESSAGE(zajel_ptr,
-                                      descriptor_ptr);
+    mapping_ptr = (zajel_mapping_s*) zajel_ptr->allocationFunction_ptr(sizeof(zajel_mapping_s));
 
-            if(TRUE == descriptor_ptr->isSynchronous)
-            {
-                /*<Message is synchronous, framework will now block the source (calling) thread>*/
-                ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
-                                         descriptor_ptr->sourceComponentID,
-                                         block);
-            } /*if: <Message is synchronous, framework will now block the source (calling) thread>*/
+    if(NULL == mapping_ptr)
+    {
+        zajel_numa_unmap(address_ptr,
+                         size);
 
-            break;/*<Both components are running in different threads, different cores>*/
-        default:
-            /*<Invalid dynamic relation>*/
-            ASSERT((FALSE),
-                   "zajel: Invalid dynamic relation received!",
-                   fileName,
-                   lineNumber);
-            break;/*<Invalid dynamic relation>*/
-    } /*switch: <This switch checks the dynamic relation between both components and act accordingly>*/
-} /*function: zajel_send*/
+        return NULL;
+    } /*if: <Mapping cannot be tracked>*/
 
-void zajel_acknowledge(zajel_s*                zajel_ptr,
-                       void*                   message_ptr COMMA()
-                       FILE_AND_LINE_FOR_TYPE())
-{
-    zajel_message_descriptor_s          ackDescriptor;
-    zajel_message_descriptor_s*         descriptor_ptr;
-    zajel_component_dynamic_relation_e  dynamicRelation;
+    mapping_ptr->address_ptr    = address_ptr;
+    mapping_ptr->size           = size;
+    mapping_ptr->boundBytes     = 0;
+    mapping_ptr->isHuge         = isHuge;
 
-    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+    zajel_placement_lock(zajel_ptr);
 
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid control block pointer!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != message_ptr),
-           "zajel: message_cannot equal NULL!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->messageID < ZAJEL_MESSAGE_COUNT),
-           "zajel: Message ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->messageID),
-           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->sourceComponentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: Source component ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->destinationComponentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: Destination component ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT(((TRUE == descriptor_ptr->isSynchronous)),
-           "zajel: It is not allowed to acknowledge asynchronous message!",
-           fileName,
-           lineNumber);
+    mapping_ptr->next_ptr   = zajel_ptr->mapping_ptr;
+    zajel_ptr->mapping_ptr  = mapping_ptr;
 
+    zajel_placement_unlock(zajel_ptr);
 
-    dynamicRelation = zajel_component_get_dynamic_relation(zajel_ptr,
-                                                           descriptor_ptr->sourceComponentID,
-                                                           descriptor_ptr->destinationComponentID);
+    return address_ptr;
+} /*function: zajel_placement_alloc*/
 
-    switch(dynamicRelation)
+STATIC void zajel_placement_bind(zajel_s*   zajel_ptr,
+                                 void*      memory_ptr,
+                                 void*      block_ptr,
+                                 uintptr_t  size,
+                                 uint32_t   threadID)
+{
+    zajel_mapping_s*    mapping_ptr;
+    uint32_t            nodeID;
+
+    if(FALSE == zajel_ptr->isNumaEnabled)
     {
-        /*<This switch checks the dynamic relation between both components and act accordingly>*/
+        return;
+    } /*if: <Memory is not placed>*/
 
-        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD:
-            /*<Both components are running in the same thread>*/
+    nodeID = zajel_ptr->coreInformationArray[ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
+                                                                      threadID)].nodeID;
 
-            ASSERT((FALSE),
-                   "zajel: It is not allowed to ack a message sent from the same thread!",
-                   fileName,
-                   lineNumber);
+    if(ZAJEL_NUMA_NODE_ANY == nodeID)
+    {
+        return;
+    } /*if: <Node of the thread is unknown, the system places the memory on first touch>*/
 
-            break;/*<Both components are running in the same thread>*/
-        case ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE:
-            /*<Both components are running in different threads, same core>*/
+    mapping_ptr = zajel_placement_find(zajel_ptr,
+                                       memory_ptr,
+                                       FALSE);
 
-            ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
-                                     descriptor_ptr->sourceComponentID,
-                                     unblock);
+    if((NULL != mapping_ptr) &&
+       (zajel_numa_bind(block_ptr,
+                        size,
+                        nodeID)))
+    {
+        mapping_ptr->boundBytes += size;
+    } /*if: <Block is mapped, and the system supports binding it>*/
+} /*function: zajel_placement_bind*/
 
-            break;/*<Both components are running in different threads, same core>*/
-        case ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES:
-            /*<Both components are running in different threads, different cores>*/
+STATIC void zajel_placement_free(zajel_s*   zajel_ptr,
+                                 void*      memory_ptr)
+{
+    zajel_mapping_s* mapping_ptr;
 
-            /*Adjusting the message parameter so that it is delivered to the original source*/
-            ackDescriptor.messageID                 = ZAJEL_ACK_MESSAGE_ID;
-            ackDescriptor.sourceComponentID         = descriptor_ptr->destinationComponentID;
-            ackDescriptor.destinationComponentID    = descriptor_ptr->sourceComponentID;
-            ackDescriptor.isSynchronous             = descriptor_ptr->isSynchronous;
+    mapping_ptr = zajel_placement_find(zajel_ptr,
+                                       memory_ptr,
+                                       TRUE);
 
-            zajel_send(zajel_ptr,
-                       (void*)&ackDescriptor COMMA()
-                       FILE_AND_LINE_FOR_CALL());
+    if(NULL == mapping_ptr)
+    {
+        zajel_ptr->deallocationFunction_ptr(memory_ptr);
 
-            break;/*<Both components are running in different threads, different cores>*/
-        default:
-            /*<Invalid dynamic relation>*/
-            ASSERT((FALSE),
-                   "zajel: Invalid dynamic relation received!",
-                   fileName,
-                   lineNumber);
-            break;/*<Invalid dynamic relation>*/
-    } /*switch: <This switch checks the dynamic relation between both components and act accordingly>*/
-} /*function: zajel_acknowledge*/
+        return;
+    } /*if: <Block came from the allocation function>*/
 
-void zajel_deliver(zajel_s* zajel_ptr,
-                   void*    message_ptr,
-                   uint32_t callerThreadID COMMA()
-                   FILE_AND_LINE_FOR_TYPE())
+    zajel_numa_unmap(mapping_ptr->address_ptr,
+                     mapping_ptr->size);
+    zajel_ptr->deallocationFunction_ptr(mapping_ptr);
+} /*function: zajel_placement_free*/
+
+STATIC zajel_mapping_s* zajel_placement_find(zajel_s*       zajel_ptr,
+                                             const void*    memory_ptr,
+                                             bool_t         isRemoved)
 {
-    zajel_message_descriptor_s*         descriptor_ptr;
+    zajel_mapping_s**   link_ptr;
+    zajel_mapping_s*    mapping_ptr;
 
-    descriptor_ptr = (zajel_message_descriptor_s*) message_ptr;
+    mapping_ptr = NULL;
 
-    ASSERT((NULL != zajel_ptr),
-           "zajel: Invalid control block pointer!",
-           fileName,
-           lineNumber);
-    ASSERT((NULL != message_ptr),
-           "zajel: message_cannot equal NULL!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->messageID < ZAJEL_MESSAGE_COUNT),
-           "zajel: Message ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->messageID),
-           "zajel: Zero cannot be used as a message ID, as it is reserved by the framework for acknowledge!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->sourceComponentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: Source component ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT((descriptor_ptr->destinationComponentID < ZAJEL_COMPONENT_COUNT),
-           "zajel: Destination component ID is greater than the supported message count!",
-           fileName,
-           lineNumber);
-    ASSERT(((TRUE == descriptor_ptr->isSynchronous) || (FALSE == descriptor_ptr->isSynchronous)),
-           "zajel: isSynchronous is niether true nor false!",
-           fileName,
-           lineNumber);
-    ASSERT((ZAJEL_THREAD_GET_CORE_ID(zajel_ptr,
-                                     callerThreadID) ==
-            ZAJEL_COMPONENT_GET_CORE_ID(zajel_ptr,
-                                        descriptor_ptr->destinationComponentID)),
-           "zajel: The destination core shall be the same as the calling core!",
-           fileName,
-           lineNumber);
+    zajel_placement_lock(zajel_ptr);
 
-    if(callerThreadID == ZAJEL_COMPONENT_GET_THREAD_ID(zajel_ptr,
-                                                       descriptor_ptr->destinationComponentID))
-    {
-        /*<Caller thread is the same as the destination thread, calling the handler directly in the same context>*/
-        zajel_ptr->messageInformationArray[descriptor_ptr->messageID].messageHandlerFunction(descriptor_ptr);
-    } /*if: <Caller thread is the same as the destination thread, calling the handler directly in the same context>*/
-    else
+    for(link_ptr = &zajel_ptr->mapping_ptr; NULL != *link_ptr; link_ptr = &(*link_ptr)->next_ptr)
     {
-        /*<Caller thread is different from the destination thread>*/
-        if(ZAJEL_ACK_MESSAGE_ID != descriptor_ptr->messageID)
+        /*<Look for the block among the mapped ones>*/
+        if(memory_ptr == (*link_ptr)->address_ptr)
         {
-            /*<Normal message received from a different core>*/
-            ZAJEL_THREAD_HANDLE_MESSAGE(zajel_ptr,
-                                        descriptor_ptr);
-        } /*if: <Normal message received from a different core>*/
-        else
-        {
-            /*<Acknowledge message received from a different core>*/
-            ZAJEL_THREAD_SYNCHRONIZE(zajel_ptr,
-                                     descriptor_ptr->destinationComponentID,
-                                     unblock);
-        } /*else: <Acknowledge message received from a different core>*/
-    } /*else: <Caller thread is different from the destination thread>*/
-} /*function: zajel_deliver*/
+            mapping_ptr = *link_ptr;
 
+            if(isRemoved)
+            {
+                *link_ptr = mapping_ptr->next_ptr;
+            } /*if: <Block is being released>*/
 
-/***************************************************************************************************
- *
- *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
- *
- **************************************************************************************************/
+            break;
+        } /*if: <Block found>*/
+    } /*for: <Look for the block among the mapped ones>*/
+
+    zajel_placement_unlock(zajel_ptr);
 
+    return mapping_ptr;
+} /*function: zajel_placement_find*/
 
-zajel_component_dynamic_relation_e zajel_component_get_dynamic_relation(zajel_s*    zajel_ptr,
-                                                                        uint32_t    sourceComponentID,
-                                                                        uint32_t    destinationComponentID)
+STATIC void zajel_placement_lock(zajel_s* zajel_ptr)
 {
-    zajel_component_information_u decision;
-    /*
-     * FIXME: mgalal on Mar 6, 2010
-     *
-     * Needs to be fixed according to the discussion with Karim.
-     */
+    /*Expected lock value*/
+    uint32_t unlocked;
 
-    decision.handle =   zajel_ptr->componentInformationArray[sourceComponentID].handle ^
-                        zajel_ptr->componentInformationArray[destinationComponentID].handle;
+    unlocked = FALSE;
 
-    return ((!decision.parameters.threadID) ?   (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD) :
-            (!decision.parameters.coreID)   ?   (ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE) :
-                                                (ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES));
+    while(FALSE == ZAJEL_ATOMIC_CAS(&zajel_ptr->mappingLock,
+                                    &unlocked,
+                                    TRUE))
+    {
+        /*<Another thread is going through the mapped blocks>*/
+        unlocked = FALSE;
+        ZAJEL_CPU_RELAX();
+    } /*while: <Another thread is going through the mapped blocks>*/
+} /*function: zajel_placement_lock*/
 
-} /*function: zajel_component_get_dynamic_relation*/
-/*function: */
+STATIC void zajel_placement_unlock(zajel_s* zajel_ptr)
+{
+    ZAJEL_ATOMIC_STORE_RELEASE(&zajel_ptr->mappingLock, FALSE);
+} /*function: zajel_placement_unlock*/
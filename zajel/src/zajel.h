@@ -37,16 +37,106 @@
  *  M A C R O S
  *
  **************************************************************************************************/
-/*
- * TODO: mgalal on Mar 6, 2010
- *
- * To be removed, debug is only defined temporarily to simplify development.
- */
+/*The debug checks (and the caller file/line arguments) are enabled unless NDEBUG is defined*/
+#if !defined(NDEBUG) && !defined(DEBUG)
 #define DEBUG 1
+#endif
 
 /*This message is reserved for inter-core synchronous message synchronization*/
 #define ZAJEL_ACK_MESSAGE_ID            (0)
 
+/*Counts used by zajel_init when no configuration is given*/
+#define ZAJEL_DEFAULT_MESSAGE_COUNT     (100)
+#define ZAJEL_DEFAULT_COMPONENT_COUNT   (10)
+#define ZAJEL_DEFAULT_THREAD_COUNT      (4)
+#define ZAJEL_DEFAULT_CORE_COUNT        (2)
+
+/*Biggest counts supported by the identifiers types*/
+#define ZAJEL_MAX_MESSAGE_COUNT         (65536)
+#define ZAJEL_MAX_COMPONENT_COUNT       (65536)
+#define ZAJEL_MAX_THREAD_COUNT          (256)
+#define ZAJEL_MAX_CORE_COUNT            (256)
+
+/*Values of the message descriptor flags*/
+#define ZAJEL_MESSAGE_FLAG_NONE         (0x00)
+/*The message was sent using zajel_call, and it is followed by a zajel_call_reply_s*/
+#define ZAJEL_MESSAGE_FLAG_CALL         (0x01)
+/*The message carries a shared payload, and it starts with a zajel_payload_descriptor_s*/
+#define ZAJEL_MESSAGE_FLAG_PAYLOAD      (0x02)
+/*The message was published to a topic (zajel_publish), it is owned by the framework*/
+#define ZAJEL_MESSAGE_FLAG_TOPIC        (0x04)
+/*The message is the marker closing the migration of its destination (zajel_migrate_component)*/
+#define ZAJEL_MESSAGE_FLAG_MIGRATION    (0x08)
+/*The message was passed on by the former thread of a migrating component, reset before handling*/
+#define ZAJEL_MESSAGE_FLAG_FORWARDED    (0x10)
+/*Bits of the flags holding the priority chosen by the sender, 0 to use the priority of the message ID*/
+#define ZAJEL_MESSAGE_FLAG_PRIORITY_MASK    (0x60)
+#define ZAJEL_MESSAGE_FLAG_PRIORITY_SHIFT   (5)
+/*Sends the message with the given zajel_priority_e (see zajel_enable_priority_lanes)*/
+#define ZAJEL_MESSAGE_FLAG_PRIORITY(priority)                                                      \
+    ((uint8_t)(((priority) + 1) << ZAJEL_MESSAGE_FLAG_PRIORITY_SHIFT))
+/*Set by the framework while the message counts against the inbound capacity of its destination thread*/
+#define ZAJEL_MESSAGE_FLAG_COUNTED      (0x80)
+/*Bits of the flags set by the sender, the priority and (through zajel_payload_attach) the payload*/
+#define ZAJEL_MESSAGE_FLAG_SENDER_MASK  (ZAJEL_MESSAGE_FLAG_PAYLOAD | ZAJEL_MESSAGE_FLAG_PRIORITY_MASK)
+
+/*Number of size classes of the message pools, the blocks size doubles from 64 up to 4096 bytes*/
+#define ZAJEL_POOL_SIZE_CLASS_COUNT     (7)
+
+/*Returned instead of a timer identifier when the calling thread has no timer left*/
+#define ZAJEL_TIMER_ID_INVALID          (0)
+
+/*Biggest number of timers a thread can have armed at once*/
+#define ZAJEL_MAX_TIMER_COUNT           (1 << 24)
+
+/*Number of entries reported by zajel_get_pool_statistics, the size classes then the oversize ones*/
+#define ZAJEL_POOL_STATISTICS_COUNT     (ZAJEL_POOL_SIZE_CLASS_COUNT + 1)
+
+/*The load balancer times one handled message out of this many (a power of two) for each component*/
+#ifndef ZAJEL_BALANCE_SAMPLE_PERIOD
+#define ZAJEL_BALANCE_SAMPLE_PERIOD     (16)
+#endif
+
+/*Number of most frequent sources of messages tracked for each component by the load balancer*/
+#define ZAJEL_BALANCE_PEER_COUNT        (4)
+
+/*Biggest number of moves a balancing policy may ask for in a single round*/
+#define ZAJEL_BALANCE_MAX_MOVE_COUNT    (4)
+
+/*Values used by zajel_balance_policy_default when no zajel_balance_config_s is given*/
+#define ZAJEL_BALANCE_DEFAULT_IMBALANCE_PERCENT (25)
+#define ZAJEL_BALANCE_DEFAULT_COOLDOWN_ROUNDS   (4)
+
+/*The statistics measure the queue residency of one message out of this many (a power of two) sent by each thread*/
+#ifndef ZAJEL_STATS_SAMPLE_PERIOD
+#define ZAJEL_STATS_SAMPLE_PERIOD       (64)
+#endif
+
+/*
+ * Layout of the statistics histograms: the values (in nanoseconds) below 2^ZAJEL_STATS_SUB_BUCKET_BITS
+ * have their own buckets, then each power of two is split into 2^ZAJEL_STATS_SUB_BUCKET_BITS buckets
+ * (a relative error of 12.5%), the values from 2^ZAJEL_STATS_MAX_VALUE_BITS on share the last one.
+ */
+#define ZAJEL_STATS_SUB_BUCKET_BITS     (3)
+#define ZAJEL_STATS_MAX_VALUE_BITS      (40)
+#define ZAJEL_STATS_BUCKET_COUNT                                                                   \
+    ((ZAJEL_STATS_MAX_VALUE_BITS - ZAJEL_STATS_SUB_BUCKET_BITS + 1) << ZAJEL_STATS_SUB_BUCKET_BITS)
+
+/*First bytes of a trace file written by zajel_trace_dump ("ZAJTRACE" read as a little endian word), and its layout version*/
+#define ZAJEL_TRACE_FILE_MAGIC          (0x45434152544A415AULL)
+#define ZAJEL_TRACE_FILE_VERSION        (1)
+
+/*Biggest number of NUMA nodes the memory placement handles, the nodes beyond are left unused*/
+#define ZAJEL_NUMA_MAX_NODE_COUNT       (64)
+
+/*The node of a core which is not known, its memory is placed by the operating system (first touch)*/
+#define ZAJEL_NUMA_NODE_ANY             (0xFFFFFFFF)
+
+/*Values of the zajel_enable_numa flags*/
+#define ZAJEL_NUMA_FLAG_NONE            (0x00)
+/*Back the per-thread blocks of at least a huge page with huge pages, when the system has some left*/
+#define ZAJEL_NUMA_FLAG_HUGE_PAGES      (0x01)
+
 #ifndef FALSE
 #define FALSE                           (0)
 #endif
@@ -115,9 +205,15 @@ typedef struct zajel zajel_s;
 /*boolean type*/
 typedef uint8_t bool_t;
 
-/*Supports up to 255 unique message id (0 is reserved for ack). In case more messages are needed,
- * a bigger type (short, long) can be used instead of byte*/
-typedef uint8_t message_id;
+/*Supports up to 65535 unique message id (0 is reserved for ack), each component may give them its
+ * own meaning (see zajel_regsiter_component_handler)*/
+typedef uint16_t message_id;
+
+/*Supports up to 65536 unique component id*/
+typedef uint16_t component_id;
+
+/*Identifies an armed timer (see zajel_send_after), ZAJEL_TIMER_ID_INVALID is never used*/
+typedef uint64_t timer_id;
 
 /***************************************************************************************************
  * Enumeration Name:
@@ -129,9 +225,72 @@ typedef uint8_t message_id;
 typedef enum zajel_status
 {
     ZAJEL_STATUS_SUCCESS = 0,
-    ZAJEL_STATUS_FAILURE = 1
+    ZAJEL_STATUS_FAILURE = 1,
+    /*The destination cannot take the message right now, nothing was sent*/
+    ZAJEL_STATUS_WOULD_BLOCK = 2
 } zajel_status_e;
 
+/***************************************************************************************************
+ * Enumeration Name:
+ * zajel_component_dynamic_relation_e
+ *
+ * Enumeration Description:
+ * Lists the different relation that can exist between any two components.
+ **************************************************************************************************/
+typedef enum zajel_component_dynamic_relation
+{
+    /*Both components are running on the same thread, on the same core*/
+    ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_THREAD        = 0,
+    /*Both components are running on different threads, on the same core*/
+    ZAJEL_COMPONENT_DYNAMIC_RELATION_SAME_CORE          = 1,
+    /*Both components are running on different threads, on different cores*/
+    ZAJEL_COMPONENT_DYNAMIC_RELATION_DIFFERENT_CORES    = 2,
+    ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT              = 3
+} zajel_component_dynamic_relation_e;
+
+/***************************************************************************************************
+ * Enumeration Name:
+ * zajel_priority_e
+ *
+ * Enumeration Description:
+ * The priority classes of the messages, from the most urgent one (see zajel_enable_priority_lanes).
+ **************************************************************************************************/
+typedef enum zajel_priority
+{
+    /*Control plane messages (heartbeats, cancellations...), drained before anything else*/
+    ZAJEL_PRIORITY_CONTROL  = 0,
+    /*Priority of every message unless told otherwise*/
+    ZAJEL_PRIORITY_NORMAL   = 1,
+    /*Bulk data, drained once the other lanes are empty (or got their share)*/
+    ZAJEL_PRIORITY_BULK     = 2,
+    ZAJEL_PRIORITY_COUNT    = 3
+} zajel_priority_e;
+
+/***************************************************************************************************
+ * Enumeration Name:
+ * zajel_trace_event_e
+ *
+ * Enumeration Description:
+ * The events written to the trace (see zajel_enable_trace), all of them recorded by the thread they
+ * happen on.
+ **************************************************************************************************/
+typedef enum zajel_trace_event
+{
+    /*A message is handed over by its sender*/
+    ZAJEL_TRACE_EVENT_SEND              = 0,
+    /*A message received by a core is passed to zajel_deliver*/
+    ZAJEL_TRACE_EVENT_DELIVER           = 1,
+    /*A synchronous message is acknowledged by its receiver*/
+    ZAJEL_TRACE_EVENT_ACKNOWLEDGE       = 2,
+    /*The sender of a synchronous message blocks, then resumes once acknowledged*/
+    ZAJEL_TRACE_EVENT_BLOCK             = 3,
+    ZAJEL_TRACE_EVENT_UNBLOCK           = 4,
+    /*The handler of a message is entered, then left*/
+    ZAJEL_TRACE_EVENT_HANDLER_ENTRY     = 5,
+    ZAJEL_TRACE_EVENT_HANDLER_EXIT      = 6,
+    ZAJEL_TRACE_EVENT_COUNT             = 7
+} zajel_trace_event_e;
+
 /***************************************************************************************************
  * Structure Name:
  * zajel_message_descriptor_s
@@ -145,13 +304,379 @@ typedef struct zajel_message_descriptor
     /*Message Identifier*/
     message_id messageID;
     /*Sender component identifier */
-    uint8_t    sourceComponentID;
+    component_id sourceComponentID;
     /*Receiver component identifier*/
-    uint8_t    destinationComponentID;
+    component_id destinationComponentID;
     /*Shall message be sent synchronously (i.e. sender will wait for the receiver to finish before continuing)*/
     bool_t     isSynchronous;
+    /*
+     * ZAJEL_MESSAGE_FLAG_xxx, reserved for the framework: the sender sets ZAJEL_MESSAGE_FLAG_NONE or
+     * a ZAJEL_MESSAGE_FLAG_PRIORITY, and the send functions clear the bits out of
+     * ZAJEL_MESSAGE_FLAG_SENDER_MASK, so a reused descriptor carries no stale framework state
+     */
+    uint8_t    flags;
 } zajel_message_descriptor_s;
 
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_call_reply_s
+ *
+ * Structure Description:
+ * The reply area of a message sent using zajel_call, it is filled by the receiver using zajel_reply.
+ * The reply payload (up to capacity bytes) immediately follows this structure, and the whole reply
+ * (sizeof(zajel_call_reply_s) + size bytes) travels back with the acknowledgment when the caller
+ * runs on a different core.
+ **************************************************************************************************/
+typedef struct zajel_call_reply
+{
+    /*Used as the acknowledgment descriptor when the reply crosses cores, owned by the framework*/
+    zajel_message_descriptor_s  descriptor;
+    /*User defined status of the call, set by the receiver*/
+    uint32_t                    status;
+    /*Number of bytes written to the reply payload*/
+    uint32_t                    size;
+    /*Number of bytes reserved for the reply payload by the caller*/
+    uint32_t                    capacity;
+    /*Padding, keeps the reply payload 8 bytes aligned*/
+    uint32_t                    reserved;
+    /*Address of the call in the caller address space, used to copy back a reply received by value*/
+    uint64_t                    callerAddress;
+} zajel_call_reply_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_call_descriptor_s
+ *
+ * Structure Description:
+ * This structure shall be the first member in any message sent using zajel_call, the members
+ * following it form the reply payload, then (optionally) the call arguments.
+ **************************************************************************************************/
+typedef struct zajel_call_descriptor
+{
+    /*The message descriptor, kept first so that the call can be used as a plain message*/
+    zajel_message_descriptor_s  descriptor;
+    /*The reply area, filled by the receiver*/
+    zajel_call_reply_s          reply;
+} zajel_call_descriptor_s;
+
+/*Gets the reply payload of the given call (zajel_call_descriptor_s*)*/
+#define ZAJEL_CALL_REPLY_PAYLOAD(call_ptr)      ((void*)(&(call_ptr)->reply + 1))
+
+/*Gets the number of bytes to be copied by a core transport carrying the given reply (zajel_call_reply_s*)*/
+#define ZAJEL_CALL_REPLY_MESSAGE_SIZE(reply_ptr) (sizeof(zajel_call_reply_s) + (reply_ptr)->size)
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_linked_message_descriptor_s
+ *
+ * Structure Description:
+ * An optional extension of the message descriptor, that shall be used instead of
+ * zajel_message_descriptor_s as the first member of the messages sent to threads using the mailbox
+ * transport. It carries the link used to chain the message inside the destination mailbox, so that
+ * enqueueing never allocates memory.
+ **************************************************************************************************/
+typedef struct zajel_linked_message_descriptor
+{
+    /*The message descriptor, kept first so that the extension can be used as a plain descriptor*/
+    zajel_message_descriptor_s                  descriptor;
+    /*Next message in the mailbox, owned by the framework*/
+    struct zajel_linked_message_descriptor*     next_ptr;
+} zajel_linked_message_descriptor_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_payload_s
+ *
+ * Structure Description:
+ * Precedes the data of a reference counted payload, allocated using zajel_payload_alloc. Once
+ * attached to a message the data shall be considered immutable, as it may be read by several
+ * receivers at the same time.
+ **************************************************************************************************/
+typedef struct zajel_payload
+{
+    /*Number of owners (the creator and every message it is attached to), owned by the framework*/
+    uint32_t    referenceCount;
+    /*Number of data bytes*/
+    uint32_t    size;
+    /*Whether the payload lives in the shared region, owned by the framework*/
+    uint32_t    isShared;
+    /*Padding, keeps the data 16 bytes aligned*/
+    uint32_t    reserved;
+} zajel_payload_s;
+
+/*Gets the data of the given payload (zajel_payload_s*)*/
+#define ZAJEL_PAYLOAD_DATA(payload_ptr)         ((void*)((payload_ptr) + 1))
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_payload_descriptor_s
+ *
+ * Structure Description:
+ * This structure shall be the first member in any message carrying a payload (zajel_payload_attach).
+ * It extends the linked descriptor so that such messages can use every thread transport, and it
+ * refers to the payload using a handle, which stays valid across the processes sharing a region.
+ **************************************************************************************************/
+typedef struct zajel_payload_descriptor
+{
+    /*The message descriptor and its mailbox link, kept first*/
+    zajel_linked_message_descriptor_s   linkedDescriptor;
+    /*Handle of the attached payload, owned by the framework*/
+    uint64_t                            payloadHandle;
+} zajel_payload_descriptor_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_pool_statistics_s
+ *
+ * Structure Description:
+ * Holds the counters of a single size class of a thread message pool, used to size the pools.
+ **************************************************************************************************/
+typedef struct zajel_pool_statistics
+{
+    /*Biggest message served by this size class, zero for the oversize entry*/
+    uint32_t    blockSize;
+    /*Number of allocations served from the free blocks*/
+    uint64_t    hits;
+    /*Number of allocations that needed to call the allocation function*/
+    uint64_t    misses;
+    /*Number of blocks freed by threads other than the owner*/
+    uint64_t    remoteFrees;
+} zajel_pool_statistics_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_stats_counters_s
+ *
+ * Structure Description:
+ * The traffic counters of a message ID or of a dynamic relation (see zajel_stats_snapshot).
+ **************************************************************************************************/
+typedef struct zajel_stats_counters
+{
+    /*Messages sent, counted by the sending thread*/
+    uint64_t    sendCount;
+    /*Messages handled, counted by the thread running the handler*/
+    uint64_t    deliverCount;
+    /*Synchronous messages the sending thread was blocked on, and the time it spent blocked in nanoseconds*/
+    uint64_t    blockCount;
+    uint64_t    blockTime;
+} zajel_stats_counters_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_stats_histogram_s
+ *
+ * Structure Description:
+ * A log-linear histogram of durations in nanoseconds, the bounds of its buckets are given by
+ * ZAJEL_STATS_SUB_BUCKET_BITS and ZAJEL_STATS_MAX_VALUE_BITS (see zajel_stats_percentile).
+ **************************************************************************************************/
+typedef struct zajel_stats_histogram
+{
+    /*Number of recorded values, their sum and the biggest one*/
+    uint64_t    count;
+    uint64_t    sum;
+    uint64_t    max;
+    uint64_t    bucketArray[ZAJEL_STATS_BUCKET_COUNT];
+} zajel_stats_histogram_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_stats_s
+ *
+ * Structure Description:
+ * The statistics of all the threads merged together, both arrays are indexed by the relation
+ * between the source and destination components (zajel_component_dynamic_relation_e).
+ **************************************************************************************************/
+typedef struct zajel_stats
+{
+    zajel_stats_counters_s  relationArray[ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT];
+    /*Time from sending the sampled messages to running their handler*/
+    zajel_stats_histogram_s residencyArray[ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT];
+} zajel_stats_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_trace_record_s
+ *
+ * Structure Description:
+ * A single trace event, as written in the trace file.
+ **************************************************************************************************/
+typedef struct zajel_trace_record
+{
+    /*Value of the processor timestamp counter (see zajel_trace_file_header_s for its frequency)*/
+    uint64_t    timestamp;
+    /*Address of the message descriptor, tying the events of the same message together*/
+    uint64_t    flowID;
+    uint16_t    messageID;
+    uint16_t    sourceComponentID;
+    uint16_t    destinationComponentID;
+    /*One of zajel_trace_event_e*/
+    uint8_t     event;
+    uint8_t     reserved;
+} zajel_trace_record_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_trace_file_header_s
+ *
+ * Structure Description:
+ * Starts a trace file, followed by threadCount blocks, each made of a zajel_trace_thread_header_s
+ * and its records (the oldest first). The timestamp counter and the monotonic clock are read
+ * together when the trace is enabled and when it is dumped, giving the frequency of the former.
+ **************************************************************************************************/
+typedef struct zajel_trace_file_header
+{
+    /*ZAJEL_TRACE_FILE_MAGIC and ZAJEL_TRACE_FILE_VERSION*/
+    uint64_t    magic;
+    uint32_t    version;
+    uint32_t    threadCount;
+    uint64_t    startTimestamp;
+    uint64_t    startNanoseconds;
+    uint64_t    endTimestamp;
+    uint64_t    endNanoseconds;
+} zajel_trace_file_header_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_trace_thread_header_s
+ *
+ * Structure Description:
+ * Starts the records of a thread in a trace file.
+ **************************************************************************************************/
+typedef struct zajel_trace_thread_header
+{
+    uint32_t    threadID;
+    uint32_t    coreID;
+    /*Number of records following the header*/
+    uint64_t    recordCount;
+} zajel_trace_thread_header_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_memory_placement_s
+ *
+ * Structure Description:
+ * Where the memory mapped by the framework once NUMA placement is enabled lies (see
+ * zajel_get_memory_placement). The pages are only counted on a node once touched.
+ **************************************************************************************************/
+typedef struct zajel_memory_placement
+{
+    /*Bytes resident on each node, nodeCount entries are meaningful*/
+    uint64_t    nodeBytesArray[ZAJEL_NUMA_MAX_NODE_COUNT];
+    /*Bytes not touched yet, or whose node could not be queried*/
+    uint64_t    unresidentBytes;
+    /*Bytes mapped, the ones mapped using huge pages, and the ones bound to the node of their thread*/
+    uint64_t    mappedBytes;
+    uint64_t    hugePageBytes;
+    uint64_t    boundBytes;
+    /*Number of nodes of the system (1 when it is not NUMA), and of memory blocks mapped*/
+    uint32_t    nodeCount;
+    uint32_t    mappingCount;
+} zajel_memory_placement_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_config_s
+ *
+ * Structure Description:
+ * Holds the sizes of the framework tables, given to zajel_init. Each identifier registered later
+ * shall be less than the matching count.
+ **************************************************************************************************/
+typedef struct zajel_config
+{
+    /*Number of message identifiers, including the reserved acknowledge (at most ZAJEL_MAX_MESSAGE_COUNT)*/
+    uint32_t    messageCount;
+    /*Number of component identifiers (at most ZAJEL_MAX_COMPONENT_COUNT)*/
+    uint32_t    componentCount;
+    /*Number of thread identifiers (at most ZAJEL_MAX_THREAD_COUNT)*/
+    uint32_t    threadCount;
+    /*Number of core identifiers (at most ZAJEL_MAX_CORE_COUNT)*/
+    uint32_t    coreCount;
+} zajel_config_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_balance_peer_s
+ *
+ * Structure Description:
+ * A component frequently sending messages to another one, and the (approximate) number of messages
+ * it sent since the load balancer was enabled.
+ **************************************************************************************************/
+typedef struct zajel_balance_peer
+{
+    uint32_t    componentID;
+    uint32_t    messageCount;
+} zajel_balance_peer_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_component_load_s
+ *
+ * Structure Description:
+ * The load of a single component, as seen by a balancing round (see zajel_balance).
+ **************************************************************************************************/
+typedef struct zajel_component_load
+{
+    /*Messages handled since the previous round*/
+    uint64_t                messageCount;
+    /*Time spent in the handlers since the previous round, in nanoseconds (estimated from samples)*/
+    uint64_t                handlerTime;
+    /*The most frequent sources of the handled messages, unused entries have a zero messageCount*/
+    zajel_balance_peer_s    peerArray[ZAJEL_BALANCE_PEER_COUNT];
+    /*Thread running the component*/
+    uint32_t                threadID;
+    /*Number of rounds since the component was last moved by the load balancer*/
+    uint32_t                idleRounds;
+} zajel_component_load_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_balance_view_s
+ *
+ * Structure Description:
+ * What a balancing policy gets to decide on the moves, the load of a thread being the time spent in
+ * the handlers of its components since the previous round.
+ **************************************************************************************************/
+typedef struct zajel_balance_view
+{
+    /*The load of each component, componentCount entries (unregistered ones are left empty)*/
+    const zajel_component_load_s*   componentLoadArray;
+    uint32_t                        componentCount;
+    /*The load and the core of each thread, threadCount entries*/
+    const uint64_t*                 threadLoadArray;
+    const uint32_t*                 threadCoreArray;
+    uint32_t                        threadCount;
+    /*TRUE if the components may only move to a thread of the same core (shm transport)*/
+    bool_t                          isCoreBound;
+} zajel_balance_view_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_balance_move_s
+ *
+ * Structure Description:
+ * A component that a balancing policy asks to move to another thread.
+ **************************************************************************************************/
+typedef struct zajel_balance_move
+{
+    uint32_t    componentID;
+    uint32_t    threadID;
+} zajel_balance_move_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_balance_config_s
+ *
+ * Structure Description:
+ * The tuning of zajel_balance_policy_default, given as the policy context.
+ **************************************************************************************************/
+typedef struct zajel_balance_config
+{
+    /*Nothing is moved unless the busiest thread is loaded this much more than the idlest one*/
+    uint32_t    imbalancePercent;
+    /*Number of rounds a moved component stays where it is before it may be moved again*/
+    uint32_t    cooldownRounds;
+} zajel_balance_config_s;
+
 /*Memory allocation function prototype*/
 typedef void*(*allocation_function)(size_t bytesCount);
 
@@ -167,6 +692,9 @@ typedef void (*unlock_function)();
 /*Defines the prototypes of message handler functions*/
 typedef void (*zajel_message_handler_function) (zajel_message_descriptor_s*);
 
+/*Defines the prototypes of the message handlers of a component, given the context they were registered with*/
+typedef void (*zajel_component_handler_function) (void*, zajel_message_descriptor_s*);
+
 /*
  * A callback function when called, shall block the sending (caller) thread, and it is used for
  * synchronous message delivery.
@@ -185,6 +713,27 @@ typedef void (*zajel_handle_message_callback) (zajel_message_descriptor_s*);
 /*Called by the framework so that the receiver core handle the given message*/
 typedef void (*zajel_core_handle_message_callback) (zajel_message_descriptor_s*);
 
+/*Called by the framework so that the receiver thread handle the given batch of messages*/
+typedef void (*zajel_handle_message_batch_callback) (zajel_message_descriptor_s**, uint32_t);
+
+/*Called by the framework so that the receiver core handle the given batch of messages*/
+typedef void (*zajel_core_handle_message_batch_callback) (zajel_message_descriptor_s**, uint32_t);
+
+/*
+ * A load balancing policy, fills up to maxMoveCount moves from the given view and returns their
+ * number, the context is the one given to zajel_enable_load_balancer
+ */
+typedef uint32_t (*zajel_balance_policy) (void*                         context_ptr,
+                                          const zajel_balance_view_s*   view_ptr,
+                                          zajel_balance_move_s*         move_array,
+                                          uint32_t                      maxMoveCount);
+
+/*An intrusive multi-producer/single-consumer mailbox, defined in zajel_mailbox.h*/
+typedef struct zajel_mailbox zajel_mailbox_s;
+
+/*A shared memory region used as the cross-core transport, defined in zajel_shm.c*/
+typedef struct zajel_shm zajel_shm_s;
+
 
 /***************************************************************************************************
  *
@@ -197,15 +746,18 @@ typedef void (*zajel_core_handle_message_callback) (zajel_message_descriptor_s*)
  *  Name        : zajel_init
  *
  *  Arguments   : zajel_s**             zajelPointer_ptr,
+ *                const zajel_config_s* config_ptr,
  *                allocation_function   allocationFunction_ptr,
  *                zajel_deallocation_function deallocationFunction_ptr COMMA()
  *                FILE_AND_LINE_FOR_TYPE()
  *
- *  Description : This function initializes the zajel framework.
+ *  Description : This function initializes the zajel framework, sizing its tables according to the
+ *                  given configuration (or the ZAJEL_DEFAULT_xxx counts when config_ptr is NULL).
  *
  *  Returns     : void.
  **************************************************************************************************/
 void zajel_init(zajel_s**                     zajelPointer_ptr,
+                const zajel_config_s*         config_ptr,
                 allocation_function           allocationFunction_ptr,
                 zajel_deallocation_function   deallocationFunction_ptr COMMA()
                 FILE_AND_LINE_FOR_TYPE());
@@ -244,6 +796,53 @@ void zajel_regsiter_message(zajel_s*                        zajel_ptr,
                             char*                           messageName_Ptr COMMA()
                             FILE_AND_LINE_FOR_TYPE());
 
+/***************************************************************************************************
+ *  Name        : zajel_regsiter_component_handler
+ *
+ *  Arguments   : zajel_s*                          zajel_ptr,
+ *                uint32_t                          componentID,
+ *                uint32_t                          messageID,
+ *                zajel_component_handler_function  handler_ptr,
+ *                void*                             context_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function registers the handler of the given message ID for the messages sent
+ *                  to the given component only, it is called with the given context. It takes
+ *                  precedence over the handler registered by zajel_regsiter_message, so each
+ *                  component can give the message IDs its own meaning. The handlers of a component
+ *                  are kept in a dense table spanning its smallest to its biggest message ID, which
+ *                  is best kept compact. It shall be called before sealing the topology.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_regsiter_component_handler(zajel_s*                          zajel_ptr,
+                                      uint32_t                          componentID,
+                                      uint32_t                          messageID,
+                                      zajel_component_handler_function  handler_ptr,
+                                      void*                             context_ptr COMMA()
+                                      FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_regsiter_unused_messages
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  firstMessageID,
+ *                uint32_t  messageCount COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function declares the given range of message IDs as not handled by this
+ *                  process, either unused or handled by the other processes sharing a region, so
+ *                  that zajel_seal accepts them without a handler. Such a message reaching this
+ *                  process is a bug, caught by the debug builds and dropped by the release ones.
+ *                  It shall be called before sealing the topology.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_regsiter_unused_messages(zajel_s*    zajel_ptr,
+                                    uint32_t    firstMessageID,
+                                    uint32_t    messageCount COMMA()
+                                    FILE_AND_LINE_FOR_TYPE());
+
 /***************************************************************************************************
  *  Name        : zajel_regsiter_component
  *
@@ -292,6 +891,33 @@ void zajel_regsiter_thread(zajel_s*                         zajel_ptr,
                            char*                            threadName_Ptr COMMA()
                            FILE_AND_LINE_FOR_TYPE());
 
+/***************************************************************************************************
+ *  Name        : zajel_regsiter_thread_mailbox
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                uint32_t          threadID,
+ *                uint32_t          coreID,
+ *                zajel_mailbox_s*  mailbox_ptr,
+ *                char*             threadName_Ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function register a thread to zajel framework, using the given (caller owned)
+ *                  mailbox as its inbound queue instead of a handleMessageCallback, and the ready-made
+ *                  zajel_mailbox_block/zajel_mailbox_unblock callbacks for synchronous messages.
+ *
+ *                  Every message sent to a component running on this thread shall start with a
+ *                  zajel_linked_message_descriptor_s. The thread collects its messages using
+ *                  zajel_poll, and parks using zajel_mailbox_wait when there is nothing to do.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_regsiter_thread_mailbox(zajel_s*         zajel_ptr,
+                                   uint32_t         threadID,
+                                   uint32_t         coreID,
+                                   zajel_mailbox_s* mailbox_ptr,
+                                   char*            threadName_Ptr COMMA()
+                                   FILE_AND_LINE_FOR_TYPE());
+
 /***************************************************************************************************
  *  Name        : zajel_regsiter_core
  *
@@ -312,62 +938,1097 @@ void zajel_regsiter_core(zajel_s*                           zajel_ptr,
                          char*                              coreName_Ptr COMMA()
                          FILE_AND_LINE_FOR_TYPE());
 
-/*
- * TODO: mgalal on Mar 6, 2010
+/***************************************************************************************************
+ *  Name        : zajel_set_inbound_capacity
  *
- * Add function to perform remapping (component to thread and thread to core).
- */
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                uint32_t  capacity COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function bounds the number of messages queued to the given thread (sent but
+ *                  not collected yet, priority lanes included), 0 (the default) leaves it unbounded.
+ *                  It only applies to the queues owned by the framework (ring or mailbox transport),
+ *                  and it shall be called before sealing the topology.
+ *
+ *                  The bound is enforced by zajel_try_send, which refuses the messages once it is
+ *                  reached. The other ways of sending still count their messages but never refuse
+ *                  them, and the senders racing for the last free entries may overshoot the bound by
+ *                  at most one message each.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_set_inbound_capacity(zajel_s*    zajel_ptr,
+                                uint32_t    threadID,
+                                uint32_t    capacity COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
 
 /***************************************************************************************************
- *  Name        : zajel_send
+ *  Name        : zajel_regsiter_thread_batch_callback
  *
- *  Arguments   : zajel_s*  zajel_ptr,
- *                void*     message_ptr COMMA()
+ *  Arguments   : zajel_s*                            zajel_ptr,
+ *                uint32_t                            threadID,
+ *                zajel_handle_message_batch_callback handleMessageBatchCallback COMMA()
  *                FILE_AND_LINE_FOR_TYPE()
  *
- *  Description : This function sends the given message to the registered handler, and it takes care
- *                  of details like in which thread that hander runs, what is the logical sending
- *                  method (synch/asynch) and how to physically achieve it.
+ *  Description : This function registers an optional batch-aware variant of the thread
+ *                  handleMessageCallback, used by zajel_send_batch to hand all the messages
+ *                  destined to this thread in a single call. The thread shall already be registered.
  *
  *  Returns     : void.
  **************************************************************************************************/
-void zajel_send(zajel_s*    zajel_ptr,
-                void*       message_ptr COMMA()
-                FILE_AND_LINE_FOR_TYPE());
+void zajel_regsiter_thread_batch_callback(zajel_s*                              zajel_ptr,
+                                          uint32_t                              threadID,
+                                          zajel_handle_message_batch_callback   handleMessageBatchCallback COMMA()
+                                          FILE_AND_LINE_FOR_TYPE());
 
 /***************************************************************************************************
- *  Name        : zajel_acknowledge
+ *  Name        : zajel_regsiter_core_batch_callback
  *
- *  Arguments   : zajel_s*  zajel_ptr,
- *                void*     message_ptr COMMA()
+ *  Arguments   : zajel_s*                                  zajel_ptr,
+ *                uint32_t                                  coreID,
+ *                zajel_core_handle_message_batch_callback  handleMessageBatchCallback COMMA()
  *                FILE_AND_LINE_FOR_TYPE()
  *
- *  Description : This function is used by the receiver thread to acknowledge the reception of a
- *                  synchronous message.
+ *  Description : This function registers an optional batch-aware variant of the core
+ *                  handleMessageCallback, used by zajel_send_batch to hand all the messages
+ *                  destined to this core in a single call. The core shall already be registered.
  *
  *  Returns     : void.
  **************************************************************************************************/
-void zajel_acknowledge(zajel_s* zajel_ptr,
-                       void*    message_ptr COMMA()
-                       FILE_AND_LINE_FOR_TYPE());
+void zajel_regsiter_core_batch_callback(zajel_s*                                    zajel_ptr,
+                                        uint32_t                                    coreID,
+                                        zajel_core_handle_message_batch_callback    handleMessageBatchCallback COMMA()
+                                        FILE_AND_LINE_FOR_TYPE());
 
 /***************************************************************************************************
- *  Name        : zajel_deliver
+ *  Name        : zajel_enable_ring_transport
  *
- *  Arguments   : zajel_s* zajel_ptr,
- *                void*    message_ptr,
- *                uint32_t callerThreadID COMMA()
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  ringCapacity COMMA()
  *                FILE_AND_LINE_FOR_TYPE()
  *
- *  Description : This function is used by the receiver core to deliver the received message
- *                  internally to one of the threads on the same core, or to unblock a thread on that
- *                  core, which was blocked after sending synchronous message.
+ *  Description : This function enables the built-in transport, where every ordered pair of threads
+ *                  is connected through a wait-free single-producer/single-consumer ring of
+ *                  ringCapacity messages (must be a power of two). Once enabled, the messages sent to
+ *                  a thread are no longer passed to its handleMessageCallback, instead the thread
+ *                  collects them using zajel_poll.
+ *
+ *                  It shall be called after registering all the threads (threads registered with a
+ *                  mailbox keep using it), and each message shall be sent from the thread running
+ *                  its source component (or from the thread passed as
+ *                  callerThreadID to zajel_deliver), as each ring accepts a single producer.
  *
  *  Returns     : void.
  **************************************************************************************************/
-void zajel_deliver(zajel_s* zajel_ptr,
-                   void*    message_ptr,
+void zajel_enable_ring_transport(zajel_s*   zajel_ptr,
+                                 uint32_t   ringCapacity COMMA()
+                                 FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_migrate_component
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  componentID,
+ *                uint32_t  newThreadID,
+ *                uint32_t  callerThreadID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function moves the given component to another thread (possibly on another
+ *                  core) of a sealed topology, while the messages keep flowing. The new component
+ *                  handle and a new set of routes are published atomically, the senders still holding
+ *                  the old routes keep using them safely, and these are freed once every thread sent
+ *                  a message along the new ones (or when the framework is destroyed).
+ *
+ *                  The messages already queued on the former thread are passed on to the new thread,
+ *                  and handled ahead of the ones sent after the migration, which the new thread holds
+ *                  until a marker, sent by callerThreadID along the old route, tells it that the
+ *                  former thread is drained. This needs the messages to be handled through
+ *                  zajel_deliver or zajel_dispatch, the messages collected by zajel_poll are not
+ *                  checked. A message whose sending overlaps the migration (a sender waiting for room
+ *                  in a full ring for instance) is waited for as well, the former thread holding the
+ *                  marker until it is queued, so the messages of each sender keep their order.
+ *
+ *                  Once this function returns, the component code shall only run on the new thread.
+ *                  A component waiting for an acknowledgment cannot be migrated, and when the shm
+ *                  transport is enabled the new thread shall run on the same core (the other processes
+ *                  keep the same topology).
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE while the previous migration of the component
+ *                  (or too many other migrations) are still in progress, the caller may retry later.
+ **************************************************************************************************/
+zajel_status_e zajel_migrate_component(zajel_s*   zajel_ptr,
+                                       uint32_t   componentID,
+                                       uint32_t   newThreadID,
+                                       uint32_t   callerThreadID COMMA()
+                                       FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_load_balancer
+ *
+ *  Arguments   : zajel_s*              zajel_ptr,
+ *                zajel_balance_policy  policy,
+ *                void*                 context_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function makes the framework count, for every component, the messages it
+ *                  handles, who sent them, and (on one message out of ZAJEL_BALANCE_SAMPLE_PERIOD)
+ *                  the time spent in its handlers. zajel_balance then uses these counters to move the
+ *                  components from the busy threads to the idle ones, as decided by the given policy
+ *                  (zajel_balance_policy_default if NULL) which gets context_ptr. It shall be called
+ *                  before sealing the topology. The components are moved by zajel_migrate_component,
+ *                  so its conditions apply to every component a policy may pick.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_load_balancer(zajel_s*                zajel_ptr,
+                                zajel_balance_policy    policy,
+                                void*                   context_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_balance
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  callerThreadID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function runs a single balancing round: it gathers the load of every component
+ *                  and thread since the previous round, asks the policy which components to move,
+ *                  and migrates them using zajel_migrate_component (sending the markers from
+ *                  callerThreadID). The moves that cannot be made right now are dropped, the next
+ *                  round deciding again. It shall be called periodically (every few hundreds of
+ *                  milliseconds for instance) by a single thread, once the topology is sealed.
+ *
+ *  Returns     : uint32_t, number of components moved.
+ **************************************************************************************************/
+uint32_t zajel_balance(zajel_s*     zajel_ptr,
+                       uint32_t     callerThreadID COMMA()
+                       FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_balance_policy_default
+ *
+ *  Arguments   : void*                         context_ptr,
+ *                const zajel_balance_view_s*   view_ptr,
+ *                zajel_balance_move_s*         move_array,
+ *                uint32_t                      maxMoveCount
+ *
+ *  Description : The default balancing policy, context_ptr is a zajel_balance_config_s (or NULL for
+ *                  the defaults). Once the busiest thread is loaded imbalancePercent more than the
+ *                  idlest one, it moves a single component off the busiest thread, picking the one
+ *                  that ends up with the most traffic to its peers in the same thread (then in the
+ *                  same core), then the one evening the load out the best. A component is only moved
+ *                  if the move lowers the load of the busiest thread without making another thread
+ *                  busier, and not again before cooldownRounds rounds, so components do not bounce.
+ *
+ *  Returns     : uint32_t, number of moves (0 or 1).
+ **************************************************************************************************/
+uint32_t zajel_balance_policy_default(void*                         context_ptr,
+                                      const zajel_balance_view_s*   view_ptr,
+                                      zajel_balance_move_s*         move_array,
+                                      uint32_t                      maxMoveCount);
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_work_stealing
+ *
+ *  Arguments   : zajel_s*  zajel_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function enables the actors (see zajel_regsiter_actor), by giving every
+ *                  thread a run queue, it shall be called before sealing the topology. zajel_dispatch
+ *                  then runs, with the budget left by the inbound messages of its thread, the
+ *                  runnable actors of the thread, then steals the ones of the other threads of the
+ *                  same core.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_work_stealing(zajel_s* zajel_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_regsiter_actor
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  componentID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function turns the given registered component into an actor: it gets a
+ *                  mailbox of its own, and instead of always running on its thread, it is run by any
+ *                  thread of its core calling zajel_dispatch, one thread at a time, in the order its
+ *                  messages arrived. Its thread (which shall use the ring or the mailbox transport)
+ *                  only becomes its home, where it is queued whenever it becomes runnable (waking the
+ *                  thread if parked in zajel_mailbox_wait).
+ *
+ *                  Every message sent to an actor shall start with a zajel_linked_message_descriptor_s,
+ *                  and an actor only exchanges asynchronous messages. While it runs, the handle of the
+ *                  component names the running thread, so the messages it sends leave from that
+ *                  thread. An actor cannot be migrated, and it is left out by the load balancer.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_regsiter_actor(zajel_s*  zajel_ptr,
+                          uint32_t  componentID COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_priority_lanes
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                const uint32_t*   weightArray COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function gives every thread using the ring or the mailbox transport a lane per
+ *                  zajel_priority_e, it shall be called before sealing the topology. The normal lane
+ *                  is the thread transport itself, the other ones are mailboxes, so the messages sent
+ *                  with these priorities shall start with a zajel_linked_message_descriptor_s.
+ *
+ *                  zajel_dispatch and zajel_poll collect the lanes from the most urgent one. When
+ *                  weightArray is NULL the lanes are drained strictly by priority, otherwise it holds
+ *                  ZAJEL_PRIORITY_COUNT weights: each lane first gets up to its weight of every
+ *                  collected batch, then the room left goes to the lanes by priority, so that a busy
+ *                  lane never starves the less urgent ones.
+ *
+ *                  The priority of a message is the one of its message ID (see
+ *                  zajel_regsiter_message_priority), unless the sender sets ZAJEL_MESSAGE_FLAG_PRIORITY
+ *                  in its flags. The messages keep their order within a lane only, and the priority is
+ *                  ignored for the messages sent to an actor, to another core, or to a thread using the
+ *                  callbacks.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_priority_lanes(zajel_s*           zajel_ptr,
+                                 const uint32_t*    weightArray COMMA()
+                                 FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_regsiter_message_priority
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  messageID,
+ *                uint32_t  priority COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sets the zajel_priority_e of the given message, used whenever it is
+ *                  sent without ZAJEL_MESSAGE_FLAG_PRIORITY. The priority lanes shall be enabled, and
+ *                  the topology not sealed yet. The messages are of normal priority by default.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_regsiter_message_priority(zajel_s*   zajel_ptr,
+                                     uint32_t   messageID,
+                                     uint32_t   priority COMMA()
+                                     FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_message_pools
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  blocksPerSlab COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function enables the framework managed message pools, one pool per thread,
+ *                  each made of ZAJEL_POOL_SIZE_CLASS_COUNT size classes. The pools grow by slabs of
+ *                  blocksPerSlab blocks obtained from the allocation function given to zajel_init,
+ *                  and are only released when the framework is destroyed. It shall be called before
+ *                  sealing the topology.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_message_pools(zajel_s*    zajel_ptr,
+                                uint32_t    blocksPerSlab COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_sync_slots
+ *
+ *  Arguments   : zajel_s*  zajel_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function enables the built-in synchronization slots, one per thread, used
+ *                  instead of the threads block/unblock callbacks for synchronous messages. The
+ *                  sender of a synchronous message spins on its slot for a bounded, adaptive number
+ *                  of iterations before parking on a futex, and the acknowledgment completes the slot
+ *                  directly, so a receiver answering within a few microseconds costs no context
+ *                  switch. The slots only work between threads of the same process. It shall be
+ *                  called before sealing the topology.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_sync_slots(zajel_s* zajel_ptr COMMA()
+                             FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_timers
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint64_t  tickNanoseconds,
+ *                uint32_t  timersPerThread COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function gives every thread a hierarchical timing wheel of the given
+ *                  resolution, able to hold up to timersPerThread (at most ZAJEL_MAX_TIMER_COUNT)
+ *                  timers armed at once, for zajel_send_after and zajel_send_every. It shall be
+ *                  called before sealing the topology. Arming and cancelling a timer are O(1). The
+ *                  messages still held by the timers when the framework is destroyed are released with
+ *                  the deallocation function, unless the message pools are enabled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_timers(zajel_s*   zajel_ptr,
+                         uint64_t   tickNanoseconds,
+                         uint32_t   timersPerThread COMMA()
+                         FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_stats
+ *
+ *  Arguments   : zajel_s* zajel_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function gives every thread its own (cache line aligned) statistics, counting
+ *                  the messages it sends and handles per message ID and per dynamic relation, the
+ *                  time it spends blocked on synchronous messages, and the queue residency of one
+ *                  message out of ZAJEL_STATS_SAMPLE_PERIOD it sends. Each counter is only written by
+ *                  its thread, without locks nor read-modify-write atomics, and zajel_stats_snapshot
+ *                  merges them on demand. It shall be called before sealing the topology.
+ *
+ *                  A thread samples at most one message in flight towards each destination thread,
+ *                  and the residency of the messages crossing to another process through the shm
+ *                  transport is not measured.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_stats(zajel_s* zajel_ptr COMMA()
+                        FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_trace
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  recordsPerThread COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function gives every thread a ring of recordsPerThread (a power of two) trace
+ *                  records, keeping the latest events of the thread: the messages sent, delivered
+ *                  through zajel_deliver and acknowledged, the blocking on synchronous messages, and
+ *                  the handlers run, each stamped with the processor timestamp counter. Each ring is
+ *                  only written by its thread, without locks nor read-modify-write atomics. Nothing
+ *                  is recorded until zajel_trace_start is called, and while the trace is stopped
+ *                  each of these events costs a single test. It shall be called before sealing the
+ *                  topology.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_trace(zajel_s*    zajel_ptr,
+                        uint32_t    recordsPerThread COMMA()
+                        FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_start
+ *
+ *  Arguments   : zajel_s* zajel_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function starts recording the events, the trace shall be enabled. It can be
+ *                  called by any thread, the threads start recording shortly afterwards.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_trace_start(zajel_s* zajel_ptr COMMA()
+                       FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_stop
+ *
+ *  Arguments   : zajel_s* zajel_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function stops recording the events, the recorded ones are kept until the
+ *                  trace is started again. It can be called by any thread, for instance as soon as
+ *                  a latency spike is detected.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_trace_stop(zajel_s* zajel_ptr COMMA()
+                      FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_numa
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  flags COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function places the memory of each thread on the NUMA node of its core (see
+ *                  zajel_set_core_node), the memory being mapped from the system instead of taken
+ *                  from the allocation function. It covers the memory allocated afterwards: the ring
+ *                  slots (on the node of the consumer), the message pools, the timers, the statistics,
+ *                  the trace records, and the routes (each thread reading its own row, the table is
+ *                  in effect replicated on the node of every thread). The blocks of each thread are
+ *                  page aligned, flags being ZAJEL_NUMA_FLAG_xxx. It shall be called first, before
+ *                  enabling the transports and the other features, and only before sealing.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_numa(zajel_s*     zajel_ptr,
+                       uint32_t     flags COMMA()
+                       FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_set_core_node
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  coreID,
+ *                uint32_t  nodeID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sets the NUMA node the threads of the given core run on, or
+ *                  ZAJEL_NUMA_NODE_ANY (the default) to leave their memory to the operating system.
+ *                  It shall be called before enabling the features placing memory (see
+ *                  zajel_enable_numa), the POSIX backend calls it for the cores pinned to a node.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_set_core_node(zajel_s*   zajel_ptr,
+                         uint32_t   coreID,
+                         uint32_t   nodeID COMMA()
+                         FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_shm_transport
+ *
+ *  Arguments   : zajel_s*      zajel_ptr,
+ *                zajel_shm_s*  shm_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function makes the given shared region (see zajel_shm.h) the transport of all
+ *                  the messages sent to the other cores, instead of the cores callbacks (the cores are
+ *                  still registered, but their callbacks are no longer called). The messages sent to the other cores shall then be allocated using
+ *                  zajel_shm_message_alloc, and the region shall outlive the control block.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_shm_transport(zajel_s*        zajel_ptr,
+                                zajel_shm_s*    shm_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_enable_topics
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  topicCount,
+ *                uint32_t  subscriptionCapacity COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function enables the publish/subscribe topics, with topic IDs up to
+ *                  topicCount - 1 and up to subscriptionCapacity subscriptions overall.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_enable_topics(zajel_s*   zajel_ptr,
+                         uint32_t   topicCount,
+                         uint32_t   subscriptionCapacity COMMA()
+                         FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_subscribe
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  componentID,
+ *                uint32_t  topicID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function subscribes the given component to the given topic, the subscriptions
+ *                  are part of the topology (they shall be made before sealing it, and in the same
+ *                  way by all the processes sharing a region).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_subscribe(zajel_s*   zajel_ptr,
+                     uint32_t   componentID,
+                     uint32_t   topicID COMMA()
+                     FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_seal
+ *
+ *  Arguments   : zajel_s*  zajel_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function shall be called once all the cores, threads, components and messages
+ *                  are registered (and the optional transports enabled). It validates the whole
+ *                  topology at once: every component is mapped to a registered thread, every thread
+ *                  to a registered core, and every message ID (but the acknowledge) has a handler,
+ *                  registered using zajel_regsiter_message or zajel_regsiter_component_handler, or is
+ *                  declared unused by zajel_regsiter_unused_messages. The checks are the same in all
+ *                  builds. Then it resolves the routes, and freezes the topology so that
+ *                  zajel_send_fast can skip the per-message checks.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE (and the topology is left unsealed) if the
+ *                  validation failed.
+ **************************************************************************************************/
+zajel_status_e zajel_seal(zajel_s* zajel_ptr COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_message_alloc
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  callerThreadID,
+ *                uint32_t  size COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function allocates a message of the given size from the pool of the calling
+ *                  thread (callerThreadID), messages bigger than the biggest size class are allocated
+ *                  directly using the allocation function.
+ *
+ *  Returns     : void*, NULL if the allocation function failed.
+ **************************************************************************************************/
+void* zajel_message_alloc(zajel_s*  zajel_ptr,
+                          uint32_t  callerThreadID,
+                          uint32_t  size COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_message_free
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  callerThreadID,
+ *                void*     message_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function releases a message allocated by zajel_message_alloc, it can be called
+ *                  from any thread. A message freed by a thread other than the one that allocated it
+ *                  goes back to the owner pool through a lock-free remote-free list.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_message_free(zajel_s*    zajel_ptr,
+                        uint32_t    callerThreadID,
+                        void*       message_ptr COMMA()
+                        FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_get_pool_statistics
+ *
+ *  Arguments   : zajel_s*                  zajel_ptr,
+ *                uint32_t                  threadID,
+ *                zajel_pool_statistics_s*  statistics_array COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function copies the counters of the given thread pool into statistics_array,
+ *                  which shall hold ZAJEL_POOL_STATISTICS_COUNT entries: one per size class, in
+ *                  ascending block size, followed by the oversize allocations.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_get_pool_statistics(zajel_s*                 zajel_ptr,
+                               uint32_t                 threadID,
+                               zajel_pool_statistics_s* statistics_array COMMA()
+                               FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_get_component_core
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  componentID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function gets the core currently running the given (registered) component, it
+ *                  can be called by any thread while the components are migrated. It is meant for the
+ *                  core callbacks, which are only given the message, to find the destination core.
+ *
+ *  Returns     : uint32_t.
+ **************************************************************************************************/
+uint32_t zajel_get_component_core(zajel_s*  zajel_ptr,
+                                  uint32_t  componentID COMMA()
+                                  FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_get_memory_placement
+ *
+ *  Arguments   : zajel_s*                  zajel_ptr,
+ *                zajel_memory_placement_s* placement_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function reports where the memory mapped since zajel_enable_numa lies, by
+ *                  asking the operating system for the node of each of its pages. It can be called
+ *                  by any thread, placement_ptr is zeroed when NUMA placement is not enabled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_get_memory_placement(zajel_s*                    zajel_ptr,
+                                zajel_memory_placement_s*   placement_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_snapshot
+ *
+ *  Arguments   : zajel_s*                  zajel_ptr,
+ *                zajel_stats_s*            stats_ptr,
+ *                zajel_stats_counters_s*   messageCounters_array COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function merges the statistics of all the threads into stats_ptr, and the
+ *                  counters of each message ID into messageCounters_array (unless NULL), which shall
+ *                  hold as many entries as the message count given to zajel_init. It can be called by
+ *                  any thread while the messages flow, each counter being read atomically (but not
+ *                  all of them at the same instant). The statistics shall be enabled.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_stats_snapshot(zajel_s*                  zajel_ptr,
+                          zajel_stats_s*            stats_ptr,
+                          zajel_stats_counters_s*   messageCounters_array COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_percentile
+ *
+ *  Arguments   : const zajel_stats_histogram_s*    histogram_ptr,
+ *                uint32_t                          partsPerMillion
+ *
+ *  Description : This function estimates the value below which the given part of the recorded values
+ *                  falls, in parts per million (500000 for the median, 999000 for p99.9). The result
+ *                  is the upper bound of the bucket holding that value, capped to the biggest value.
+ *
+ *  Returns     : uint64_t, the value in nanoseconds, zero if the histogram is empty.
+ **************************************************************************************************/
+uint64_t zajel_stats_percentile(const zajel_stats_histogram_s*  histogram_ptr,
+                                uint32_t                        partsPerMillion);
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_dump
+ *
+ *  Arguments   : zajel_s*      zajel_ptr,
+ *                const char*   path_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function writes the recorded events of every thread to the given file (see
+ *                  zajel_trace_file_header_s), to be converted by tools/zajel_trace_convert. It can
+ *                  be called by any thread while the trace is running, the records overwritten
+ *                  while being copied are then left out, but stopping the trace first gives a
+ *                  consistent picture of all the threads.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE if the file cannot be written.
+ **************************************************************************************************/
+zajel_status_e zajel_trace_dump(zajel_s*    zajel_ptr,
+                                const char* path_ptr COMMA()
+                                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_payload_alloc
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  size COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function allocates a reference counted payload of size data bytes, owned by
+ *                  the caller (a reference count of one). The payload is allocated from the shared
+ *                  region when the shm transport is enabled, so that it can cross cores, and using
+ *                  the allocation function otherwise.
+ *
+ *  Returns     : zajel_payload_s*, NULL if the allocation failed.
+ **************************************************************************************************/
+zajel_payload_s* zajel_payload_alloc(zajel_s*   zajel_ptr,
+                                     uint32_t   size COMMA()
+                                     FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_payload_retain
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                zajel_payload_s*  payload_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function adds an owner to the given payload, it can be called from any thread.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_payload_retain(zajel_s*          zajel_ptr,
+                          zajel_payload_s*  payload_ptr COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_payload_release
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                zajel_payload_s*  payload_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function removes an owner from the given payload, it can be called from any
+ *                  thread (of any process sharing the region). The last owner frees the payload.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_payload_release(zajel_s*         zajel_ptr,
+                           zajel_payload_s* payload_ptr COMMA()
+                           FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_payload_attach
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                void*             message_ptr,
+ *                zajel_payload_s*  payload_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function attaches the given payload to the given message (starting with a
+ *                  zajel_payload_descriptor_s), and makes the message an owner of the payload. The
+ *                  framework releases it once the message handler returns, so the same payload can
+ *                  be attached to several messages (multicast) without copying its data. The
+ *                  caller keeps its own reference, and shall release it when no longer needed.
+ *                  A payload cannot be attached to a message sent using zajel_call.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_payload_attach(zajel_s*          zajel_ptr,
+                          void*             message_ptr,
+                          zajel_payload_s*  payload_ptr COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_payload_get
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function gets the payload attached to the given message, it is valid until
+ *                  the message handler returns, unless the handler retains it.
+ *
+ *  Returns     : zajel_payload_s*, NULL if the message carries no payload.
+ **************************************************************************************************/
+zajel_payload_s* zajel_payload_get(zajel_s* zajel_ptr,
+                                   void*    message_ptr COMMA()
+                                   FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_send
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sends the given message to the registered handler, and it takes care
+ *                  of details like in which thread that hander runs, what is the logical sending
+ *                  method (synch/asynch) and how to physically achieve it. The flags of the message
+ *                  are reserved on entry, only the bits of ZAJEL_MESSAGE_FLAG_SENDER_MASK are kept
+ *                  (the same goes for the other send functions).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_send(zajel_s*    zajel_ptr,
+                void*       message_ptr COMMA()
+                FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_send_fast
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr
+ *
+ *  Description : This function is the check-free variant of zajel_send, to be used once the topology
+ *                  is sealed (see zajel_seal). The release builds neither validate the message nor
+ *                  check the routes, the debug builds keep the full validation of zajel_send.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_send_fast(zajel_s*   zajel_ptr,
+                     void*      message_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_try_send
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function is the non-blocking variant of zajel_send, for asynchronous messages
+ *                  only. Rather than waiting for room, it gives up when the destination is full:
+ *
+ *                  o The inbound capacity of the destination thread is reached (see
+ *                    zajel_set_inbound_capacity).
+ *                  o The ring leading to the destination thread is full (ring transport).
+ *                  o The source core ran out of credits for the destination core (shm transport).
+ *
+ *                  The destinations reached through user callbacks (threads, cores) and the actors
+ *                  are never considered full. The caller keeps the ownership of a refused message,
+ *                  and may retry it later (typically after draining its own messages).
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_WOULD_BLOCK if the destination is full.
+ **************************************************************************************************/
+zajel_status_e zajel_try_send(zajel_s*  zajel_ptr,
+                              void*     message_ptr COMMA()
+                              FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_send_batch
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void**    message_ptr_array,
+ *                uint32_t  messageCount COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sends the given asynchronous messages, all sent from components
+ *                  running on the calling thread. The messages are classified by destination thread
+ *                  (or core) in a single pass, then each destination is handed its messages at once:
+ *                  through its batch callback when registered, a single ring publication, or a single
+ *                  mailbox exchange. The order of the messages going to the same destination is kept.
+ *                  An empty batch (or a NULL array) sends nothing.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_send_batch(zajel_s*  zajel_ptr,
+                      void**    message_ptr_array,
+                      uint32_t  messageCount COMMA()
+                      FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_publish
+ *
+ *  Arguments   : zajel_s*          zajel_ptr,
+ *                uint32_t          topicID,
+ *                message_id        messageID,
+ *                component_id      sourceComponentID,
+ *                zajel_payload_s*  payload_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sends the given message (asynchronously) to every subscriber of the
+ *                  given topic. The subscribers are grouped by destination: every thread of the
+ *                  sending core gets a single message, and so does every other core, which then
+ *                  splits it among its own threads. The handler runs once per subscriber, with the
+ *                  message destination set to that subscriber, and reads the data from the payload
+ *                  (zajel_payload_get), shared by all the subscribers. The messages are allocated and
+ *                  freed by the framework, so the handlers shall not free them. The payload may be
+ *                  NULL, the caller keeps its own reference otherwise.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_publish(zajel_s*         zajel_ptr,
+                   uint32_t         topicID,
+                   message_id       messageID,
+                   component_id     sourceComponentID,
+                   zajel_payload_s* payload_ptr COMMA()
+                   FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_send_after
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  callerThreadID,
+ *                void*     message_ptr,
+ *                uint64_t  delayNanoseconds COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sends the given asynchronous message once the given delay is over
+ *                  (rounded up to the timers tick). The timer is armed on the wheel of the calling
+ *                  thread, which sends the message from its zajel_dispatch (or zajel_advance_timers)
+ *                  once it expires, along the route it would have taken with zajel_send, so a
+ *                  timeout that a component sets for itself never leaves its thread. The message is
+ *                  owned by the timer until then.
+ *
+ *  Returns     : timer_id, to be given to zajel_timer_cancel, or ZAJEL_TIMER_ID_INVALID if the calling
+ *                  thread has no timer left.
+ **************************************************************************************************/
+timer_id zajel_send_after(zajel_s*  zajel_ptr,
+                          uint32_t  callerThreadID,
+                          void*     message_ptr,
+                          uint64_t  delayNanoseconds COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_send_every
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  callerThreadID,
+ *                void*     message_ptr,
+ *                uint32_t  size,
+ *                uint64_t  periodNanoseconds COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sends a copy of the given asynchronous message (of size bytes) every
+ *                  period (rounded up to the timers tick), starting one period from now, until the
+ *                  timer is cancelled. The timer keeps the given message, and the copies are owned by
+ *                  their handler like any other message: they are allocated from the pool of the
+ *                  calling thread when the message pools are enabled, and with the allocation function
+ *                  given to zajel_init otherwise. The periods missed by a thread late to dispatch are
+ *                  skipped rather than sent in a burst.
+ *
+ *  Returns     : timer_id, to be given to zajel_timer_cancel, or ZAJEL_TIMER_ID_INVALID if the calling
+ *                  thread has no timer left.
+ **************************************************************************************************/
+timer_id zajel_send_every(zajel_s*  zajel_ptr,
+                          uint32_t  callerThreadID,
+                          void*     message_ptr,
+                          uint32_t  size,
+                          uint64_t  periodNanoseconds COMMA()
+                          FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_cancel
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  callerThreadID,
+ *                timer_id  timerID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function cancels the given timer, it shall be called by the thread which armed
+ *                  it. A timer which already sent its message (or was already cancelled) is left
+ *                  alone, the stale identifiers are recognized.
+ *
+ *  Returns     : void*, the message given when the timer was armed, now owned by the caller again,
+ *                  NULL if the timer is no longer armed.
+ **************************************************************************************************/
+void* zajel_timer_cancel(zajel_s*   zajel_ptr,
+                         uint32_t   callerThreadID,
+                         timer_id   timerID COMMA()
+                         FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_call
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr,
+ *                uint32_t  replyCapacity COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function sends the given message (starting with a zajel_call_descriptor_s)
+ *                  synchronously, and waits for the receiver to answer it using zajel_reply. The
+ *                  replyCapacity bytes following the zajel_call_descriptor_s are reserved for the
+ *                  reply payload, which is found at ZAJEL_CALL_REPLY_PAYLOAD once the call returns.
+ *                  The result comes back with the acknowledgment, no extra message is sent.
+ *
+ *  Returns     : uint32_t, the status given by the receiver to zajel_reply.
+ **************************************************************************************************/
+uint32_t zajel_call(zajel_s*    zajel_ptr,
+                    void*       message_ptr,
+                    uint32_t    replyCapacity COMMA()
+                    FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_reply
+ *
+ *  Arguments   : zajel_s*      zajel_ptr,
+ *                void*         message_ptr,
+ *                uint32_t      status,
+ *                const void*   result_ptr,
+ *                uint32_t      resultSize COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function is used by the receiver of a message sent using zajel_call to answer
+ *                  it, instead of zajel_acknowledge. The status and resultSize bytes of result_ptr
+ *                  are written to the reply area of the message (result_ptr may already point to the
+ *                  reply payload, or be NULL when resultSize is zero), then the caller is released.
+ *                  The message shall not be accessed by the receiver afterwards.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_reply(zajel_s*       zajel_ptr,
+                 void*          message_ptr,
+                 uint32_t       status,
+                 const void*    result_ptr,
+                 uint32_t       resultSize COMMA()
+                 FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_acknowledge
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                void*     message_ptr COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function is used by the receiver thread to acknowledge the reception of a
+ *                  synchronous message.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_acknowledge(zajel_s* zajel_ptr,
+                       void*    message_ptr COMMA()
+                       FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_deliver
+ *
+ *  Arguments   : zajel_s* zajel_ptr,
+ *                void*    message_ptr,
+ *                uint32_t callerThreadID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function is used by the receiver core to deliver the received message
+ *                  internally to one of the threads on the same core, or to unblock a thread on that
+ *                  core, which was blocked after sending synchronous message.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_deliver(zajel_s* zajel_ptr,
+                   void*    message_ptr,
                    uint32_t callerThreadID COMMA()
                    FILE_AND_LINE_FOR_TYPE());
 
+/***************************************************************************************************
+ *  Name        : zajel_poll
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                void**    message_ptr_array,
+ *                uint32_t  maxCount COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function is used by a thread using the ring or the mailbox transport to drain
+ *                  its incoming messages, it never blocks. The collected messages shall be passed by the same thread
+ *                  to zajel_deliver (with callerThreadID set to threadID) to invoke their handlers.
+ *
+ *  Returns     : uint32_t, number of messages stored in message_ptr_array (at most maxCount).
+ **************************************************************************************************/
+uint32_t zajel_poll(zajel_s*    zajel_ptr,
+                    uint32_t    threadID,
+                    void**      message_ptr_array,
+                    uint32_t    maxCount COMMA()
+                    FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_dispatch
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID,
+ *                uint32_t  budget COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function is the receive loop of a thread using the ring or the mailbox
+ *                  transport, it shall be called by that thread only. It drains the inbound messages
+ *                  in batches, running the registered handler of each message to completion, and
+ *                  returns once the inbound queues are empty or budget messages were handled, so
+ *                  that the thread can attend its other duties with a bounded latency. When work
+ *                  stealing is enabled, it then runs the runnable actors with the budget left. When
+ *                  the timers are enabled, it first sends the messages of the expired timers of the
+ *                  thread (see zajel_advance_timers).
+ *
+ *  Returns     : uint32_t, number of messages handled.
+ **************************************************************************************************/
+uint32_t zajel_dispatch(zajel_s*    zajel_ptr,
+                        uint32_t    threadID,
+                        uint32_t    budget COMMA()
+                        FILE_AND_LINE_FOR_TYPE());
+
+/***************************************************************************************************
+ *  Name        : zajel_advance_timers
+ *
+ *  Arguments   : zajel_s*  zajel_ptr,
+ *                uint32_t  threadID COMMA()
+ *                FILE_AND_LINE_FOR_TYPE()
+ *
+ *  Description : This function moves the timing wheel of the given (calling) thread up to the
+ *                  current time, and sends the messages of the timers expiring on the way. It is
+ *                  called by zajel_dispatch, the threads using the callbacks (or zajel_poll) shall
+ *                  call it from their own loop. A thread only sends its timers while it runs one of
+ *                  these, not while it is parked on its mailbox.
+ *
+ *  Returns     : uint32_t, number of messages sent.
+ **************************************************************************************************/
+uint32_t zajel_advance_timers(zajel_s*  zajel_ptr,
+                              uint32_t  threadID COMMA()
+                              FILE_AND_LINE_FOR_TYPE());
+
 #endif /* ZAJEL_H_ */
@@ -0,0 +1,324 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * Components running as actors (see zajel_regsiter_actor).
+ *
+ * An actor owns an inbound mailbox, and is runnable while the mailbox holds messages. A runnable
+ * actor sits in a single run queue at a time: whoever makes it runnable raises its isScheduled flag,
+ * and only the one that actually flipped the flag queues it, so at most one thread ever runs a given
+ * actor. The running thread drains a batch of messages, lowers the flag, then queues the actor again
+ * if messages arrived meanwhile.
+ *
+ * Every thread owns a run queue, fed by the senders and drained by the owner, while the other
+ * threads of the same core steal from it once their own queue is empty. The queues are intrusive
+ * lists guarded by a spin lock, which is only held for a few instructions.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_ACTOR_H_
+#define ZAJEL_ACTOR_H_
+
+#include <stdint.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+#include "zajel_mailbox.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_actor_s
+ *
+ * Structure Description:
+ * Holds a single actor, the mailbox keeps its own cache lines, and the scheduling fields share the
+ * last one.
+ **************************************************************************************************/
+typedef struct zajel_actor
+{
+    /*The inbound messages of the component*/
+    zajel_mailbox_s             mailbox;
+    /*TRUE while the actor is queued or running, exchanged by the senders and the running thread*/
+    uint32_t                    isScheduled             ZAJEL_CACHE_ALIGNED;
+    /*The component run by this actor*/
+    uint32_t                    componentID;
+    /*The run queue of the home thread of the actor, and the mailbox of that thread (NULL if none)*/
+    struct zajel_actor_queue*   homeQueue_ptr;
+    zajel_mailbox_s*            homeMailbox_ptr;
+    /*Next actor in the same run queue*/
+    struct zajel_actor*         next_ptr;
+    /*The memory block holding the actor, as returned by the allocation function*/
+    void*                       memory_ptr;
+} zajel_actor_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_actor_queue_s
+ *
+ * Structure Description:
+ * The runnable actors of a single thread, in the order they became runnable.
+ **************************************************************************************************/
+typedef struct zajel_actor_queue
+{
+    /*Spin lock guarding the list*/
+    uint32_t                lock                        ZAJEL_CACHE_ALIGNED;
+    zajel_actor_s*          head_ptr;
+    zajel_actor_s*          tail_ptr;
+} zajel_actor_queue_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_init
+ *
+ *  Arguments   : zajel_actor_s*        actor_ptr,
+ *                uint32_t              componentID,
+ *                zajel_actor_queue_s*  homeQueue_ptr,
+ *                zajel_mailbox_s*      homeMailbox_ptr,
+ *                void*                 memory_ptr
+ *
+ *  Description : Initializes an idle actor, with an empty mailbox.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_actor_init(zajel_actor_s*          actor_ptr,
+                                    uint32_t                componentID,
+                                    zajel_actor_queue_s*    homeQueue_ptr,
+                                    zajel_mailbox_s*        homeMailbox_ptr,
+                                    void*                   memory_ptr)
+{
+    zajel_mailbox_init(&actor_ptr->mailbox);
+
+    actor_ptr->isScheduled      = FALSE;
+    actor_ptr->componentID      = componentID;
+    actor_ptr->homeQueue_ptr    = homeQueue_ptr;
+    actor_ptr->homeMailbox_ptr  = homeMailbox_ptr;
+    actor_ptr->next_ptr         = NULL;
+    actor_ptr->memory_ptr       = memory_ptr;
+} /*function: zajel_actor_init*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_post
+ *
+ *  Arguments   : zajel_actor_s*                        actor_ptr,
+ *                zajel_linked_message_descriptor_s*    message_ptr
+ *
+ *  Description : Appends the given message to the actor mailbox, it can be called by any thread.
+ *
+ *  Returns     : bool_t, TRUE if the actor just became runnable, the caller shall then queue it.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_actor_post(zajel_actor_s*                        actor_ptr,
+                                      zajel_linked_message_descriptor_s*    message_ptr)
+{
+    zajel_mailbox_push(&actor_ptr->mailbox,
+                       message_ptr);
+
+    /*The message is published before the flag is checked, see zajel_actor_release*/
+    return (FALSE == ZAJEL_ATOMIC_EXCHANGE(&actor_ptr->isScheduled, TRUE));
+} /*function: zajel_actor_post*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_release
+ *
+ *  Arguments   : zajel_actor_s* actor_ptr
+ *
+ *  Description : Called by the thread running the actor once it is done with it.
+ *
+ *  Returns     : bool_t, TRUE if messages arrived meanwhile, the caller shall then queue it again.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_actor_release(zajel_actor_s* actor_ptr)
+{
+    /*Last message pushed, read while the mailbox is still owned by the calling thread*/
+    zajel_linked_message_descriptor_s*  head_ptr;
+    bool_t                              isEmpty;
+
+    /*The check of zajel_mailbox_wait, it reports a message still being pushed as well*/
+    head_ptr    = ZAJEL_ATOMIC_LOAD(&actor_ptr->mailbox.head_ptr);
+    isEmpty     = ((&actor_ptr->mailbox.stub == actor_ptr->mailbox.tail_ptr) &&
+                   (&actor_ptr->mailbox.stub == head_ptr));
+
+    ZAJEL_ATOMIC_STORE(&actor_ptr->isScheduled, FALSE);
+
+    /*
+     * Once the flag is lowered another thread may own the mailbox, so only the head is checked
+     * again. The senders push (moving the head away) before checking the flag, so a message is
+     * either seen here or by its sender. As only the owner pushes the stub, the head cannot come
+     * back to the value read above.
+     */
+    if((TRUE == isEmpty) &&
+       (head_ptr == ZAJEL_ATOMIC_LOAD(&actor_ptr->mailbox.head_ptr)))
+    {
+        return FALSE;
+    } /*if: <Mailbox is empty>*/
+
+    return (FALSE == ZAJEL_ATOMIC_EXCHANGE(&actor_ptr->isScheduled, TRUE));
+} /*function: zajel_actor_release*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_queue_init
+ *
+ *  Arguments   : zajel_actor_queue_s* queue_ptr
+ *
+ *  Description : Initializes an empty run queue.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_actor_queue_init(zajel_actor_queue_s* queue_ptr)
+{
+    queue_ptr->lock     = 0;
+    queue_ptr->head_ptr = NULL;
+    queue_ptr->tail_ptr = NULL;
+} /*function: zajel_actor_queue_init*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_queue_lock
+ *
+ *  Arguments   : zajel_actor_queue_s* queue_ptr
+ *
+ *  Description : Acquires the lock of the given run queue, spinning until it is free.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_actor_queue_lock(zajel_actor_queue_s* queue_ptr)
+{
+    /*Expected lock value*/
+    uint32_t unlocked;
+
+    unlocked = 0;
+
+    while(FALSE == ZAJEL_ATOMIC_CAS(&queue_ptr->lock,
+                                    &unlocked,
+                                    1))
+    {
+        unlocked = 0;
+        ZAJEL_CPU_RELAX();
+    } /*while: <Lock is held by another thread>*/
+} /*function: zajel_actor_queue_lock*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_queue_push
+ *
+ *  Arguments   : zajel_actor_queue_s*  queue_ptr,
+ *                zajel_actor_s*        actor_ptr
+ *
+ *  Description : Appends the given runnable actor to the run queue, it can be called by any thread.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_actor_queue_push(zajel_actor_queue_s*  queue_ptr,
+                                          zajel_actor_s*        actor_ptr)
+{
+    actor_ptr->next_ptr = NULL;
+
+    zajel_actor_queue_lock(queue_ptr);
+
+    if(NULL == queue_ptr->tail_ptr)
+    {
+        ZAJEL_ATOMIC_STORE_RELAXED(&queue_ptr->head_ptr, actor_ptr);
+    } /*if: <Queue is empty>*/
+    else
+    {
+        queue_ptr->tail_ptr->next_ptr = actor_ptr;
+    } /*else: <Queue is not empty>*/
+
+    queue_ptr->tail_ptr = actor_ptr;
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&queue_ptr->lock, 0);
+} /*function: zajel_actor_queue_push*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_queue_pop
+ *
+ *  Arguments   : zajel_actor_queue_s* queue_ptr
+ *
+ *  Description : Removes the oldest runnable actor from the run queue, it can be called by any
+ *                  thread. An empty queue is detected without taking the lock.
+ *
+ *  Returns     : zajel_actor_s*, NULL if the queue is empty.
+ **************************************************************************************************/
+STATIC INLINE zajel_actor_s* zajel_actor_queue_pop(zajel_actor_queue_s* queue_ptr)
+{
+    zajel_actor_s* actor_ptr;
+
+    if(NULL == ZAJEL_ATOMIC_LOAD_RELAXED(&queue_ptr->head_ptr))
+    {
+        return NULL;
+    } /*if: <Queue looks empty>*/
+
+    zajel_actor_queue_lock(queue_ptr);
+
+    actor_ptr = queue_ptr->head_ptr;
+
+    if(NULL != actor_ptr)
+    {
+        ZAJEL_ATOMIC_STORE_RELAXED(&queue_ptr->head_ptr, actor_ptr->next_ptr);
+
+        if(NULL == actor_ptr->next_ptr)
+        {
+            queue_ptr->tail_ptr = NULL;
+        } /*if: <Queue is now empty>*/
+    } /*if: <Queue is really not empty>*/
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&queue_ptr->lock, 0);
+
+    return actor_ptr;
+} /*function: zajel_actor_queue_pop*/
+
+/***************************************************************************************************
+ *  Name        : zajel_actor_schedule
+ *
+ *  Arguments   : zajel_actor_s* actor_ptr
+ *
+ *  Description : Queues the given runnable actor on its home thread, waking that thread if it is
+ *                  parked on its mailbox. Only called by the one that raised the isScheduled flag.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_actor_schedule(zajel_actor_s* actor_ptr)
+{
+    zajel_actor_queue_push(actor_ptr->homeQueue_ptr,
+                           actor_ptr);
+
+    if(NULL != actor_ptr->homeMailbox_ptr)
+    {
+        zajel_mailbox_wake(actor_ptr->homeMailbox_ptr);
+    } /*if: <Home thread may be parked on its mailbox>*/
+} /*function: zajel_actor_schedule*/
+
+#endif /* ZAJEL_ACTOR_H_ */
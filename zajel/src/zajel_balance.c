@@ -0,0 +1,306 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <string.h>
+#include "zajel_balance.h"
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_balance_is_target
+ *
+ *  Arguments   : const zajel_balance_view_s*   view_ptr,
+ *                uint32_t                      fromThreadID,
+ *                uint32_t                      toThreadID
+ *
+ *  Description : Tells whether the components of the first thread may be moved to the second one.
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_balance_is_target(const zajel_balance_view_s*    view_ptr,
+                                             uint32_t                       fromThreadID,
+                                             uint32_t                       toThreadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_balance_gather_affinity
+ *
+ *  Arguments   : const zajel_balance_view_s*   view_ptr,
+ *                uint32_t                      componentID,
+ *                uint64_t*                     threadAffinityArray,
+ *                uint64_t*                     coreAffinityArray
+ *
+ *  Description : Sums, per thread and per core, the messages exchanged between the given component
+ *                  and its peers (in both directions), the arrays shall be zeroed beforehand.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_balance_gather_affinity(const zajel_balance_view_s*   view_ptr,
+                                          uint32_t                      componentID,
+                                          uint64_t*                     threadAffinityArray,
+                                          uint64_t*                     coreAffinityArray);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+uint32_t zajel_balance_policy_default(void*                         context_ptr,
+                                      const zajel_balance_view_s*   view_ptr,
+                                      zajel_balance_move_s*         move_array,
+                                      uint32_t                      maxMoveCount)
+{
+    const zajel_balance_config_s*   config_ptr;
+    const zajel_component_load_s*   load_ptr;
+    zajel_balance_config_s          defaultConfig;
+    /*Messages exchanged by the candidate component with the components of each thread and core*/
+    uint64_t                        threadAffinityArray[ZAJEL_MAX_THREAD_COUNT];
+    uint64_t                        coreAffinityArray[ZAJEL_MAX_CORE_COUNT];
+    uint32_t                        busiestThreadID;
+    uint32_t                        idlestThreadID;
+    uint64_t                        busiestLoad;
+    uint64_t                        idlestLoad;
+    /*Affinity of the candidate component to the busiest thread, and to the considered thread*/
+    int64_t                         sourceAffinity;
+    int64_t                         affinity;
+    /*Highest load of the busiest and the considered threads once the candidate component moved*/
+    uint64_t                        peakLoad;
+    /*Best move found so far*/
+    bool_t                          isMoveFound;
+    int64_t                         bestAffinity;
+    uint64_t                        bestPeakLoad;
+    uint32_t                        componentID;
+    uint32_t                        threadID;
+    uint32_t                        coreID;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Finding the busiest and the idlest threads, and doing nothing unless they are far enough
+     *   apart.
+     * o Considering each component of the busiest thread that was not moved recently, and each
+     *   thread it could go to without becoming the busiest.
+     * o Picking the move keeping the most traffic in the same thread/core, then the one evening the
+     *   load out the best, then the one going to the idlest thread.
+     */
+    if(NULL == context_ptr)
+    {
+        defaultConfig.imbalancePercent  = ZAJEL_BALANCE_DEFAULT_IMBALANCE_PERCENT;
+        defaultConfig.cooldownRounds    = ZAJEL_BALANCE_DEFAULT_COOLDOWN_ROUNDS;
+        config_ptr                      = &defaultConfig;
+    } /*if: <Use the default tuning>*/
+    else
+    {
+        config_ptr = (const zajel_balance_config_s*) context_ptr;
+    } /*else: <Use the caller's tuning>*/
+
+    if(0 == maxMoveCount)
+    {
+        return 0;
+    } /*if: <No move allowed>*/
+
+    busiestThreadID = 0;
+
+    for(threadID = 1; threadID < view_ptr->threadCount; ++threadID)
+    {
+        if(view_ptr->threadLoadArray[threadID] > view_ptr->threadLoadArray[busiestThreadID])
+        {
+            busiestThreadID = threadID;
+        } /*if: <Thread is busier>*/
+    } /*for: <Find the busiest thread>*/
+
+    busiestLoad     = view_ptr->threadLoadArray[busiestThreadID];
+    idlestThreadID  = view_ptr->threadCount;
+    idlestLoad      = 0;
+
+    for(threadID = 0; threadID < view_ptr->threadCount; ++threadID)
+    {
+        if((TRUE == zajel_balance_is_target(view_ptr,
+                                            busiestThreadID,
+                                            threadID)) &&
+           ((idlestThreadID == view_ptr->threadCount) ||
+            (view_ptr->threadLoadArray[threadID] < idlestLoad)))
+        {
+            idlestThreadID  = threadID;
+            idlestLoad      = view_ptr->threadLoadArray[threadID];
+        } /*if: <Thread is a less loaded target>*/
+    } /*for: <Find the idlest thread the busiest one may hand components to>*/
+
+    if((idlestThreadID == view_ptr->threadCount) ||
+       ((busiestLoad * 100) <= (idlestLoad * (100 + config_ptr->imbalancePercent))))
+    {
+        return 0;
+    } /*if: <Load is balanced enough (or there is nowhere to go)>*/
+
+    isMoveFound     = FALSE;
+    bestAffinity    = 0;
+    bestPeakLoad    = 0;
+
+    for(componentID = 0; componentID < view_ptr->componentCount; ++componentID)
+    {
+        /*<Consider each component of the busiest thread>*/
+        load_ptr = &view_ptr->componentLoadArray[componentID];
+
+        if((load_ptr->threadID != busiestThreadID) ||
+           (0 == load_ptr->handlerTime) ||
+           (load_ptr->idleRounds < config_ptr->cooldownRounds))
+        {
+            continue;
+        } /*if: <Component is elsewhere, idle, or was moved recently>*/
+
+        memset(threadAffinityArray,
+               0,
+               sizeof(uint64_t) * view_ptr->threadCount);
+        memset(coreAffinityArray,
+               0,
+               sizeof(coreAffinityArray));
+
+        zajel_balance_gather_affinity(view_ptr,
+                                      componentID,
+                                      threadAffinityArray,
+                                      coreAffinityArray);
+
+        /*A peer in the same thread counts twice, as it is in the same core as well*/
+        sourceAffinity = (int64_t)(threadAffinityArray[busiestThreadID] +
+                                   coreAffinityArray[view_ptr->threadCoreArray[busiestThreadID]]);
+
+        for(threadID = 0; threadID < view_ptr->threadCount; ++threadID)
+        {
+            /*<Consider each thread the component may go to>*/
+            if((FALSE == zajel_balance_is_target(view_ptr,
+                                                 busiestThreadID,
+                                                 threadID)) ||
+               ((view_ptr->threadLoadArray[threadID] + load_ptr->handlerTime) >= busiestLoad))
+            {
+                continue;
+            } /*if: <Thread would become the busiest one>*/
+
+            coreID      = view_ptr->threadCoreArray[threadID];
+            affinity    = (int64_t)(threadAffinityArray[threadID] + coreAffinityArray[coreID]) - sourceAffinity;
+            peakLoad    = view_ptr->threadLoadArray[threadID] + load_ptr->handlerTime;
+
+            if(peakLoad < (busiestLoad - load_ptr->handlerTime))
+            {
+                peakLoad = busiestLoad - load_ptr->handlerTime;
+            } /*if: <Busiest thread stays the most loaded of the two>*/
+
+            if((FALSE == isMoveFound) ||
+               (affinity > bestAffinity) ||
+               ((affinity == bestAffinity) && (peakLoad < bestPeakLoad)) ||
+               ((affinity == bestAffinity) && (peakLoad == bestPeakLoad) &&
+                (view_ptr->threadLoadArray[threadID] < view_ptr->threadLoadArray[move_array[0].threadID])))
+            {
+                isMoveFound                 = TRUE;
+                bestAffinity                = affinity;
+                bestPeakLoad                = peakLoad;
+                move_array[0].componentID   = componentID;
+                move_array[0].threadID      = threadID;
+            } /*if: <Move is the best so far>*/
+        } /*for: <Consider each thread the component may go to>*/
+    } /*for: <Consider each component of the busiest thread>*/
+
+    return (TRUE == isMoveFound) ? (1) : (0);
+} /*function: zajel_balance_policy_default*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC INLINE bool_t zajel_balance_is_target(const zajel_balance_view_s*    view_ptr,
+                                             uint32_t                       fromThreadID,
+                                             uint32_t                       toThreadID)
+{
+    return ((toThreadID != fromThreadID) &&
+            ((FALSE == view_ptr->isCoreBound) ||
+             (view_ptr->threadCoreArray[toThreadID] == view_ptr->threadCoreArray[fromThreadID])));
+} /*function: zajel_balance_is_target*/
+
+STATIC void zajel_balance_gather_affinity(const zajel_balance_view_s*   view_ptr,
+                                          uint32_t                      componentID,
+                                          uint64_t*                     threadAffinityArray,
+                                          uint64_t*                     coreAffinityArray)
+{
+    const zajel_component_load_s*   load_ptr;
+    const zajel_balance_peer_s*     peer_ptr;
+    uint32_t                        peerComponentID;
+    uint32_t                        threadID;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        j;
+
+    for(i = 0; i < view_ptr->componentCount; ++i)
+    {
+        /*<Go through the sketches of all the components>*/
+        load_ptr = &view_ptr->componentLoadArray[i];
+
+        for(j = 0; j < ZAJEL_BALANCE_PEER_COUNT; ++j)
+        {
+            peer_ptr        = &load_ptr->peerArray[j];
+            peerComponentID = peer_ptr->componentID;
+
+            if((0 == peer_ptr->messageCount) ||
+               (peerComponentID >= view_ptr->componentCount))
+            {
+                continue;
+            } /*if: <Entry is unused>*/
+
+            if(i == componentID)
+            {
+                /*<The peer sends to the component, it counts where the peer runs>*/
+                threadID = view_ptr->componentLoadArray[peerComponentID].threadID;
+            } /*if: <The peer sends to the component, it counts where the peer runs>*/
+            else if(peerComponentID == componentID)
+            {
+                /*<The component sends to this one, it counts where this one runs>*/
+                threadID = load_ptr->threadID;
+            } /*else if: <The component sends to this one, it counts where this one runs>*/
+            else
+            {
+                continue;
+            } /*else: <Traffic between two other components>*/
+
+            threadAffinityArray[threadID]                           += peer_ptr->messageCount;
+            coreAffinityArray[view_ptr->threadCoreArray[threadID]]  += peer_ptr->messageCount;
+        } /*for: <Each tracked source>*/
+    } /*for: <Go through the sketches of all the components>*/
+} /*function: zajel_balance_gather_affinity*/
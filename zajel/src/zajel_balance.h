@@ -0,0 +1,158 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * Per-component traffic counters feeding the load balancer (see zajel_enable_load_balancer).
+ *
+ * Each component owns a cache line of counters, only written by the thread running the component,
+ * so counting a message needs no read-modify-write atomic, and the thread running zajel_balance
+ * reads them as they go. The sources of the handled messages are tracked with a space-saving sketch
+ * of ZAJEL_BALANCE_PEER_COUNT entries: a source missing from the sketch replaces the least counted
+ * entry and inherits its count, so the heavy senders are kept while the counts stay approximate.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_BALANCE_H_
+#define ZAJEL_BALANCE_H_
+
+#include <stdint.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_balance_counters_s
+ *
+ * Structure Description:
+ * The counters of a single component, they fill their own cache line.
+ **************************************************************************************************/
+typedef struct zajel_balance_counters
+{
+    /*Messages handled, only written by the thread running the component*/
+    uint64_t                messageCount                ZAJEL_CACHE_ALIGNED;
+    /*Time spent in the handlers in nanoseconds, estimated from the sampled messages*/
+    uint64_t                handlerTime;
+    /*The most frequent sources of the handled messages*/
+    zajel_balance_peer_s    peerArray[ZAJEL_BALANCE_PEER_COUNT];
+    /*The above counters as seen by the previous balancing round, only used by zajel_balance*/
+    uint64_t                balancedMessageCount;
+    uint64_t                balancedHandlerTime;
+} zajel_balance_counters_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_balance_is_sampled
+ *
+ *  Arguments   : zajel_balance_counters_s* counters_ptr
+ *
+ *  Description : Tells whether the handling of the next message of the component shall be timed.
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_balance_is_sampled(zajel_balance_counters_s* counters_ptr)
+{
+    return (0 == (counters_ptr->messageCount & (ZAJEL_BALANCE_SAMPLE_PERIOD - 1)));
+} /*function: zajel_balance_is_sampled*/
+
+/***************************************************************************************************
+ *  Name        : zajel_balance_count
+ *
+ *  Arguments   : zajel_balance_counters_s* counters_ptr,
+ *                uint32_t                  componentID,
+ *                uint32_t                  sourceComponentID,
+ *                uint64_t                  handlerTime
+ *
+ *  Description : Counts a message handled by the given component, sent by sourceComponentID, must
+ *                  only be called by the thread running the component. handlerTime is the measured
+ *                  time of a sampled message, and zero otherwise.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_balance_count(zajel_balance_counters_s*    counters_ptr,
+                                       uint32_t                     componentID,
+                                       uint32_t                     sourceComponentID,
+                                       uint64_t                     handlerTime)
+{
+    zajel_balance_peer_s*   peer_ptr;
+    /*The least counted entry of the sketch*/
+    zajel_balance_peer_s*   least_ptr;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    ZAJEL_COUNTER_INCREMENT(counters_ptr->messageCount);
+
+    if(handlerTime)
+    {
+        ZAJEL_ATOMIC_STORE_RELAXED(&counters_ptr->handlerTime,
+                                   counters_ptr->handlerTime + (handlerTime * ZAJEL_BALANCE_SAMPLE_PERIOD));
+    } /*if: <Message was sampled>*/
+
+    if(sourceComponentID == componentID)
+    {
+        return;
+    } /*if: <Messages sent to itself tell nothing about the placement>*/
+
+    least_ptr = &counters_ptr->peerArray[0];
+
+    for(i = 0; i < ZAJEL_BALANCE_PEER_COUNT; ++i)
+    {
+        /*<Look the source up>*/
+        peer_ptr = &counters_ptr->peerArray[i];
+
+        if((peer_ptr->componentID == sourceComponentID) &&
+           (0 != peer_ptr->messageCount))
+        {
+            ZAJEL_COUNTER_INCREMENT(peer_ptr->messageCount);
+            return;
+        } /*if: <Source is already tracked>*/
+
+        if(peer_ptr->messageCount < least_ptr->messageCount)
+        {
+            least_ptr = peer_ptr;
+        } /*if: <Entry is less counted>*/
+    } /*for: <Look the source up>*/
+
+    ZAJEL_ATOMIC_STORE_RELAXED(&least_ptr->componentID, sourceComponentID);
+    ZAJEL_COUNTER_INCREMENT(least_ptr->messageCount);
+} /*function: zajel_balance_count*/
+
+#endif /* ZAJEL_BALANCE_H_ */
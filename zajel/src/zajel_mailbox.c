@@ -0,0 +1,204 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <stddef.h>
+#include "zajel_mailbox.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*The consumer is running, producers do not need to wake it*/
+#define ZAJEL_MAILBOX_CONSUMER_RUNNING          (0)
+/*The consumer is parked (or about to park) on the consumerState word*/
+#define ZAJEL_MAILBOX_CONSUMER_PARKED           (1)
+/*The consumer was woken by zajel_mailbox_wake, its next wait returns immediately*/
+#define ZAJEL_MAILBOX_CONSUMER_NOTIFIED         (2)
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+void zajel_mailbox_init(zajel_mailbox_s* mailbox_ptr)
+{
+    mailbox_ptr->stub.next_ptr          = NULL;
+    mailbox_ptr->head_ptr               = &mailbox_ptr->stub;
+    mailbox_ptr->tail_ptr               = &mailbox_ptr->stub;
+    mailbox_ptr->consumerState          = ZAJEL_MAILBOX_CONSUMER_RUNNING;
+
+    zajel_sync_slot_init(&mailbox_ptr->synchronizationSlot);
+} /*function: zajel_mailbox_init*/
+
+void zajel_mailbox_push(zajel_mailbox_s*                    mailbox_ptr,
+                        zajel_linked_message_descriptor_s*  message_ptr)
+{
+    zajel_mailbox_push_chain(mailbox_ptr,
+                             message_ptr,
+                             message_ptr);
+} /*function: zajel_mailbox_push*/
+
+void zajel_mailbox_push_chain(zajel_mailbox_s*                      mailbox_ptr,
+                              zajel_linked_message_descriptor_s*    first_ptr,
+                              zajel_linked_message_descriptor_s*    last_ptr)
+{
+    zajel_linked_message_descriptor_s* previous_ptr;
+
+    ZAJEL_ATOMIC_STORE_RELAXED(&last_ptr->next_ptr, NULL);
+
+    /*
+     * The exchange is the linearization point of the push, the chain is only completed afterwards,
+     * the consumer treats a missing link as "not yet ready" rather than as "empty".
+     */
+    previous_ptr = ZAJEL_ATOMIC_EXCHANGE(&mailbox_ptr->head_ptr, last_ptr);
+    ZAJEL_ATOMIC_STORE_RELEASE(&previous_ptr->next_ptr, first_ptr);
+
+    if(ZAJEL_UNLIKELY(ZAJEL_MAILBOX_CONSUMER_PARKED == ZAJEL_ATOMIC_LOAD(&mailbox_ptr->consumerState)))
+    {
+        /*<Consumer is parked, only the producer that flips the state pays for the system call>*/
+        if(ZAJEL_MAILBOX_CONSUMER_PARKED == ZAJEL_ATOMIC_EXCHANGE(&mailbox_ptr->consumerState,
+                                                                  ZAJEL_MAILBOX_CONSUMER_RUNNING))
+        {
+            zajel_futex_wake(&mailbox_ptr->consumerState,
+                             1);
+        } /*if: <This producer woke the consumer up>*/
+    } /*if: <Consumer is parked, only the producer that flips the state pays for the system call>*/
+} /*function: zajel_mailbox_push_chain*/
+
+zajel_linked_message_descriptor_s* zajel_mailbox_pop(zajel_mailbox_s* mailbox_ptr)
+{
+    zajel_linked_message_descriptor_s* tail_ptr;
+    zajel_linked_message_descriptor_s* next_ptr;
+
+    tail_ptr = mailbox_ptr->tail_ptr;
+    next_ptr = ZAJEL_ATOMIC_LOAD_ACQUIRE(&tail_ptr->next_ptr);
+
+    if(&mailbox_ptr->stub == tail_ptr)
+    {
+        /*<Skip the stub>*/
+        if(NULL == next_ptr)
+        {
+            return NULL;
+        } /*if: <Mailbox is empty>*/
+
+        mailbox_ptr->tail_ptr   = next_ptr;
+        tail_ptr                = next_ptr;
+        next_ptr                = ZAJEL_ATOMIC_LOAD_ACQUIRE(&tail_ptr->next_ptr);
+    } /*if: <Skip the stub>*/
+
+    if(NULL != next_ptr)
+    {
+        /*<The tail is followed by another message, it can be safely handed over>*/
+        mailbox_ptr->tail_ptr = next_ptr;
+        return tail_ptr;
+    } /*if: <The tail is followed by another message, it can be safely handed over>*/
+
+    if(tail_ptr != ZAJEL_ATOMIC_LOAD(&mailbox_ptr->head_ptr))
+    {
+        /*<A producer is in the middle of a push, the message will be ready shortly>*/
+        return NULL;
+    } /*if: <A producer is in the middle of a push, the message will be ready shortly>*/
+
+    /*The tail is the last message, re-insert the stub behind it so that it can be detached*/
+    zajel_mailbox_push(mailbox_ptr,
+                       &mailbox_ptr->stub);
+
+    next_ptr = ZAJEL_ATOMIC_LOAD_ACQUIRE(&tail_ptr->next_ptr);
+
+    if(NULL != next_ptr)
+    {
+        mailbox_ptr->tail_ptr = next_ptr;
+        return tail_ptr;
+    } /*if: <The stub (or a newer message) is now linked>*/
+
+    return NULL;
+} /*function: zajel_mailbox_pop*/
+
+void zajel_mailbox_wait(zajel_mailbox_s* mailbox_ptr)
+{
+    if(ZAJEL_MAILBOX_CONSUMER_NOTIFIED == ZAJEL_ATOMIC_EXCHANGE(&mailbox_ptr->consumerState,
+                                                                ZAJEL_MAILBOX_CONSUMER_PARKED))
+    {
+        /*<Consumer was woken while running, it has something to do>*/
+        ZAJEL_ATOMIC_STORE(&mailbox_ptr->consumerState,
+                           ZAJEL_MAILBOX_CONSUMER_RUNNING);
+        return;
+    } /*if: <Consumer was woken while running, it has something to do>*/
+
+    /*
+     * The state is published before checking the mailbox, and the producers publish their message
+     * before checking the state, so at least one side always sees the other.
+     */
+    while(ZAJEL_MAILBOX_CONSUMER_PARKED == ZAJEL_ATOMIC_LOAD(&mailbox_ptr->consumerState))
+    {
+        /*<Sleep until a producer flips the state>*/
+        if((&mailbox_ptr->stub != mailbox_ptr->tail_ptr) ||
+           (&mailbox_ptr->stub != ZAJEL_ATOMIC_LOAD(&mailbox_ptr->head_ptr)))
+        {
+            /*<Mailbox is not empty, no need to sleep>*/
+            break;
+        } /*if: <Mailbox is not empty, no need to sleep>*/
+
+        zajel_futex_wait(&mailbox_ptr->consumerState,
+                         ZAJEL_MAILBOX_CONSUMER_PARKED);
+    } /*while: <Sleep until a producer flips the state>*/
+
+    ZAJEL_ATOMIC_STORE(&mailbox_ptr->consumerState,
+                       ZAJEL_MAILBOX_CONSUMER_RUNNING);
+} /*function: zajel_mailbox_wait*/
+
+void zajel_mailbox_wake(zajel_mailbox_s* mailbox_ptr)
+{
+    if(ZAJEL_MAILBOX_CONSUMER_PARKED == ZAJEL_ATOMIC_EXCHANGE(&mailbox_ptr->consumerState,
+                                                              ZAJEL_MAILBOX_CONSUMER_NOTIFIED))
+    {
+        zajel_futex_wake(&mailbox_ptr->consumerState,
+                         1);
+    } /*if: <Consumer is parked>*/
+} /*function: zajel_mailbox_wake*/
+
+void zajel_mailbox_block(void* mailbox_ptr)
+{
+    zajel_sync_slot_block(&((zajel_mailbox_s*) mailbox_ptr)->synchronizationSlot);
+} /*function: zajel_mailbox_block*/
+
+void zajel_mailbox_unblock(void* mailbox_ptr)
+{
+    zajel_sync_slot_unblock(&((zajel_mailbox_s*) mailbox_ptr)->synchronizationSlot);
+} /*function: zajel_mailbox_unblock*/
@@ -0,0 +1,192 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * An intrusive multi-producer/single-consumer mailbox, it can be used as the inbound queue of a
+ * thread instead of the per threads pair rings, its memory does not grow with the number of
+ * producers.
+ *
+ * Messages are chained through the link of zajel_linked_message_descriptor_s, so pushing never
+ * allocates. The consumer parks on a futex only when the mailbox is empty, and a producer issues the
+ * wake system call only when it finds the consumer parked.
+ *
+ * The same object also carries the slot used to block/unblock its thread on synchronous messages,
+ * through the ready-made zajel_mailbox_block/zajel_mailbox_unblock callbacks (which spin then park,
+ * see zajel_sync.h).
+ */
+#ifndef ZAJEL_MAILBOX_H_
+#define ZAJEL_MAILBOX_H_
+
+#include <stdint.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+#include "zajel_sync.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_mailbox_s
+ *
+ * Structure Description:
+ * Holds a single mailbox, the fields written by the producers, the consumer state and the consumer
+ * fields live on separate cache lines.
+ **************************************************************************************************/
+struct zajel_mailbox
+{
+    /*Last pushed message, exchanged by the producers*/
+    zajel_linked_message_descriptor_s*  head_ptr            ZAJEL_CACHE_ALIGNED;
+    /*Futex word telling whether the consumer is running or parked*/
+    uint32_t                            consumerState       ZAJEL_CACHE_ALIGNED;
+    /*Slot used by the ready-made block/unblock callbacks*/
+    zajel_sync_slot_s                   synchronizationSlot;
+    /*Next message to be popped, only used by the consumer*/
+    zajel_linked_message_descriptor_s*  tail_ptr            ZAJEL_CACHE_ALIGNED;
+    /*Placeholder keeping the chain non-empty, so that producers never touch the tail*/
+    zajel_linked_message_descriptor_s   stub;
+};
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_init
+ *
+ *  Arguments   : zajel_mailbox_s* mailbox_ptr
+ *
+ *  Description : This function initializes the given mailbox to an empty one.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_init(zajel_mailbox_s* mailbox_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_push
+ *
+ *  Arguments   : zajel_mailbox_s*                    mailbox_ptr,
+ *                zajel_linked_message_descriptor_s*  message_ptr
+ *
+ *  Description : This function appends the given message to the mailbox, it can be called by any
+ *                  number of threads concurrently, and wakes the consumer if it is parked.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_push(zajel_mailbox_s*                    mailbox_ptr,
+                        zajel_linked_message_descriptor_s*  message_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_push_chain
+ *
+ *  Arguments   : zajel_mailbox_s*                    mailbox_ptr,
+ *                zajel_linked_message_descriptor_s*  first_ptr,
+ *                zajel_linked_message_descriptor_s*  last_ptr
+ *
+ *  Description : This function appends a chain of messages, already linked from first_ptr to
+ *                  last_ptr through their next_ptr, using a single exchange and at most one wake.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_push_chain(zajel_mailbox_s*                      mailbox_ptr,
+                              zajel_linked_message_descriptor_s*    first_ptr,
+                              zajel_linked_message_descriptor_s*    last_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_pop
+ *
+ *  Arguments   : zajel_mailbox_s* mailbox_ptr
+ *
+ *  Description : This function removes the oldest message from the mailbox, it shall only be called
+ *                  by the consumer thread, and it never blocks.
+ *
+ *  Returns     : zajel_linked_message_descriptor_s*, NULL if no message is ready.
+ **************************************************************************************************/
+zajel_linked_message_descriptor_s* zajel_mailbox_pop(zajel_mailbox_s* mailbox_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_wait
+ *
+ *  Arguments   : zajel_mailbox_s* mailbox_ptr
+ *
+ *  Description : This function parks the consumer thread until a message is pushed (or
+ *                  zajel_mailbox_wake is called), it returns immediately if the mailbox is not empty
+ *                  or if the consumer was woken since its last wait. It shall only be called by the
+ *                  consumer.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_wait(zajel_mailbox_s* mailbox_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_wake
+ *
+ *  Arguments   : zajel_mailbox_s* mailbox_ptr
+ *
+ *  Description : This function wakes the consumer without pushing anything, used when the consumer
+ *                  has work to do elsewhere (a runnable actor for instance). If the consumer is not
+ *                  parked, its next zajel_mailbox_wait returns immediately.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_wake(zajel_mailbox_s* mailbox_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_block
+ *
+ *  Arguments   : void* mailbox_ptr
+ *
+ *  Description : A ready-made zajel_block_callback, spins then parks the calling thread until
+ *                  zajel_mailbox_unblock is called for the same mailbox (the mailbox is passed as the
+ *                  thread synchronization primitive).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_block(void* mailbox_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_mailbox_unblock
+ *
+ *  Arguments   : void* mailbox_ptr
+ *
+ *  Description : A ready-made zajel_unblock_callback, releases the thread blocked (or about to block)
+ *                  in zajel_mailbox_block on the same mailbox.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_mailbox_unblock(void* mailbox_ptr);
+
+#endif /* ZAJEL_MAILBOX_H_ */
@@ -0,0 +1,324 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif /*__linux__*/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "zajel_numa.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*The memory policy asking for a node without failing when it is full, and the flag moving the pages already touched*/
+#define ZAJEL_NUMA_MPOL_PREFERRED       (1)
+#define ZAJEL_NUMA_MPOL_MF_MOVE         (1 << 1)
+
+/*Number of pages queried by each system call*/
+#define ZAJEL_NUMA_QUERY_BATCH          (256)
+
+/*Bits of a word of a node mask*/
+#define ZAJEL_NUMA_MASK_WORD_BITS       (8 * sizeof(unsigned long))
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_path_exists
+ *
+ *  Arguments   : const char*   format_ptr,
+ *                uint32_t      first,
+ *                uint32_t      second
+ *
+ *  Description : Tells whether the sysfs entry named by the given format (taking up to two unsigned
+ *                  integers) exists.
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+STATIC bool_t zajel_numa_path_exists(const char*    format_ptr,
+                                     uint32_t       first,
+                                     uint32_t       second);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+uint32_t zajel_numa_node_count(void)
+{
+    uint32_t nodeCount;
+    /*Temporary counter*/
+    uint32_t i;
+
+    nodeCount = 1;
+
+    for(i = 0; i < ZAJEL_NUMA_MAX_NODE_COUNT; ++i)
+    {
+        /*<The nodes may be sparse, the count covers the biggest one>*/
+        if(zajel_numa_path_exists("/sys/devices/system/node/node%u",
+                                  i,
+                                  0))
+        {
+            nodeCount = i + 1;
+        } /*if: <Node is present>*/
+    } /*for: <The nodes may be sparse, the count covers the biggest one>*/
+
+    return nodeCount;
+} /*function: zajel_numa_node_count*/
+
+uint32_t zajel_numa_cpu_node(uint32_t cpu)
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    for(i = 0; i < ZAJEL_NUMA_MAX_NODE_COUNT; ++i)
+    {
+        /*<The CPU directory links to its node>*/
+        if(zajel_numa_path_exists("/sys/devices/system/cpu/cpu%u/node%u",
+                                  cpu,
+                                  i))
+        {
+            return i;
+        } /*if: <CPU belongs to this node>*/
+    } /*for: <The CPU directory links to its node>*/
+
+    return ZAJEL_NUMA_NODE_ANY;
+} /*function: zajel_numa_cpu_node*/
+
+void* zajel_numa_map(uintptr_t  size,
+                     bool_t     isHuge,
+                     bool_t     isHugeAdvised)
+{
+#ifdef __linux__
+    void*   address_ptr;
+    int     flags;
+
+    flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if(isHuge)
+    {
+#ifdef MAP_HUGETLB
+        flags |= MAP_HUGETLB;
+#else
+        return NULL;
+#endif /*MAP_HUGETLB*/
+    } /*if: <Explicit huge pages>*/
+
+    address_ptr = mmap(NULL,
+                       (size_t) size,
+                       PROT_READ | PROT_WRITE,
+                       flags,
+                       -1,
+                       0);
+
+    if(MAP_FAILED == address_ptr)
+    {
+        return NULL;
+    } /*if: <Memory cannot be mapped>*/
+
+#ifdef MADV_HUGEPAGE
+    if((!isHuge) && (isHugeAdvised))
+    {
+        /*Only a hint, the system may have the transparent huge pages disabled*/
+        (void) madvise(address_ptr,
+                       (size_t) size,
+                       MADV_HUGEPAGE);
+    } /*if: <Transparent huge pages wanted>*/
+#endif /*MADV_HUGEPAGE*/
+
+    return address_ptr;
+#else
+    (void) size;
+    (void) isHuge;
+    (void) isHugeAdvised;
+
+    return NULL;
+#endif /*__linux__*/
+} /*function: zajel_numa_map*/
+
+void zajel_numa_unmap(void*     address_ptr,
+                      uintptr_t size)
+{
+#ifdef __linux__
+    (void) munmap(address_ptr,
+                  (size_t) size);
+#else
+    (void) address_ptr;
+    (void) size;
+#endif /*__linux__*/
+} /*function: zajel_numa_unmap*/
+
+bool_t zajel_numa_bind(void*        address_ptr,
+                       uintptr_t    size,
+                       uint32_t     nodeID)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long maskArray[ZAJEL_NUMA_MAX_NODE_COUNT / ZAJEL_NUMA_MASK_WORD_BITS];
+
+    ASSERT((nodeID < ZAJEL_NUMA_MAX_NODE_COUNT),
+           "zajel: Invalid node!",
+           __FILE__,
+           __LINE__);
+
+    memset(maskArray,
+           0,
+           sizeof(maskArray));
+
+    maskArray[nodeID / ZAJEL_NUMA_MASK_WORD_BITS] = 1UL << (nodeID % ZAJEL_NUMA_MASK_WORD_BITS);
+
+    /*The kernel reads one bit less than the given maximum node*/
+    return (0 == syscall(SYS_mbind,
+                         address_ptr,
+                         (unsigned long) size,
+                         ZAJEL_NUMA_MPOL_PREFERRED,
+                         maskArray,
+                         (unsigned long) (ZAJEL_NUMA_MAX_NODE_COUNT + 1),
+                         ZAJEL_NUMA_MPOL_MF_MOVE)) ?
+           (TRUE) :
+           (FALSE);
+#else
+    (void) address_ptr;
+    (void) size;
+    (void) nodeID;
+
+    return FALSE;
+#endif /*__linux__ && SYS_mbind*/
+} /*function: zajel_numa_bind*/
+
+void zajel_numa_query(const void*   address_ptr,
+                      uintptr_t     size,
+                      uint64_t*     nodeBytes_array,
+                      uint64_t*     unresidentBytes_ptr)
+{
+#if defined(__linux__) && defined(SYS_move_pages)
+    void*       pageArray[ZAJEL_NUMA_QUERY_BATCH];
+    int         statusArray[ZAJEL_NUMA_QUERY_BATCH];
+    uintptr_t   pageCount;
+    uintptr_t   batchCount;
+    /*Temporary counters*/
+    uintptr_t   i;
+    uintptr_t   j;
+
+    pageCount = size / ZAJEL_NUMA_PAGE_SIZE;
+
+    for(i = 0; i < pageCount; i += batchCount)
+    {
+        /*<Query the pages batch by batch>*/
+        batchCount = ((pageCount - i) < ZAJEL_NUMA_QUERY_BATCH) ?
+                     (pageCount - i) :
+                     (ZAJEL_NUMA_QUERY_BATCH);
+
+        for(j = 0; j < batchCount; ++j)
+        {
+            pageArray[j] = (void*) ((uintptr_t) address_ptr + ((i + j) * ZAJEL_NUMA_PAGE_SIZE));
+        } /*for: <List the pages of the batch>*/
+
+        /*Without target nodes, the current node of each page is returned in its status*/
+        if(0 != syscall(SYS_move_pages,
+                        0,
+                        (unsigned long) batchCount,
+                        pageArray,
+                        NULL,
+                        statusArray,
+                        0))
+        {
+            *unresidentBytes_ptr += batchCount * ZAJEL_NUMA_PAGE_SIZE;
+            continue;
+        } /*if: <System cannot tell, the whole batch is unknown>*/
+
+        for(j = 0; j < batchCount; ++j)
+        {
+            if((statusArray[j] >= 0) &&
+               (statusArray[j] < ZAJEL_NUMA_MAX_NODE_COUNT))
+            {
+                nodeBytes_array[statusArray[j]] += ZAJEL_NUMA_PAGE_SIZE;
+            } /*if: <Page is resident on a node>*/
+            else
+            {
+                *unresidentBytes_ptr += ZAJEL_NUMA_PAGE_SIZE;
+            } /*else: <Page was not touched yet>*/
+        } /*for: <Count each page of the batch>*/
+    } /*for: <Query the pages batch by batch>*/
+#else
+    (void) address_ptr;
+    (void) nodeBytes_array;
+
+    *unresidentBytes_ptr += size;
+#endif /*__linux__ && SYS_move_pages*/
+} /*function: zajel_numa_query*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC bool_t zajel_numa_path_exists(const char*    format_ptr,
+                                     uint32_t       first,
+                                     uint32_t       second)
+{
+#ifdef __linux__
+    char path[96];
+
+    (void) snprintf(path,
+                    sizeof(path),
+                    format_ptr,
+                    first,
+                    second);
+
+    return (0 == access(path, F_OK)) ? (TRUE) : (FALSE);
+#else
+    (void) format_ptr;
+    (void) first;
+    (void) second;
+
+    return FALSE;
+#endif /*__linux__*/
+} /*function: zajel_numa_path_exists*/
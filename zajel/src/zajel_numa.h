@@ -0,0 +1,166 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * NUMA placement primitives (see zajel_enable_numa).
+ *
+ * The memory is mapped straight from the system, then each range is bound to a node before it is
+ * first touched, so its pages are allocated there. The binding is a preference: a node running out
+ * of memory falls back to the others instead of failing. The system calls are made directly, so no
+ * NUMA library is needed, and the functions degrade to a single node on the systems (or kernels)
+ * without NUMA support, the mapping functions failing on the platforms other than Linux.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_NUMA_H_
+#define ZAJEL_NUMA_H_
+
+#include <stdint.h>
+#include "zajel.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Granularity of the placement, and size of the huge pages used by ZAJEL_NUMA_FLAG_HUGE_PAGES*/
+#define ZAJEL_NUMA_PAGE_SIZE            (4096)
+#define ZAJEL_NUMA_HUGE_PAGE_SIZE       (2 * 1024 * 1024)
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_NUMA_ALIGN_UP
+ *
+ *  Arguments   : value, alignment
+ *
+ *  Description : This macro rounds the given value up to a multiple of the given power of two.
+ *
+ *  Returns     : uintptr_t.
+ **************************************************************************************************/
+#define ZAJEL_NUMA_ALIGN_UP(value, alignment)                                                      \
+    (((uintptr_t)(value) + ((uintptr_t)(alignment) - 1)) & ~((uintptr_t)(alignment) - 1))
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_node_count
+ *
+ *  Arguments   : void
+ *
+ *  Description : Gets the number of nodes of the system, as listed by sysfs (at most
+ *                  ZAJEL_NUMA_MAX_NODE_COUNT).
+ *
+ *  Returns     : uint32_t, 1 when the system is not NUMA.
+ **************************************************************************************************/
+uint32_t zajel_numa_node_count(void);
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_cpu_node
+ *
+ *  Arguments   : uint32_t  cpu
+ *
+ *  Description : Gets the node of the given CPU, as listed by sysfs.
+ *
+ *  Returns     : uint32_t, ZAJEL_NUMA_NODE_ANY when it is not known.
+ **************************************************************************************************/
+uint32_t zajel_numa_cpu_node(uint32_t cpu);
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_map
+ *
+ *  Arguments   : uintptr_t size,
+ *                bool_t    isHuge,
+ *                bool_t    isHugeAdvised
+ *
+ *  Description : Maps size bytes of zeroed anonymous memory, using huge pages when isHuge (size
+ *                  shall then be a multiple of ZAJEL_NUMA_HUGE_PAGE_SIZE). Otherwise the memory is
+ *                  made of regular pages, which the system is asked to merge into transparent huge
+ *                  pages when isHugeAdvised. No page is allocated until first touched.
+ *
+ *  Returns     : void*, NULL if the memory cannot be mapped (no huge page left for instance).
+ **************************************************************************************************/
+void* zajel_numa_map(uintptr_t  size,
+                     bool_t     isHuge,
+                     bool_t     isHugeAdvised);
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_unmap
+ *
+ *  Arguments   : void*     address_ptr,
+ *                uintptr_t size
+ *
+ *  Description : Unmaps memory mapped by zajel_numa_map.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_numa_unmap(void*     address_ptr,
+                      uintptr_t size);
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_bind
+ *
+ *  Arguments   : void*     address_ptr,
+ *                uintptr_t size,
+ *                uint32_t  nodeID
+ *
+ *  Description : Makes the given page aligned range of mapped memory prefer the given node, the pages
+ *                  already touched are moved there.
+ *
+ *  Returns     : bool_t, FALSE if the system does not support binding memory to a node.
+ **************************************************************************************************/
+bool_t zajel_numa_bind(void*        address_ptr,
+                       uintptr_t    size,
+                       uint32_t     nodeID);
+
+/***************************************************************************************************
+ *  Name        : zajel_numa_query
+ *
+ *  Arguments   : const void*   address_ptr,
+ *                uintptr_t     size,
+ *                uint64_t*     nodeBytes_array,
+ *                uint64_t*     unresidentBytes_ptr
+ *
+ *  Description : Adds the bytes of the given page aligned range of mapped memory resident on each
+ *                  node to nodeBytes_array (ZAJEL_NUMA_MAX_NODE_COUNT entries), and the ones not
+ *                  resident (or whose node is unknown) to unresidentBytes_ptr.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_numa_query(const void*   address_ptr,
+                      uintptr_t     size,
+                      uint64_t*     nodeBytes_array,
+                      uint64_t*     unresidentBytes_ptr);
+
+#endif /* ZAJEL_NUMA_H_ */
@@ -0,0 +1,232 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * This header is internal to the framework, it collects the compiler and processor specific
+ * primitives (atomics, cache line alignment, spinning hints) so that the rest of the code stays
+ * portable. It is not meant to be included directly by the framework users.
+ */
+#ifndef ZAJEL_PLATFORM_H_
+#define ZAJEL_PLATFORM_H_
+
+#include <stdint.h>
+#include <time.h>
+#include "zajel.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif /*__linux__*/
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Size of a single cache line, used to pad data shared between different threads*/
+#ifndef ZAJEL_CACHE_LINE_SIZE
+#define ZAJEL_CACHE_LINE_SIZE           (64)
+#endif
+
+/*Aligns the declared variable or member on a cache line boundary*/
+#define ZAJEL_CACHE_ALIGNED             __attribute__((aligned(ZAJEL_CACHE_LINE_SIZE)))
+
+/*Rounds the given size/address up to the next cache line boundary*/
+#define ZAJEL_CACHE_ALIGN_UP(value)                                                                \
+    (((value) + (ZAJEL_CACHE_LINE_SIZE - 1)) & ~((uintptr_t)(ZAJEL_CACHE_LINE_SIZE - 1)))
+
+/*Branch prediction hints*/
+#define ZAJEL_LIKELY(condition)         __builtin_expect(!!(condition), 1)
+#define ZAJEL_UNLIKELY(condition)       __builtin_expect(!!(condition), 0)
+
+/*Brings the cache line holding the given address ahead of its use, for reading*/
+#define ZAJEL_PREFETCH(address)         __builtin_prefetch((address), 0, 3)
+
+/*Atomic accessors, thin wrappers around the GCC builtins*/
+#define ZAJEL_ATOMIC_LOAD_RELAXED(ptr)          __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define ZAJEL_ATOMIC_LOAD_ACQUIRE(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define ZAJEL_ATOMIC_STORE_RELAXED(ptr, value)  __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+#define ZAJEL_ATOMIC_STORE_RELEASE(ptr, value)  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define ZAJEL_ATOMIC_LOAD(ptr)                  __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+#define ZAJEL_ATOMIC_STORE(ptr, value)          __atomic_store_n((ptr), (value), __ATOMIC_SEQ_CST)
+#define ZAJEL_ATOMIC_EXCHANGE(ptr, value)       __atomic_exchange_n((ptr), (value), __ATOMIC_SEQ_CST)
+#define ZAJEL_ATOMIC_FETCH_ADD(ptr, value)      __atomic_fetch_add((ptr), (value), __ATOMIC_SEQ_CST)
+#define ZAJEL_ATOMIC_FETCH_SUB(ptr, value)      __atomic_fetch_sub((ptr), (value), __ATOMIC_SEQ_CST)
+#define ZAJEL_ATOMIC_CAS(ptr, expected_ptr, value)                                                 \
+    __atomic_compare_exchange_n((ptr), (expected_ptr), (value), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define ZAJEL_ATOMIC_FENCE()                    __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_COUNTER_INCREMENT
+ *
+ *  Arguments   : counter
+ *
+ *  Description : This macro increments a counter written by a single thread and read by any thread,
+ *                  no read-modify-write atomic is needed as long as there is a single writer.
+ *
+ *  Returns     : None.
+ **************************************************************************************************/
+#define ZAJEL_COUNTER_INCREMENT(counter)                                                           \
+    ZAJEL_ATOMIC_STORE_RELAXED(&(counter), ZAJEL_ATOMIC_LOAD_RELAXED(&(counter)) + 1)
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_CPU_RELAX
+ *
+ *  Arguments   : None.
+ *
+ *  Description : This macro hints the processor that the caller is busy-waiting, so that it can
+ *                  release the pipeline resources to the sibling hardware thread.
+ *
+ *  Returns     : None.
+ **************************************************************************************************/
+#if defined(__i386__) || defined(__x86_64__)
+#define ZAJEL_CPU_RELAX()               __asm__ __volatile__("pause" ::: "memory")
+#elif defined(__aarch64__) || defined(__arm__)
+#define ZAJEL_CPU_RELAX()               __asm__ __volatile__("yield" ::: "memory")
+#else
+#define ZAJEL_CPU_RELAX()               __asm__ __volatile__("" ::: "memory")
+#endif
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_futex_wait
+ *
+ *  Arguments   : uint32_t* address_ptr,
+ *                uint32_t  expectedValue
+ *
+ *  Description : Puts the calling thread to sleep as long as the given word holds the expected
+ *                  value. It may return spuriously, so the caller shall always re-check its condition.
+ *                  On platforms without futex support it degrades to a spinning hint.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_futex_wait(uint32_t*   address_ptr,
+                                    uint32_t    expectedValue)
+{
+#ifdef __linux__
+    syscall(SYS_futex,
+            address_ptr,
+            FUTEX_WAIT_PRIVATE,
+            expectedValue,
+            NULL,
+            NULL,
+            0);
+#else
+    (void)address_ptr;
+    (void)expectedValue;
+    ZAJEL_CPU_RELAX();
+#endif /*__linux__*/
+} /*function: zajel_futex_wait*/
+
+/***************************************************************************************************
+ *  Name        : zajel_futex_wake
+ *
+ *  Arguments   : uint32_t* address_ptr,
+ *                uint32_t  waitersCount
+ *
+ *  Description : Wakes up to waitersCount threads sleeping on the given word.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_futex_wake(uint32_t*   address_ptr,
+                                    uint32_t    waitersCount)
+{
+#ifdef __linux__
+    syscall(SYS_futex,
+            address_ptr,
+            FUTEX_WAKE_PRIVATE,
+            waitersCount,
+            NULL,
+            NULL,
+            0);
+#else
+    (void)address_ptr;
+    (void)waitersCount;
+#endif /*__linux__*/
+} /*function: zajel_futex_wake*/
+
+/***************************************************************************************************
+ *  Name        : zajel_time_now
+ *
+ *  Arguments   : None.
+ *
+ *  Description : Reads a monotonic clock, only meant to measure short durations.
+ *
+ *  Returns     : uint64_t, the time in nanoseconds.
+ **************************************************************************************************/
+STATIC INLINE uint64_t zajel_time_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC,
+                  &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+} /*function: zajel_time_now*/
+
+/***************************************************************************************************
+ *  Name        : zajel_timestamp_now
+ *
+ *  Arguments   : None.
+ *
+ *  Description : Reads the processor timestamp counter, much cheaper than the monotonic clock but
+ *                  counting at a processor specific frequency. Platforms without a known counter
+ *                  fall back to the monotonic clock.
+ *
+ *  Returns     : uint64_t, the counter value.
+ **************************************************************************************************/
+STATIC INLINE uint64_t zajel_timestamp_now(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    uint32_t low;
+    uint32_t high;
+
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+
+    return ((uint64_t)high << 32) | low;
+#elif defined(__aarch64__)
+    uint64_t value;
+
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+
+    return value;
+#else
+    return zajel_time_now();
+#endif
+} /*function: zajel_timestamp_now*/
+
+#endif /* ZAJEL_PLATFORM_H_ */
@@ -0,0 +1,334 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <stddef.h>
+#include "zajel_pool.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_POOL_BLOCK_SIZE
+ *
+ *  Arguments   : sizeClass
+ *
+ *  Description : This macro gets the size of the blocks (header included) of the given size class.
+ *
+ *  Returns     : uint32_t.
+ **************************************************************************************************/
+#define ZAJEL_POOL_BLOCK_SIZE(sizeClass)    ((uint32_t)ZAJEL_POOL_SMALLEST_BLOCK_SIZE << (sizeClass))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_POOL_BLOCK_HEADER
+ *
+ *  Arguments   : block_ptr
+ *
+ *  Description : This macro gets the header preceding the given block.
+ *
+ *  Returns     : zajel_pool_block_header_u*.
+ **************************************************************************************************/
+#define ZAJEL_POOL_BLOCK_HEADER(block_ptr)  (((zajel_pool_block_header_u*)(block_ptr)) - 1)
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_refill
+ *
+ *  Arguments   : zajel_pool_s*         pool_ptr,
+ *                uint32_t              sizeClass,
+ *                allocation_function   allocationFunction_ptr
+ *
+ *  Description : Allocates a new slab for the given size class, and chains its blocks into the local
+ *                  free list.
+ *
+ *  Returns     : bool_t, FALSE if the allocation function failed.
+ **************************************************************************************************/
+STATIC bool_t zajel_pool_refill(zajel_pool_s*        pool_ptr,
+                                uint32_t             sizeClass,
+                                allocation_function  allocationFunction_ptr);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+void zajel_pool_init(zajel_pool_s*  pool_ptr,
+                     uint32_t       ownerThreadID,
+                     uint32_t       blocksPerSlab)
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    for(i = 0; i < ZAJEL_POOL_SIZE_CLASS_COUNT; ++i)
+    {
+        /*<Reset all size classes>*/
+        pool_ptr->sizeClassArray[i].remoteFree_ptr  = NULL;
+        pool_ptr->sizeClassArray[i].remoteFrees     = 0;
+        pool_ptr->sizeClassArray[i].localFree_ptr   = NULL;
+        pool_ptr->sizeClassArray[i].hits            = 0;
+        pool_ptr->sizeClassArray[i].misses          = 0;
+    } /*for: <Reset all size classes>*/
+
+    pool_ptr->oversizeAllocations   = 0;
+    pool_ptr->slabList_ptr          = NULL;
+    pool_ptr->blocksPerSlab         = blocksPerSlab;
+    pool_ptr->ownerThreadID         = ownerThreadID;
+} /*function: zajel_pool_init*/
+
+void* zajel_pool_alloc(zajel_pool_s*        pool_ptr,
+                       uint32_t             size,
+                       allocation_function  allocationFunction_ptr)
+{
+    zajel_pool_size_class_s*    sizeClass_ptr;
+    zajel_pool_block_header_u*  header_ptr;
+    /*Size of the block, header included*/
+    uint32_t                    blockSize;
+    /*Index of the smallest size class fitting the block*/
+    uint32_t                    sizeClass;
+
+    blockSize = size + sizeof(zajel_pool_block_header_u);
+    sizeClass = (blockSize <= ZAJEL_POOL_SMALLEST_BLOCK_SIZE) ?
+                (0) :
+                (32 - __builtin_clz(blockSize - 1) - 6);
+
+    if(ZAJEL_UNLIKELY(sizeClass >= ZAJEL_POOL_SIZE_CLASS_COUNT))
+    {
+        /*<Too big for the pools, allocate it directly>*/
+        header_ptr = (zajel_pool_block_header_u*) allocationFunction_ptr(blockSize);
+
+        if(NULL == header_ptr)
+        {
+            return NULL;
+        } /*if: <Allocation failed>*/
+
+        header_ptr->fields.ownerThreadID    = (uint16_t)pool_ptr->ownerThreadID;
+        header_ptr->fields.sizeClass        = ZAJEL_POOL_OVERSIZE_CLASS;
+        ZAJEL_COUNTER_INCREMENT(pool_ptr->oversizeAllocations);
+
+        return (void*)(header_ptr + 1);
+    } /*if: <Too big for the pools, allocate it directly>*/
+
+    sizeClass_ptr = &pool_ptr->sizeClassArray[sizeClass];
+
+    if(ZAJEL_UNLIKELY(NULL == sizeClass_ptr->localFree_ptr))
+    {
+        /*<Local list is empty, reclaim the blocks freed by the other threads>*/
+        if(NULL != ZAJEL_ATOMIC_LOAD_RELAXED(&sizeClass_ptr->remoteFree_ptr))
+        {
+            sizeClass_ptr->localFree_ptr = __atomic_exchange_n(&sizeClass_ptr->remoteFree_ptr,
+                                                               NULL,
+                                                               __ATOMIC_ACQUIRE);
+        } /*if: <Other threads returned some blocks>*/
+
+        if(NULL == sizeClass_ptr->localFree_ptr)
+        {
+            /*<Nothing to reclaim, a new slab is needed>*/
+            ZAJEL_COUNTER_INCREMENT(sizeClass_ptr->misses);
+
+            if(FALSE == zajel_pool_refill(pool_ptr,
+                                          sizeClass,
+                                          allocationFunction_ptr))
+            {
+                return NULL;
+            } /*if: <Allocation failed>*/
+        } /*if: <Nothing to reclaim, a new slab is needed>*/
+        else
+        {
+            ZAJEL_COUNTER_INCREMENT(sizeClass_ptr->hits);
+        } /*else: <Served from the reclaimed blocks>*/
+    } /*if: <Local list is empty, reclaim the blocks freed by the other threads>*/
+    else
+    {
+        ZAJEL_COUNTER_INCREMENT(sizeClass_ptr->hits);
+    } /*else: <Served from the local list>*/
+
+    header_ptr                      = sizeClass_ptr->localFree_ptr;
+    sizeClass_ptr->localFree_ptr    = header_ptr->fields.next_ptr;
+
+    return (void*)(header_ptr + 1);
+} /*function: zajel_pool_alloc*/
+
+void zajel_pool_free(zajel_pool_s*                  ownerPool_ptr,
+                     void*                          block_ptr,
+                     uint32_t                       callerThreadID,
+                     zajel_deallocation_function    deallocationFunction_ptr)
+{
+    zajel_pool_size_class_s*    sizeClass_ptr;
+    zajel_pool_block_header_u*  header_ptr;
+    zajel_pool_block_header_u*  head_ptr;
+
+    header_ptr = ZAJEL_POOL_BLOCK_HEADER(block_ptr);
+
+    if(ZAJEL_UNLIKELY(ZAJEL_POOL_OVERSIZE_CLASS == header_ptr->fields.sizeClass))
+    {
+        /*<Block was allocated directly, release it directly>*/
+        deallocationFunction_ptr(header_ptr);
+        return;
+    } /*if: <Block was allocated directly, release it directly>*/
+
+    sizeClass_ptr = &ownerPool_ptr->sizeClassArray[header_ptr->fields.sizeClass];
+
+    if(ZAJEL_LIKELY(callerThreadID == ownerPool_ptr->ownerThreadID))
+    {
+        /*<Freed by the owner, no synchronization needed>*/
+        header_ptr->fields.next_ptr     = sizeClass_ptr->localFree_ptr;
+        sizeClass_ptr->localFree_ptr    = header_ptr;
+    } /*if: <Freed by the owner, no synchronization needed>*/
+    else
+    {
+        /*<Freed by another thread, push it onto the remote-free list>*/
+        head_ptr = ZAJEL_ATOMIC_LOAD_RELAXED(&sizeClass_ptr->remoteFree_ptr);
+
+        do
+        {
+            header_ptr->fields.next_ptr = head_ptr;
+        } while(FALSE == __atomic_compare_exchange_n(&sizeClass_ptr->remoteFree_ptr,
+                                                     &head_ptr,
+                                                     header_ptr,
+                                                     1,
+                                                     __ATOMIC_RELEASE,
+                                                     __ATOMIC_RELAXED));
+
+        __atomic_fetch_add(&sizeClass_ptr->remoteFrees,
+                           1,
+                           __ATOMIC_RELAXED);
+    } /*else: <Freed by another thread, push it onto the remote-free list>*/
+} /*function: zajel_pool_free*/
+
+uint32_t zajel_pool_get_owner(void* block_ptr)
+{
+    return ZAJEL_POOL_BLOCK_HEADER(block_ptr)->fields.ownerThreadID;
+} /*function: zajel_pool_get_owner*/
+
+void zajel_pool_get_statistics(zajel_pool_s*            pool_ptr,
+                               zajel_pool_statistics_s* statistics_array)
+{
+    /*Temporary counter*/
+    uint32_t i;
+
+    for(i = 0; i < ZAJEL_POOL_SIZE_CLASS_COUNT; ++i)
+    {
+        /*<Copy the counters of each size class>*/
+        statistics_array[i].blockSize   = ZAJEL_POOL_BLOCK_SIZE(i) - sizeof(zajel_pool_block_header_u);
+        statistics_array[i].hits        = ZAJEL_ATOMIC_LOAD_RELAXED(&pool_ptr->sizeClassArray[i].hits);
+        statistics_array[i].misses      = ZAJEL_ATOMIC_LOAD_RELAXED(&pool_ptr->sizeClassArray[i].misses);
+        statistics_array[i].remoteFrees = ZAJEL_ATOMIC_LOAD_RELAXED(&pool_ptr->sizeClassArray[i].remoteFrees);
+    } /*for: <Copy the counters of each size class>*/
+
+    /*Oversize allocations never hit a pool*/
+    statistics_array[ZAJEL_POOL_OVERSIZE_CLASS].blockSize   = 0;
+    statistics_array[ZAJEL_POOL_OVERSIZE_CLASS].hits        = 0;
+    statistics_array[ZAJEL_POOL_OVERSIZE_CLASS].misses      = ZAJEL_ATOMIC_LOAD_RELAXED(&pool_ptr->oversizeAllocations);
+    statistics_array[ZAJEL_POOL_OVERSIZE_CLASS].remoteFrees = 0;
+} /*function: zajel_pool_get_statistics*/
+
+void zajel_pool_destroy(zajel_pool_s*               pool_ptr,
+                        zajel_deallocation_function deallocationFunction_ptr)
+{
+    void* slab_ptr;
+    void* nextSlab_ptr;
+
+    for(slab_ptr = pool_ptr->slabList_ptr; NULL != slab_ptr; slab_ptr = nextSlab_ptr)
+    {
+        /*<Release all the slabs>*/
+        nextSlab_ptr = *(void**)slab_ptr;
+        deallocationFunction_ptr(slab_ptr);
+    } /*for: <Release all the slabs>*/
+
+    pool_ptr->slabList_ptr = NULL;
+} /*function: zajel_pool_destroy*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC bool_t zajel_pool_refill(zajel_pool_s*        pool_ptr,
+                                uint32_t             sizeClass,
+                                allocation_function  allocationFunction_ptr)
+{
+    zajel_pool_size_class_s*    sizeClass_ptr;
+    zajel_pool_block_header_u*  header_ptr;
+    /*The new slab, starts with the link to the previously allocated slab*/
+    void*                       slab_ptr;
+    /*Start of the cache aligned area carved into blocks*/
+    uintptr_t                   block;
+    uint32_t                    blockSize;
+    /*Temporary counter*/
+    uint32_t                    i;
+
+    sizeClass_ptr   = &pool_ptr->sizeClassArray[sizeClass];
+    blockSize       = ZAJEL_POOL_BLOCK_SIZE(sizeClass);
+
+    /*The first cache line holds the slabs link, and absorbs the alignment of the blocks*/
+    slab_ptr = allocationFunction_ptr((2 * ZAJEL_CACHE_LINE_SIZE) + (blockSize * pool_ptr->blocksPerSlab));
+
+    if(NULL == slab_ptr)
+    {
+        return FALSE;
+    } /*if: <Allocation failed>*/
+
+    *(void**)slab_ptr       = pool_ptr->slabList_ptr;
+    pool_ptr->slabList_ptr  = slab_ptr;
+
+    /*
+     * Blocks are laid out so that the messages (not the headers) start on a cache line boundary when
+     * the block size allows it.
+     */
+    block = ZAJEL_CACHE_ALIGN_UP((uintptr_t)slab_ptr + sizeof(void*) + sizeof(zajel_pool_block_header_u)) -
+            sizeof(zajel_pool_block_header_u);
+
+    for(i = 0; i < pool_ptr->blocksPerSlab; ++i)
+    {
+        /*<Chain the blocks of the new slab into the local free list>*/
+        header_ptr                          = (zajel_pool_block_header_u*)(block + (i * blockSize));
+        header_ptr->fields.ownerThreadID    = (uint16_t)pool_ptr->ownerThreadID;
+        header_ptr->fields.sizeClass        = (uint16_t)sizeClass;
+        header_ptr->fields.next_ptr         = sizeClass_ptr->localFree_ptr;
+        sizeClass_ptr->localFree_ptr        = header_ptr;
+    } /*for: <Chain the blocks of the new slab into the local free list>*/
+
+    return TRUE;
+} /*function: zajel_pool_refill*/
@@ -0,0 +1,228 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * Per-thread slab pools used to allocate the messages.
+ *
+ * Each thread owns one pool, made of a fixed set of power of two size classes. Blocks are carved
+ * out of slabs obtained from the framework allocation function, and each block is preceded by a
+ * small header recording its owner thread and size class. A block freed by its owner goes back to
+ * the owner's local free list, while a block freed by any other thread is pushed onto the owner's
+ * lock-free remote-free list, which the owner reclaims as a whole (with a single exchange) once its
+ * local list runs dry. As the reclaim takes the whole list, the remote-free list is immune to ABA.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_POOL_H_
+#define ZAJEL_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Size of the blocks of the smallest size class (header included), other classes double it*/
+#define ZAJEL_POOL_SMALLEST_BLOCK_SIZE      (64)
+
+/*Marks a block that was too big for any size class, and allocated directly*/
+#define ZAJEL_POOL_OVERSIZE_CLASS           (ZAJEL_POOL_SIZE_CLASS_COUNT)
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Union Name:
+ * zajel_pool_block_header_u
+ *
+ * Union Description:
+ * Precedes every block handed out by the pools, the padding keeps the message 16 bytes aligned.
+ **************************************************************************************************/
+typedef union zajel_pool_block_header
+{
+    struct
+    {
+        /*Next free block, only meaningful while the block is in a free list*/
+        union zajel_pool_block_header*  next_ptr;
+        /*Thread owning the pool the block came from*/
+        uint16_t                        ownerThreadID;
+        /*Size class of the block, or ZAJEL_POOL_OVERSIZE_CLASS*/
+        uint16_t                        sizeClass;
+    } fields;
+    /*Keeps the header size (and so the message alignment) fixed on all platforms*/
+    uint8_t                             padding[16];
+} zajel_pool_block_header_u;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_pool_size_class_s
+ *
+ * Structure Description:
+ * Holds the free lists and the counters of a single size class, the remote-free list is the only
+ * part written by other threads, so it sits on its own cache line.
+ **************************************************************************************************/
+typedef struct zajel_pool_size_class
+{
+    /*Blocks freed by other threads, pushed concurrently and reclaimed as a whole by the owner*/
+    zajel_pool_block_header_u*  remoteFree_ptr      ZAJEL_CACHE_ALIGNED;
+    /*Number of blocks pushed onto the remote-free list*/
+    uint64_t                    remoteFrees;
+    /*Blocks freed by the owner thread, only used by the owner*/
+    zajel_pool_block_header_u*  localFree_ptr       ZAJEL_CACHE_ALIGNED;
+    /*Number of allocations served without calling the allocation function*/
+    uint64_t                    hits;
+    /*Number of allocations that needed a new slab*/
+    uint64_t                    misses;
+} zajel_pool_size_class_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_pool_s
+ *
+ * Structure Description:
+ * Holds the pool of a single thread.
+ **************************************************************************************************/
+typedef struct zajel_pool
+{
+    /*The size classes, ordered by ascending block size*/
+    zajel_pool_size_class_s     sizeClassArray[ZAJEL_POOL_SIZE_CLASS_COUNT];
+    /*Number of allocations too big for any size class, served by the allocation function*/
+    uint64_t                    oversizeAllocations ZAJEL_CACHE_ALIGNED;
+    /*Singly linked list of the slabs allocated so far, released when the pool is destroyed*/
+    void*                       slabList_ptr;
+    /*Number of blocks carved out of each slab*/
+    uint32_t                    blocksPerSlab;
+    /*Thread owning this pool*/
+    uint32_t                    ownerThreadID;
+} zajel_pool_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_init
+ *
+ *  Arguments   : zajel_pool_s* pool_ptr,
+ *                uint32_t      ownerThreadID,
+ *                uint32_t      blocksPerSlab
+ *
+ *  Description : Initializes an empty pool, no memory is allocated until the first allocation.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_pool_init(zajel_pool_s*  pool_ptr,
+                     uint32_t       ownerThreadID,
+                     uint32_t       blocksPerSlab);
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_alloc
+ *
+ *  Arguments   : zajel_pool_s*         pool_ptr,
+ *                uint32_t              size,
+ *                allocation_function   allocationFunction_ptr
+ *
+ *  Description : Allocates a block of at least size bytes, must only be called by the owner thread.
+ *
+ *  Returns     : void*, NULL if the allocation function failed.
+ **************************************************************************************************/
+void* zajel_pool_alloc(zajel_pool_s*        pool_ptr,
+                       uint32_t             size,
+                       allocation_function  allocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_free
+ *
+ *  Arguments   : zajel_pool_s*                 ownerPool_ptr,
+ *                void*                         block_ptr,
+ *                uint32_t                      callerThreadID,
+ *                zajel_deallocation_function   deallocationFunction_ptr
+ *
+ *  Description : Returns the given block to the pool of its owner, ownerPool_ptr shall be the pool
+ *                  of the thread returned by zajel_pool_get_owner for this block.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_pool_free(zajel_pool_s*                  ownerPool_ptr,
+                     void*                          block_ptr,
+                     uint32_t                       callerThreadID,
+                     zajel_deallocation_function    deallocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_get_owner
+ *
+ *  Arguments   : void* block_ptr
+ *
+ *  Description : Gets the thread owning the pool the given block was allocated from.
+ *
+ *  Returns     : uint32_t.
+ **************************************************************************************************/
+uint32_t zajel_pool_get_owner(void* block_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_get_statistics
+ *
+ *  Arguments   : zajel_pool_s*             pool_ptr,
+ *                zajel_pool_statistics_s*  statistics_array
+ *
+ *  Description : Copies the counters of each size class, followed by the oversize allocations, into
+ *                  the given array of ZAJEL_POOL_STATISTICS_COUNT entries. It can be called from any
+ *                  thread, the counters are read without stopping the owner.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_pool_get_statistics(zajel_pool_s*            pool_ptr,
+                               zajel_pool_statistics_s* statistics_array);
+
+/***************************************************************************************************
+ *  Name        : zajel_pool_destroy
+ *
+ *  Arguments   : zajel_pool_s*                 pool_ptr,
+ *                zajel_deallocation_function   deallocationFunction_ptr
+ *
+ *  Description : Releases all the slabs of the pool, any block still in use becomes invalid.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_pool_destroy(zajel_pool_s*               pool_ptr,
+                        zajel_deallocation_function deallocationFunction_ptr);
+
+#endif /* ZAJEL_POOL_H_ */
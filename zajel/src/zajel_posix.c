@@ -0,0 +1,900 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sched.h>
+#endif /*__linux__*/
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "zajel_posix.h"
+#include "zajel_mailbox.h"
+#include "zajel_numa.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/*Role of a thread identifier within the backend*/
+typedef enum zajel_posix_role
+{
+    /*Not part of the topology*/
+    ZAJEL_POSIX_ROLE_UNUSED     = 0,
+    /*Created by the backend, runs its thread function*/
+    ZAJEL_POSIX_ROLE_THREAD     = 1,
+    /*Created by the caller, attached using zajel_posix_attach*/
+    ZAJEL_POSIX_ROLE_EXTERNAL   = 2,
+    /*Created by the backend, delivers the messages coming from the other cores*/
+    ZAJEL_POSIX_ROLE_GATEWAY    = 3
+} zajel_posix_role_e;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_thread_s
+ *
+ * Structure Description:
+ * A thread of the backend, its mailbox keeps it on cache lines of its own.
+ **************************************************************************************************/
+typedef struct zajel_posix_thread
+{
+    /*Inbound queue and synchronization slot of the thread, the gateway gets the messages of its core*/
+    zajel_mailbox_s             mailbox;
+    pthread_t                   pthread;
+    zajel_posix_s*              posix_ptr;
+    zajel_posix_thread_function function_ptr;
+    void*                       argument_ptr;
+    uint32_t                    threadID;
+    uint32_t                    coreID;
+    /*One of zajel_posix_role_e*/
+    uint8_t                     role;
+    bool_t                      isCreated;
+} zajel_posix_thread_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_core_s
+ *
+ * Structure Description:
+ * A core of the backend.
+ **************************************************************************************************/
+typedef struct zajel_posix_core
+{
+#ifdef __linux__
+    cpu_set_t   cpuSet;
+#endif /*__linux__*/
+    /*FALSE if the threads of the core are left unpinned*/
+    bool_t      isPinned;
+    uint32_t    gatewayThreadID;
+} zajel_posix_core_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_carrier_s
+ *
+ * Structure Description:
+ * Carries the copy of an acknowledgment (and of the reply of a call) to the gateway of the source
+ * core, the copy follows the carrier. The acknowledgment identifier tells the carriers apart from
+ * the messages pushed in place.
+ **************************************************************************************************/
+typedef struct zajel_posix_carrier
+{
+    zajel_linked_message_descriptor_s link;
+} zajel_posix_carrier_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_s
+ *
+ * Structure Description:
+ * A backend instance.
+ **************************************************************************************************/
+struct zajel_posix
+{
+    zajel_s*                    zajel_ptr;
+    /*Indexed by thread ID, the unused entries are left zeroed*/
+    zajel_posix_thread_s*       threadArray_ptr;
+    uint32_t                    threadSlotCount;
+    /*Indexed by core ID*/
+    zajel_posix_core_s*         coreArray_ptr;
+    uint32_t                    coreSlotCount;
+    allocation_function         allocationFunction_ptr;
+    zajel_deallocation_function deallocationFunction_ptr;
+    /*Block holding the threads and cores, as allocated (before the cache line alignment)*/
+    void*                       memory_ptr;
+    /*TRUE once zajel_posix_stop is called*/
+    bool_t                      isStopping;
+};
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_core_push
+ *
+ *  Arguments   : zajel_message_descriptor_s* descriptor_ptr
+ *
+ *  Description : The core callback of every core, it pushes the message to the gateway of the
+ *                  destination core, copying the acknowledgments (built on the stack of
+ *                  zajel_acknowledge).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_posix_core_push(zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_gateway_run
+ *
+ *  Arguments   : zajel_posix_s*    posix_ptr,
+ *                uint32_t          threadID
+ *
+ *  Description : The body of a gateway, it delivers the messages pushed by the other cores until the
+ *                  backend is stopped, and releases the carriers of the acknowledgments.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_posix_gateway_run(zajel_posix_s*  posix_ptr,
+                                    uint32_t        threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_thread_start
+ *
+ *  Arguments   : void* thread_ptr
+ *
+ *  Description : The start routine of the threads created by the backend, it pins the thread then
+ *                  runs its body.
+ *
+ *  Returns     : void*, NULL.
+ **************************************************************************************************/
+STATIC void* zajel_posix_thread_start(void* thread_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_pin
+ *
+ *  Arguments   : zajel_posix_s*    posix_ptr,
+ *                uint32_t          threadID
+ *
+ *  Description : Pins the calling thread to the CPU set of the core of the given thread.
+ *
+ *  Returns     : zajel_status_e.
+ **************************************************************************************************/
+STATIC zajel_status_e zajel_posix_pin(zajel_posix_s*    posix_ptr,
+                                      uint32_t          threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_core_setup
+ *
+ *  Arguments   : zajel_posix_core_s*   core_ptr,
+ *                const char*           cpuList_ptr,
+ *                uint32_t              coreIndex
+ *
+ *  Description : Sets the CPU set of the given core from its CPU list, or picks the CPU of the core
+ *                  (the coreIndex-th allowed to the process, wrapping around) when the list is NULL.
+ *                  The CPUs shall all be allowed to the process.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE if the list is invalid.
+ **************************************************************************************************/
+STATIC zajel_status_e zajel_posix_core_setup(zajel_posix_core_s*    core_ptr,
+                                             const char*            cpuList_ptr,
+                                             uint32_t               coreIndex);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_core_node
+ *
+ *  Arguments   : const zajel_posix_core_s* core_ptr
+ *
+ *  Description : Gets the NUMA node of the CPUs the given core is pinned to.
+ *
+ *  Returns     : uint32_t, ZAJEL_NUMA_NODE_ANY if the core is not pinned, or if its CPUs span
+ *                  several nodes.
+ **************************************************************************************************/
+STATIC uint32_t zajel_posix_core_node(const zajel_posix_core_s* core_ptr);
+
+/***************************************************************************************************
+ *
+ *  G L O B A L S
+ *
+ **************************************************************************************************/
+
+/*The backend running in the process, the core callbacks are not given any context*/
+static zajel_posix_s* zajelPosix_ptr = NULL;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+zajel_status_e zajel_posix_init(zajel_posix_s**                 posixPointer_ptr,
+                                zajel_s*                        zajel_ptr,
+                                const zajel_posix_topology_s*   topology_ptr,
+                                allocation_function             allocationFunction_ptr,
+                                zajel_deallocation_function     deallocationFunction_ptr)
+{
+    zajel_posix_s*                      posix_ptr;
+    zajel_posix_thread_s*               thread_ptr;
+    const zajel_posix_core_config_s*    coreConfig_ptr;
+    const zajel_posix_thread_config_s*  threadConfig_ptr;
+    uint32_t                            threadsSize;
+    /*Temporary counter*/
+    uint32_t                            i;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs.
+     * o Sizing the thread and core tables after the biggest identifiers of the topology.
+     * o Resolving the CPU set of each core, so an invalid CPU list fails with nothing registered.
+     * o Registering each core, its gateway and each thread to the framework.
+     */
+    ASSERT((NULL != posixPointer_ptr),
+           "zajel: posixPointer_ptr cannot be NULL!",
+           __FILE__,
+           __LINE__);
+    ASSERT((NULL != zajel_ptr),
+           "zajel: Invalid pointer to the control block!",
+           __FILE__,
+           __LINE__);
+    ASSERT(((NULL != topology_ptr) && (0 != topology_ptr->coreCount)),
+           "zajel: The topology shall have at least a core!",
+           __FILE__,
+           __LINE__);
+
+    if(NULL != zajelPosix_ptr)
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <A backend is already running in the process>*/
+
+    posix_ptr = (zajel_posix_s*) allocationFunction_ptr(sizeof(zajel_posix_s));
+
+    ASSERT((NULL != posix_ptr),
+           "zajel: Failed to allocate the backend!",
+           __FILE__,
+           __LINE__);
+
+    memset(posix_ptr,
+           0,
+           sizeof(zajel_posix_s));
+
+    posix_ptr->zajel_ptr                = zajel_ptr;
+    posix_ptr->allocationFunction_ptr   = allocationFunction_ptr;
+    posix_ptr->deallocationFunction_ptr = deallocationFunction_ptr;
+
+    for(i = 0; i < topology_ptr->coreCount; ++i)
+    {
+        /*<Size the tables after the cores and their gateways>*/
+        coreConfig_ptr = &topology_ptr->coreArray[i];
+
+        if(coreConfig_ptr->coreID >= posix_ptr->coreSlotCount)
+        {
+            posix_ptr->coreSlotCount = coreConfig_ptr->coreID + 1;
+        } /*if: <Biggest core so far>*/
+
+        if(coreConfig_ptr->gatewayThreadID >= posix_ptr->threadSlotCount)
+        {
+            posix_ptr->threadSlotCount = coreConfig_ptr->gatewayThreadID + 1;
+        } /*if: <Biggest thread so far>*/
+    } /*for: <Size the tables after the cores and their gateways>*/
+
+    for(i = 0; i < topology_ptr->threadCount; ++i)
+    {
+        /*<Size the thread table after the threads>*/
+        if(topology_ptr->threadArray[i].threadID >= posix_ptr->threadSlotCount)
+        {
+            posix_ptr->threadSlotCount = topology_ptr->threadArray[i].threadID + 1;
+        } /*if: <Biggest thread so far>*/
+    } /*for: <Size the thread table after the threads>*/
+
+    /*The threads size is a multiple of the cache line (see zajel_mailbox_s), the cores follow them*/
+    threadsSize             = posix_ptr->threadSlotCount * (uint32_t) sizeof(zajel_posix_thread_s);
+    posix_ptr->memory_ptr   = allocationFunction_ptr(ZAJEL_CACHE_LINE_SIZE +
+                                                     threadsSize +
+                                                     (posix_ptr->coreSlotCount * sizeof(zajel_posix_core_s)));
+
+    ASSERT((NULL != posix_ptr->memory_ptr),
+           "zajel: Failed to allocate the backend threads!",
+           __FILE__,
+           __LINE__);
+
+    posix_ptr->threadArray_ptr  = (zajel_posix_thread_s*) ZAJEL_CACHE_ALIGN_UP((uintptr_t) posix_ptr->memory_ptr);
+    posix_ptr->coreArray_ptr    = (zajel_posix_core_s*)((uint8_t*) posix_ptr->threadArray_ptr + threadsSize);
+
+    memset(posix_ptr->threadArray_ptr,
+           0,
+           threadsSize + (posix_ptr->coreSlotCount * sizeof(zajel_posix_core_s)));
+
+    for(i = 0; i < topology_ptr->coreCount; ++i)
+    {
+        /*<Resolve the CPU set of each core, before anything is registered to the framework>*/
+        coreConfig_ptr = &topology_ptr->coreArray[i];
+
+        if(ZAJEL_STATUS_SUCCESS != zajel_posix_core_setup(&posix_ptr->coreArray_ptr[coreConfig_ptr->coreID],
+                                                          coreConfig_ptr->cpuList_ptr,
+                                                          i))
+        {
+            posix_ptr->deallocationFunction_ptr(posix_ptr->memory_ptr);
+            posix_ptr->deallocationFunction_ptr(posix_ptr);
+
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Invalid CPU list>*/
+    } /*for: <Resolve the CPU set of each core, before anything is registered to the framework>*/
+
+    for(i = 0; i < topology_ptr->coreCount; ++i)
+    {
+        /*<Register each core and its gateway>*/
+        coreConfig_ptr = &topology_ptr->coreArray[i];
+        thread_ptr     = &posix_ptr->threadArray_ptr[coreConfig_ptr->gatewayThreadID];
+
+        ASSERT((ZAJEL_POSIX_ROLE_UNUSED == thread_ptr->role),
+               "zajel: A thread of the topology is listed twice!",
+               __FILE__,
+               __LINE__);
+
+        posix_ptr->coreArray_ptr[coreConfig_ptr->coreID].gatewayThreadID = coreConfig_ptr->gatewayThreadID;
+
+        thread_ptr->posix_ptr   = posix_ptr;
+        thread_ptr->threadID    = coreConfig_ptr->gatewayThreadID;
+        thread_ptr->coreID      = coreConfig_ptr->coreID;
+        thread_ptr->role        = ZAJEL_POSIX_ROLE_GATEWAY;
+
+        zajel_regsiter_core(zajel_ptr,
+                            coreConfig_ptr->coreID,
+                            zajel_posix_core_push,
+                            coreConfig_ptr->name_ptr COMMA()
+                            FILE_AND_LINE_FOR_REF());
+        zajel_set_core_node(zajel_ptr,
+                            coreConfig_ptr->coreID,
+                            zajel_posix_core_node(&posix_ptr->coreArray_ptr[coreConfig_ptr->coreID]) COMMA()
+                            FILE_AND_LINE_FOR_REF());
+        zajel_regsiter_thread_mailbox(zajel_ptr,
+                                      coreConfig_ptr->gatewayThreadID,
+                                      coreConfig_ptr->coreID,
+                                      &thread_ptr->mailbox,
+                                      coreConfig_ptr->name_ptr COMMA()
+                                      FILE_AND_LINE_FOR_REF());
+    } /*for: <Register each core and its gateway>*/
+
+    for(i = 0; i < topology_ptr->threadCount; ++i)
+    {
+        /*<Register each thread>*/
+        threadConfig_ptr    = &topology_ptr->threadArray[i];
+        thread_ptr          = &posix_ptr->threadArray_ptr[threadConfig_ptr->threadID];
+
+        ASSERT((ZAJEL_POSIX_ROLE_UNUSED == thread_ptr->role),
+               "zajel: A thread of the topology is listed twice!",
+               __FILE__,
+               __LINE__);
+        ASSERT(((threadConfig_ptr->coreID < posix_ptr->coreSlotCount) &&
+                (ZAJEL_POSIX_ROLE_GATEWAY == posix_ptr->threadArray_ptr[posix_ptr->coreArray_ptr[threadConfig_ptr->coreID].gatewayThreadID].role)),
+               "zajel: The core of a thread is not part of the topology!",
+               __FILE__,
+               __LINE__);
+
+        thread_ptr->posix_ptr       = posix_ptr;
+        thread_ptr->threadID        = threadConfig_ptr->threadID;
+        thread_ptr->coreID          = threadConfig_ptr->coreID;
+        thread_ptr->function_ptr    = threadConfig_ptr->function_ptr;
+        thread_ptr->argument_ptr    = threadConfig_ptr->argument_ptr;
+        thread_ptr->role            = (threadConfig_ptr->isExternal) ?
+                                      (ZAJEL_POSIX_ROLE_EXTERNAL) :
+                                      (ZAJEL_POSIX_ROLE_THREAD);
+
+        zajel_regsiter_thread_mailbox(zajel_ptr,
+                                      threadConfig_ptr->threadID,
+                                      threadConfig_ptr->coreID,
+                                      &thread_ptr->mailbox,
+                                      threadConfig_ptr->name_ptr COMMA()
+                                      FILE_AND_LINE_FOR_REF());
+    } /*for: <Register each thread>*/
+
+    zajelPosix_ptr      = posix_ptr;
+    *posixPointer_ptr   = posix_ptr;
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_posix_init*/
+
+zajel_status_e zajel_posix_start(zajel_posix_s* posix_ptr)
+{
+    zajel_posix_thread_s*   thread_ptr;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    ASSERT((NULL != posix_ptr),
+           "zajel: Invalid pointer to the backend!",
+           __FILE__,
+           __LINE__);
+
+    for(i = 0; i < posix_ptr->threadSlotCount; ++i)
+    {
+        /*<Create each thread of the backend>*/
+        thread_ptr = &posix_ptr->threadArray_ptr[i];
+
+        if(((ZAJEL_POSIX_ROLE_THREAD != thread_ptr->role) && (ZAJEL_POSIX_ROLE_GATEWAY != thread_ptr->role)) ||
+           (TRUE == thread_ptr->isCreated))
+        {
+            continue;
+        } /*if: <Thread is not created by the backend, or already running>*/
+
+        if(0 != pthread_create(&thread_ptr->pthread,
+                               NULL,
+                               zajel_posix_thread_start,
+                               thread_ptr))
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Thread cannot be created>*/
+
+        thread_ptr->isCreated = TRUE;
+    } /*for: <Create each thread of the backend>*/
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_posix_start*/
+
+zajel_status_e zajel_posix_attach(zajel_posix_s*    posix_ptr,
+                                  uint32_t          threadID)
+{
+    ASSERT((NULL != posix_ptr),
+           "zajel: Invalid pointer to the backend!",
+           __FILE__,
+           __LINE__);
+    ASSERT(((threadID < posix_ptr->threadSlotCount) &&
+            (ZAJEL_POSIX_ROLE_EXTERNAL == posix_ptr->threadArray_ptr[threadID].role)),
+           "zajel: Only the external threads of the topology can be attached!",
+           __FILE__,
+           __LINE__);
+
+    return zajel_posix_pin(posix_ptr,
+                           threadID);
+} /*function: zajel_posix_attach*/
+
+void zajel_posix_run(zajel_posix_s* posix_ptr,
+                     uint32_t       threadID)
+{
+    zajel_mailbox_s* mailbox_ptr;
+
+    ASSERT((NULL != posix_ptr),
+           "zajel: Invalid pointer to the backend!",
+           __FILE__,
+           __LINE__);
+    ASSERT(((threadID < posix_ptr->threadSlotCount) &&
+            (ZAJEL_POSIX_ROLE_THREAD <= posix_ptr->threadArray_ptr[threadID].role) &&
+            (ZAJEL_POSIX_ROLE_GATEWAY != posix_ptr->threadArray_ptr[threadID].role)),
+           "zajel: The thread is not part of the topology!",
+           __FILE__,
+           __LINE__);
+
+    mailbox_ptr = &posix_ptr->threadArray_ptr[threadID].mailbox;
+
+    while(FALSE == ZAJEL_ATOMIC_LOAD_ACQUIRE(&posix_ptr->isStopping))
+    {
+        /*<Dispatch the inbound messages, park when there is none>*/
+        if(0 == zajel_dispatch(posix_ptr->zajel_ptr,
+                               threadID,
+                               ZAJEL_POSIX_DISPATCH_BUDGET COMMA()
+                               FILE_AND_LINE_FOR_REF()))
+        {
+            /*A message pushed (or a wake) since the dispatch returns at once*/
+            zajel_mailbox_wait(mailbox_ptr);
+        } /*if: <Nothing to do>*/
+    } /*while: <Dispatch the inbound messages, park when there is none>*/
+} /*function: zajel_posix_run*/
+
+bool_t zajel_posix_is_running(zajel_posix_s* posix_ptr)
+{
+    return (FALSE == ZAJEL_ATOMIC_LOAD_ACQUIRE(&posix_ptr->isStopping)) ? (TRUE) : (FALSE);
+} /*function: zajel_posix_is_running*/
+
+void zajel_posix_wake(zajel_posix_s*    posix_ptr,
+                      uint32_t          threadID)
+{
+    ASSERT(((threadID < posix_ptr->threadSlotCount) &&
+            (ZAJEL_POSIX_ROLE_UNUSED != posix_ptr->threadArray_ptr[threadID].role)),
+           "zajel: The thread is not part of the topology!",
+           __FILE__,
+           __LINE__);
+
+    zajel_mailbox_wake(&posix_ptr->threadArray_ptr[threadID].mailbox);
+} /*function: zajel_posix_wake*/
+
+void zajel_posix_stop(zajel_posix_s* posix_ptr)
+{
+    zajel_posix_thread_s*   thread_ptr;
+    /*Temporary counter*/
+    uint32_t                i;
+
+    ASSERT((NULL != posix_ptr),
+           "zajel: Invalid pointer to the backend!",
+           __FILE__,
+           __LINE__);
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&posix_ptr->isStopping, TRUE);
+
+    for(i = 0; i < posix_ptr->threadSlotCount; ++i)
+    {
+        /*<Wake each thread, a thread about to park returns from its next wait at once>*/
+        if(ZAJEL_POSIX_ROLE_UNUSED != posix_ptr->threadArray_ptr[i].role)
+        {
+            zajel_mailbox_wake(&posix_ptr->threadArray_ptr[i].mailbox);
+        } /*if: <Thread is part of the topology>*/
+    } /*for: <Wake each thread, a thread about to park returns from its next wait at once>*/
+
+    for(i = 0; i < posix_ptr->threadSlotCount; ++i)
+    {
+        /*<Wait for each created thread>*/
+        thread_ptr = &posix_ptr->threadArray_ptr[i];
+
+        if(TRUE == thread_ptr->isCreated)
+        {
+            pthread_join(thread_ptr->pthread,
+                         NULL);
+            thread_ptr->isCreated = FALSE;
+        } /*if: <Thread was created by the backend>*/
+    } /*for: <Wait for each created thread>*/
+} /*function: zajel_posix_stop*/
+
+void zajel_posix_destroy(zajel_posix_s** posixPointer_ptr)
+{
+    zajel_posix_s* posix_ptr;
+
+    ASSERT(((NULL != posixPointer_ptr) && (NULL != *posixPointer_ptr)),
+           "zajel: Invalid pointer to the backend!",
+           __FILE__,
+           __LINE__);
+
+    posix_ptr = *posixPointer_ptr;
+
+    if(zajelPosix_ptr == posix_ptr)
+    {
+        zajelPosix_ptr = NULL;
+    } /*if: <Backend of the process>*/
+
+    posix_ptr->deallocationFunction_ptr(posix_ptr->memory_ptr);
+    posix_ptr->deallocationFunction_ptr(posix_ptr);
+
+    *posixPointer_ptr = NULL;
+} /*function: zajel_posix_destroy*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC void zajel_posix_core_push(zajel_message_descriptor_s* descriptor_ptr)
+{
+    zajel_posix_s*          posix_ptr;
+    zajel_posix_carrier_s*  carrier_ptr;
+    zajel_posix_thread_s*   gateway_ptr;
+    uint32_t                size;
+
+    posix_ptr   = zajelPosix_ptr;
+    gateway_ptr = &posix_ptr->threadArray_ptr[posix_ptr->coreArray_ptr[zajel_get_component_core(posix_ptr->zajel_ptr,
+                                                                                                descriptor_ptr->destinationComponentID COMMA()
+                                                                                                FILE_AND_LINE_FOR_REF())].gatewayThreadID];
+
+    if(ZAJEL_LIKELY(ZAJEL_ACK_MESSAGE_ID != descriptor_ptr->messageID))
+    {
+        /*<Message crosses in place>*/
+        zajel_mailbox_push(&gateway_ptr->mailbox,
+                           (zajel_linked_message_descriptor_s*) descriptor_ptr);
+
+        return;
+    } /*if: <Message crosses in place>*/
+
+    /*<Acknowledgment built by the framework, copy it (with the reply of a call)>*/
+    size = (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_CALL) ?
+           ((uint32_t) ZAJEL_CALL_REPLY_MESSAGE_SIZE((zajel_call_reply_s*) descriptor_ptr)) :
+           ((uint32_t) sizeof(zajel_message_descriptor_s));
+
+    carrier_ptr = (zajel_posix_carrier_s*) posix_ptr->allocationFunction_ptr(sizeof(zajel_posix_carrier_s) + size);
+
+    ASSERT((NULL != carrier_ptr),
+           "zajel: Failed to allocate the copy of an acknowledgment!",
+           __FILE__,
+           __LINE__);
+
+    memcpy((void*)(carrier_ptr + 1),
+           descriptor_ptr,
+           size);
+    carrier_ptr->link.descriptor.messageID = ZAJEL_ACK_MESSAGE_ID;
+
+    zajel_mailbox_push(&gateway_ptr->mailbox,
+                       &carrier_ptr->link);
+} /*function: zajel_posix_core_push*/
+
+STATIC void zajel_posix_gateway_run(zajel_posix_s*  posix_ptr,
+                                    uint32_t        threadID)
+{
+    zajel_linked_message_descriptor_s*  message_ptr;
+    zajel_mailbox_s*                    mailbox_ptr;
+
+    mailbox_ptr = &posix_ptr->threadArray_ptr[threadID].mailbox;
+
+    for(;;)
+    {
+        /*<Deliver the messages of the other cores, the queued ones included once stopping>*/
+        message_ptr = zajel_mailbox_pop(mailbox_ptr);
+
+        if(NULL == message_ptr)
+        {
+            if(TRUE == ZAJEL_ATOMIC_LOAD_ACQUIRE(&posix_ptr->isStopping))
+            {
+                break;
+            } /*if: <Backend is stopping>*/
+
+            zajel_mailbox_wait(mailbox_ptr);
+
+            continue;
+        } /*if: <Nothing to deliver>*/
+
+        if(ZAJEL_ACK_MESSAGE_ID == message_ptr->descriptor.messageID)
+        {
+            /*<Carrier of an acknowledgment>*/
+            zajel_deliver(posix_ptr->zajel_ptr,
+                          (void*)((zajel_posix_carrier_s*) message_ptr + 1),
+                          threadID COMMA()
+                          FILE_AND_LINE_FOR_REF());
+
+            posix_ptr->deallocationFunction_ptr(message_ptr);
+        } /*if: <Carrier of an acknowledgment>*/
+        else
+        {
+            zajel_deliver(posix_ptr->zajel_ptr,
+                          message_ptr,
+                          threadID COMMA()
+                          FILE_AND_LINE_FOR_REF());
+        } /*else: <Message in place>*/
+    } /*for: <Deliver the messages of the other cores, the queued ones included once stopping>*/
+} /*function: zajel_posix_gateway_run*/
+
+STATIC void* zajel_posix_thread_start(void* thread_ptr)
+{
+    zajel_posix_thread_s* posixThread_ptr;
+
+    posixThread_ptr = (zajel_posix_thread_s*) thread_ptr;
+
+    /*The CPU sets were checked against the ones allowed to the process, pinning cannot fail*/
+    (void) zajel_posix_pin(posixThread_ptr->posix_ptr,
+                           posixThread_ptr->threadID);
+
+    if(ZAJEL_POSIX_ROLE_GATEWAY == posixThread_ptr->role)
+    {
+        zajel_posix_gateway_run(posixThread_ptr->posix_ptr,
+                                posixThread_ptr->threadID);
+    } /*if: <Gateway of a core>*/
+    else if(NULL != posixThread_ptr->function_ptr)
+    {
+        posixThread_ptr->function_ptr(posixThread_ptr->posix_ptr,
+                                      posixThread_ptr->threadID,
+                                      posixThread_ptr->argument_ptr);
+    } /*if: <Thread has its own body>*/
+    else
+    {
+        zajel_posix_run(posixThread_ptr->posix_ptr,
+                        posixThread_ptr->threadID);
+    } /*else: <Default body>*/
+
+    return NULL;
+} /*function: zajel_posix_thread_start*/
+
+STATIC zajel_status_e zajel_posix_pin(zajel_posix_s*    posix_ptr,
+                                      uint32_t          threadID)
+{
+    zajel_posix_core_s* core_ptr;
+
+    core_ptr = &posix_ptr->coreArray_ptr[posix_ptr->threadArray_ptr[threadID].coreID];
+
+    if(FALSE == core_ptr->isPinned)
+    {
+        return ZAJEL_STATUS_SUCCESS;
+    } /*if: <Threads of the core are left unpinned>*/
+
+#ifdef __linux__
+    if(0 != sched_setaffinity(0,
+                              sizeof(cpu_set_t),
+                              &core_ptr->cpuSet))
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Thread cannot be pinned>*/
+#endif /*__linux__*/
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_posix_pin*/
+
+STATIC zajel_status_e zajel_posix_core_setup(zajel_posix_core_s*    core_ptr,
+                                             const char*            cpuList_ptr,
+                                             uint32_t               coreIndex)
+{
+#ifdef __linux__
+    cpu_set_t       allowedSet;
+    const char*     cursor_ptr;
+    char*           end_ptr;
+    unsigned long   first;
+    unsigned long   last;
+    /*Number of allowed CPUs to skip before reaching the CPU of the core*/
+    uint32_t        rank;
+    /*Temporary counter*/
+    uint32_t        cpu;
+
+    if((NULL != cpuList_ptr) &&
+       ('\0' == cpuList_ptr[0]))
+    {
+        core_ptr->isPinned = FALSE;
+
+        return ZAJEL_STATUS_SUCCESS;
+    } /*if: <Threads of the core are left unpinned>*/
+
+    if(0 != sched_getaffinity(0,
+                              sizeof(cpu_set_t),
+                              &allowedSet))
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <CPUs allowed to the process are unknown>*/
+
+    CPU_ZERO(&core_ptr->cpuSet);
+    core_ptr->isPinned = TRUE;
+
+    if(NULL == cpuList_ptr)
+    {
+        /*<Pick the coreIndex-th allowed CPU, wrapping around>*/
+        rank = coreIndex % (uint32_t) CPU_COUNT(&allowedSet);
+
+        for(cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(!CPU_ISSET(cpu, &allowedSet))
+            {
+                continue;
+            } /*if: <CPU not allowed to the process>*/
+
+            if(0 == rank)
+            {
+                CPU_SET(cpu, &core_ptr->cpuSet);
+
+                return ZAJEL_STATUS_SUCCESS;
+            } /*if: <CPU of the core>*/
+
+            --rank;
+        } /*for: <Each CPU>*/
+    } /*if: <Pick the coreIndex-th allowed CPU, wrapping around>*/
+
+    cursor_ptr = cpuList_ptr;
+
+    for(;;)
+    {
+        /*<Parse each item of the list, a single CPU or a range>*/
+        first = strtoul(cursor_ptr, &end_ptr, 10);
+
+        if(end_ptr == cursor_ptr)
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Not a number>*/
+
+        last = first;
+
+        if('-' == *end_ptr)
+        {
+            cursor_ptr  = end_ptr + 1;
+            last        = strtoul(cursor_ptr, &end_ptr, 10);
+
+            if((end_ptr == cursor_ptr) || (last < first))
+            {
+                return ZAJEL_STATUS_FAILURE;
+            } /*if: <Invalid range>*/
+        } /*if: <Range>*/
+
+        for(; first <= last; ++first)
+        {
+            if((first >= CPU_SETSIZE) || (!CPU_ISSET(first, &allowedSet)))
+            {
+                return ZAJEL_STATUS_FAILURE;
+            } /*if: <CPU not allowed to the process>*/
+
+            CPU_SET(first, &core_ptr->cpuSet);
+        } /*for: <Each CPU of the item>*/
+
+        if('\0' == *end_ptr)
+        {
+            break;
+        } /*if: <End of the list>*/
+
+        if(',' != *end_ptr)
+        {
+            return ZAJEL_STATUS_FAILURE;
+        } /*if: <Invalid separator>*/
+
+        cursor_ptr = end_ptr + 1;
+    } /*for: <Parse each item of the list, a single CPU or a range>*/
+#else
+    (void) cpuList_ptr;
+    (void) coreIndex;
+
+    core_ptr->isPinned = FALSE;
+#endif /*__linux__*/
+
+    return ZAJEL_STATUS_SUCCESS;
+} /*function: zajel_posix_core_setup*/
+
+STATIC uint32_t zajel_posix_core_node(const zajel_posix_core_s* core_ptr)
+{
+#ifdef __linux__
+    uint32_t nodeID;
+    uint32_t cpuNodeID;
+    /*Temporary counter*/
+    uint32_t cpu;
+
+    if(FALSE == core_ptr->isPinned)
+    {
+        return ZAJEL_NUMA_NODE_ANY;
+    } /*if: <Threads of the core may run anywhere>*/
+
+    nodeID = ZAJEL_NUMA_NODE_ANY;
+
+    for(cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        /*<All the CPUs of the core shall be on the same node>*/
+        if(!CPU_ISSET(cpu, &core_ptr->cpuSet))
+        {
+            continue;
+        } /*if: <CPU not used by the core>*/
+
+        cpuNodeID = zajel_numa_cpu_node(cpu);
+
+        if((ZAJEL_NUMA_NODE_ANY == cpuNodeID) ||
+           ((ZAJEL_NUMA_NODE_ANY != nodeID) && (cpuNodeID != nodeID)))
+        {
+            return ZAJEL_NUMA_NODE_ANY;
+        } /*if: <Node of the CPU is unknown, or differs from the previous ones>*/
+
+        nodeID = cpuNodeID;
+    } /*for: <All the CPUs of the core shall be on the same node>*/
+
+    return nodeID;
+#else
+    (void) core_ptr;
+
+    return ZAJEL_NUMA_NODE_ANY;
+#endif /*__linux__*/
+} /*function: zajel_posix_core_node*/
@@ -0,0 +1,253 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+/*
+ * A ready-made backend running the whole topology within a single process, on POSIX threads:
+ *
+ *  o Every thread is registered with a mailbox (see zajel_mailbox.h), giving it a lock-free inbound
+ *    queue and spin-then-park block/unblock callbacks, and runs zajel_posix_run (or the function of
+ *    the topology, which typically ends up calling it).
+ *  o Every core is given a gateway thread, which delivers the messages and acknowledgments coming
+ *    from the other cores through zajel_deliver. The gateway runs no component, so it never blocks.
+ *  o Every thread of a core (its gateway included) is pinned to the CPU set of the core, using
+ *    sched_setaffinity, so that the logical cores keep matching the hardware and their caches.
+ *
+ * The messages sent to the threads of the backend, or to another core, shall start with a
+ * zajel_linked_message_descriptor_s. The acknowledgments crossing cores are copied by the backend.
+ * As the core callbacks are not given any context, a single backend can run in a process. The CPU
+ * pinning is only available on Linux, the threads are left unpinned on the other platforms.
+ */
+#ifndef ZAJEL_POSIX_H_
+#define ZAJEL_POSIX_H_
+
+#include <stdint.h>
+#include "zajel.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Budget given to zajel_dispatch by each iteration of zajel_posix_run*/
+#define ZAJEL_POSIX_DISPATCH_BUDGET     (64)
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/*A backend instance*/
+typedef struct zajel_posix zajel_posix_s;
+
+/*Body of a thread created by the backend*/
+typedef void (*zajel_posix_thread_function) (zajel_posix_s*, uint32_t threadID, void* argument_ptr);
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_core_config_s
+ *
+ * Structure Description:
+ * A core of the topology.
+ **************************************************************************************************/
+typedef struct zajel_posix_core_config
+{
+    uint32_t    coreID;
+    /*Thread (not listed in the threads of the topology) created by the backend to deliver the messages coming from the other cores*/
+    uint32_t    gatewayThreadID;
+    /*
+     * CPUs running the threads of the core, in the Linux cpulist format ("2", "0-3,8"...). When NULL,
+     * the core gets a single CPU: the CPUs allowed to the process are given to the cores in the order
+     * of the topology (wrapping around). An empty string leaves the threads of the core unpinned.
+     * A core whose CPUs all belong to the same NUMA node gets it as its node (zajel_set_core_node).
+     */
+    const char* cpuList_ptr;
+    char*       name_ptr;
+} zajel_posix_core_config_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_thread_config_s
+ *
+ * Structure Description:
+ * A thread of the topology.
+ **************************************************************************************************/
+typedef struct zajel_posix_thread_config
+{
+    uint32_t                    threadID;
+    uint32_t                    coreID;
+    /*Body of the thread, zajel_posix_run when NULL*/
+    zajel_posix_thread_function function_ptr;
+    void*                       argument_ptr;
+    /*TRUE if the thread is not created by the backend, but attached by the caller (see zajel_posix_attach)*/
+    bool_t                      isExternal;
+    char*                       name_ptr;
+} zajel_posix_thread_config_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_posix_topology_s
+ *
+ * Structure Description:
+ * The cores and threads run by the backend.
+ **************************************************************************************************/
+typedef struct zajel_posix_topology
+{
+    const zajel_posix_core_config_s*    coreArray;
+    uint32_t                            coreCount;
+    const zajel_posix_thread_config_s*  threadArray;
+    uint32_t                            threadCount;
+} zajel_posix_topology_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_init
+ *
+ *  Arguments   : zajel_posix_s**               posixPointer_ptr,
+ *                zajel_s*                      zajel_ptr,
+ *                const zajel_posix_topology_s* topology_ptr,
+ *                allocation_function           allocationFunction_ptr,
+ *                zajel_deallocation_function   deallocationFunction_ptr
+ *
+ *  Description : This function registers the cores and threads of the given topology (the gateways
+ *                  included) to the framework, which shall be sized for them. The components and
+ *                  messages are then registered as usual, and the topology sealed, before starting
+ *                  the threads using zajel_posix_start. The backend memory and the copies of the
+ *                  acknowledgments crossing cores come from the given (thread safe) allocator. The
+ *                  features placing their memory on the node of each core (see zajel_enable_numa)
+ *                  shall be enabled afterwards.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE if a CPU list is invalid, or if a backend is
+ *                  already running in the process.
+ **************************************************************************************************/
+zajel_status_e zajel_posix_init(zajel_posix_s**                 posixPointer_ptr,
+                                zajel_s*                        zajel_ptr,
+                                const zajel_posix_topology_s*   topology_ptr,
+                                allocation_function             allocationFunction_ptr,
+                                zajel_deallocation_function     deallocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_start
+ *
+ *  Arguments   : zajel_posix_s* posix_ptr
+ *
+ *  Description : This function creates the threads of the topology (but the external ones), each of
+ *                  them pinning itself to the CPU set of its core first.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE if a thread cannot be created (the threads
+ *                  already created keep running until zajel_posix_stop).
+ **************************************************************************************************/
+zajel_status_e zajel_posix_start(zajel_posix_s* posix_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_attach
+ *
+ *  Arguments   : zajel_posix_s*    posix_ptr,
+ *                uint32_t          threadID
+ *
+ *  Description : This function pins the calling thread, which runs the given external thread of the
+ *                  topology, to the CPU set of its core.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE if the thread cannot be pinned.
+ **************************************************************************************************/
+zajel_status_e zajel_posix_attach(zajel_posix_s*    posix_ptr,
+                                  uint32_t          threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_run
+ *
+ *  Arguments   : zajel_posix_s*    posix_ptr,
+ *                uint32_t          threadID
+ *
+ *  Description : This function is the default body of the threads: it dispatches the messages of the
+ *                  given (calling) thread, parking on its mailbox when there is nothing to do, until
+ *                  zajel_posix_stop is called. A parked thread does not advance its timers.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_posix_run(zajel_posix_s* posix_ptr,
+                     uint32_t       threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_is_running
+ *
+ *  Arguments   : zajel_posix_s* posix_ptr
+ *
+ *  Description : This function tells whether the threads shall keep running, for the thread functions
+ *                  having their own loop.
+ *
+ *  Returns     : bool_t, FALSE once zajel_posix_stop is called.
+ **************************************************************************************************/
+bool_t zajel_posix_is_running(zajel_posix_s* posix_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_wake
+ *
+ *  Arguments   : zajel_posix_s*    posix_ptr,
+ *                uint32_t          threadID
+ *
+ *  Description : This function wakes the given thread if it is parked in zajel_posix_run (or on its
+ *                  mailbox), to have it check zajel_posix_is_running or attend other duties.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_posix_wake(zajel_posix_s*    posix_ptr,
+                      uint32_t          threadID);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_stop
+ *
+ *  Arguments   : zajel_posix_s* posix_ptr
+ *
+ *  Description : This function asks the threads to stop, wakes them, and waits for the ones created
+ *                  by the backend to exit. The external threads shall have left zajel_posix_run.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_posix_stop(zajel_posix_s* posix_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_posix_destroy
+ *
+ *  Arguments   : zajel_posix_s** posixPointer_ptr
+ *
+ *  Description : This function releases the backend, once stopped. The framework keeps referring to
+ *                  the mailboxes of the backend, so it shall be destroyed first (or not used anymore).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_posix_destroy(zajel_posix_s** posixPointer_ptr);
+
+#endif /* ZAJEL_POSIX_H_ */
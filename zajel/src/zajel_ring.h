@@ -0,0 +1,255 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * A wait-free single-producer/single-consumer ring of pointers.
+ *
+ * The producer owns the head index, the consumer owns the tail index, and each side keeps a cached
+ * copy of the other side's index so that the shared cache line is only touched when the cached
+ * copy says the ring looks full (producer) or empty (consumer). Both indices run freely and wrap
+ * around naturally, the capacity must be a power of two.
+ */
+#ifndef ZAJEL_RING_H_
+#define ZAJEL_RING_H_
+
+#include <stdint.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_ring_s
+ *
+ * Structure Description:
+ * Holds a single SPSC ring, the producer and consumer fields live on separate cache lines to avoid
+ * false sharing between the two threads.
+ **************************************************************************************************/
+typedef struct zajel_ring
+{
+    /*Next slot to be written, only modified by the producer*/
+    uint32_t    head                        ZAJEL_CACHE_ALIGNED;
+    /*Producer's last observed value of the tail*/
+    uint32_t    cachedTail;
+    /*Next slot to be read, only modified by the consumer*/
+    uint32_t    tail                        ZAJEL_CACHE_ALIGNED;
+    /*Consumer's last observed value of the head*/
+    uint32_t    cachedHead;
+    /*Capacity - 1, used to wrap the free running indices, read-only after initialization*/
+    uint32_t    mask                        ZAJEL_CACHE_ALIGNED;
+    /*The ring storage, capacity entries*/
+    void**      slots_ptr;
+} zajel_ring_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_ring_init
+ *
+ *  Arguments   : zajel_ring_s* ring_ptr,
+ *                void**        slots_ptr,
+ *                uint32_t      capacity
+ *
+ *  Description : Initializes the given ring over the given storage, capacity must be a power of two.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_ring_init(zajel_ring_s*    ring_ptr,
+                                   void**           slots_ptr,
+                                   uint32_t         capacity)
+{
+    ring_ptr->head          = 0;
+    ring_ptr->cachedTail    = 0;
+    ring_ptr->tail          = 0;
+    ring_ptr->cachedHead    = 0;
+    ring_ptr->mask          = capacity - 1;
+    ring_ptr->slots_ptr     = slots_ptr;
+} /*function: zajel_ring_init*/
+
+/***************************************************************************************************
+ *  Name        : zajel_ring_push
+ *
+ *  Arguments   : zajel_ring_s* ring_ptr,
+ *                void*         item_ptr
+ *
+ *  Description : Appends the given item to the ring, must only be called by the producer thread.
+ *
+ *  Returns     : bool_t, FALSE if the ring is full.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_ring_push(zajel_ring_s*  ring_ptr,
+                                     void*          item_ptr)
+{
+    uint32_t head;
+
+    head = ring_ptr->head;
+
+    if(ZAJEL_UNLIKELY((head - ring_ptr->cachedTail) > ring_ptr->mask))
+    {
+        /*<Ring looks full, refresh the cached tail>*/
+        ring_ptr->cachedTail = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ring_ptr->tail);
+
+        if((head - ring_ptr->cachedTail) > ring_ptr->mask)
+        {
+            return FALSE;
+        } /*if: <Ring is really full>*/
+    } /*if: <Ring looks full, refresh the cached tail>*/
+
+    ring_ptr->slots_ptr[head & ring_ptr->mask] = item_ptr;
+    ZAJEL_ATOMIC_STORE_RELEASE(&ring_ptr->head, head + 1);
+
+    return TRUE;
+} /*function: zajel_ring_push*/
+
+/***************************************************************************************************
+ *  Name        : zajel_ring_is_full
+ *
+ *  Arguments   : zajel_ring_s* ring_ptr
+ *
+ *  Description : Checks whether the next push would fail, must only be called by the producer thread.
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_ring_is_full(zajel_ring_s* ring_ptr)
+{
+    if((ring_ptr->head - ring_ptr->cachedTail) > ring_ptr->mask)
+    {
+        /*<Ring looks full, refresh the cached tail>*/
+        ring_ptr->cachedTail = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ring_ptr->tail);
+    } /*if: <Ring looks full, refresh the cached tail>*/
+
+    return ((ring_ptr->head - ring_ptr->cachedTail) > ring_ptr->mask) ? (TRUE) : (FALSE);
+} /*function: zajel_ring_is_full*/
+
+/***************************************************************************************************
+ *  Name        : zajel_ring_push_burst
+ *
+ *  Arguments   : zajel_ring_s* ring_ptr,
+ *                void**        items_ptr,
+ *                uint32_t      count
+ *
+ *  Description : Appends up to count items to the ring, must only be called by the producer thread.
+ *                  The whole burst is published to the consumer with a single store.
+ *
+ *  Returns     : uint32_t, number of items appended (less than count if the ring got full).
+ **************************************************************************************************/
+STATIC INLINE uint32_t zajel_ring_push_burst(zajel_ring_s*  ring_ptr,
+                                             void**         items_ptr,
+                                             uint32_t       count)
+{
+    uint32_t head;
+    uint32_t space;
+    uint32_t i;
+
+    head    = ring_ptr->head;
+    space   = ring_ptr->mask + 1 - (head - ring_ptr->cachedTail);
+
+    if(space < count)
+    {
+        /*<Not enough space seen, refresh the cached tail>*/
+        ring_ptr->cachedTail    = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ring_ptr->tail);
+        space                   = ring_ptr->mask + 1 - (head - ring_ptr->cachedTail);
+    } /*if: <Not enough space seen, refresh the cached tail>*/
+
+    if(space > count)
+    {
+        space = count;
+    } /*if: <Limit the burst to the caller's items>*/
+
+    for(i = 0; i < space; ++i)
+    {
+        ring_ptr->slots_ptr[(head + i) & ring_ptr->mask] = items_ptr[i];
+    } /*for: <Copy the burst in>*/
+
+    if(space)
+    {
+        ZAJEL_ATOMIC_STORE_RELEASE(&ring_ptr->head, head + space);
+    } /*if: <Publish the burst to the consumer>*/
+
+    return space;
+} /*function: zajel_ring_push_burst*/
+
+/***************************************************************************************************
+ *  Name        : zajel_ring_pop_burst
+ *
+ *  Arguments   : zajel_ring_s* ring_ptr,
+ *                void**        items_ptr,
+ *                uint32_t      maxCount
+ *
+ *  Description : Removes up to maxCount items from the ring, must only be called by the consumer
+ *                  thread. The whole burst is released to the producer with a single store.
+ *
+ *  Returns     : uint32_t, number of items removed.
+ **************************************************************************************************/
+STATIC INLINE uint32_t zajel_ring_pop_burst(zajel_ring_s*   ring_ptr,
+                                            void**          items_ptr,
+                                            uint32_t        maxCount)
+{
+    uint32_t tail;
+    uint32_t available;
+    uint32_t i;
+
+    tail        = ring_ptr->tail;
+    available   = ring_ptr->cachedHead - tail;
+
+    if(available < maxCount)
+    {
+        /*<Not enough items seen, refresh the cached head>*/
+        ring_ptr->cachedHead    = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ring_ptr->head);
+        available               = ring_ptr->cachedHead - tail;
+    } /*if: <Not enough items seen, refresh the cached head>*/
+
+    if(available > maxCount)
+    {
+        available = maxCount;
+    } /*if: <Limit the burst to the caller's buffer>*/
+
+    for(i = 0; i < available; ++i)
+    {
+        items_ptr[i] = ring_ptr->slots_ptr[(tail + i) & ring_ptr->mask];
+    } /*for: <Copy the burst out>*/
+
+    if(available)
+    {
+        ZAJEL_ATOMIC_STORE_RELEASE(&ring_ptr->tail, tail + available);
+    } /*if: <Release the consumed slots to the producer>*/
+
+    return available;
+} /*function: zajel_ring_pop_burst*/
+
+#endif /* ZAJEL_RING_H_ */
@@ -0,0 +1,1000 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /*__linux__*/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "zajel_shm.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Written last by the creator, tells the attaching processes that the region is initialized*/
+#define ZAJEL_SHM_MAGIC                     (0x7A6A6C31)
+
+/*Maximum length of the region name (terminator included)*/
+#define ZAJEL_SHM_NAME_LENGTH               (64)
+
+/*Number of size classes of the shared heap (64 bytes up to 128KB), and the size of the smallest blocks (header included)*/
+#define ZAJEL_SHM_SIZE_CLASS_COUNT          (12)
+#define ZAJEL_SHM_SMALLEST_BLOCK_SIZE       (64)
+
+/*Marks an offset pushed in a ring as a copy made by the transport, released once delivered*/
+#define ZAJEL_SHM_COPY_FLAG                 (1)
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_SHM_OFFSET_TO_POINTER / ZAJEL_SHM_POINTER_TO_OFFSET
+ *
+ *  Arguments   : shm_ptr, offset / shm_ptr, pointer
+ *
+ *  Description : These macros translate between the offsets stored in the region, and the addresses
+ *                  of the local mapping.
+ *
+ *  Returns     : void* / uint32_t.
+ **************************************************************************************************/
+#define ZAJEL_SHM_OFFSET_TO_POINTER(shm_ptr, offset)    ((void*)((shm_ptr)->base_ptr + (offset)))
+#define ZAJEL_SHM_POINTER_TO_OFFSET(shm_ptr, pointer)   ((uint32_t)((uint8_t*)(pointer) - (shm_ptr)->base_ptr))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_SHM_IS_IN_HEAP
+ *
+ *  Arguments   : shm_ptr, pointer
+ *
+ *  Description : This macro checks whether the given address belongs to the local mapping of the
+ *                  shared heap.
+ *
+ *  Returns     : bool_t.
+ **************************************************************************************************/
+#define ZAJEL_SHM_IS_IN_HEAP(shm_ptr, pointer)                                                     \
+    (((uint8_t*)(pointer) >= ((shm_ptr)->base_ptr + (shm_ptr)->heapOffset)) &&                      \
+     ((uint8_t*)(pointer) <  ((shm_ptr)->base_ptr + (shm_ptr)->regionSize)))
+
+/***************************************************************************************************
+ *  Macro Name  : ZAJEL_SHM_RING
+ *
+ *  Arguments   : shm_ptr, sourceCoreID, destinationCoreID
+ *
+ *  Description : This macro gets the ring carrying the messages from the source to the destination core.
+ *
+ *  Returns     : zajel_shm_ring_s*.
+ **************************************************************************************************/
+#define ZAJEL_SHM_RING(shm_ptr, sourceCoreID, destinationCoreID)                                   \
+    ((zajel_shm_ring_s*)((shm_ptr)->base_ptr + (shm_ptr)->header_ptr->ringsOffset +                 \
+                         ((((sourceCoreID) * (shm_ptr)->header_ptr->coreCount) + (destinationCoreID)) * \
+                          (shm_ptr)->header_ptr->ringSize)))
+
+/*Gets the slots following the given ring*/
+#define ZAJEL_SHM_RING_SLOTS(ring_ptr)      ((zajel_shm_slot_s*)((ring_ptr) + 1))
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_shm_header_s
+ *
+ * Structure Description:
+ * Starts the shared region, the fields written by all the cores live on their own cache lines. Each
+ * free list head is an offset tagged (upper half) with a counter bumped on every change, so that a
+ * block popped and pushed back in between by another core cannot fool a compare-and-swap.
+ **************************************************************************************************/
+typedef struct zajel_shm_header
+{
+    uint32_t    magic;
+    uint32_t    coreCount;
+    uint32_t    ringCapacity;
+    /*Size of a ring, slots included*/
+    uint32_t    ringSize;
+    uint32_t    ringsOffset;
+    uint32_t    heapOffset;
+    uint32_t    regionSize;
+    /*Offset of the heap part that was never allocated*/
+    uint32_t    heapTop                                         ZAJEL_CACHE_ALIGNED;
+    uint64_t    freeListArray[ZAJEL_SHM_SIZE_CLASS_COUNT]       ZAJEL_CACHE_ALIGNED;
+} zajel_shm_header_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_shm_slot_s
+ *
+ * Structure Description:
+ * A ring slot, its sequence tells the producers whether it is free for the current lap, and the
+ * consumer whether it was filled.
+ **************************************************************************************************/
+typedef struct zajel_shm_slot
+{
+    uint32_t    sequence;
+    uint32_t    offset;
+} zajel_shm_slot_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_shm_ring_s
+ *
+ * Structure Description:
+ * A bounded multi-producer/single-consumer ring of offsets, followed by its slots. The producers
+ * (all the threads of the source core) claim the slots by advancing the head, the consumer (the
+ * dispatching thread of the destination core) owns the tail.
+ *
+ * The producers first take a credit, one per message, and the consumer gives it back once the
+ * message is off the ring. A producer never claims a slot that is not free, so the ones running
+ * out of credits wait on their own cache line rather than on the slots of the destination core.
+ **************************************************************************************************/
+typedef struct zajel_shm_ring
+{
+    uint32_t    credits                     ZAJEL_CACHE_ALIGNED;
+    uint32_t    head                        ZAJEL_CACHE_ALIGNED;
+    uint32_t    tail                        ZAJEL_CACHE_ALIGNED;
+    /*Capacity - 1, read-only after initialization*/
+    uint32_t    mask                        ZAJEL_CACHE_ALIGNED;
+} zajel_shm_ring_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_shm_block_header_s
+ *
+ * Structure Description:
+ * Precedes every block of the shared heap, the padding keeps the message 16 bytes aligned.
+ **************************************************************************************************/
+typedef struct zajel_shm_block_header
+{
+    /*Offset of the next free block of the same size class, only meaningful while free*/
+    uint32_t    nextOffset;
+    uint32_t    sizeClass;
+    uint32_t    reserved[2];
+} zajel_shm_block_header_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_shm_port_s
+ *
+ * Structure Description:
+ * Leads from the local core to a destination core, used as the route context of zajel_shm_push.
+ **************************************************************************************************/
+typedef struct zajel_shm_port
+{
+    zajel_shm_s*        shm_ptr;
+    zajel_shm_ring_s*   ring_ptr;
+} zajel_shm_port_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_shm_s
+ *
+ * Structure Description:
+ * The local (per process) handle of a shared region, followed by its ports.
+ **************************************************************************************************/
+struct zajel_shm
+{
+    uint8_t*                base_ptr;
+    zajel_shm_header_s*     header_ptr;
+    /*Local copies of the read-only header fields*/
+    uint32_t                heapOffset;
+    uint32_t                regionSize;
+    uint32_t                localCoreID;
+    /*Next source core to be drained by zajel_shm_dispatch*/
+    uint32_t                pollCursor;
+    int                     fd;
+    bool_t                  isOwner;
+    char                    name[ZAJEL_SHM_NAME_LENGTH];
+    zajel_shm_port_s*       portArray_ptr;
+};
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_handle_create
+ *
+ *  Arguments   : zajel_shm_s**         shmPointer_ptr,
+ *                void*                 base_ptr,
+ *                int                   fd,
+ *                const char*           name_ptr,
+ *                uint32_t              localCoreID,
+ *                bool_t                isOwner,
+ *                allocation_function   allocationFunction_ptr
+ *
+ *  Description : Allocates and fills the local handle of the given (initialized) mapping.
+ *
+ *  Returns     : bool_t, FALSE if the allocation function failed.
+ **************************************************************************************************/
+STATIC bool_t zajel_shm_handle_create(zajel_shm_s**         shmPointer_ptr,
+                                      void*                 base_ptr,
+                                      int                   fd,
+                                      const char*           name_ptr,
+                                      uint32_t              localCoreID,
+                                      bool_t                isOwner,
+                                      allocation_function   allocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_ring_pop
+ *
+ *  Arguments   : zajel_shm_ring_s* ring_ptr,
+ *                uint32_t*         offset_ptr
+ *
+ *  Description : Removes the oldest offset from the given ring, must only be called by the consumer.
+ *
+ *  Returns     : bool_t, FALSE if the ring is empty.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_shm_ring_pop(zajel_shm_ring_s*   ring_ptr,
+                                        uint32_t*           offset_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_ring_push
+ *
+ *  Arguments   : zajel_shm_ring_s* ring_ptr,
+ *                uint32_t          offset
+ *
+ *  Description : Appends the given offset to the ring, the caller shall hold a credit of the ring.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_shm_ring_push(zajel_shm_ring_s*    ring_ptr,
+                                       uint32_t             offset);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_credit_take
+ *
+ *  Arguments   : zajel_shm_ring_s* ring_ptr
+ *
+ *  Description : Takes a credit of the given ring, without waiting.
+ *
+ *  Returns     : bool_t, FALSE if the source core has no credits left.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_shm_credit_take(zajel_shm_ring_s* ring_ptr);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+zajel_status_e zajel_shm_create(zajel_shm_s**       shmPointer_ptr,
+                                const char*         name_ptr,
+                                uint32_t            coreCount,
+                                uint32_t            localCoreID,
+                                uint32_t            ringCapacity,
+                                uint32_t            heapSize,
+                                allocation_function allocationFunction_ptr)
+{
+#ifdef __linux__
+    zajel_shm_header_s* header_ptr;
+    zajel_shm_ring_s*   ring_ptr;
+    zajel_shm_slot_s*   slot_ptr;
+    void*               base_ptr;
+    uint64_t            ringsOffset;
+    uint64_t            ringSize;
+    uint64_t            heapOffset;
+    uint64_t            regionSize;
+    int                 fd;
+    /*Temporary counters*/
+    uint32_t            i;
+    uint32_t            j;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Validating inputs, and laying out the region.
+     * o Creating and mapping the region.
+     * o Initializing the rings and the heap, then publishing the region with its magic.
+     */
+    ASSERT((NULL != shmPointer_ptr),
+           "zajel: Invalid pointer to the shared memory handle!",
+           __FILE__,
+           __LINE__);
+    ASSERT((NULL != allocationFunction_ptr),
+           "zajel: Invalid allocation function!",
+           __FILE__,
+           __LINE__);
+
+    if((0 == coreCount) || (localCoreID >= coreCount) || (coreCount > ZAJEL_MAX_CORE_COUNT) ||
+       (ringCapacity < 2) || (ringCapacity & (ringCapacity - 1)) ||
+       ((NULL != name_ptr) && (strlen(name_ptr) >= ZAJEL_SHM_NAME_LENGTH)))
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Invalid layout>*/
+
+    ringsOffset = ZAJEL_CACHE_ALIGN_UP((uint64_t)sizeof(zajel_shm_header_s));
+    ringSize    = ZAJEL_CACHE_ALIGN_UP((uint64_t)sizeof(zajel_shm_ring_s) +
+                                       ((uint64_t)sizeof(zajel_shm_slot_s) * ringCapacity));
+    heapOffset  = ringsOffset + (ringSize * coreCount * coreCount);
+    regionSize  = heapOffset + ZAJEL_CACHE_ALIGN_UP((uint64_t)heapSize);
+
+    if(regionSize > UINT32_MAX)
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Offsets are 32 bits wide>*/
+
+    if(NULL != name_ptr)
+    {
+        fd = shm_open(name_ptr,
+                      O_CREAT | O_EXCL | O_RDWR,
+                      0600);
+    } /*if: <Named region>*/
+    else
+    {
+        fd = memfd_create("zajel",
+                          0);
+    } /*else: <Anonymous region>*/
+
+    if(fd < 0)
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Region could not be created>*/
+
+    base_ptr = MAP_FAILED;
+
+    if(0 == ftruncate(fd,
+                      (off_t)regionSize))
+    {
+        base_ptr = mmap(NULL,
+                        (size_t)regionSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd,
+                        0);
+    } /*if: <Region sized (and zeroed)>*/
+
+    if(MAP_FAILED == base_ptr)
+    {
+        close(fd);
+
+        if(NULL != name_ptr)
+        {
+            shm_unlink(name_ptr);
+        } /*if: <Remove the name>*/
+
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Region could not be mapped>*/
+
+    header_ptr                  = (zajel_shm_header_s*) base_ptr;
+    header_ptr->coreCount       = coreCount;
+    header_ptr->ringCapacity    = ringCapacity;
+    header_ptr->ringSize        = (uint32_t)ringSize;
+    header_ptr->ringsOffset     = (uint32_t)ringsOffset;
+    header_ptr->heapOffset      = (uint32_t)heapOffset;
+    header_ptr->regionSize      = (uint32_t)regionSize;
+    header_ptr->heapTop         = (uint32_t)heapOffset;
+
+    for(i = 0; i < (coreCount * coreCount); ++i)
+    {
+        /*<Initialize every ring, each slot is free for the first lap>*/
+        ring_ptr            = (zajel_shm_ring_s*)((uint8_t*)base_ptr + ringsOffset + (ringSize * i));
+        ring_ptr->mask      = ringCapacity - 1;
+        ring_ptr->credits   = ringCapacity;
+        slot_ptr        = ZAJEL_SHM_RING_SLOTS(ring_ptr);
+
+        for(j = 0; j < ringCapacity; ++j)
+        {
+            slot_ptr[j].sequence = j;
+        } /*for: <Initialize the slots>*/
+    } /*for: <Initialize every ring, each slot is free for the first lap>*/
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&header_ptr->magic, ZAJEL_SHM_MAGIC);
+
+    if(FALSE == zajel_shm_handle_create(shmPointer_ptr,
+                                        base_ptr,
+                                        fd,
+                                        name_ptr,
+                                        localCoreID,
+                                        TRUE,
+                                        allocationFunction_ptr))
+    {
+        munmap(base_ptr,
+               (size_t)regionSize);
+        close(fd);
+
+        if(NULL != name_ptr)
+        {
+            shm_unlink(name_ptr);
+        } /*if: <Remove the name>*/
+
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Local handle could not be allocated>*/
+
+    return ZAJEL_STATUS_SUCCESS;
+#else
+    (void)shmPointer_ptr;
+    (void)name_ptr;
+    (void)coreCount;
+    (void)localCoreID;
+    (void)ringCapacity;
+    (void)heapSize;
+    (void)allocationFunction_ptr;
+
+    return ZAJEL_STATUS_FAILURE;
+#endif /*__linux__*/
+} /*function: zajel_shm_create*/
+
+zajel_status_e zajel_shm_attach(zajel_shm_s**       shmPointer_ptr,
+                                const char*         name_ptr,
+                                int                 fd,
+                                uint32_t            localCoreID,
+                                allocation_function allocationFunction_ptr)
+{
+#ifdef __linux__
+    zajel_shm_header_s* header_ptr;
+    void*               base_ptr;
+    struct stat         status;
+
+    ASSERT((NULL != shmPointer_ptr),
+           "zajel: Invalid pointer to the shared memory handle!",
+           __FILE__,
+           __LINE__);
+    ASSERT((NULL != allocationFunction_ptr),
+           "zajel: Invalid allocation function!",
+           __FILE__,
+           __LINE__);
+
+    if((NULL != name_ptr) && (strlen(name_ptr) >= ZAJEL_SHM_NAME_LENGTH))
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Name is too long>*/
+
+    if(NULL != name_ptr)
+    {
+        fd = shm_open(name_ptr,
+                      O_RDWR,
+                      0);
+    } /*if: <Named region>*/
+
+    if(fd < 0)
+    {
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Region does not exist>*/
+
+    base_ptr = MAP_FAILED;
+
+    if((0 == fstat(fd,
+                   &status)) &&
+       (status.st_size >= (off_t)sizeof(zajel_shm_header_s)))
+    {
+        base_ptr = mmap(NULL,
+                        (size_t)status.st_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd,
+                        0);
+    } /*if: <Region is big enough to hold a header>*/
+
+    if(MAP_FAILED == base_ptr)
+    {
+        if(NULL != name_ptr)
+        {
+            close(fd);
+        } /*if: <Descriptor was opened here>*/
+
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Region could not be mapped>*/
+
+    header_ptr = (zajel_shm_header_s*) base_ptr;
+
+    if((ZAJEL_SHM_MAGIC != ZAJEL_ATOMIC_LOAD_ACQUIRE(&header_ptr->magic)) ||
+       (header_ptr->regionSize != (uint64_t)status.st_size) ||
+       (localCoreID >= header_ptr->coreCount) ||
+       (FALSE == zajel_shm_handle_create(shmPointer_ptr,
+                                         base_ptr,
+                                         fd,
+                                         NULL,
+                                         localCoreID,
+                                         FALSE,
+                                         allocationFunction_ptr)))
+    {
+        munmap(base_ptr,
+               (size_t)status.st_size);
+
+        if(NULL != name_ptr)
+        {
+            close(fd);
+        } /*if: <Descriptor was opened here>*/
+
+        return ZAJEL_STATUS_FAILURE;
+    } /*if: <Region not initialized yet, or not matching>*/
+
+    return ZAJEL_STATUS_SUCCESS;
+#else
+    (void)shmPointer_ptr;
+    (void)name_ptr;
+    (void)fd;
+    (void)localCoreID;
+    (void)allocationFunction_ptr;
+
+    return ZAJEL_STATUS_FAILURE;
+#endif /*__linux__*/
+} /*function: zajel_shm_attach*/
+
+void zajel_shm_detach(zajel_shm_s**                 shmPointer_ptr,
+                      zajel_deallocation_function   deallocationFunction_ptr)
+{
+    zajel_shm_s* shm_ptr;
+
+    ASSERT((NULL != shmPointer_ptr),
+           "zajel: Invalid pointer to the shared memory handle!",
+           __FILE__,
+           __LINE__);
+
+    shm_ptr = *shmPointer_ptr;
+
+    if(NULL == shm_ptr)
+    {
+        return;
+    } /*if: <Nothing to detach>*/
+
+#ifdef __linux__
+    munmap(shm_ptr->base_ptr,
+           shm_ptr->regionSize);
+    close(shm_ptr->fd);
+
+    if((TRUE == shm_ptr->isOwner) && (0 != shm_ptr->name[0]))
+    {
+        shm_unlink(shm_ptr->name);
+    } /*if: <Creator removes the name>*/
+#endif /*__linux__*/
+
+    deallocationFunction_ptr(shm_ptr);
+    *shmPointer_ptr = NULL;
+} /*function: zajel_shm_detach*/
+
+int zajel_shm_get_fd(zajel_shm_s* shm_ptr)
+{
+    return shm_ptr->fd;
+} /*function: zajel_shm_get_fd*/
+
+uint32_t zajel_shm_get_core_count(zajel_shm_s* shm_ptr)
+{
+    return shm_ptr->header_ptr->coreCount;
+} /*function: zajel_shm_get_core_count*/
+
+uint32_t zajel_shm_get_offset(zajel_shm_s*  shm_ptr,
+                              void*         message_ptr)
+{
+    ASSERT(ZAJEL_SHM_IS_IN_HEAP(shm_ptr, message_ptr),
+           "zajel: The message was not allocated from the shared heap!",
+           __FILE__,
+           __LINE__);
+
+    return ZAJEL_SHM_POINTER_TO_OFFSET(shm_ptr,
+                                       message_ptr);
+} /*function: zajel_shm_get_offset*/
+
+void* zajel_shm_get_pointer(zajel_shm_s*    shm_ptr,
+                            uint32_t        offset)
+{
+    return ZAJEL_SHM_OFFSET_TO_POINTER(shm_ptr,
+                                       offset);
+} /*function: zajel_shm_get_pointer*/
+
+void* zajel_shm_message_alloc(zajel_shm_s*  shm_ptr,
+                              uint32_t      size)
+{
+    zajel_shm_header_s*         header_ptr;
+    zajel_shm_block_header_s*   block_ptr;
+    uint64_t                    head;
+    uint64_t                    newHead;
+    uint32_t                    top;
+    uint32_t                    blockSize;
+    uint32_t                    sizeClass;
+
+    header_ptr  = shm_ptr->header_ptr;
+    blockSize   = ZAJEL_SHM_SMALLEST_BLOCK_SIZE;
+
+    for(sizeClass = 0; (size + sizeof(zajel_shm_block_header_s)) > blockSize; ++sizeClass)
+    {
+        if((ZAJEL_SHM_SIZE_CLASS_COUNT - 1) == sizeClass)
+        {
+            return NULL;
+        } /*if: <Bigger than the biggest size class>*/
+
+        blockSize <<= 1;
+    } /*for: <Find the smallest fitting size class>*/
+
+    head = ZAJEL_ATOMIC_LOAD(&header_ptr->freeListArray[sizeClass]);
+
+    while((uint32_t)head)
+    {
+        /*<Pop a free block, a stale next offset is caught by the tag>*/
+        block_ptr   = (zajel_shm_block_header_s*) ZAJEL_SHM_OFFSET_TO_POINTER(shm_ptr,
+                                                                              (uint32_t)head);
+        newHead     = (((head >> 32) + 1) << 32) | ZAJEL_ATOMIC_LOAD_RELAXED(&block_ptr->nextOffset);
+
+        if(ZAJEL_ATOMIC_CAS(&header_ptr->freeListArray[sizeClass],
+                            &head,
+                            newHead))
+        {
+            return (void*)(block_ptr + 1);
+        } /*if: <Block popped>*/
+    } /*while: <Pop a free block, a stale next offset is caught by the tag>*/
+
+    top = ZAJEL_ATOMIC_LOAD(&header_ptr->heapTop);
+
+    do
+    {
+        /*<Carve a new block out of the untouched heap part>*/
+        if((shm_ptr->regionSize - top) < blockSize)
+        {
+            return NULL;
+        } /*if: <Heap exhausted>*/
+    } while(!ZAJEL_ATOMIC_CAS(&header_ptr->heapTop,
+                              &top,
+                              top + blockSize)); /*do: <Carve a new block out of the untouched heap part>*/
+
+    block_ptr               = (zajel_shm_block_header_s*) ZAJEL_SHM_OFFSET_TO_POINTER(shm_ptr,
+                                                                                      top);
+    block_ptr->sizeClass    = sizeClass;
+
+    return (void*)(block_ptr + 1);
+} /*function: zajel_shm_message_alloc*/
+
+void zajel_shm_message_free(zajel_shm_s*    shm_ptr,
+                            void*           message_ptr)
+{
+    zajel_shm_header_s*         header_ptr;
+    zajel_shm_block_header_s*   block_ptr;
+    uint64_t                    head;
+    uint64_t                    newHead;
+    uint32_t                    offset;
+
+    ASSERT(ZAJEL_SHM_IS_IN_HEAP(shm_ptr, message_ptr),
+           "zajel: The message was not allocated from the shared heap!",
+           __FILE__,
+           __LINE__);
+
+    header_ptr  = shm_ptr->header_ptr;
+    block_ptr   = ((zajel_shm_block_header_s*) message_ptr) - 1;
+    offset      = ZAJEL_SHM_POINTER_TO_OFFSET(shm_ptr,
+                                              block_ptr);
+    head        = ZAJEL_ATOMIC_LOAD(&header_ptr->freeListArray[block_ptr->sizeClass]);
+
+    do
+    {
+        /*<Push the block on its size class free list>*/
+        ZAJEL_ATOMIC_STORE_RELAXED(&block_ptr->nextOffset, (uint32_t)head);
+        newHead = (((head >> 32) + 1) << 32) | offset;
+    } while(!ZAJEL_ATOMIC_CAS(&header_ptr->freeListArray[block_ptr->sizeClass],
+                              &head,
+                              newHead)); /*do: <Push the block on its size class free list>*/
+} /*function: zajel_shm_message_free*/
+
+void* zajel_shm_get_port(zajel_shm_s*   shm_ptr,
+                         uint32_t       destinationCoreID)
+{
+    ASSERT((destinationCoreID < shm_ptr->header_ptr->coreCount),
+           "zajel: Destination core ID is greater than the shared region core count!",
+           __FILE__,
+           __LINE__);
+
+    return &shm_ptr->portArray_ptr[destinationCoreID];
+} /*function: zajel_shm_get_port*/
+
+void zajel_shm_push(void*                       port_ptr,
+                    zajel_message_descriptor_s* descriptor_ptr)
+{
+    zajel_shm_s*        shm_ptr;
+    zajel_shm_ring_s*   ring_ptr;
+    void*               copy_ptr;
+    uint32_t            size;
+    uint32_t            offset;
+
+    shm_ptr     = ((zajel_shm_port_s*) port_ptr)->shm_ptr;
+    ring_ptr    = ((zajel_shm_port_s*) port_ptr)->ring_ptr;
+
+    while(FALSE == zajel_shm_credit_take(ring_ptr))
+    {
+        ZAJEL_CPU_RELAX();
+    } /*while: <Wait for the destination core to give some credits back>*/
+
+    if(ZAJEL_LIKELY(ZAJEL_SHM_IS_IN_HEAP(shm_ptr, descriptor_ptr)))
+    {
+        /*<Message lives in the shared heap, pass its offset>*/
+        offset = ZAJEL_SHM_POINTER_TO_OFFSET(shm_ptr,
+                                             descriptor_ptr);
+    } /*if: <Message lives in the shared heap, pass its offset>*/
+    else
+    {
+        /*<Acknowledgment built by the framework, copy it to the shared heap>*/
+        ASSERT((ZAJEL_ACK_MESSAGE_ID == descriptor_ptr->messageID),
+               "zajel: Only messages allocated from the shared heap can be sent to another core!",
+               __FILE__,
+               __LINE__);
+
+        size = (descriptor_ptr->flags & ZAJEL_MESSAGE_FLAG_CALL) ?
+               ((uint32_t)ZAJEL_CALL_REPLY_MESSAGE_SIZE((zajel_call_reply_s*) descriptor_ptr)) :
+               ((uint32_t)sizeof(zajel_message_descriptor_s));
+
+        while(NULL == (copy_ptr = zajel_shm_message_alloc(shm_ptr,
+                                                          size)))
+        {
+            ZAJEL_CPU_RELAX();
+        } /*while: <Wait for the receivers to release some blocks>*/
+
+        memcpy(copy_ptr,
+               descriptor_ptr,
+               size);
+        offset = ZAJEL_SHM_POINTER_TO_OFFSET(shm_ptr,
+                                             copy_ptr) | ZAJEL_SHM_COPY_FLAG;
+    } /*else: <Acknowledgment built by the framework, copy it to the shared heap>*/
+
+    zajel_shm_ring_push(ring_ptr,
+                        offset);
+} /*function: zajel_shm_push*/
+
+bool_t zajel_shm_try_push(void*                         port_ptr,
+                          zajel_message_descriptor_s*   descriptor_ptr)
+{
+    zajel_shm_s*        shm_ptr;
+    zajel_shm_ring_s*   ring_ptr;
+
+    shm_ptr     = ((zajel_shm_port_s*) port_ptr)->shm_ptr;
+    ring_ptr    = ((zajel_shm_port_s*) port_ptr)->ring_ptr;
+
+    ASSERT((ZAJEL_SHM_IS_IN_HEAP(shm_ptr, descriptor_ptr)),
+           "zajel: Only messages allocated from the shared heap can be sent to another core!",
+           __FILE__,
+           __LINE__);
+
+    if(FALSE == zajel_shm_credit_take(ring_ptr))
+    {
+        return FALSE;
+    } /*if: <Destination core did not give enough credits back>*/
+
+    zajel_shm_ring_push(ring_ptr,
+                        ZAJEL_SHM_POINTER_TO_OFFSET(shm_ptr,
+                                                    descriptor_ptr));
+
+    return TRUE;
+} /*function: zajel_shm_try_push*/
+
+uint32_t zajel_shm_dispatch(zajel_shm_s*    shm_ptr,
+                            zajel_s*        zajel_ptr,
+                            uint32_t        callerThreadID,
+                            uint32_t        budget)
+{
+    void*       message_ptr;
+    uint32_t    coreCount;
+    uint32_t    sourceCoreID;
+    uint32_t    offset;
+    uint32_t    delivered;
+    uint32_t    idleCount;
+
+    /*
+     * This function is responsible for:
+     ***********************************************************************************************
+     *
+     * o Taking one message at a time from each source core in turn, so that a busy core cannot
+     *   starve the others, until a whole round finds all the rings empty.
+     * o Delivering each message in place, and releasing the copies made by the transport.
+     */
+    coreCount   = shm_ptr->header_ptr->coreCount;
+    delivered   = 0;
+    idleCount   = 0;
+
+    while((delivered < budget) && (idleCount < coreCount))
+    {
+        /*<Drain the rings coming from the other cores>*/
+        sourceCoreID        = shm_ptr->pollCursor;
+        shm_ptr->pollCursor = ((sourceCoreID + 1) == coreCount) ? (0) : (sourceCoreID + 1);
+
+        if((sourceCoreID == shm_ptr->localCoreID) ||
+           (FALSE == zajel_shm_ring_pop(ZAJEL_SHM_RING(shm_ptr,
+                                                      sourceCoreID,
+                                                      shm_ptr->localCoreID),
+                                        &offset)))
+        {
+            ++idleCount;
+            continue;
+        } /*if: <Nothing from this core>*/
+
+        message_ptr = ZAJEL_SHM_OFFSET_TO_POINTER(shm_ptr,
+                                                  offset & ~(uint32_t)ZAJEL_SHM_COPY_FLAG);
+
+        zajel_deliver(zajel_ptr,
+                      message_ptr,
+                      callerThreadID COMMA()
+                      FILE_AND_LINE_FOR_REF());
+
+        if(offset & ZAJEL_SHM_COPY_FLAG)
+        {
+            zajel_shm_message_free(shm_ptr,
+                                   message_ptr);
+        } /*if: <Copy made by the transport>*/
+
+        ++delivered;
+        idleCount = 0;
+    } /*while: <Drain the rings coming from the other cores>*/
+
+    return delivered;
+} /*function: zajel_shm_dispatch*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC bool_t zajel_shm_handle_create(zajel_shm_s**         shmPointer_ptr,
+                                      void*                 base_ptr,
+                                      int                   fd,
+                                      const char*           name_ptr,
+                                      uint32_t              localCoreID,
+                                      bool_t                isOwner,
+                                      allocation_function   allocationFunction_ptr)
+{
+    zajel_shm_s*        shm_ptr;
+    zajel_shm_header_s* header_ptr;
+    /*Temporary counter*/
+    uint32_t            i;
+
+    header_ptr  = (zajel_shm_header_s*) base_ptr;
+    shm_ptr     = (zajel_shm_s*) allocationFunction_ptr(sizeof(zajel_shm_s) +
+                                                        (sizeof(zajel_shm_port_s) * header_ptr->coreCount));
+
+    if(NULL == shm_ptr)
+    {
+        return FALSE;
+    } /*if: <Allocation failed>*/
+
+    shm_ptr->base_ptr       = (uint8_t*) base_ptr;
+    shm_ptr->header_ptr     = header_ptr;
+    shm_ptr->heapOffset     = header_ptr->heapOffset;
+    shm_ptr->regionSize     = header_ptr->regionSize;
+    shm_ptr->localCoreID    = localCoreID;
+    shm_ptr->pollCursor     = 0;
+    shm_ptr->fd             = fd;
+    shm_ptr->isOwner        = isOwner;
+    shm_ptr->name[0]        = 0;
+    shm_ptr->portArray_ptr  = (zajel_shm_port_s*)(shm_ptr + 1);
+
+    if(NULL != name_ptr)
+    {
+        strcpy(shm_ptr->name,
+               name_ptr);
+    } /*if: <Keep the name, to be removed by the creator>*/
+
+    for(i = 0; i < header_ptr->coreCount; ++i)
+    {
+        /*<Resolve the ports leading from the local core>*/
+        shm_ptr->portArray_ptr[i].shm_ptr   = shm_ptr;
+        shm_ptr->portArray_ptr[i].ring_ptr  = ZAJEL_SHM_RING(shm_ptr,
+                                                             localCoreID,
+                                                             i);
+    } /*for: <Resolve the ports leading from the local core>*/
+
+    *shmPointer_ptr = shm_ptr;
+
+    return TRUE;
+} /*function: zajel_shm_handle_create*/
+
+STATIC INLINE bool_t zajel_shm_ring_pop(zajel_shm_ring_s*   ring_ptr,
+                                        uint32_t*           offset_ptr)
+{
+    zajel_shm_slot_s*   slot_ptr;
+    uint32_t            position;
+
+    position = ring_ptr->tail;
+    slot_ptr = &ZAJEL_SHM_RING_SLOTS(ring_ptr)[position & ring_ptr->mask];
+
+    if(ZAJEL_ATOMIC_LOAD_ACQUIRE(&slot_ptr->sequence) != (position + 1))
+    {
+        return FALSE;
+    } /*if: <Ring is empty, or the producer did not finish writing the slot>*/
+
+    *offset_ptr = slot_ptr->offset;
+    ZAJEL_ATOMIC_STORE_RELEASE(&slot_ptr->sequence, position + ring_ptr->mask + 1);
+    ZAJEL_ATOMIC_STORE_RELAXED(&ring_ptr->tail, position + 1);
+
+    /*The slot is free again, give its credit back to the source core*/
+    ZAJEL_ATOMIC_FETCH_ADD(&ring_ptr->credits, 1);
+
+    return TRUE;
+} /*function: zajel_shm_ring_pop*/
+
+STATIC INLINE void zajel_shm_ring_push(zajel_shm_ring_s*    ring_ptr,
+                                       uint32_t             offset)
+{
+    zajel_shm_slot_s*   slot_ptr;
+    uint32_t            position;
+    uint32_t            sequence;
+
+    position = ZAJEL_ATOMIC_LOAD_RELAXED(&ring_ptr->head);
+
+    for(;;)
+    {
+        /*<Claim the slot at the head, the credit makes sure one is free or being freed>*/
+        slot_ptr = &ZAJEL_SHM_RING_SLOTS(ring_ptr)[position & ring_ptr->mask];
+        sequence = ZAJEL_ATOMIC_LOAD_ACQUIRE(&slot_ptr->sequence);
+
+        if(sequence == position)
+        {
+            if(ZAJEL_ATOMIC_CAS(&ring_ptr->head,
+                                &position,
+                                position + 1))
+            {
+                break;
+            } /*if: <Slot claimed>*/
+        } /*if: <Slot is free for this lap>*/
+        else
+        {
+            if((int32_t)(sequence - position) < 0)
+            {
+                ZAJEL_CPU_RELAX();
+            } /*if: <Consumer did not release the slot yet>*/
+
+            position = ZAJEL_ATOMIC_LOAD_RELAXED(&ring_ptr->head);
+        } /*else: <Slot not released yet, or another producer claimed it>*/
+    } /*for: <Claim the slot at the head, the credit makes sure one is free or being freed>*/
+
+    slot_ptr->offset = offset;
+    ZAJEL_ATOMIC_STORE_RELEASE(&slot_ptr->sequence, position + 1);
+} /*function: zajel_shm_ring_push*/
+
+STATIC INLINE bool_t zajel_shm_credit_take(zajel_shm_ring_s* ring_ptr)
+{
+    uint32_t credits;
+
+    credits = ZAJEL_ATOMIC_LOAD_RELAXED(&ring_ptr->credits);
+
+    do
+    {
+        if(0 == credits)
+        {
+            return FALSE;
+        } /*if: <No credits left>*/
+    } while(FALSE == ZAJEL_ATOMIC_CAS(&ring_ptr->credits,
+                                      &credits,
+                                      credits - 1));
+
+    return TRUE;
+} /*function: zajel_shm_credit_take*/
@@ -0,0 +1,270 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * A built-in cross-core transport for deployments where each core runs as a separate process. All
+ * the processes map the same shared region holding:
+ *
+ *  o A bounded multi-producer/single-consumer ring for every ordered pair of cores, guarded by
+ *    credits: a core pushes a message only after taking one of the ring credits, which the
+ *    destination core gives back as it drains the ring.
+ *  o A message heap, made of lock-free size classes.
+ *
+ * The region only holds offsets (never pointers), so it can be mapped at a different address by
+ * each process. A message allocated from the heap crosses cores without being copied: the ring
+ * carries its offset, and the receiving process calls zajel_deliver on the message in place. The
+ * only messages copied are the acknowledgments built on the stack by zajel_acknowledge, the reply
+ * of a zajel_call travels in place too (inside the call message).
+ *
+ * The region is created by one process (named using shm_open, or anonymous using memfd_create and
+ * then inherited by the other processes), and attached by the others. Each process registers the
+ * whole topology in its own control block, enables the transport on it (zajel_enable_shm_transport),
+ * and runs zajel_shm_dispatch from one of its threads. That thread shall not send synchronous
+ * messages to the other cores, as it delivers their acknowledgments. The transport is only
+ * available on Linux, the create/attach functions fail on the other platforms.
+ */
+#ifndef ZAJEL_SHM_H_
+#define ZAJEL_SHM_H_
+
+#include <stdint.h>
+#include "zajel.h"
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_create
+ *
+ *  Arguments   : zajel_shm_s**         shmPointer_ptr,
+ *                const char*           name_ptr,
+ *                uint32_t              coreCount,
+ *                uint32_t              localCoreID,
+ *                uint32_t              ringCapacity,
+ *                uint32_t              heapSize,
+ *                allocation_function   allocationFunction_ptr
+ *
+ *  Description : This function creates and maps a shared region for coreCount cores, with a ring of
+ *                  ringCapacity messages (a power of two) for every ordered pair of cores and a heap
+ *                  of heapSize bytes, the whole region shall fit in 4GB. The region is named name_ptr
+ *                  (see shm_open), or anonymous when name_ptr is NULL, in which case its file
+ *                  descriptor (zajel_shm_get_fd) shall be inherited by the other processes. The
+ *                  local handle is allocated using the given allocation function.
+ *
+ *  Returns     : zajel_status_e.
+ **************************************************************************************************/
+zajel_status_e zajel_shm_create(zajel_shm_s**       shmPointer_ptr,
+                                const char*         name_ptr,
+                                uint32_t            coreCount,
+                                uint32_t            localCoreID,
+                                uint32_t            ringCapacity,
+                                uint32_t            heapSize,
+                                allocation_function allocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_attach
+ *
+ *  Arguments   : zajel_shm_s**         shmPointer_ptr,
+ *                const char*           name_ptr,
+ *                int                   fd,
+ *                uint32_t              localCoreID,
+ *                allocation_function   allocationFunction_ptr
+ *
+ *  Description : This function maps a shared region created by another process, either by name, or
+ *                  using the given (inherited) file descriptor when name_ptr is NULL.
+ *
+ *  Returns     : zajel_status_e, ZAJEL_STATUS_FAILURE if the region is missing or not initialized yet.
+ **************************************************************************************************/
+zajel_status_e zajel_shm_attach(zajel_shm_s**       shmPointer_ptr,
+                                const char*         name_ptr,
+                                int                 fd,
+                                uint32_t            localCoreID,
+                                allocation_function allocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_detach
+ *
+ *  Arguments   : zajel_shm_s**                 shmPointer_ptr,
+ *                zajel_deallocation_function   deallocationFunction_ptr
+ *
+ *  Description : This function unmaps the shared region and releases the local handle, the process
+ *                  which created a named region also removes its name.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_shm_detach(zajel_shm_s**                 shmPointer_ptr,
+                      zajel_deallocation_function   deallocationFunction_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_get_fd
+ *
+ *  Arguments   : zajel_shm_s* shm_ptr
+ *
+ *  Description : This function gets the file descriptor of the shared region.
+ *
+ *  Returns     : int.
+ **************************************************************************************************/
+int zajel_shm_get_fd(zajel_shm_s* shm_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_get_core_count
+ *
+ *  Arguments   : zajel_shm_s* shm_ptr
+ *
+ *  Description : This function gets the number of cores sharing the region.
+ *
+ *  Returns     : uint32_t.
+ **************************************************************************************************/
+uint32_t zajel_shm_get_core_count(zajel_shm_s* shm_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_get_offset
+ *
+ *  Arguments   : zajel_shm_s*  shm_ptr,
+ *                void*         message_ptr
+ *
+ *  Description : This function gets the offset of the given block within the region, the same for
+ *                  all the processes, so that it can be stored in the messages.
+ *
+ *  Returns     : uint32_t.
+ **************************************************************************************************/
+uint32_t zajel_shm_get_offset(zajel_shm_s*  shm_ptr,
+                              void*         message_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_get_pointer
+ *
+ *  Arguments   : zajel_shm_s*  shm_ptr,
+ *                uint32_t      offset
+ *
+ *  Description : This function gets the local address of the block at the given offset.
+ *
+ *  Returns     : void*.
+ **************************************************************************************************/
+void* zajel_shm_get_pointer(zajel_shm_s*    shm_ptr,
+                            uint32_t        offset);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_message_alloc
+ *
+ *  Arguments   : zajel_shm_s*  shm_ptr,
+ *                uint32_t      size
+ *
+ *  Description : This function allocates a message from the shared heap, it can be called by any
+ *                  thread of any process. Only such messages can be sent to another core.
+ *
+ *  Returns     : void*, NULL if the heap is exhausted or size is bigger than the biggest size class
+ *                  (128KB, header included).
+ **************************************************************************************************/
+void* zajel_shm_message_alloc(zajel_shm_s*  shm_ptr,
+                              uint32_t      size);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_message_free
+ *
+ *  Arguments   : zajel_shm_s*  shm_ptr,
+ *                void*         message_ptr
+ *
+ *  Description : This function releases a message allocated by zajel_shm_message_alloc, it can be
+ *                  called by any thread of any process.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_shm_message_free(zajel_shm_s*    shm_ptr,
+                            void*           message_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_get_port
+ *
+ *  Arguments   : zajel_shm_s*  shm_ptr,
+ *                uint32_t      destinationCoreID
+ *
+ *  Description : This function gets the port leading from the local core to the given core, it is
+ *                  used by the framework as the context of zajel_shm_push.
+ *
+ *  Returns     : void*.
+ **************************************************************************************************/
+void* zajel_shm_get_port(zajel_shm_s*   shm_ptr,
+                         uint32_t       destinationCoreID);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_push
+ *
+ *  Arguments   : void*                         port_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : This function passes the given message to the destination core of the given port,
+ *                  spinning while the local core has no credits left for it. The message shall be
+ *                  allocated from the shared heap, unless it is an acknowledgment (which is copied).
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_shm_push(void*                       port_ptr,
+                    zajel_message_descriptor_s* descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_try_push
+ *
+ *  Arguments   : void*                         port_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : This function is the non-blocking variant of zajel_shm_push, used by zajel_try_send.
+ *                  The message shall be allocated from the shared heap.
+ *
+ *  Returns     : bool_t, FALSE (and nothing is sent) if the local core has no credits left for the
+ *                  destination core.
+ **************************************************************************************************/
+bool_t zajel_shm_try_push(void*                         port_ptr,
+                          zajel_message_descriptor_s*   descriptor_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_shm_dispatch
+ *
+ *  Arguments   : zajel_shm_s*  shm_ptr,
+ *                zajel_s*      zajel_ptr,
+ *                uint32_t      callerThreadID,
+ *                uint32_t      budget
+ *
+ *  Description : This function is the receive loop of the local core, it shall be called by a single
+ *                  thread of the local core (callerThreadID). It drains the rings coming from the
+ *                  other cores fairly, passing each message to zajel_deliver in place, and returns
+ *                  once the rings are empty or budget messages were delivered.
+ *
+ *  Returns     : uint32_t, number of messages delivered.
+ **************************************************************************************************/
+uint32_t zajel_shm_dispatch(zajel_shm_s*    shm_ptr,
+                            zajel_s*        zajel_ptr,
+                            uint32_t        callerThreadID,
+                            uint32_t        budget);
+
+#endif /* ZAJEL_SHM_H_ */
@@ -0,0 +1,206 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include "zajel_stats.h"
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_counters_add
+ *
+ *  Arguments   : zajel_stats_counters_s*       total_ptr,
+ *                const zajel_stats_counters_s* counters_ptr
+ *
+ *  Description : Adds the given counters, written by another thread, to the total.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_stats_counters_add(zajel_stats_counters_s*         total_ptr,
+                                            const zajel_stats_counters_s*   counters_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_bucket_bound
+ *
+ *  Arguments   : uint32_t bucket
+ *
+ *  Description : Computes the biggest value falling in the given bucket (see zajel_stats_bucket).
+ *
+ *  Returns     : uint64_t.
+ **************************************************************************************************/
+STATIC INLINE uint64_t zajel_stats_bucket_bound(uint32_t bucket);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+void zajel_stats_merge(const zajel_stats_thread_s*  thread_ptr,
+                       uint32_t                     messageCount,
+                       zajel_stats_s*               stats_ptr,
+                       zajel_stats_counters_s*      messageCounters_array)
+{
+    const zajel_stats_histogram_s*  histogram_ptr;
+    zajel_stats_histogram_s*        total_ptr;
+    uint64_t                        max;
+    /*Temporary counters*/
+    uint32_t                        i;
+    uint32_t                        j;
+
+    for(i = 0; i < ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT; ++i)
+    {
+        /*<Merge each relation>*/
+        zajel_stats_counters_add(&stats_ptr->relationArray[i],
+                                 &thread_ptr->relationArray[i]);
+
+        histogram_ptr   = &thread_ptr->residencyArray[i];
+        total_ptr       = &stats_ptr->residencyArray[i];
+
+        total_ptr->count    += ZAJEL_ATOMIC_LOAD_RELAXED(&histogram_ptr->count);
+        total_ptr->sum      += ZAJEL_ATOMIC_LOAD_RELAXED(&histogram_ptr->sum);
+        max                 = ZAJEL_ATOMIC_LOAD_RELAXED(&histogram_ptr->max);
+
+        if(max > total_ptr->max)
+        {
+            total_ptr->max = max;
+        } /*if: <New maximum>*/
+
+        for(j = 0; j < ZAJEL_STATS_BUCKET_COUNT; ++j)
+        {
+            total_ptr->bucketArray[j] += ZAJEL_ATOMIC_LOAD_RELAXED(&histogram_ptr->bucketArray[j]);
+        } /*for: <Merge each bucket>*/
+    } /*for: <Merge each relation>*/
+
+    if(NULL == messageCounters_array)
+    {
+        return;
+    } /*if: <Message counters are not wanted>*/
+
+    for(i = 0; i < messageCount; ++i)
+    {
+        zajel_stats_counters_add(&messageCounters_array[i],
+                                 &ZAJEL_STATS_MESSAGE_COUNTERS(thread_ptr)[i]);
+    } /*for: <Merge each message ID>*/
+} /*function: zajel_stats_merge*/
+
+uint64_t zajel_stats_percentile(const zajel_stats_histogram_s*  histogram_ptr,
+                                uint32_t                        partsPerMillion)
+{
+    /*Number of values at or below the wanted one*/
+    uint64_t rank;
+    uint64_t count;
+    uint64_t bound;
+    /*Temporary counter*/
+    uint32_t i;
+
+    if(0 == histogram_ptr->count)
+    {
+        return 0;
+    } /*if: <Empty histogram>*/
+
+    if(partsPerMillion > 1000000)
+    {
+        partsPerMillion = 1000000;
+    } /*if: <Beyond the whole histogram>*/
+
+    rank = ((histogram_ptr->count * partsPerMillion) + 999999) / 1000000;
+
+    if(0 == rank)
+    {
+        rank = 1;
+    } /*if: <Smallest value>*/
+
+    count = 0;
+
+    for(i = 0; i < ZAJEL_STATS_BUCKET_COUNT; ++i)
+    {
+        /*<Find the bucket holding the wanted value>*/
+        count += histogram_ptr->bucketArray[i];
+
+        if(count >= rank)
+        {
+            break;
+        } /*if: <Bucket reached>*/
+    } /*for: <Find the bucket holding the wanted value>*/
+
+    if(ZAJEL_STATS_BUCKET_COUNT == i)
+    {
+        /*The buckets were read while being updated*/
+        return histogram_ptr->max;
+    } /*if: <Bucket not reached>*/
+
+    bound = zajel_stats_bucket_bound(i);
+
+    return (bound < histogram_ptr->max) ? (bound) : (histogram_ptr->max);
+} /*function: zajel_stats_percentile*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC INLINE void zajel_stats_counters_add(zajel_stats_counters_s*         total_ptr,
+                                            const zajel_stats_counters_s*   counters_ptr)
+{
+    total_ptr->sendCount    += ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->sendCount);
+    total_ptr->deliverCount += ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->deliverCount);
+    total_ptr->blockCount   += ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->blockCount);
+    total_ptr->blockTime    += ZAJEL_ATOMIC_LOAD_RELAXED(&counters_ptr->blockTime);
+} /*function: zajel_stats_counters_add*/
+
+STATIC INLINE uint64_t zajel_stats_bucket_bound(uint32_t bucket)
+{
+    uint32_t shift;
+
+    if(bucket < (2U << ZAJEL_STATS_SUB_BUCKET_BITS))
+    {
+        return bucket;
+    } /*if: <Bucket of a single value>*/
+
+    if((ZAJEL_STATS_BUCKET_COUNT - 1) == bucket)
+    {
+        return UINT64_MAX;
+    } /*if: <Bucket of the values out of range>*/
+
+    shift = (bucket >> ZAJEL_STATS_SUB_BUCKET_BITS) - 1;
+
+    return ((((uint64_t)((1U << ZAJEL_STATS_SUB_BUCKET_BITS) +
+                         (bucket & ((1U << ZAJEL_STATS_SUB_BUCKET_BITS) - 1)))) + 1) << shift) - 1;
+} /*function: zajel_stats_bucket_bound*/
@@ -0,0 +1,320 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * Per-thread message statistics (see zajel_enable_stats).
+ *
+ * Each thread owns a block of counters, only written by itself, so counting a message needs neither
+ * a lock nor a read-modify-write atomic, and zajel_stats_snapshot reads them as they go. The block
+ * holds the counters per dynamic relation, the residency histograms, then the counters of each
+ * message ID.
+ *
+ * The residency is sampled through a probe leading the block of the destination thread, on its own
+ * cache line: a sender picking a message for sampling installs it there with the sending time (unless
+ * another message is already probed), and the destination thread records the elapsed time when it
+ * runs the probed message. A probe left behind (the message was dropped, or handled by a batch
+ * callback) is replaced once older than ZAJEL_STATS_PROBE_TIMEOUT.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_STATS_H_
+#define ZAJEL_STATS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Age in nanoseconds after which a probe which was never taken back may be replaced*/
+#define ZAJEL_STATS_PROBE_TIMEOUT       (1000000000ULL)
+
+/*The counters of each message ID, following the block of a thread*/
+#define ZAJEL_STATS_MESSAGE_COUNTERS(thread_ptr)                                                   \
+    ((zajel_stats_counters_s*)((thread_ptr) + 1))
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_stats_thread_s
+ *
+ * Structure Description:
+ * The statistics of a single thread, followed by the counters of each message ID.
+ **************************************************************************************************/
+typedef struct zajel_stats_thread
+{
+    /*The sampled message on its way to this thread, NULL if none, installed by the senders*/
+    zajel_message_descriptor_s* probe_ptr                   ZAJEL_CACHE_ALIGNED;
+    /*The time the probed message was sent*/
+    uint64_t                    probeTime;
+    /*Messages sent by this thread, only used to pick the sampled ones*/
+    uint32_t                    sampleCount                 ZAJEL_CACHE_ALIGNED;
+    zajel_stats_counters_s      relationArray[ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT];
+    zajel_stats_histogram_s     residencyArray[ZAJEL_COMPONENT_DYNAMIC_RELATION_COUNT];
+} zajel_stats_thread_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_merge
+ *
+ *  Arguments   : const zajel_stats_thread_s*   thread_ptr,
+ *                uint32_t                      messageCount,
+ *                zajel_stats_s*                stats_ptr,
+ *                zajel_stats_counters_s*       messageCounters_array
+ *
+ *  Description : Adds the statistics of the given thread to stats_ptr, and its counters of each
+ *                  message ID to messageCounters_array (unless NULL). It can be called by any thread.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_stats_merge(const zajel_stats_thread_s*  thread_ptr,
+                       uint32_t                     messageCount,
+                       zajel_stats_s*               stats_ptr,
+                       zajel_stats_counters_s*      messageCounters_array);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_bucket
+ *
+ *  Arguments   : uint64_t value
+ *
+ *  Description : Finds the histogram bucket of the given value: the small values have their own
+ *                  bucket, the others are placed by their highest set bit and the
+ *                  ZAJEL_STATS_SUB_BUCKET_BITS bits following it.
+ *
+ *  Returns     : uint32_t, the bucket index.
+ **************************************************************************************************/
+STATIC INLINE uint32_t zajel_stats_bucket(uint64_t value)
+{
+    /*Index of the highest set bit*/
+    uint32_t magnitude;
+
+    if(value < (1ULL << ZAJEL_STATS_SUB_BUCKET_BITS))
+    {
+        return (uint32_t)value;
+    } /*if: <Small value>*/
+
+    if(value >> ZAJEL_STATS_MAX_VALUE_BITS)
+    {
+        return ZAJEL_STATS_BUCKET_COUNT - 1;
+    } /*if: <Value out of range>*/
+
+    magnitude = 63 - (uint32_t)__builtin_clzll(value);
+
+    return ((magnitude - ZAJEL_STATS_SUB_BUCKET_BITS) << ZAJEL_STATS_SUB_BUCKET_BITS) +
+           (uint32_t)(value >> (magnitude - ZAJEL_STATS_SUB_BUCKET_BITS));
+} /*function: zajel_stats_bucket*/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_record
+ *
+ *  Arguments   : zajel_stats_histogram_s*  histogram_ptr,
+ *                uint64_t                  value
+ *
+ *  Description : Records a value into the given histogram, must only be called by its owner thread.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_stats_record(zajel_stats_histogram_s*  histogram_ptr,
+                                      uint64_t                  value)
+{
+    ZAJEL_COUNTER_INCREMENT(histogram_ptr->bucketArray[zajel_stats_bucket(value)]);
+    ZAJEL_COUNTER_INCREMENT(histogram_ptr->count);
+    ZAJEL_ATOMIC_STORE_RELAXED(&histogram_ptr->sum,
+                               histogram_ptr->sum + value);
+
+    if(value > histogram_ptr->max)
+    {
+        ZAJEL_ATOMIC_STORE_RELAXED(&histogram_ptr->max,
+                                   value);
+    } /*if: <New maximum>*/
+} /*function: zajel_stats_record*/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_count_send
+ *
+ *  Arguments   : zajel_stats_thread_s* thread_ptr,
+ *                uint32_t              messageID,
+ *                uint32_t              relation
+ *
+ *  Description : Counts a message sent by the owner thread of the block.
+ *
+ *  Returns     : bool_t, TRUE if the residency of the message shall be sampled.
+ **************************************************************************************************/
+STATIC INLINE bool_t zajel_stats_count_send(zajel_stats_thread_s*   thread_ptr,
+                                            uint32_t                messageID,
+                                            uint32_t                relation)
+{
+    ZAJEL_COUNTER_INCREMENT(thread_ptr->relationArray[relation].sendCount);
+    ZAJEL_COUNTER_INCREMENT(ZAJEL_STATS_MESSAGE_COUNTERS(thread_ptr)[messageID].sendCount);
+
+    return (0 == (++thread_ptr->sampleCount & (ZAJEL_STATS_SAMPLE_PERIOD - 1)));
+} /*function: zajel_stats_count_send*/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_count_deliver
+ *
+ *  Arguments   : zajel_stats_thread_s* thread_ptr,
+ *                uint32_t              messageID,
+ *                uint32_t              relation
+ *
+ *  Description : Counts a message handled by the owner thread of the block.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_stats_count_deliver(zajel_stats_thread_s*  thread_ptr,
+                                             uint32_t               messageID,
+                                             uint32_t               relation)
+{
+    ZAJEL_COUNTER_INCREMENT(thread_ptr->relationArray[relation].deliverCount);
+    ZAJEL_COUNTER_INCREMENT(ZAJEL_STATS_MESSAGE_COUNTERS(thread_ptr)[messageID].deliverCount);
+} /*function: zajel_stats_count_deliver*/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_count_block
+ *
+ *  Arguments   : zajel_stats_thread_s* thread_ptr,
+ *                uint32_t              messageID,
+ *                uint32_t              relation,
+ *                uint64_t              blockTime
+ *
+ *  Description : Counts the time the owner thread of the block spent waiting on a synchronous message.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_stats_count_block(zajel_stats_thread_s*    thread_ptr,
+                                           uint32_t                 messageID,
+                                           uint32_t                 relation,
+                                           uint64_t                 blockTime)
+{
+    zajel_stats_counters_s* counters_ptr;
+
+    counters_ptr = &thread_ptr->relationArray[relation];
+    ZAJEL_COUNTER_INCREMENT(counters_ptr->blockCount);
+    ZAJEL_ATOMIC_STORE_RELAXED(&counters_ptr->blockTime,
+                               counters_ptr->blockTime + blockTime);
+
+    counters_ptr = &ZAJEL_STATS_MESSAGE_COUNTERS(thread_ptr)[messageID];
+    ZAJEL_COUNTER_INCREMENT(counters_ptr->blockCount);
+    ZAJEL_ATOMIC_STORE_RELAXED(&counters_ptr->blockTime,
+                               counters_ptr->blockTime + blockTime);
+} /*function: zajel_stats_count_block*/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_probe_set
+ *
+ *  Arguments   : zajel_stats_thread_s*         destination_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr
+ *
+ *  Description : Probes the given message on its way to the owner thread of the block, unless another
+ *                  message is already probed, must be called before the message is queued.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_stats_probe_set(zajel_stats_thread_s*          destination_ptr,
+                                         zajel_message_descriptor_s*    descriptor_ptr)
+{
+    zajel_message_descriptor_s* probe_ptr;
+    uint64_t                    now;
+
+    probe_ptr   = ZAJEL_ATOMIC_LOAD_RELAXED(&destination_ptr->probe_ptr);
+    now         = zajel_time_now();
+
+    if((NULL != probe_ptr) &&
+       ((now - ZAJEL_ATOMIC_LOAD_RELAXED(&destination_ptr->probeTime)) < ZAJEL_STATS_PROBE_TIMEOUT))
+    {
+        return;
+    } /*if: <Another message is probed>*/
+
+    if(ZAJEL_ATOMIC_CAS(&destination_ptr->probe_ptr,
+                        &probe_ptr,
+                        descriptor_ptr))
+    {
+        /*The queueing of the message publishes the time to the destination thread*/
+        ZAJEL_ATOMIC_STORE_RELAXED(&destination_ptr->probeTime,
+                                   now);
+    } /*if: <Probe installed>*/
+} /*function: zajel_stats_probe_set*/
+
+/***************************************************************************************************
+ *  Name        : zajel_stats_probe_check
+ *
+ *  Arguments   : zajel_stats_thread_s*         thread_ptr,
+ *                zajel_message_descriptor_s*   descriptor_ptr,
+ *                uint32_t                      relation
+ *
+ *  Description : Records the residency of the given message if it is the one probed, must only be
+ *                  called by the owner thread of the block.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_stats_probe_check(zajel_stats_thread_s*        thread_ptr,
+                                           zajel_message_descriptor_s*  descriptor_ptr,
+                                           uint32_t                     relation)
+{
+    uint64_t probeTime;
+
+    if(ZAJEL_LIKELY(descriptor_ptr != ZAJEL_ATOMIC_LOAD_RELAXED(&thread_ptr->probe_ptr)))
+    {
+        return;
+    } /*if: <Message is not probed>*/
+
+    probeTime = ZAJEL_ATOMIC_LOAD_RELAXED(&thread_ptr->probeTime);
+
+    if(ZAJEL_ATOMIC_CAS(&thread_ptr->probe_ptr,
+                        &descriptor_ptr,
+                        NULL))
+    {
+        zajel_stats_record(&thread_ptr->residencyArray[relation],
+                           zajel_time_now() - probeTime);
+    } /*if: <Probe taken back>*/
+} /*function: zajel_stats_probe_check*/
+
+#endif /* ZAJEL_STATS_H_ */
@@ -0,0 +1,152 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <stddef.h>
+#include "zajel_sync.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Nothing happened since the last block*/
+#define ZAJEL_SYNC_SLOT_STATE_IDLE          (0)
+/*The unblock came before (or while) the block*/
+#define ZAJEL_SYNC_SLOT_STATE_SIGNALED      (1)
+/*The owner is parked on the state word*/
+#define ZAJEL_SYNC_SLOT_STATE_PARKED        (2)
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+void zajel_sync_slot_init(zajel_sync_slot_s* slot_ptr)
+{
+    slot_ptr->state             = ZAJEL_SYNC_SLOT_STATE_IDLE;
+    slot_ptr->spinLimit         = ZAJEL_SYNC_SLOT_INITIAL_SPIN_LIMIT;
+    slot_ptr->spinCompletions   = 0;
+    slot_ptr->parkCompletions   = 0;
+} /*function: zajel_sync_slot_init*/
+
+void zajel_sync_slot_block(void* slot_ptr)
+{
+    zajel_sync_slot_s*  thisSlot_ptr;
+    /*Value of the state word, as found by the last atomic operation*/
+    uint32_t            state;
+    /*Number of spins done so far*/
+    uint32_t            spins;
+
+    thisSlot_ptr = (zajel_sync_slot_s*) slot_ptr;
+
+    for(spins = 0; spins < thisSlot_ptr->spinLimit; ++spins)
+    {
+        /*<Spin, as the acknowledgment might be only a few hundred cycles away>*/
+        if(ZAJEL_SYNC_SLOT_STATE_SIGNALED == ZAJEL_ATOMIC_LOAD_ACQUIRE(&thisSlot_ptr->state))
+        {
+            /*<Completed while spinning, move the limit towards twice what was needed>*/
+            ZAJEL_ATOMIC_STORE_RELAXED(&thisSlot_ptr->state,
+                                       ZAJEL_SYNC_SLOT_STATE_IDLE);
+
+            thisSlot_ptr->spinLimit = ((7 * thisSlot_ptr->spinLimit) + (2 * spins)) / 8;
+
+            if(thisSlot_ptr->spinLimit < ZAJEL_SYNC_SLOT_MIN_SPIN_LIMIT)
+            {
+                thisSlot_ptr->spinLimit = ZAJEL_SYNC_SLOT_MIN_SPIN_LIMIT;
+            } /*if: <Keep the limit above the minimum>*/
+            else if(thisSlot_ptr->spinLimit > ZAJEL_SYNC_SLOT_MAX_SPIN_LIMIT)
+            {
+                thisSlot_ptr->spinLimit = ZAJEL_SYNC_SLOT_MAX_SPIN_LIMIT;
+            } /*else if: <Keep the limit below the maximum, it grows by up to an eighth per message>*/
+
+            ++thisSlot_ptr->spinCompletions;
+
+            return;
+        } /*if: <Completed while spinning, move the limit towards twice what was needed>*/
+
+        ZAJEL_CPU_RELAX();
+    } /*for: <Spin, as the acknowledgment might be only a few hundred cycles away>*/
+
+    state = ZAJEL_SYNC_SLOT_STATE_IDLE;
+
+    if(ZAJEL_ATOMIC_CAS(&thisSlot_ptr->state,
+                        &state,
+                        ZAJEL_SYNC_SLOT_STATE_PARKED))
+    {
+        /*<Still not signaled, park until the unblock>*/
+        while(ZAJEL_SYNC_SLOT_STATE_PARKED == ZAJEL_ATOMIC_LOAD(&thisSlot_ptr->state))
+        {
+            zajel_futex_wait(&thisSlot_ptr->state,
+                             ZAJEL_SYNC_SLOT_STATE_PARKED);
+        } /*while: <Still parked>*/
+
+        /*Spinning was not enough, give up some of it next time*/
+        thisSlot_ptr->spinLimit -= thisSlot_ptr->spinLimit / 4;
+
+        if(thisSlot_ptr->spinLimit < ZAJEL_SYNC_SLOT_MIN_SPIN_LIMIT)
+        {
+            thisSlot_ptr->spinLimit = ZAJEL_SYNC_SLOT_MIN_SPIN_LIMIT;
+        } /*if: <Keep the limit above the minimum>*/
+
+        ++thisSlot_ptr->parkCompletions;
+    } /*if: <Still not signaled, park until the unblock>*/
+    else
+    {
+        /*<Signaled right after the last spin>*/
+        ++thisSlot_ptr->spinCompletions;
+    } /*else: <Signaled right after the last spin>*/
+
+    /*Consume the signal, making the slot ready for the next synchronous message*/
+    ZAJEL_ATOMIC_STORE(&thisSlot_ptr->state,
+                       ZAJEL_SYNC_SLOT_STATE_IDLE);
+} /*function: zajel_sync_slot_block*/
+
+void zajel_sync_slot_unblock(void* slot_ptr)
+{
+    zajel_sync_slot_s* thisSlot_ptr;
+
+    thisSlot_ptr = (zajel_sync_slot_s*) slot_ptr;
+
+    if(ZAJEL_SYNC_SLOT_STATE_PARKED == ZAJEL_ATOMIC_EXCHANGE(&thisSlot_ptr->state,
+                                                             ZAJEL_SYNC_SLOT_STATE_SIGNALED))
+    {
+        /*<The owner gave up spinning, wake it up>*/
+        zajel_futex_wake(&thisSlot_ptr->state,
+                         1);
+    } /*if: <The owner gave up spinning, wake it up>*/
+} /*function: zajel_sync_slot_unblock*/
@@ -0,0 +1,132 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+
+/*
+ * A synchronization slot used to block the sender of a synchronous message until its receiver
+ * acknowledges it.
+ *
+ * The blocked thread first spins on the slot for a bounded number of iterations, and only parks on
+ * the slot futex if the acknowledgment did not arrive in the meantime. The spin limit adapts to the
+ * observed round trips: it moves towards twice the spin count that succeeded, and shrinks each time
+ * spinning was not enough, so that slow receivers do not burn the sender core for nothing.
+ *
+ * zajel_sync_slot_block/zajel_sync_slot_unblock match the block/unblock callbacks prototypes, and
+ * can be registered directly with the slot passed as the thread synchronization primitive.
+ */
+#ifndef ZAJEL_SYNC_H_
+#define ZAJEL_SYNC_H_
+
+#include <stdint.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Spin limit of a new slot*/
+#define ZAJEL_SYNC_SLOT_INITIAL_SPIN_LIMIT      (1024)
+/*The spin limit never goes below this, so that a fast receiver can always be caught spinning*/
+#define ZAJEL_SYNC_SLOT_MIN_SPIN_LIMIT          (64)
+/*The spin limit never goes above this, bounding the time wasted before parking*/
+#define ZAJEL_SYNC_SLOT_MAX_SPIN_LIMIT          (32768)
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_sync_slot_s
+ *
+ * Structure Description:
+ * Holds a single synchronization slot, it occupies its own cache line so that the spinning thread
+ * only shares it with the acknowledging one.
+ **************************************************************************************************/
+typedef struct zajel_sync_slot
+{
+    /*Futex word, one of the ZAJEL_SYNC_SLOT_STATE_ values defined in zajel_sync.c*/
+    uint32_t    state                   ZAJEL_CACHE_ALIGNED;
+    /*Current spin limit, only used by the blocked thread*/
+    uint32_t    spinLimit;
+    /*Number of blocks completed while spinning, for tuning purposes*/
+    uint32_t    spinCompletions;
+    /*Number of blocks that needed to park, for tuning purposes*/
+    uint32_t    parkCompletions;
+} zajel_sync_slot_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_sync_slot_init
+ *
+ *  Arguments   : zajel_sync_slot_s* slot_ptr
+ *
+ *  Description : This function initializes the given slot, nothing signaled and nobody blocked.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_sync_slot_init(zajel_sync_slot_s* slot_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_sync_slot_block
+ *
+ *  Arguments   : void* slot_ptr
+ *
+ *  Description : A ready-made zajel_block_callback, spins then parks the calling thread until
+ *                  zajel_sync_slot_unblock is called for the same slot. Only one thread (the slot
+ *                  owner) shall block on a given slot.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_sync_slot_block(void* slot_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_sync_slot_unblock
+ *
+ *  Arguments   : void* slot_ptr
+ *
+ *  Description : A ready-made zajel_unblock_callback, completes the slot, waking the owner only if it
+ *                  already parked. It may be called before the owner blocks.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_sync_slot_unblock(void* slot_ptr);
+
+#endif /* ZAJEL_SYNC_H_ */
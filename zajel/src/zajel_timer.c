@@ -0,0 +1,294 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <stddef.h>
+#include "zajel_timer.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Mask extracting a slot index*/
+#define ZAJEL_TIMER_SLOT_MASK           ((uint64_t)(ZAJEL_TIMER_SLOT_COUNT - 1))
+
+/*
+ * Furthest a timer can be placed from the current tick, the top level slots shall stay ahead of the
+ * current one (a further timer is placed there, and goes around until it gets close enough)
+ */
+#define ZAJEL_TIMER_MAX_DISTANCE                                                                   \
+    ((1ULL << (ZAJEL_TIMER_SLOT_BITS * ZAJEL_TIMER_LEVEL_COUNT)) -                                 \
+     (1ULL << (ZAJEL_TIMER_SLOT_BITS * (ZAJEL_TIMER_LEVEL_COUNT - 1))))
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_link
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr,
+ *                zajel_timer_s*        timer_ptr
+ *
+ *  Description : Links the given timer into the slot matching its expiry, relative to the current
+ *                  tick. The expiry shall be after the current tick.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC void zajel_timer_link(zajel_timer_wheel_s*   wheel_ptr,
+                             zajel_timer_s*         timer_ptr);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+void zajel_timer_wheel_init(zajel_timer_wheel_s*    wheel_ptr,
+                            zajel_timer_s*          timerArray,
+                            uint32_t                capacity,
+                            uint64_t                currentTick)
+{
+    /*Temporary counters*/
+    uint32_t level;
+    uint32_t i;
+
+    for(level = 0; level < ZAJEL_TIMER_LEVEL_COUNT; ++level)
+    {
+        for(i = 0; i < ZAJEL_TIMER_SLOT_COUNT; ++i)
+        {
+            wheel_ptr->slotArray[level][i] = NULL;
+        } /*for: <Empty each slot>*/
+    } /*for: <Empty each level>*/
+
+    wheel_ptr->free_ptr = NULL;
+
+    for(i = capacity; i > 0; --i)
+    {
+        /*<Chain the timers into the free list, the first one ends up at its head>*/
+        timerArray[i - 1].next_ptr      = wheel_ptr->free_ptr;
+        timerArray[i - 1].link_ptr_ptr  = NULL;
+        timerArray[i - 1].message_ptr   = NULL;
+        timerArray[i - 1].generation    = 1;
+        wheel_ptr->free_ptr             = &timerArray[i - 1];
+    } /*for: <Chain the timers into the free list, the first one ends up at its head>*/
+
+    wheel_ptr->currentTick  = currentTick;
+    wheel_ptr->armedCount   = 0;
+    wheel_ptr->capacity     = capacity;
+    wheel_ptr->timerArray   = timerArray;
+} /*function: zajel_timer_wheel_init*/
+
+zajel_timer_s* zajel_timer_alloc(zajel_timer_wheel_s* wheel_ptr)
+{
+    zajel_timer_s* timer_ptr;
+
+    timer_ptr = wheel_ptr->free_ptr;
+
+    if(NULL != timer_ptr)
+    {
+        wheel_ptr->free_ptr = timer_ptr->next_ptr;
+        timer_ptr->next_ptr = NULL;
+    } /*if: <A timer is available>*/
+
+    return timer_ptr;
+} /*function: zajel_timer_alloc*/
+
+void zajel_timer_free(zajel_timer_wheel_s*  wheel_ptr,
+                      zajel_timer_s*        timer_ptr)
+{
+    /*Generation 0 is never used, so that no valid identifier is 0*/
+    if(0 == ++timer_ptr->generation)
+    {
+        timer_ptr->generation = 1;
+    } /*if: <Generation wrapped around>*/
+
+    timer_ptr->message_ptr  = NULL;
+    timer_ptr->next_ptr     = wheel_ptr->free_ptr;
+    wheel_ptr->free_ptr     = timer_ptr;
+} /*function: zajel_timer_free*/
+
+void zajel_timer_arm(zajel_timer_wheel_s*   wheel_ptr,
+                     zajel_timer_s*         timer_ptr)
+{
+    if(timer_ptr->expiry <= wheel_ptr->currentTick)
+    {
+        timer_ptr->expiry = wheel_ptr->currentTick + 1;
+    } /*if: <Already due, the current tick is over>*/
+
+    zajel_timer_link(wheel_ptr,
+                     timer_ptr);
+
+    ++wheel_ptr->armedCount;
+} /*function: zajel_timer_arm*/
+
+void zajel_timer_disarm(zajel_timer_wheel_s*    wheel_ptr,
+                        zajel_timer_s*          timer_ptr)
+{
+    *timer_ptr->link_ptr_ptr = timer_ptr->next_ptr;
+
+    if(NULL != timer_ptr->next_ptr)
+    {
+        timer_ptr->next_ptr->link_ptr_ptr = timer_ptr->link_ptr_ptr;
+    } /*if: <Timer was not the last of its slot>*/
+
+    timer_ptr->next_ptr     = NULL;
+    timer_ptr->link_ptr_ptr = NULL;
+
+    --wheel_ptr->armedCount;
+} /*function: zajel_timer_disarm*/
+
+zajel_timer_s* zajel_timer_wheel_advance(zajel_timer_wheel_s*   wheel_ptr,
+                                         uint64_t               tick)
+{
+    zajel_timer_s*  timer_ptr;
+    zajel_timer_s*  next_ptr;
+    /*Head and tail link of the expired timers list*/
+    zajel_timer_s*  expired_ptr;
+    zajel_timer_s** expiredTail_ptr_ptr;
+    uint64_t        currentTick;
+    /*Highest level whose slot comes up on the current tick*/
+    uint32_t        topLevel;
+    /*Temporary counter*/
+    uint32_t        level;
+
+    expired_ptr         = NULL;
+    expiredTail_ptr_ptr = &expired_ptr;
+
+    if(0 == wheel_ptr->armedCount)
+    {
+        /*<Nothing can expire, jump right to the given tick>*/
+        if(tick > wheel_ptr->currentTick)
+        {
+            wheel_ptr->currentTick = tick;
+        } /*if: <Time went by>*/
+
+        return NULL;
+    } /*if: <Nothing can expire, jump right to the given tick>*/
+
+    while((wheel_ptr->currentTick < tick) && (0 != wheel_ptr->armedCount))
+    {
+        /*<Move one tick forward>*/
+        currentTick = ++wheel_ptr->currentTick;
+
+        for(topLevel = 0;
+            ((topLevel + 1) < ZAJEL_TIMER_LEVEL_COUNT) &&
+            (0 == ((currentTick >> (ZAJEL_TIMER_SLOT_BITS * topLevel)) & ZAJEL_TIMER_SLOT_MASK));
+            ++topLevel)
+        {
+        } /*for: <Find the levels wrapping around on this tick>*/
+
+        for(level = topLevel; level > 0; --level)
+        {
+            /*<Cascade the slots coming up, from the highest level, their timers go down the levels>*/
+            timer_ptr = wheel_ptr->slotArray[level][(currentTick >> (ZAJEL_TIMER_SLOT_BITS * level)) & ZAJEL_TIMER_SLOT_MASK];
+            wheel_ptr->slotArray[level][(currentTick >> (ZAJEL_TIMER_SLOT_BITS * level)) & ZAJEL_TIMER_SLOT_MASK] = NULL;
+
+            while(NULL != timer_ptr)
+            {
+                next_ptr = timer_ptr->next_ptr;
+
+                zajel_timer_link(wheel_ptr,
+                                 timer_ptr);
+
+                timer_ptr = next_ptr;
+            } /*while: <Link each timer again>*/
+        } /*for: <Cascade the slots coming up, from the highest level, their timers go down the levels>*/
+
+        timer_ptr = wheel_ptr->slotArray[0][currentTick & ZAJEL_TIMER_SLOT_MASK];
+        wheel_ptr->slotArray[0][currentTick & ZAJEL_TIMER_SLOT_MASK] = NULL;
+
+        while(NULL != timer_ptr)
+        {
+            /*<Move the expired timers to the end of the expired list>*/
+            timer_ptr->link_ptr_ptr = NULL;
+            *expiredTail_ptr_ptr    = timer_ptr;
+            expiredTail_ptr_ptr     = &timer_ptr->next_ptr;
+            timer_ptr               = timer_ptr->next_ptr;
+
+            --wheel_ptr->armedCount;
+        } /*while: <Move the expired timers to the end of the expired list>*/
+    } /*while: <Move one tick forward>*/
+
+    if(wheel_ptr->currentTick < tick)
+    {
+        wheel_ptr->currentTick = tick;
+    } /*if: <The wheel got empty on the way, jump right to the given tick>*/
+
+    return expired_ptr;
+} /*function: zajel_timer_wheel_advance*/
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+STATIC void zajel_timer_link(zajel_timer_wheel_s*   wheel_ptr,
+                             zajel_timer_s*         timer_ptr)
+{
+    zajel_timer_s** slot_ptr_ptr;
+    /*Tick deciding where the timer goes, its expiry unless it is beyond the wheel span*/
+    uint64_t        placement;
+    uint32_t        level;
+
+    placement = timer_ptr->expiry;
+
+    if((placement - wheel_ptr->currentTick) > ZAJEL_TIMER_MAX_DISTANCE)
+    {
+        placement = wheel_ptr->currentTick + ZAJEL_TIMER_MAX_DISTANCE;
+    } /*if: <Beyond the wheel span, go around the top level>*/
+
+    for(level = 0;
+        ((level + 1) < ZAJEL_TIMER_LEVEL_COUNT) &&
+        (0 != ((placement ^ wheel_ptr->currentTick) >> (ZAJEL_TIMER_SLOT_BITS * (level + 1))));
+        ++level)
+    {
+    } /*for: <Find the lowest level sharing the higher bits of the current tick>*/
+
+    slot_ptr_ptr            = &wheel_ptr->slotArray[level][(placement >> (ZAJEL_TIMER_SLOT_BITS * level)) & ZAJEL_TIMER_SLOT_MASK];
+    timer_ptr->next_ptr     = *slot_ptr_ptr;
+    timer_ptr->link_ptr_ptr = slot_ptr_ptr;
+
+    if(NULL != timer_ptr->next_ptr)
+    {
+        timer_ptr->next_ptr->link_ptr_ptr = &timer_ptr->next_ptr;
+    } /*if: <Slot was not empty>*/
+
+    *slot_ptr_ptr = timer_ptr;
+} /*function: zajel_timer_link*/
@@ -0,0 +1,211 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * Per-thread hierarchical timing wheels, used by the delayed and periodic messages.
+ *
+ * A wheel is made of ZAJEL_TIMER_LEVEL_COUNT levels of ZAJEL_TIMER_SLOT_COUNT slots, each level
+ * covering ZAJEL_TIMER_SLOT_COUNT times the span of the one below it. A timer is linked into the
+ * lowest level whose span reaches its expiry, so that the insertion and the removal are O(1). When
+ * the lower levels wrap around, the matching slot of the level above is cascaded, its timers going
+ * down the levels until the lowest one expires them. The timers further than the whole wheel span
+ * go around the top level until they get close enough.
+ *
+ * The timers themselves come from an array given at initialization, so that a timer identifier
+ * stays safe to use (if stale) after the timer is released. A wheel is only used by its owner
+ * thread.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_TIMER_H_
+#define ZAJEL_TIMER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  M A C R O S
+ *
+ **************************************************************************************************/
+
+/*Number of bits of the tick indexing each level, and the resulting slots per level*/
+#define ZAJEL_TIMER_SLOT_BITS           (8)
+#define ZAJEL_TIMER_SLOT_COUNT          (1 << ZAJEL_TIMER_SLOT_BITS)
+
+/*Number of levels, the wheel spans 2^32 ticks*/
+#define ZAJEL_TIMER_LEVEL_COUNT         (4)
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_timer_s
+ *
+ * Structure Description:
+ * A single timer, linked into a slot of the wheel while it is armed, and into the free list of the
+ * wheel otherwise.
+ **************************************************************************************************/
+typedef struct zajel_timer
+{
+    /*Next timer of the same slot (or of the free list, or of the expired list)*/
+    struct zajel_timer*     next_ptr;
+    /*The link pointing to this timer, so that it can be removed in O(1), NULL while not linked*/
+    struct zajel_timer**    link_ptr_ptr;
+    /*Tick at which the timer expires*/
+    uint64_t                expiry;
+    /*Number of ticks between two expirations, 0 for a timer expiring once*/
+    uint64_t                period;
+    /*The message sent by the timer, and its size (periodic timers send a copy of it)*/
+    void*                   message_ptr;
+    uint32_t                size;
+    /*Incremented whenever the timer is released, so that the stale identifiers are recognized*/
+    uint32_t                generation;
+} zajel_timer_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_timer_wheel_s
+ *
+ * Structure Description:
+ * Holds the timing wheel of a single thread.
+ **************************************************************************************************/
+typedef struct zajel_timer_wheel
+{
+    /*Heads of the timers list of each slot of each level*/
+    zajel_timer_s*  slotArray[ZAJEL_TIMER_LEVEL_COUNT][ZAJEL_TIMER_SLOT_COUNT];
+    /*Last tick the wheel was advanced to, the timers armed expire after it*/
+    uint64_t        currentTick;
+    /*Number of armed timers*/
+    uint32_t        armedCount;
+    /*Number of timers of timerArray*/
+    uint32_t        capacity;
+    /*All the timers of the wheel, and the ones not armed*/
+    zajel_timer_s*  timerArray;
+    zajel_timer_s*  free_ptr;
+} zajel_timer_wheel_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_wheel_init
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr,
+ *                zajel_timer_s*        timerArray,
+ *                uint32_t              capacity,
+ *                uint64_t              currentTick
+ *
+ *  Description : Initializes an empty wheel, starting at the given tick, over the given timers.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_timer_wheel_init(zajel_timer_wheel_s*    wheel_ptr,
+                            zajel_timer_s*          timerArray,
+                            uint32_t                capacity,
+                            uint64_t                currentTick);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_alloc
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr
+ *
+ *  Description : Takes a timer from the free list of the wheel.
+ *
+ *  Returns     : zajel_timer_s*, NULL if all the timers are in use.
+ **************************************************************************************************/
+zajel_timer_s* zajel_timer_alloc(zajel_timer_wheel_s* wheel_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_free
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr,
+ *                zajel_timer_s*        timer_ptr
+ *
+ *  Description : Returns the given (not armed) timer to the free list, invalidating its identifiers.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_timer_free(zajel_timer_wheel_s*  wheel_ptr,
+                      zajel_timer_s*        timer_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_arm
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr,
+ *                zajel_timer_s*        timer_ptr
+ *
+ *  Description : Links the given timer into the wheel according to its expiry, a timer already due
+ *                  expires on the next tick.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_timer_arm(zajel_timer_wheel_s*   wheel_ptr,
+                     zajel_timer_s*         timer_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_disarm
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr,
+ *                zajel_timer_s*        timer_ptr
+ *
+ *  Description : Unlinks the given armed timer from the wheel.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+void zajel_timer_disarm(zajel_timer_wheel_s*    wheel_ptr,
+                        zajel_timer_s*          timer_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_timer_wheel_advance
+ *
+ *  Arguments   : zajel_timer_wheel_s*  wheel_ptr,
+ *                uint64_t              tick
+ *
+ *  Description : Moves the wheel up to the given tick, and unlinks the timers expiring on the way.
+ *                  The expired timers are no longer armed, a periodic one shall be armed again by
+ *                  the caller.
+ *
+ *  Returns     : zajel_timer_s*, the list of expired timers (chained through next_ptr), in expiry
+ *                  order, NULL if none.
+ **************************************************************************************************/
+zajel_timer_s* zajel_timer_wheel_advance(zajel_timer_wheel_s*   wheel_ptr,
+                                         uint64_t               tick);
+
+#endif /* ZAJEL_TIMER_H_ */
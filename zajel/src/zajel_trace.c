@@ -0,0 +1,118 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <string.h>
+#include "zajel_trace.h"
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+uint32_t zajel_trace_ring_read(const zajel_trace_ring_s*    ring_ptr,
+                               zajel_trace_record_s*        record_array)
+{
+    /*Index of the oldest record held by the ring, and of the next one to be written*/
+    uint64_t first;
+    uint64_t head;
+    /*Oldest record which was surely not overwritten during the copy*/
+    uint64_t oldestValid;
+    /*Temporary counter*/
+    uint64_t i;
+
+    head    = ZAJEL_ATOMIC_LOAD_ACQUIRE(&ring_ptr->head);
+    first   = (head > ring_ptr->mask) ? (head - ring_ptr->mask - 1) : (0);
+
+    for(i = first; i < head; ++i)
+    {
+        record_array[i - first] = ring_ptr->recordArray[i & ring_ptr->mask];
+    } /*for: <Copy the records out>*/
+
+    /*
+     * The copy is ordered before reading the head again, a record is only sure to be intact if the
+     * owner did not start overwriting it, and it may be writing the slot after the published head
+     */
+    ZAJEL_ATOMIC_FENCE();
+    oldestValid = ZAJEL_ATOMIC_LOAD_RELAXED(&ring_ptr->head) + 1;
+    oldestValid = (oldestValid > ring_ptr->mask) ? (oldestValid - ring_ptr->mask - 1) : (0);
+
+    if(oldestValid >= head)
+    {
+        return 0;
+    } /*if: <All the records were overwritten>*/
+
+    if(oldestValid > first)
+    {
+        memmove(record_array,
+                &record_array[oldestValid - first],
+                (size_t)(head - oldestValid) * sizeof(zajel_trace_record_s));
+        first = oldestValid;
+    } /*if: <Leave out the records overwritten during the copy>*/
+
+    return (uint32_t)(head - first);
+} /*function: zajel_trace_ring_read*/
+
+bool_t zajel_trace_thread_write(const zajel_trace_ring_s*   ring_ptr,
+                                uint32_t                    threadID,
+                                uint32_t                    coreID,
+                                zajel_trace_record_s*       record_array,
+                                FILE*                       file_ptr)
+{
+    zajel_trace_thread_header_s header;
+
+    header.threadID     = threadID;
+    header.coreID       = coreID;
+    header.recordCount  = zajel_trace_ring_read(ring_ptr,
+                                                record_array);
+
+    if(1 != fwrite(&header,
+                   sizeof(header),
+                   1,
+                   file_ptr))
+    {
+        return FALSE;
+    } /*if: <Header not written>*/
+
+    if(header.recordCount != fwrite(record_array,
+                                    sizeof(zajel_trace_record_s),
+                                    (size_t) header.recordCount,
+                                    file_ptr))
+    {
+        return FALSE;
+    } /*if: <Records not written>*/
+
+    return TRUE;
+} /*function: zajel_trace_thread_write*/
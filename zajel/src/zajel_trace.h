@@ -0,0 +1,204 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * Per-thread trace rings (see zajel_enable_trace).
+ *
+ * Each thread owns a ring of fixed size records, written by itself only: the record is filled in
+ * place then published by bumping the free running head index, so the ring always holds the latest
+ * events of the thread, the older ones being overwritten. A reader copies the ring out, then reads
+ * the head again to leave out the records overwritten during the copy.
+ *
+ * This header is internal to the framework.
+ */
+#ifndef ZAJEL_TRACE_H_
+#define ZAJEL_TRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "zajel.h"
+#include "zajel_platform.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_trace_ring_s
+ *
+ * Structure Description:
+ * The trace ring of a single thread, on its own cache line.
+ **************************************************************************************************/
+typedef struct zajel_trace_ring
+{
+    /*Number of records written so far, only modified by the owner thread*/
+    uint64_t                head                ZAJEL_CACHE_ALIGNED;
+    /*Capacity - 1, used to wrap the head index, read-only after initialization*/
+    uint32_t                mask;
+    /*The ring storage, capacity records*/
+    zajel_trace_record_s*   recordArray;
+} zajel_trace_ring_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_ring_read
+ *
+ *  Arguments   : const zajel_trace_ring_s* ring_ptr,
+ *                zajel_trace_record_s*     record_array
+ *
+ *  Description : Copies the records of the given ring, the oldest first, into record_array (which
+ *                  shall hold the ring capacity), leaving out the ones overwritten meanwhile. It can
+ *                  be called by any thread.
+ *
+ *  Returns     : uint32_t, number of records copied.
+ **************************************************************************************************/
+uint32_t zajel_trace_ring_read(const zajel_trace_ring_s*    ring_ptr,
+                               zajel_trace_record_s*        record_array);
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_thread_write
+ *
+ *  Arguments   : const zajel_trace_ring_s* ring_ptr,
+ *                uint32_t                  threadID,
+ *                uint32_t                  coreID,
+ *                zajel_trace_record_s*     record_array,
+ *                FILE*                     file_ptr
+ *
+ *  Description : Writes the records of the given thread to the trace file, preceded by their
+ *                  zajel_trace_thread_header_s, record_array being used to copy the ring out (see
+ *                  zajel_trace_ring_read).
+ *
+ *  Returns     : bool_t, FALSE if the file could not be written.
+ **************************************************************************************************/
+bool_t zajel_trace_thread_write(const zajel_trace_ring_s*   ring_ptr,
+                                uint32_t                    threadID,
+                                uint32_t                    coreID,
+                                zajel_trace_record_s*       record_array,
+                                FILE*                       file_ptr);
+
+/***************************************************************************************************
+ *
+ *  I N T E R F A C E   F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_ring_init
+ *
+ *  Arguments   : zajel_trace_ring_s*   ring_ptr,
+ *                zajel_trace_record_s* recordArray,
+ *                uint32_t              capacity
+ *
+ *  Description : Initializes an empty ring over the given storage, capacity must be a power of two.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_trace_ring_init(zajel_trace_ring_s*    ring_ptr,
+                                         zajel_trace_record_s*  recordArray,
+                                         uint32_t               capacity)
+{
+    ring_ptr->head          = 0;
+    ring_ptr->mask          = capacity - 1;
+    ring_ptr->recordArray   = recordArray;
+} /*function: zajel_trace_ring_init*/
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_write
+ *
+ *  Arguments   : zajel_trace_ring_s*   ring_ptr,
+ *                uint32_t              event,
+ *                const void*           flow_ptr,
+ *                uint32_t              messageID,
+ *                uint32_t              sourceComponentID,
+ *                uint32_t              destinationComponentID
+ *
+ *  Description : Records an event of the given message, must only be called by the owner thread of
+ *                  the ring. The message is only identified by its address, so that the events
+ *                  following its release can still be recorded.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_trace_write(zajel_trace_ring_s*    ring_ptr,
+                                     uint32_t               event,
+                                     const void*            flow_ptr,
+                                     uint32_t               messageID,
+                                     uint32_t               sourceComponentID,
+                                     uint32_t               destinationComponentID)
+{
+    zajel_trace_record_s*   record_ptr;
+    uint64_t                head;
+
+    head        = ring_ptr->head;
+    record_ptr  = &ring_ptr->recordArray[head & ring_ptr->mask];
+
+    record_ptr->timestamp               = zajel_timestamp_now();
+    record_ptr->flowID                  = (uint64_t)(uintptr_t) flow_ptr;
+    record_ptr->messageID               = (uint16_t) messageID;
+    record_ptr->sourceComponentID       = (uint16_t) sourceComponentID;
+    record_ptr->destinationComponentID  = (uint16_t) destinationComponentID;
+    record_ptr->event                   = (uint8_t) event;
+    record_ptr->reserved                = 0;
+
+    ZAJEL_ATOMIC_STORE_RELEASE(&ring_ptr->head, head + 1);
+} /*function: zajel_trace_write*/
+
+/***************************************************************************************************
+ *  Name        : zajel_trace_message
+ *
+ *  Arguments   : zajel_trace_ring_s*                   ring_ptr,
+ *                uint32_t                              event,
+ *                const zajel_message_descriptor_s*     descriptor_ptr
+ *
+ *  Description : Records an event of the given message, which shall still be valid.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+STATIC INLINE void zajel_trace_message(zajel_trace_ring_s*                  ring_ptr,
+                                       uint32_t                             event,
+                                       const zajel_message_descriptor_s*    descriptor_ptr)
+{
+    zajel_trace_write(ring_ptr,
+                      event,
+                      descriptor_ptr,
+                      descriptor_ptr->messageID,
+                      descriptor_ptr->sourceComponentID,
+                      descriptor_ptr->destinationComponentID);
+} /*function: zajel_trace_message*/
+
+#endif /* ZAJEL_TRACE_H_ */
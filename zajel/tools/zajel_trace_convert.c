@@ -0,0 +1,523 @@
+/***************************************************************************************************
+ *
+ * zajel - an embedded communication framework for multi-threaded/multi-core environment.
+ *
+ * Copyright  2009  Mohamed Galal El-Din, Karim Emad Morsy.
+ *
+ ***************************************************************************************************
+ *
+ * This file is part of zajel library.
+ *
+ * zajel is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or any later version.
+ *
+ * zajel is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with zajel. If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***************************************************************************************************
+ *
+ * For more information, questions, or inquiries please contact:
+ *
+ * Mohamed Galal El-Din:    mohamed.g.ebrahim@gmail.com
+ * Karim Emad Morsy:        karim.e.morsy@gmail.com
+ *
+ **************************************************************************************************/
+
+/*
+ * Converts a trace file written by zajel_trace_dump into the Chrome trace event JSON format, which
+ * can be opened by ui.perfetto.dev or chrome://tracing. Each core is shown as a process and each
+ * thread of the framework as a thread: the handlers and the blocking on synchronous messages as
+ * slices, the other events as instants, with flow arrows from each send to the delivery and the
+ * handler of the message, and from each acknowledgment to the sender it releases.
+ *
+ * Build: make (see Makefile), writes build/zajel_trace_convert
+ * Usage: zajel_trace_convert <trace file> <json file>
+ */
+
+/***************************************************************************************************
+ *
+ *  I N C L U D E S
+ *
+ **************************************************************************************************/
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "zajel.h"
+
+/***************************************************************************************************
+ *
+ *  T Y P E S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_convert_event_s
+ *
+ * Structure Description:
+ * A record of the trace file, along with the thread which recorded it.
+ **************************************************************************************************/
+typedef struct zajel_convert_event
+{
+    zajel_trace_record_s    record;
+    uint32_t                threadID;
+    uint32_t                coreID;
+} zajel_convert_event_s;
+
+/***************************************************************************************************
+ * Structure Name:
+ * zajel_convert_flows_s
+ *
+ * Structure Description:
+ * The open flows, keyed by the address of their message, in an open addressing table which never
+ * gets full as it has twice as many entries as the trace has records.
+ **************************************************************************************************/
+typedef struct zajel_convert_flows
+{
+    /*The message address of each entry, zero if the entry was never used*/
+    uint64_t*   keyArray;
+    /*The flow identifier of each entry, zero once the flow is closed*/
+    uint64_t*   flowArray;
+    uint64_t    mask;
+} zajel_convert_flows_s;
+
+/***************************************************************************************************
+ *
+ *  I N T E R N A L   F U N C T I O N   D E C L A R A T I O N S
+ *
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *  Name        : zajel_convert_compare
+ *
+ *  Arguments   : const void* first_ptr,
+ *                const void* second_ptr
+ *
+ *  Description : Orders two events by their timestamp, for qsort.
+ *
+ *  Returns     : int.
+ **************************************************************************************************/
+static int zajel_convert_compare(const void*    first_ptr,
+                                 const void*    second_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_convert_flow_slot
+ *
+ *  Arguments   : zajel_convert_flows_s*    flows_ptr,
+ *                uint64_t                  key
+ *
+ *  Description : Finds the entry of the given message address, or the unused entry it goes to.
+ *
+ *  Returns     : uint64_t, the entry index.
+ **************************************************************************************************/
+static uint64_t zajel_convert_flow_slot(zajel_convert_flows_s*  flows_ptr,
+                                        uint64_t                key);
+
+/***************************************************************************************************
+ *  Name        : zajel_convert_flow_open
+ *
+ *  Arguments   : zajel_convert_flows_s*    flows_ptr,
+ *                uint64_t                  key,
+ *                uint64_t                  flowID
+ *
+ *  Description : Opens a flow for the given message address, replacing any flow left open for it.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_convert_flow_open(zajel_convert_flows_s*  flows_ptr,
+                                    uint64_t                key,
+                                    uint64_t                flowID);
+
+/***************************************************************************************************
+ *  Name        : zajel_convert_flow_find
+ *
+ *  Arguments   : zajel_convert_flows_s*    flows_ptr,
+ *                uint64_t                  key,
+ *                int                       isClosing
+ *
+ *  Description : Finds the open flow of the given message address, closing it if asked to.
+ *
+ *  Returns     : uint64_t, the flow identifier, zero if none is open.
+ **************************************************************************************************/
+static uint64_t zajel_convert_flow_find(zajel_convert_flows_s*  flows_ptr,
+                                        uint64_t                key,
+                                        int                     isClosing);
+
+/***************************************************************************************************
+ *  Name        : zajel_convert_write_event
+ *
+ *  Arguments   : FILE*                         output_ptr,
+ *                const zajel_convert_event_s*  event_ptr,
+ *                double                        time,
+ *                const char*                   phase_ptr,
+ *                const char*                   name_ptr
+ *
+ *  Description : Writes a slice or instant event of the given record, its name followed by the
+ *                  message ID.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_convert_write_event(FILE*                         output_ptr,
+                                      const zajel_convert_event_s*  event_ptr,
+                                      double                        time,
+                                      const char*                   phase_ptr,
+                                      const char*                   name_ptr);
+
+/***************************************************************************************************
+ *  Name        : zajel_convert_write_flow
+ *
+ *  Arguments   : FILE*                         output_ptr,
+ *                const zajel_convert_event_s*  event_ptr,
+ *                double                        time,
+ *                const char*                   phase_ptr,
+ *                uint64_t                      flowID
+ *
+ *  Description : Writes a flow event (start, step or end) bound to the slice of the given record.
+ *
+ *  Returns     : void.
+ **************************************************************************************************/
+static void zajel_convert_write_flow(FILE*                          output_ptr,
+                                     const zajel_convert_event_s*   event_ptr,
+                                     double                         time,
+                                     const char*                    phase_ptr,
+                                     uint64_t                       flowID);
+
+/***************************************************************************************************
+ *
+ *  F U N C T I O N   D E F I N I T I O N S
+ *
+ **************************************************************************************************/
+
+int main(int    argumentCount,
+         char** argument_ptr_array)
+{
+    zajel_trace_file_header_s   header;
+    zajel_trace_thread_header_s threadHeader;
+    zajel_convert_event_s*      eventArray;
+    zajel_convert_event_s*      event_ptr;
+    zajel_convert_flows_s       messageFlows;
+    zajel_convert_flows_s       acknowledgeFlows;
+    /*Slices opened on each thread and not closed yet, the events of a slice cut by the ring are skipped*/
+    uint32_t*                   depthArray;
+    FILE*                       input_ptr;
+    FILE*                       output_ptr;
+    uint64_t                    eventCount;
+    uint64_t                    eventCapacity;
+    uint64_t                    flowCount;
+    uint64_t                    flowID;
+    /*Nanoseconds per tick of the timestamp counter*/
+    double                      tickNanoseconds;
+    /*Time of the current event in microseconds, from the first event*/
+    double                      time;
+    /*Temporary counters*/
+    uint64_t                    i;
+    uint32_t                    j;
+
+    if(3 != argumentCount)
+    {
+        fprintf(stderr, "Usage: %s <trace file> <json file>\n", argument_ptr_array[0]);
+        return 1;
+    } /*if: <Wrong arguments>*/
+
+    input_ptr = fopen(argument_ptr_array[1], "rb");
+
+    if((NULL == input_ptr) ||
+       (1 != fread(&header, sizeof(header), 1, input_ptr)) ||
+       (ZAJEL_TRACE_FILE_MAGIC != header.magic) ||
+       (ZAJEL_TRACE_FILE_VERSION != header.version))
+    {
+        fprintf(stderr, "%s: not a zajel trace file\n", argument_ptr_array[1]);
+        return 1;
+    } /*if: <Not a trace file>*/
+
+    /*<Load the records of every thread>*/
+    eventArray      = NULL;
+    eventCount      = 0;
+    eventCapacity   = 0;
+    depthArray      = (uint32_t*) calloc(header.threadCount + 1, sizeof(uint32_t));
+
+    for(j = 0; j < header.threadCount; ++j)
+    {
+        if(1 != fread(&threadHeader, sizeof(threadHeader), 1, input_ptr))
+        {
+            fprintf(stderr, "%s: truncated trace file\n", argument_ptr_array[1]);
+            return 1;
+        } /*if: <Thread header missing>*/
+
+        if((eventCount + threadHeader.recordCount) > eventCapacity)
+        {
+            eventCapacity   = (eventCount + threadHeader.recordCount) * 2;
+            eventArray      = (zajel_convert_event_s*) realloc(eventArray, eventCapacity * sizeof(zajel_convert_event_s));
+
+            if(NULL == eventArray)
+            {
+                fprintf(stderr, "Out of memory\n");
+                return 1;
+            } /*if: <No memory>*/
+        } /*if: <Grow the events>*/
+
+        for(i = 0; i < threadHeader.recordCount; ++i)
+        {
+            event_ptr = &eventArray[eventCount++];
+
+            if(1 != fread(&event_ptr->record, sizeof(zajel_trace_record_s), 1, input_ptr))
+            {
+                fprintf(stderr, "%s: truncated trace file\n", argument_ptr_array[1]);
+                return 1;
+            } /*if: <Record missing>*/
+
+            event_ptr->threadID = threadHeader.threadID;
+            event_ptr->coreID   = threadHeader.coreID;
+        } /*for: <Read each record of the thread>*/
+    } /*for: <Read the records of each thread>*/
+
+    fclose(input_ptr);
+
+    qsort(eventArray, (size_t) eventCount, sizeof(zajel_convert_event_s), zajel_convert_compare);
+
+    /*<Prepare the flow tables, twice as big as the number of records>*/
+    for(messageFlows.mask = 1; messageFlows.mask < (eventCount * 2); messageFlows.mask <<= 1);
+
+    messageFlows.keyArray       = (uint64_t*) calloc((size_t) messageFlows.mask, sizeof(uint64_t));
+    messageFlows.flowArray      = (uint64_t*) calloc((size_t) messageFlows.mask, sizeof(uint64_t));
+    messageFlows.mask          -= 1;
+    acknowledgeFlows.keyArray   = (uint64_t*) calloc((size_t) messageFlows.mask + 1, sizeof(uint64_t));
+    acknowledgeFlows.flowArray  = (uint64_t*) calloc((size_t) messageFlows.mask + 1, sizeof(uint64_t));
+    acknowledgeFlows.mask       = messageFlows.mask;
+    flowCount                   = 0;
+
+    if((NULL == depthArray) ||
+       (NULL == messageFlows.keyArray) || (NULL == messageFlows.flowArray) ||
+       (NULL == acknowledgeFlows.keyArray) || (NULL == acknowledgeFlows.flowArray))
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    } /*if: <No memory>*/
+
+    tickNanoseconds = (header.endTimestamp > header.startTimestamp) ?
+                      ((double)(header.endNanoseconds - header.startNanoseconds) /
+                       (double)(header.endTimestamp - header.startTimestamp)) :
+                      (1.0);
+
+    output_ptr = fopen(argument_ptr_array[2], "w");
+
+    if(NULL == output_ptr)
+    {
+        fprintf(stderr, "%s: cannot be created\n", argument_ptr_array[2]);
+        return 1;
+    } /*if: <Output cannot be created>*/
+
+    fprintf(output_ptr, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    for(i = 0; i < eventCount; ++i)
+    {
+        /*<Name the cores and threads appearing in the trace>*/
+        event_ptr = &eventArray[i];
+
+        if(0 == depthArray[event_ptr->threadID])
+        {
+            fprintf(output_ptr,
+                    "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"core %u\"}},\n"
+                    "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}},\n",
+                    event_ptr->coreID, event_ptr->coreID,
+                    event_ptr->coreID, event_ptr->threadID, event_ptr->threadID);
+            depthArray[event_ptr->threadID] = 1;
+        } /*if: <First event of the thread>*/
+    } /*for: <Name the cores and threads appearing in the trace>*/
+
+    for(j = 0; j < header.threadCount; ++j)
+    {
+        depthArray[j] = 0;
+    } /*for: <No slice is open yet>*/
+
+    for(i = 0; i < eventCount; ++i)
+    {
+        /*<Convert each event>*/
+        event_ptr   = &eventArray[i];
+        time        = ((double)(event_ptr->record.timestamp - eventArray[0].record.timestamp) * tickNanoseconds) / 1000.0;
+
+        switch(event_ptr->record.event)
+        {
+            case ZAJEL_TRACE_EVENT_SEND:
+                zajel_convert_write_event(output_ptr, event_ptr, time, "X", "send");
+                flowID = ++flowCount;
+                zajel_convert_flow_open(&messageFlows, event_ptr->record.flowID, flowID);
+                zajel_convert_write_flow(output_ptr, event_ptr, time, "s", flowID);
+                break;
+            case ZAJEL_TRACE_EVENT_DELIVER:
+                zajel_convert_write_event(output_ptr, event_ptr, time, "X", "deliver");
+                flowID = zajel_convert_flow_find(&messageFlows, event_ptr->record.flowID, 0);
+
+                if(0 != flowID)
+                {
+                    zajel_convert_write_flow(output_ptr, event_ptr, time, "t", flowID);
+                } /*if: <Message was sent within the trace>*/
+                break;
+            case ZAJEL_TRACE_EVENT_ACKNOWLEDGE:
+                zajel_convert_write_event(output_ptr, event_ptr, time, "X", "acknowledge");
+                flowID = ++flowCount;
+                zajel_convert_flow_open(&acknowledgeFlows, event_ptr->record.flowID, flowID);
+                zajel_convert_write_flow(output_ptr, event_ptr, time, "s", flowID);
+                break;
+            case ZAJEL_TRACE_EVENT_BLOCK:
+            case ZAJEL_TRACE_EVENT_HANDLER_ENTRY:
+                zajel_convert_write_event(output_ptr, event_ptr, time, "B",
+                                          (ZAJEL_TRACE_EVENT_BLOCK == event_ptr->record.event) ? ("blocked on") : ("handle"));
+                ++depthArray[event_ptr->threadID];
+
+                if(ZAJEL_TRACE_EVENT_HANDLER_ENTRY == event_ptr->record.event)
+                {
+                    flowID = zajel_convert_flow_find(&messageFlows, event_ptr->record.flowID, 1);
+
+                    if(0 != flowID)
+                    {
+                        zajel_convert_write_flow(output_ptr, event_ptr, time, "f", flowID);
+                    } /*if: <Message was sent within the trace>*/
+                } /*if: <Handler ends the flow of its message>*/
+                break;
+            case ZAJEL_TRACE_EVENT_UNBLOCK:
+            case ZAJEL_TRACE_EVENT_HANDLER_EXIT:
+                if(0 == depthArray[event_ptr->threadID])
+                {
+                    break;
+                } /*if: <Slice started before the oldest record of the thread>*/
+
+                if(ZAJEL_TRACE_EVENT_UNBLOCK == event_ptr->record.event)
+                {
+                    flowID = zajel_convert_flow_find(&acknowledgeFlows, event_ptr->record.flowID, 1);
+
+                    if(0 != flowID)
+                    {
+                        zajel_convert_write_flow(output_ptr, event_ptr, time, "f", flowID);
+                    } /*if: <Acknowledgment was recorded>*/
+                } /*if: <Acknowledgment ends its flow in the blocked slice>*/
+
+                zajel_convert_write_event(output_ptr, event_ptr, time, "E", "");
+                --depthArray[event_ptr->threadID];
+                break;
+            default:
+                break;
+        } /*switch: <Convert the event according to its type>*/
+    } /*for: <Convert each event>*/
+
+    /*The metadata of the trace closes the list, as the JSON format does not allow a trailing comma*/
+    fprintf(output_ptr,
+            "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":4294967295,\"args\":{\"name\":\"zajel, %llu events\"}}\n]}\n",
+            (unsigned long long) eventCount);
+
+    if(0 != fclose(output_ptr))
+    {
+        fprintf(stderr, "%s: cannot be written\n", argument_ptr_array[2]);
+        return 1;
+    } /*if: <Output cannot be written>*/
+
+    free(eventArray);
+    free(depthArray);
+    free(messageFlows.keyArray);
+    free(messageFlows.flowArray);
+    free(acknowledgeFlows.keyArray);
+    free(acknowledgeFlows.flowArray);
+
+    return 0;
+} /*function: main*/
+
+static int zajel_convert_compare(const void*    first_ptr,
+                                 const void*    second_ptr)
+{
+    uint64_t first;
+    uint64_t second;
+
+    first   = ((const zajel_convert_event_s*) first_ptr)->record.timestamp;
+    second  = ((const zajel_convert_event_s*) second_ptr)->record.timestamp;
+
+    return (first < second) ? (-1) : ((first > second) ? (1) : (0));
+} /*function: zajel_convert_compare*/
+
+static uint64_t zajel_convert_flow_slot(zajel_convert_flows_s*  flows_ptr,
+                                        uint64_t                key)
+{
+    uint64_t slot;
+
+    /*Fibonacci hashing spreads the (aligned) addresses over the table*/
+    slot = (key * 0x9E3779B97F4A7C15ULL) & flows_ptr->mask;
+
+    while((0 != flows_ptr->keyArray[slot]) && (key != flows_ptr->keyArray[slot]))
+    {
+        slot = (slot + 1) & flows_ptr->mask;
+    } /*while: <Entry used by another message>*/
+
+    return slot;
+} /*function: zajel_convert_flow_slot*/
+
+static void zajel_convert_flow_open(zajel_convert_flows_s*  flows_ptr,
+                                    uint64_t                key,
+                                    uint64_t                flowID)
+{
+    uint64_t slot;
+
+    slot                        = zajel_convert_flow_slot(flows_ptr, key);
+    flows_ptr->keyArray[slot]   = key;
+    flows_ptr->flowArray[slot]  = flowID;
+} /*function: zajel_convert_flow_open*/
+
+static uint64_t zajel_convert_flow_find(zajel_convert_flows_s*  flows_ptr,
+                                        uint64_t                key,
+                                        int                     isClosing)
+{
+    uint64_t slot;
+    uint64_t flowID;
+
+    slot    = zajel_convert_flow_slot(flows_ptr, key);
+    flowID  = flows_ptr->flowArray[slot];
+
+    if(isClosing)
+    {
+        flows_ptr->flowArray[slot] = 0;
+    } /*if: <Close the flow>*/
+
+    return flowID;
+} /*function: zajel_convert_flow_find*/
+
+static void zajel_convert_write_event(FILE*                         output_ptr,
+                                      const zajel_convert_event_s*  event_ptr,
+                                      double                        time,
+                                      const char*                   phase_ptr,
+                                      const char*                   name_ptr)
+{
+    if('E' == phase_ptr[0])
+    {
+        fprintf(output_ptr,
+                "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u},\n",
+                time, event_ptr->coreID, event_ptr->threadID);
+        return;
+    } /*if: <End of a slice, named by its beginning>*/
+
+    fprintf(output_ptr,
+            "{\"ph\":\"%s\",\"cat\":\"zajel\",\"name\":\"%s %u\",\"ts\":%.3f,%s\"pid\":%u,\"tid\":%u,"
+            "\"args\":{\"message\":%u,\"source\":%u,\"destination\":%u,\"address\":\"0x%llx\"}},\n",
+            phase_ptr, name_ptr, (unsigned) event_ptr->record.messageID, time,
+            ('X' == phase_ptr[0]) ? ("\"dur\":0.001,") : (""),
+            event_ptr->coreID, event_ptr->threadID,
+            (unsigned) event_ptr->record.messageID,
+            (unsigned) event_ptr->record.sourceComponentID,
+            (unsigned) event_ptr->record.destinationComponentID,
+            (unsigned long long) event_ptr->record.flowID);
+} /*function: zajel_convert_write_event*/
+
+static void zajel_convert_write_flow(FILE*                          output_ptr,
+                                     const zajel_convert_event_s*   event_ptr,
+                                     double                         time,
+                                     const char*                    phase_ptr,
+                                     uint64_t                       flowID)
+{
+    fprintf(output_ptr,
+            "{\"ph\":\"%s\",\"cat\":\"zajel\",\"name\":\"message\",\"id\":%llu,\"ts\":%.3f,%s\"pid\":%u,\"tid\":%u},\n",
+            phase_ptr, (unsigned long long) flowID, time,
+            ('s' != phase_ptr[0]) ? ("\"bp\":\"e\",") : (""),
+            event_ptr->coreID, event_ptr->threadID);
+} /*function: zajel_convert_write_flow*/